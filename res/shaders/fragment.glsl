@@ -12,11 +12,22 @@ flat in vec3 vColor;
 in vec2 vTexCoord;
 in vec3 vNormal;
 in vec3 vViewDir;
+in float vOcclusion;
+flat in float vFade;
 
 out vec4 FragColor;
 
+// Per-pixel threshold shared with impostor_fragment.glsl, so both crossfade without blending
+float dither()
+{
+    return fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
+}
+
 void main()
 {
+    if (vFade > 0.0 && dither() < vFade)
+        discard;
+
     // Texture colors
     vec4 texColor = texture(uTexture, vTexCoord);
     vec4 colorMode = vec4(vColor.rgb, 1.0f);
@@ -44,7 +55,8 @@ void main()
     float spec = pow(max(dot(normalize(vNormal), halfway), 0.0), uNs);
     vec4 specularColor = vec4(uKs * spec * lightColor, 1.0);
 
-    vec4 finalColor = ambientColor + diffuseColor + specularColor;
+    // Baked ambient occlusion darkens the ambient and diffuse light
+    vec4 finalColor = (ambientColor + diffuseColor) * vOcclusion + specularColor;
 
     // Texture * (ambient color + diffuse color + specular color)
     FragColor = mixedColor * finalColor;
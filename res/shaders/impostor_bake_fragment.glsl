@@ -0,0 +1,21 @@
+#version 330 core
+
+// Stores the inputs of fragment.glsl instead of a lit color, so impostors are lit at draw time
+
+uniform sampler2D uTexture;
+
+flat in vec3 vColor;
+in vec2 vTexCoord;
+in vec3 vNormal;
+in float vOcclusion;
+
+layout (location = 0) out vec4 Color;
+layout (location = 1) out vec4 VertexColor;
+layout (location = 2) out vec4 NormalDepth;
+
+void main()
+{
+    Color = vec4(texture(uTexture, vTexCoord).rgb, 1.0);
+    VertexColor = vec4(vColor, vOcclusion);
+    NormalDepth = vec4(normalize(vNormal) * 0.5 + 0.5, gl_FragCoord.z);
+}
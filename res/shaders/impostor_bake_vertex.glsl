@@ -0,0 +1,42 @@
+#version 330 core
+
+// Renders one view of the mesh into the impostor atlas: an orthographic
+// projection of the bounding sphere, in object space, looking along -uViewDir
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in float aOcclusion;
+
+uniform vec3 uCenter;
+uniform float uRadius;
+uniform vec3 uViewDir;
+uniform vec3 uViewRight;
+uniform vec3 uViewUp;
+uniform float uViewScale;
+uniform int uVertexColor;
+
+flat out vec3 vColor;
+out vec2 vTexCoord;
+out vec3 vNormal;
+out float vOcclusion;
+
+void main()
+{
+    vec3 color = vec3(
+        fract(aPos.x) * 0.3,
+        fract(aPos.y) * 0.3,
+        fract(aPos.z) * 0.3
+    );
+    float gray = (color.r + color.g + color.b) / 1.5;
+    vColor = uVertexColor == 1 ? aColor.rgb : vec3(gray);
+
+    vTexCoord = aTexCoord;
+    vOcclusion = aOcclusion;
+    vNormal = aNormal;
+
+    // Depth 0 at the front of the sphere, 1 at the back
+    vec3 p = (aPos - uCenter) / uRadius;
+    gl_Position = vec4(dot(p, uViewRight) * uViewScale, dot(p, uViewUp) * uViewScale, -dot(p, uViewDir), 1.0);
+}
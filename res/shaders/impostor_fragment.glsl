@@ -0,0 +1,122 @@
+#version 330 core
+
+// Blends the four atlas views closest to the direction of the camera and
+// lights the result like fragment.glsl
+
+uniform sampler2D uImpostorColor;
+uniform sampler2D uImpostorVertexColor;
+uniform sampler2D uImpostorNormal;
+uniform int uImpostorAzimuths;
+uniform int uImpostorElevations;
+uniform float uImpostorViewScale;
+uniform float uImpostorRadius;
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform vec3 uCameraPos;
+uniform float uColorMix;
+
+uniform vec3 uKa;
+uniform vec3 uKd;
+uniform vec3 uKs;
+uniform float uNs;
+
+flat in vec3 vDirection;
+flat in float vFade;
+in vec3 vPlane;
+in vec3 vWorldPos;
+
+out vec4 FragColor;
+
+const float PI = 3.14159265359;
+
+// Per-pixel threshold shared with fragment.glsl, so both crossfade without blending
+float dither()
+{
+    return fract(52.9829189 * fract(dot(gl_FragCoord.xy, vec2(0.06711056, 0.00583715))));
+}
+
+vec3 viewDirection(int azimuth, int elevation)
+{
+    float a = 2.0 * PI * float(azimuth) / float(uImpostorAzimuths);
+    float e = PI * ((float(elevation) + 0.5) / float(uImpostorElevations) - 0.5);
+    return vec3(cos(e) * sin(a), sin(e), cos(e) * cos(a));
+}
+
+void sampleView(int azimuth, int elevation, float weight, inout vec4 color, inout vec4 vertexColor, inout vec4 normal)
+{
+    // Reprojects the quad point into the plane of the view
+    vec3 direction = viewDirection(azimuth, elevation);
+    vec3 right = normalize(cross(vec3(0.0, 1.0, 0.0), direction));
+    vec3 up = cross(direction, right);
+    vec2 uv = clamp(vec2(dot(vPlane, right), dot(vPlane, up)) * uImpostorViewScale * 0.5 + 0.5, 0.0, 1.0);
+    uv = (vec2(azimuth, elevation) + uv) / vec2(uImpostorAzimuths, uImpostorElevations);
+    color += weight * texture(uImpostorColor, uv);
+    vertexColor += weight * texture(uImpostorVertexColor, uv);
+    normal += weight * texture(uImpostorNormal, uv);
+}
+
+void main()
+{
+    if (dither() >= vFade)
+        discard;
+
+    float azimuth = atan(vDirection.x, vDirection.z) / (2.0 * PI) * float(uImpostorAzimuths);
+    if (azimuth < 0.0)
+        azimuth += float(uImpostorAzimuths);
+    float elevation = (asin(clamp(vDirection.y, -1.0, 1.0)) / PI + 0.5) * float(uImpostorElevations) - 0.5;
+    elevation = clamp(elevation, 0.0, float(uImpostorElevations - 1));
+    int a0 = int(azimuth) % uImpostorAzimuths;
+    int a1 = (a0 + 1) % uImpostorAzimuths;
+    int e0 = int(elevation);
+    int e1 = min(e0 + 1, uImpostorElevations - 1);
+    float fa = fract(azimuth);
+    float fe = elevation - float(e0);
+
+    vec4 color = vec4(0.0);
+    vec4 vertexColor = vec4(0.0);
+    vec4 normalDepth = vec4(0.0);
+    sampleView(a0, e0, (1.0 - fa) * (1.0 - fe), color, vertexColor, normalDepth);
+    sampleView(a1, e0, fa * (1.0 - fe), color, vertexColor, normalDepth);
+    sampleView(a0, e1, (1.0 - fa) * fe, color, vertexColor, normalDepth);
+    sampleView(a1, e1, fa * fe, color, vertexColor, normalDepth);
+
+    // The atlas is premultiplied by coverage
+    if (color.a < 0.5)
+        discard;
+    float coverage = color.a;
+    color /= coverage;
+    vertexColor /= coverage;
+    normalDepth /= coverage;
+
+    // Depth 0 is the front of the bounding sphere, 1 the back
+    mat3 model = mat3(uModel);
+    vec3 worldPos = vWorldPos + model * (vDirection * (1.0 - 2.0 * normalDepth.a) * uImpostorRadius);
+    vec4 clip = uProjection * uView * vec4(worldPos, 1.0);
+    gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;
+
+    vec3 normal = normalize(transpose(inverse(model)) * (normalDepth.xyz * 2.0 - 1.0));
+    vec4 mixedColor = mix(vec4(color.rgb, 1.0), vec4(vertexColor.rgb, 1.0), uColorMix);
+
+    // Same lighting as fragment.glsl
+    vec3 lightColor = vec3(1.0);
+    float ambientIntesity = 0.2;
+    vec4 ambientColor = vec4(lightColor, 1.0) * ambientIntesity * vec4(uKa, 1.0);
+
+    vec3 lightDirection = vec3(0.0, -0.5, -1.0);
+    float diffuseIntesity = 0.8;
+    float diffuseFactor = dot(normal, -lightDirection);
+    vec4 diffuseColor = vec4(0.0);
+    if (diffuseFactor > 0) {
+        diffuseColor = vec4(lightColor, 1.0) * diffuseIntesity * vec4(uKd, 1.0) * diffuseFactor;
+    }
+
+    vec3 viewDir = normalize(uCameraPos - worldPos);
+    vec3 halfway = normalize(-lightDirection + viewDir);
+    float spec = pow(max(dot(normal, halfway), 0.0), uNs);
+    vec4 specularColor = vec4(uKs * spec * lightColor, 1.0);
+
+    vec4 finalColor = (ambientColor + diffuseColor) * vertexColor.a + specularColor;
+    FragColor = mixedColor * finalColor;
+}
@@ -0,0 +1,52 @@
+#version 330 core
+
+// One camera-facing quad per copy of the object, gl_VertexID 0-3 as a
+// triangle strip, no vertex buffer needed. Copies closer than the fade band
+// are moved out of the clip volume; the mesh is drawn for them instead.
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform vec3 uCameraPos;
+uniform int uInstanceColumns;
+uniform float uInstanceSpacing;
+uniform vec3 uImpostorCenter;
+uniform float uImpostorRadius;
+uniform float uImpostorDistance;
+uniform float uImpostorFade;
+
+flat out vec3 vDirection;
+flat out float vFade;
+out vec3 vPlane;
+out vec3 vWorldPos;
+
+vec3 instanceOffset(int instance)
+{
+    // Copies are laid out on a grid, rows going away from the camera
+    int column = instance % uInstanceColumns;
+    int row = instance / uInstanceColumns;
+    return vec3((float(column) - float(uInstanceColumns - 1) * 0.5) * uInstanceSpacing, 0.0, -float(row) * uInstanceSpacing);
+}
+
+void main()
+{
+    vec3 center = (uModel * vec4(uImpostorCenter, 1.0)).xyz + instanceOffset(gl_InstanceID);
+    vFade = clamp((length(uCameraPos - center) - uImpostorDistance + uImpostorFade) / uImpostorFade, 0.0, 1.0);
+    if (vFade == 0.0) {
+        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);
+        return;
+    }
+
+    // Quad basis built like the views of the atlas, in object space
+    mat3 model = mat3(uModel);
+    vec3 direction = normalize(inverse(model) * (uCameraPos - center));
+    vec3 right = cross(vec3(0.0, 1.0, 0.0), direction);
+    right = length(right) < 1e-4 ? vec3(1.0, 0.0, 0.0) : normalize(right);
+    vec3 up = cross(direction, right);
+
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0 - 1.0;
+    vPlane = right * corner.x + up * corner.y;
+    vDirection = direction;
+    vWorldPos = center + model * (vPlane * uImpostorRadius);
+    gl_Position = uProjection * uView * vec4(vWorldPos, 1.0);
+}
@@ -0,0 +1,62 @@
+#version 430 core
+
+// Sum, minimum and maximum of the vertex positions. The first dispatch
+// reduces the vertices to one partial result per work group, the second
+// reduces the partials with a single work group.
+
+layout (local_size_x = 256) in;
+
+struct Bounds {
+    vec4 sum;
+    vec4 minimum;
+    vec4 maximum;
+};
+
+layout (std430, binding = 0) readonly buffer Vertices { float vertices[]; };
+layout (std430, binding = 1) readonly buffer Partials { Bounds partials[]; };
+layout (std430, binding = 2) writeonly buffer Results { Bounds results[]; };
+
+uniform int uFromVertices;
+uniform uint uCount;
+uniform uint uVertexStride;
+
+shared vec3 sSum[256];
+shared vec3 sMinimum[256];
+shared vec3 sMaximum[256];
+
+void main()
+{
+    vec3 sum = vec3(0.0);
+    vec3 minimum = vec3(3.402823e38);
+    vec3 maximum = vec3(-3.402823e38);
+    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    for (uint i = gl_GlobalInvocationID.x; i < uCount; i += stride) {
+        if (uFromVertices == 1) {
+            uint base = i * uVertexStride;
+            vec3 p = vec3(vertices[base], vertices[base + 1u], vertices[base + 2u]);
+            sum += p;
+            minimum = min(minimum, p);
+            maximum = max(maximum, p);
+        } else {
+            sum += partials[i].sum.xyz;
+            minimum = min(minimum, partials[i].minimum.xyz);
+            maximum = max(maximum, partials[i].maximum.xyz);
+        }
+    }
+
+    uint local = gl_LocalInvocationID.x;
+    sSum[local] = sum;
+    sMinimum[local] = minimum;
+    sMaximum[local] = maximum;
+    barrier();
+    for (uint width = gl_WorkGroupSize.x / 2u; width > 0u; width >>= 1) {
+        if (local < width) {
+            sSum[local] += sSum[local + width];
+            sMinimum[local] = min(sMinimum[local], sMinimum[local + width]);
+            sMaximum[local] = max(sMaximum[local], sMaximum[local + width]);
+        }
+        barrier();
+    }
+    if (local == 0u)
+        results[gl_WorkGroupID.x] = Bounds(vec4(sSum[0], 0.0), vec4(sMinimum[0], 0.0), vec4(sMaximum[0], 0.0));
+}
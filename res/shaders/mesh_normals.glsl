@@ -0,0 +1,72 @@
+#version 430 core
+
+// Smooth vertex normals, same result as Object::computeNormals():
+// pass 0 adds the unit normal of every triangle to its corners, pass 1
+// normalizes the sums. Sums are 16.16 fixed point so integer atomics can
+// accumulate them in any order and still give the same result.
+
+layout (local_size_x = 256) in;
+
+layout (std430, binding = 0) buffer Vertices { float vertices[]; };
+layout (std430, binding = 1) readonly buffer Indices { uint indices[]; };
+layout (std430, binding = 2) buffer Sums { int sums[]; };
+layout (std430, binding = 3) writeonly buffer PackedVertices { uint packedVertices[]; };
+
+uniform int uPass;
+uniform uint uCount;
+uniform uint uVertexStride;
+uniform uint uNormalOffset;
+uniform int uPacked;
+
+const float FIXED_POINT = 65536.0;
+// PackedVertex is 5 words, the packed normal is the last one
+const uint PACKED_STRIDE = 5u;
+const uint PACKED_NORMAL = 4u;
+
+vec3 position(uint vertex)
+{
+    uint base = vertex * uVertexStride;
+    return vec3(vertices[base], vertices[base + 1u], vertices[base + 2u]);
+}
+
+vec2 encodeOctahedral(vec3 n)
+{
+    float sum = abs(n.x) + abs(n.y) + abs(n.z);
+    if (sum == 0.0)
+        return vec2(0.0);
+    n /= sum;
+    if (n.z >= 0.0)
+        return n.xy;
+    return (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+}
+
+void main()
+{
+    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    for (uint i = gl_GlobalInvocationID.x; i < uCount; i += stride) {
+        if (uPass == 0) {
+            uint corners[3] = uint[3](indices[i * 3u], indices[i * 3u + 1u], indices[i * 3u + 2u]);
+            vec3 p0 = position(corners[0]);
+            vec3 normal = cross(position(corners[1]) - p0, position(corners[2]) - p0);
+            float len = length(normal);
+            if (len == 0.0)
+                continue;
+            ivec3 fixedNormal = ivec3(round(normal / len * FIXED_POINT));
+            for (int k = 0; k < 3; k++) {
+                atomicAdd(sums[corners[k] * 3u], fixedNormal.x);
+                atomicAdd(sums[corners[k] * 3u + 1u], fixedNormal.y);
+                atomicAdd(sums[corners[k] * 3u + 2u], fixedNormal.z);
+            }
+        } else {
+            vec3 sum = vec3(sums[i * 3u], sums[i * 3u + 1u], sums[i * 3u + 2u]);
+            float len = length(sum);
+            vec3 normal = len > 0.0 ? sum / len : vec3(0.0);
+            uint base = i * uVertexStride + uNormalOffset;
+            vertices[base] = normal.x;
+            vertices[base + 1u] = normal.y;
+            vertices[base + 2u] = normal.z;
+            if (uPacked == 1)
+                packedVertices[i * PACKED_STRIDE + PACKED_NORMAL] = packSnorm2x16(encodeOctahedral(normal));
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#version 430 core
+
+// Second visibility buffer pass: fetches the triangle seen by the pixel,
+// rebuilds what vertex.glsl would have interpolated and shades it like fragment.glsl
+
+struct PackedVertex {
+    float px, py, pz;
+    uint uv;
+    uint normal;
+};
+
+layout (std430, binding = 0) readonly buffer Vertices { PackedVertex vertices[]; };
+layout (std430, binding = 1) readonly buffer Indices { uint indices[]; };
+layout (std430, binding = 2) readonly buffer Colors { uint colors[]; };
+layout (std430, binding = 3) readonly buffer Occlusion { uint occlusion[]; };
+
+uniform usampler2D uIds;
+uniform sampler2D uTexture;
+uniform float uColorMix;
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform vec3 uCameraPos;
+uniform int uVertexColor;
+uniform int uIndexed;
+uniform int uOcclusion;
+uniform int uInstanceColumns;
+uniform float uInstanceSpacing;
+
+uniform vec3 uKa;
+uniform vec3 uKd;
+uniform vec3 uKs;
+uniform float uNs;
+
+out vec4 FragColor;
+
+vec3 instanceOffset(int instance)
+{
+    // Copies are laid out on a grid, rows going away from the camera
+    int column = instance % uInstanceColumns;
+    int row = instance / uInstanceColumns;
+    return vec3((float(column) - float(uInstanceColumns - 1) * 0.5) * uInstanceSpacing, 0.0, -float(row) * uInstanceSpacing);
+}
+
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n;
+}
+
+float edge(vec2 a, vec2 b, vec2 p)
+{
+    return (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x);
+}
+
+// Perspective-correct barycentrics of a point given in normalized device coordinates
+vec3 barycentrics(vec4 c0, vec4 c1, vec4 c2, vec2 ndc)
+{
+    vec3 invW = 1.0 / vec3(c0.w, c1.w, c2.w);
+    vec2 p0 = c0.xy * invW.x;
+    vec2 p1 = c1.xy * invW.y;
+    vec2 p2 = c2.xy * invW.z;
+    vec3 screen = vec3(edge(p1, p2, ndc), edge(p2, p0, ndc), edge(p0, p1, ndc)) / edge(p0, p1, p2);
+    vec3 perspective = screen * invW;
+    return perspective / (perspective.x + perspective.y + perspective.z);
+}
+
+void main()
+{
+    uint id = texelFetch(uIds, ivec2(gl_FragCoord.xy), 0).r;
+    if (id == 0u)
+        discard;
+    uint triangle = (id & 0xFFFFFFu) - 1u;
+    vec3 offset = instanceOffset(int(id >> 24));
+
+    uint index[3];
+    PackedVertex vertex[3];
+    vec3 worldPos[3];
+    vec4 clipPos[3];
+    for (int k = 0; k < 3; k++) {
+        index[k] = uIndexed == 1 ? indices[triangle * 3u + uint(k)] : triangle * 3u + uint(k);
+        vertex[k] = vertices[index[k]];
+        worldPos[k] = (uModel * vec4(vertex[k].px, vertex[k].py, vertex[k].pz, 1.0)).xyz + offset;
+        clipPos[k] = uProjection * uView * vec4(worldPos[k], 1.0);
+    }
+
+    // Barycentrics at the pixel and its right and upper neighbours, for texture gradients
+    vec2 pixelSize = 2.0 / vec2(textureSize(uIds, 0));
+    vec2 ndc = gl_FragCoord.xy * pixelSize - 1.0;
+    vec3 b = barycentrics(clipPos[0], clipPos[1], clipPos[2], ndc);
+    vec3 bx = barycentrics(clipPos[0], clipPos[1], clipPos[2], ndc + vec2(pixelSize.x, 0.0));
+    vec3 by = barycentrics(clipPos[0], clipPos[1], clipPos[2], ndc + vec2(0.0, pixelSize.y));
+
+    vec2 uv0 = unpackHalf2x16(vertex[0].uv);
+    vec2 uv1 = unpackHalf2x16(vertex[1].uv);
+    vec2 uv2 = unpackHalf2x16(vertex[2].uv);
+    vec2 texCoord = b.x * uv0 + b.y * uv1 + b.z * uv2;
+    vec2 texCoordDx = bx.x * uv0 + bx.y * uv1 + bx.z * uv2 - texCoord;
+    vec2 texCoordDy = by.x * uv0 + by.y * uv1 + by.z * uv2 - texCoord;
+
+    mat3 normalMat = transpose(inverse(mat3(uModel)));
+    vec3 normal = normalize(normalMat * (b.x * decodeOctahedral(unpackSnorm2x16(vertex[0].normal)) +
+                                         b.y * decodeOctahedral(unpackSnorm2x16(vertex[1].normal)) +
+                                         b.z * decodeOctahedral(unpackSnorm2x16(vertex[2].normal))));
+    vec3 position = b.x * worldPos[0] + b.y * worldPos[1] + b.z * worldPos[2];
+
+    float vertexOcclusion[3];
+    for (int k = 0; k < 3; k++)
+        vertexOcclusion[k] = uOcclusion == 1 ? float((occlusion[index[k] >> 2] >> ((index[k] & 3u) * 8u)) & 0xFFu) / 255.0 : 1.0;
+    float ambientOcclusion = b.x * vertexOcclusion[0] + b.y * vertexOcclusion[1] + b.z * vertexOcclusion[2];
+
+    // Flat color comes from the last corner, the provoking vertex of the forward path
+    vec3 provoking = vec3(vertex[2].px, vertex[2].py, vertex[2].pz);
+    vec3 gray = vec3((fract(provoking.x) + fract(provoking.y) + fract(provoking.z)) * 0.3 / 1.5);
+    vec3 flatColor = uVertexColor == 1 ? unpackUnorm4x8(colors[index[2]]).rgb : gray;
+
+    // Same shading as fragment.glsl
+    vec4 texColor = textureGrad(uTexture, texCoord, texCoordDx, texCoordDy);
+    vec4 colorMode = vec4(flatColor, 1.0f);
+    vec4 mixedColor = mix(texColor, colorMode, uColorMix);
+
+    vec3 lightColor = vec3(1.0);
+    float ambientIntesity = 0.2;
+    vec4 ambientColor = vec4(lightColor, 1.0) * ambientIntesity * vec4(uKa, 1.0);
+
+    vec3 lightDirection = vec3(0.0, -0.5, -1.0);
+    float diffuseIntesity = 0.8;
+    float diffuseFactor = dot(normal, -lightDirection);
+    vec4 diffuseColor = vec4(0.0);
+
+    if (diffuseFactor > 0) {
+        diffuseColor = vec4(lightColor, 1.0) * diffuseIntesity * vec4(uKd, 1.0) * diffuseFactor;
+    }
+
+    vec3 viewDir = normalize(uCameraPos - position);
+    vec3 halfway = normalize(-lightDirection + viewDir);
+    float spec = pow(max(dot(normal, halfway), 0.0), uNs);
+    vec4 specularColor = vec4(uKs * spec * lightColor, 1.0);
+
+    vec4 finalColor = (ambientColor + diffuseColor) * ambientOcclusion + specularColor;
+
+    FragColor = mixedColor * finalColor;
+}
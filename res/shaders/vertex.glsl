@@ -3,20 +3,51 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 layout (location = 2) in vec3 aNormal;
+layout (location = 3) in vec4 aColor;
+layout (location = 4) in float aOcclusion;
 
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProjection;
 uniform vec3 uCameraPos;
+uniform int uVertexColor;
+uniform int uInstanceColumns;
+uniform float uInstanceSpacing;
+uniform int uInstanceOffset;
+uniform vec3 uImpostorCenter;
+uniform float uImpostorDistance;
+uniform float uImpostorFade;
 
 flat out vec3 vColor;
 out vec2 vTexCoord;
 out vec3 vNormal;
 out vec3 vViewDir;
+out float vOcclusion;
+flat out float vFade;
+
+vec3 instanceOffset(int instance)
+{
+    // Copies are laid out on a grid, rows going away from the camera
+    int column = instance % uInstanceColumns;
+    int row = instance / uInstanceColumns;
+    return vec3((float(column) - float(uInstanceColumns - 1) * 0.5) * uInstanceSpacing, 0.0, -float(row) * uInstanceSpacing);
+}
+
+float impostorFade(int instance)
+{
+    // 0 draws the mesh only, 1 the impostor only, see impostor_vertex.glsl
+    if (uImpostorFade <= 0.0)
+        return 0.0;
+    vec3 center = (uModel * vec4(uImpostorCenter, 1.0)).xyz + instanceOffset(instance);
+    return clamp((length(uCameraPos - center) - uImpostorDistance + uImpostorFade) / uImpostorFade, 0.0, 1.0);
+}
 
 void main()
 {
-    vec4 worldPos = uModel * vec4(aPos, 1.0);
+    // Draws may start past the first copy, the ones in between being impostors
+    int instance = gl_InstanceID + uInstanceOffset;
+    vec4 worldPos = uModel * vec4(aPos, 1.0) + vec4(instanceOffset(instance), 0.0);
+    vFade = impostorFade(instance);
 
     vec3 color = vec3(
         fract(aPos.x) * 0.3,
@@ -24,9 +55,10 @@ void main()
         fract(aPos.z) * 0.3
     );
     float gray = (color.r + color.g + color.b) / 1.5;
-    vColor = vec3(gray);
+    vColor = uVertexColor == 1 ? aColor.rgb : vec3(gray);
 
     vTexCoord = aTexCoord;
+    vOcclusion = aOcclusion;
 
     mat3 normalMat = transpose(inverse(mat3(uModel)));
     vNormal = normalize(normalMat * aNormal);
@@ -0,0 +1,91 @@
+#version 430 core
+
+// Same outputs as vertex.glsl, but the vertices are fetched from storage
+// buffers by gl_VertexID instead of fixed-function attributes.
+
+struct PackedVertex {
+    float px, py, pz;
+    uint uv;     // two half floats
+    uint normal; // octahedral normal, two 16-bit snorms
+};
+
+layout (std430, binding = 0) readonly buffer Vertices { PackedVertex vertices[]; };
+layout (std430, binding = 1) readonly buffer Indices { uint indices[]; };
+layout (std430, binding = 2) readonly buffer Colors { uint colors[]; };
+layout (std430, binding = 3) readonly buffer Occlusion { uint occlusion[]; };
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform vec3 uCameraPos;
+uniform int uVertexColor;
+uniform int uInstanceColumns;
+uniform float uInstanceSpacing;
+uniform int uInstanceOffset;
+uniform vec3 uImpostorCenter;
+uniform float uImpostorDistance;
+uniform float uImpostorFade;
+uniform int uIndexed;
+uniform int uOcclusion;
+
+flat out vec3 vColor;
+out vec2 vTexCoord;
+out vec3 vNormal;
+out vec3 vViewDir;
+out float vOcclusion;
+flat out float vFade;
+
+vec3 instanceOffset(int instance)
+{
+    // Copies are laid out on a grid, rows going away from the camera
+    int column = instance % uInstanceColumns;
+    int row = instance / uInstanceColumns;
+    return vec3((float(column) - float(uInstanceColumns - 1) * 0.5) * uInstanceSpacing, 0.0, -float(row) * uInstanceSpacing);
+}
+
+float impostorFade(int instance)
+{
+    // 0 draws the mesh only, 1 the impostor only, see impostor_vertex.glsl
+    if (uImpostorFade <= 0.0)
+        return 0.0;
+    vec3 center = (uModel * vec4(uImpostorCenter, 1.0)).xyz + instanceOffset(instance);
+    return clamp((length(uCameraPos - center) - uImpostorDistance + uImpostorFade) / uImpostorFade, 0.0, 1.0);
+}
+
+vec3 decodeOctahedral(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n;
+}
+
+void main()
+{
+    uint index = uIndexed == 1 ? indices[gl_VertexID] : uint(gl_VertexID);
+    PackedVertex vertex = vertices[index];
+    vec3 aPos = vec3(vertex.px, vertex.py, vertex.pz);
+
+    // Draws may start past the first copy, the ones in between being impostors
+    int instance = gl_InstanceID + uInstanceOffset;
+    vec4 worldPos = uModel * vec4(aPos, 1.0) + vec4(instanceOffset(instance), 0.0);
+    vFade = impostorFade(instance);
+
+    vec3 color = vec3(
+        fract(aPos.x) * 0.3,
+        fract(aPos.y) * 0.3,
+        fract(aPos.z) * 0.3
+    );
+    float gray = (color.r + color.g + color.b) / 1.5;
+    vColor = uVertexColor == 1 ? unpackUnorm4x8(colors[index]).rgb : vec3(gray);
+
+    vTexCoord = unpackHalf2x16(vertex.uv);
+    vOcclusion = uOcclusion == 1 ? float((occlusion[index >> 2] >> ((index & 3u) * 8u)) & 0xFFu) / 255.0 : 1.0;
+
+    mat3 normalMat = transpose(inverse(mat3(uModel)));
+    vNormal = normalize(normalMat * decodeOctahedral(unpackSnorm2x16(vertex.normal)));
+
+    vViewDir = normalize(uCameraPos - worldPos.xyz);
+
+    gl_Position = uProjection * uView * worldPos;
+}
@@ -0,0 +1,12 @@
+#version 430 core
+
+// Writes the instance in the top 8 bits and the triangle + 1 in the low 24; 0 is background
+
+flat in uint vInstance;
+
+layout (location = 0) out uint FragId;
+
+void main()
+{
+    FragId = (vInstance << 24) | uint(gl_PrimitiveID + 1);
+}
@@ -0,0 +1,40 @@
+#version 430 core
+
+// First visibility buffer pass: positions only, fetched like vertex_pulling.glsl
+
+struct PackedVertex {
+    float px, py, pz;
+    uint uv;
+    uint normal;
+};
+
+layout (std430, binding = 0) readonly buffer Vertices { PackedVertex vertices[]; };
+layout (std430, binding = 1) readonly buffer Indices { uint indices[]; };
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform int uIndexed;
+uniform int uInstanceColumns;
+uniform float uInstanceSpacing;
+
+flat out uint vInstance;
+
+vec3 instanceOffset(int instance)
+{
+    // Copies are laid out on a grid, rows going away from the camera
+    int column = instance % uInstanceColumns;
+    int row = instance / uInstanceColumns;
+    return vec3((float(column) - float(uInstanceColumns - 1) * 0.5) * uInstanceSpacing, 0.0, -float(row) * uInstanceSpacing);
+}
+
+void main()
+{
+    uint index = uIndexed == 1 ? indices[gl_VertexID] : uint(gl_VertexID);
+    PackedVertex vertex = vertices[index];
+
+    vec4 worldPos = uModel * vec4(vertex.px, vertex.py, vertex.pz, 1.0) + vec4(instanceOffset(gl_InstanceID), 0.0);
+    vInstance = uint(gl_InstanceID);
+
+    gl_Position = uProjection * uView * worldPos;
+}
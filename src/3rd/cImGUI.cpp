@@ -10,6 +10,7 @@
  */
 
 #include "cImGUI.hpp"
+#include "../utils/Kernels.hpp"
 
 /**
  * @brief Constructs the cImGUI object with default settings.
@@ -93,16 +94,42 @@ void cImGUI::displayText(const std::string &name, int posx, int posy, const std:
  *  - FPS counter
  *  - movement instructions for both object and camera
  *  - mesh mode control buttons
+ *  - playlist position and prefetch state (playlist mode only)
+ *  - animation frame, frames decoded ahead and dropped frames (sequence mode only)
+ *  - refinement level and triangles shown (progressive loading only)
+ *  - chunks drawn and memory used against the budgets (chunked streaming only)
+ *  - vertex fetch path, shading mode and GPU draw time
  *  - object's world position
  *  - camera's world position
  *
  * @param object Reference to the object whose position will be displayed
+ * @param renderer Renderer whose fetch path, shading mode and draw time are displayed
  */
-void cImGUI::displayHUD(const std::unique_ptr<Object> &object) {
+void cImGUI::displayHUD(const std::unique_ptr<Object> &object, const Renderer &renderer) {
     displayFPS();
     displayText("Object", 120, 10, "Move object: WASD + N/M");
     displayText("Camera", 310, 10, "Move camera: ARROW KEYS + SPACE/LEFT SHIFT");
     displayText("Mesh", 640, 10, "Mesh modes: T/P");
+    if (gPlaylist)
+        displayText("Playlist", 10, 40, gPlaylist->getStatus());
+    if (gSequence)
+        displayText("Sequence", 10, 40, gSequence->getStatus());
+    if (gProgressive)
+        displayText("Progressive", 10, 40, gProgressive->getStatus());
+    if (gChunks)
+        displayText("Chunks", 10, 40, gChunks->getStatus());
+
+    char fetch[160];
+    snprintf(fetch, sizeof(fetch), "Vertex fetch: %s (V), shading: %s (B), GPU %.3f ms, CPU kernels: %s",
+             renderer.isVertexPulling() ? "pulling" : "attributes",
+             renderer.isVisibilityBuffer() ? "visibility buffer" : "forward", renderer.getGpuTime(),
+             getKernelIsaName(getKernelIsa()));
+    displayText("Fetch", 10, 70, fetch);
+    if (renderer.isImpostors()) {
+        char impostors[64];
+        snprintf(impostors, sizeof(impostors), "Impostors (I): %zu copies", renderer.getImpostorCount());
+        displayText("Impostors", 10, 100, impostors);
+    }
 
     std::string objPos = "Object position: x" + std::to_string(object->getPosition()[0]) + " y " + std::to_string(object->getPosition()[1]) + " z " + std::to_string(object->getPosition()[2]);
     std::string camPos = "Camera position: x" + std::to_string(gCamera.getPosition()[0]) + " y " + std::to_string(gCamera.getPosition()[1]) + " z " + std::to_string(gCamera.getPosition()[2]);
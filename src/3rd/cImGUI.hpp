@@ -21,8 +21,17 @@
 #include "../../lib/imgui/imgui_impl_opengl3.h"
 #include "../core/Camera.hpp"
 #include "../core/Object.hpp"
+#include "../core/Playlist.hpp"
+#include "../core/Sequence.hpp"
+#include "../core/ProgressiveLoader.hpp"
+#include "../core/ChunkStreamer.hpp"
+#include "../render/Renderer.hpp"
 
 extern Camera gCamera;
+extern std::unique_ptr<Playlist> gPlaylist;
+extern std::unique_ptr<Sequence> gSequence;
+extern std::unique_ptr<ProgressiveLoader> gProgressive;
+extern std::unique_ptr<ChunkStreamer> gChunks;
 
 /**
  * @brief Wrapper for ImGui to simplify GUI creation.
@@ -38,7 +47,7 @@ public:
     void createNewFrame();
     void displayFPS();
     void displayText(const std::string &name, int posx, int posy, const std::string &text);
-    void displayHUD(const std::unique_ptr<Object> &object);
+    void displayHUD(const std::unique_ptr<Object> &object, const Renderer &renderer);
     void render();
     void cleanup();
 
@@ -0,0 +1,207 @@
+/**
+ * @file AmbientOcclusion.cpp
+ * @author Patryk
+ * @brief Per-vertex ambient occlusion baking
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include "AmbientOcclusion.hpp"
+#include "../utils/Parallel.hpp"
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Hashes a byte range eight bytes at a time, continuing from `hash`.
+ */
+static uint64_t hashBytes(uint64_t hash, const char *p, size_t size) {
+    hash ^= size * 0x9E3779B97F4A7C15ull;
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        hash = (hash ^ mix64(word)) * 0x9E3779B97F4A7C15ull;
+        p += 8;
+        size -= 8;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, size);
+    return mix64(hash ^ mix64(tail));
+}
+
+/**
+ * @brief Van der Corput radical inverse in base 2.
+ */
+static float radicalInverse(uint32_t bits) {
+    bits = (bits << 16) | (bits >> 16);
+    bits = ((bits & 0x55555555u) << 1) | ((bits & 0xAAAAAAAAu) >> 1);
+    bits = ((bits & 0x33333333u) << 2) | ((bits & 0xCCCCCCCCu) >> 2);
+    bits = ((bits & 0x0F0F0F0Fu) << 4) | ((bits & 0xF0F0F0F0u) >> 4);
+    bits = ((bits & 0x00FF00FFu) << 8) | ((bits & 0xFF00FF00u) >> 8);
+    return bits * 2.3283064365386963e-10f;
+}
+
+/**
+ * @brief Computes the ambient occlusion of every vertex by casting rays over its hemisphere.
+ *
+ * Each vertex casts `rays` cosine-weighted rays (a Hammersley set rotated
+ * by a per-vertex angle to avoid banding) around its normal, traced four
+ * at a time as a BvhPacket, and stores the fraction of rays that escape
+ * within AO_DISTANCE. Vertices are processed in parallel.
+ *
+ * @param bvh Hierarchy built over the mesh.
+ * @param vertices Mesh vertices; vertices without a normal are left unoccluded.
+ * @param rays Rays per vertex, rounded up to a multiple of 4.
+ * @param occlusion Receives one value per vertex, 255 for fully open and 0 for fully occluded.
+ */
+void bakeAmbientOcclusion(const Bvh &bvh, const std::vector<Vertex> &vertices, size_t rays,
+                          std::vector<unsigned char> &occlusion) {
+    occlusion.assign(vertices.size(), 255);
+    if (vertices.empty())
+        return;
+    const size_t packets = std::max<size_t>(1, (rays + 3) / 4);
+    const size_t total = packets * 4;
+
+    std::array<float, 3> min = vertices[0].position, max = vertices[0].position;
+    for (const Vertex &vertex: vertices) {
+        for (int a = 0; a < 3; a++) {
+            min[a] = std::min(min[a], vertex.position[a]);
+            max[a] = std::max(max[a], vertex.position[a]);
+        }
+    }
+    const float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    const float diagonal = std::sqrt(dx * dx + dy * dy + dz * dz);
+    const __m128 distance = _mm_set1_ps(diagonal * AO_DISTANCE);
+    const float bias = diagonal * AO_BIAS;
+
+    // Cosine-weighted directions around +Z, stored 4 per packet
+    std::vector<float> localX(total), localY(total), localZ(total);
+    for (size_t i = 0; i < total; i++) {
+        const float u = (i + 0.5f) / total;
+        const float phi = 2.0f * static_cast<float>(M_PI) * radicalInverse(static_cast<uint32_t>(i));
+        const float r = std::sqrt(u);
+        localX[i] = r * std::cos(phi);
+        localY[i] = r * std::sin(phi);
+        localZ[i] = std::sqrt(std::max(0.0f, 1.0f - u));
+    }
+
+    parallelFor(0, vertices.size(), AO_VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const Vertex &vertex = vertices[i];
+            const std::array<float, 3> &n = vertex.normal;
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (!(length > 0.0f))
+                continue;
+            const float normal[3] = {n[0] / length, n[1] / length, n[2] / length};
+
+            // Orthonormal basis around the normal (Duff et al.)
+            const float sign = std::copysign(1.0f, normal[2]);
+            const float a = -1.0f / (sign + normal[2]);
+            const float b = normal[0] * normal[1] * a;
+            const float tangent[3] = {1.0f + sign * normal[0] * normal[0] * a, sign * b, -sign * normal[0]};
+            const float bitangent[3] = {b, sign + normal[1] * normal[1] * a, -normal[1]};
+
+            const float angle = 2.0f * static_cast<float>(M_PI) *
+                                ((mix64(i) >> 40) * (1.0f / 16777216.0f));
+            const __m128 c = _mm_set1_ps(std::cos(angle)), s = _mm_set1_ps(std::sin(angle));
+
+            BvhPacket packet;
+            for (int axis = 0; axis < 3; axis++)
+                packet.origin[axis] = _mm_set1_ps(vertex.position[axis] + normal[axis] * bias);
+            size_t hits = 0;
+            for (size_t p = 0; p < packets; p++) {
+                const __m128 lx = _mm_loadu_ps(&localX[p * 4]), ly = _mm_loadu_ps(&localY[p * 4]);
+                const __m128 lz = _mm_loadu_ps(&localZ[p * 4]);
+                const __m128 x = _mm_sub_ps(_mm_mul_ps(lx, c), _mm_mul_ps(ly, s));
+                const __m128 y = _mm_add_ps(_mm_mul_ps(lx, s), _mm_mul_ps(ly, c));
+                for (int axis = 0; axis < 3; axis++) {
+                    packet.direction[axis] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(tangent[axis]), x),
+                                                                   _mm_mul_ps(_mm_set1_ps(bitangent[axis]), y)),
+                                                        _mm_mul_ps(_mm_set1_ps(normal[axis]), lz));
+                }
+                packet.t = distance;
+                packet.active = 0xF;
+                hits += __builtin_popcount(bvh.occluded(packet));
+            }
+            occlusion[i] = static_cast<unsigned char>(255.0f * (total - hits) / total + 0.5f);
+        }
+    });
+}
+
+/**
+ * @brief Hashes everything the baked occlusion depends on, to validate cache files.
+ */
+uint64_t hashAmbientOcclusionInput(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                                   size_t rays) {
+    float distance = AO_DISTANCE;
+    uint64_t hash = mix64(rays ^ static_cast<uint64_t>(AO_CACHE_VERSION) << 32);
+    hash = hashBytes(hash, reinterpret_cast<const char *>(&distance), sizeof(distance));
+    hash = hashBytes(hash, reinterpret_cast<const char *>(vertices.data()), vertices.size() * sizeof(Vertex));
+    return hashBytes(hash, reinterpret_cast<const char *>(indices.data()), indices.size() * sizeof(unsigned int));
+}
+
+struct AoCacheHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t hash;
+    uint64_t count;
+};
+
+/**
+ * @brief Reads baked occlusion saved by `saveAmbientOcclusionCache()`.
+ * @param path Cache file.
+ * @param hash Expected input hash; a cache baked from other geometry or settings is ignored.
+ * @param vertexCount Expected number of values.
+ * @param occlusion Receives the values.
+ * @return bool true if a matching cache was read.
+ */
+bool loadAmbientOcclusionCache(const std::string &path, uint64_t hash, size_t vertexCount,
+                               std::vector<unsigned char> &occlusion) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+    AoCacheHeader header;
+    bool ok = fread(&header, sizeof(header), 1, file) == 1 && header.magic == AO_CACHE_MAGIC &&
+              header.version == AO_CACHE_VERSION && header.hash == hash && header.count == vertexCount;
+    if (ok) {
+        occlusion.resize(vertexCount);
+        ok = fread(occlusion.data(), 1, vertexCount, file) == vertexCount;
+    }
+    fclose(file);
+    if (!ok)
+        occlusion.clear();
+    return ok;
+}
+
+/**
+ * @brief Writes baked occlusion next to the mesh so later loads can skip the bake.
+ * @return bool true if the file was written.
+ */
+bool saveAmbientOcclusionCache(const std::string &path, uint64_t hash, const std::vector<unsigned char> &occlusion) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return false;
+    }
+    const AoCacheHeader header = {AO_CACHE_MAGIC, AO_CACHE_VERSION, hash, occlusion.size()};
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(occlusion.data(), 1, occlusion.size(), file) == occlusion.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok)
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+    return ok;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file AmbientOcclusion.hpp
+ * @author Patryk
+ * @brief Per-vertex ambient occlusion baking
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_AMBIENT_OCCLUSION_HPP
+#define SCOP_AMBIENT_OCCLUSION_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Bvh.hpp"
+#include "Vertex.hpp"
+
+#define AO_DEFAULT_RAYS 64
+// Occluder search distance, relative to the bounding box diagonal
+#define AO_DISTANCE 0.1f
+// Ray origin offset along the normal, relative to the bounding box diagonal
+#define AO_BIAS 1e-4f
+#define AO_VERTEX_GRAIN 1024
+#define AO_CACHE_MAGIC 0x4F414353u // "SCAO"
+#define AO_CACHE_VERSION 1u
+#define AO_CACHE_EXTENSION ".ao"
+
+void bakeAmbientOcclusion(const Bvh &bvh, const std::vector<Vertex> &vertices, size_t rays,
+                          std::vector<unsigned char> &occlusion);
+uint64_t hashAmbientOcclusionInput(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                                   size_t rays);
+bool loadAmbientOcclusionCache(const std::string &path, uint64_t hash, size_t vertexCount,
+                               std::vector<unsigned char> &occlusion);
+bool saveAmbientOcclusionCache(const std::string &path, uint64_t hash, const std::vector<unsigned char> &occlusion);
+
+#endif //SCOP_AMBIENT_OCCLUSION_HPP
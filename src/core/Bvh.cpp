@@ -0,0 +1,459 @@
+/**
+ * @file Bvh.cpp
+ * @author Patryk
+ * @brief Bvh class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Bvh.hpp"
+#include "../utils/Parallel.hpp"
+
+/**
+ * @brief Per-triangle bounds and centroids used while building.
+ */
+struct BvhBuildContext {
+    std::vector<std::array<float, 3>> boxMin;
+    std::vector<std::array<float, 3>> boxMax;
+    std::vector<std::array<float, 3>> centroid;
+    std::vector<uint32_t> refs;
+};
+
+static float halfArea(const float min[3], const float max[3]) {
+    const float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static void growBox(float min[3], float max[3], const std::array<float, 3> &boxMin, const std::array<float, 3> &boxMax) {
+    for (int a = 0; a < 3; a++) {
+        min[a] = std::min(min[a], boxMin[a]);
+        max[a] = std::max(max[a], boxMax[a]);
+    }
+}
+
+/**
+ * @brief Appends a subtree built into its own array, rebasing its child offsets.
+ */
+static void appendSubtree(std::vector<BvhNode> &nodes, const std::vector<BvhNode> &subtree) {
+    const uint32_t base = static_cast<uint32_t>(nodes.size());
+    for (BvhNode node: subtree) {
+        if (node.count == 0)
+            node.offset += base;
+        nodes.push_back(node);
+    }
+}
+
+/**
+ * @brief Builds the subtree over refs[begin, end) into `nodes` with a binned SAH.
+ */
+static void buildNode(BvhBuildContext &context, uint32_t begin, uint32_t end, std::vector<BvhNode> &nodes) {
+    BvhNode node;
+    float centroidMin[3], centroidMax[3];
+    for (int a = 0; a < 3; a++) {
+        node.min[a] = centroidMin[a] = INFINITY;
+        node.max[a] = centroidMax[a] = -INFINITY;
+    }
+    for (uint32_t i = begin; i < end; i++) {
+        const uint32_t ref = context.refs[i];
+        growBox(node.min, node.max, context.boxMin[ref], context.boxMax[ref]);
+        growBox(centroidMin, centroidMax, context.centroid[ref], context.centroid[ref]);
+    }
+    const uint32_t count = end - begin;
+    node.axis = 0;
+    auto makeLeaf = [&]() {
+        node.offset = begin;
+        node.count = static_cast<uint16_t>(count);
+        nodes.push_back(node);
+    };
+    if (count <= BVH_LEAF_SIZE) {
+        makeLeaf();
+        return;
+    }
+
+    int axis = 0;
+    for (int a = 1; a < 3; a++) {
+        if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis])
+            axis = a;
+    }
+    const float extent = centroidMax[axis] - centroidMin[axis];
+    uint32_t *refs = context.refs.data();
+    uint32_t mid = begin + count / 2;
+    if (extent > 0.0f) {
+        struct Bin {
+            uint32_t count = 0;
+            float min[3] = {INFINITY, INFINITY, INFINITY};
+            float max[3] = {-INFINITY, -INFINITY, -INFINITY};
+        } bins[BVH_BINS];
+        const float scale = BVH_BINS / extent * 0.99999f;
+        auto binOf = [&](uint32_t ref) {
+            return std::min(BVH_BINS - 1, static_cast<int>((context.centroid[ref][axis] - centroidMin[axis]) * scale));
+        };
+        for (uint32_t i = begin; i < end; i++) {
+            Bin &bin = bins[binOf(refs[i])];
+            bin.count++;
+            growBox(bin.min, bin.max, context.boxMin[refs[i]], context.boxMax[refs[i]]);
+        }
+
+        // Sweep from the right, then from the left, evaluating every split plane
+        float rightCost[BVH_BINS];
+        Bin accumulated;
+        for (int b = BVH_BINS - 1; b > 0; b--) {
+            accumulated.count += bins[b].count;
+            for (int a = 0; a < 3; a++) {
+                accumulated.min[a] = std::min(accumulated.min[a], bins[b].min[a]);
+                accumulated.max[a] = std::max(accumulated.max[a], bins[b].max[a]);
+            }
+            rightCost[b] = accumulated.count ? accumulated.count * halfArea(accumulated.min, accumulated.max) : 0.0f;
+        }
+        accumulated = Bin();
+        float bestCost = INFINITY;
+        int bestSplit = -1;
+        for (int b = 0; b < BVH_BINS - 1; b++) {
+            accumulated.count += bins[b].count;
+            for (int a = 0; a < 3; a++) {
+                accumulated.min[a] = std::min(accumulated.min[a], bins[b].min[a]);
+                accumulated.max[a] = std::max(accumulated.max[a], bins[b].max[a]);
+            }
+            if (accumulated.count == 0 || accumulated.count == count)
+                continue;
+            const float cost = accumulated.count * halfArea(accumulated.min, accumulated.max) + rightCost[b + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+        if (bestSplit < 0 || (bestCost >= count * halfArea(node.min, node.max) && count <= BVH_MAX_LEAF_SIZE)) {
+            makeLeaf();
+            return;
+        }
+        mid = static_cast<uint32_t>(std::partition(refs + begin, refs + end, [&](uint32_t ref) {
+            return binOf(ref) <= bestSplit;
+        }) - refs);
+    } else if (count <= BVH_MAX_LEAF_SIZE) {
+        makeLeaf();
+        return;
+    }
+
+    node.axis = static_cast<uint16_t>(axis);
+    node.count = 0;
+    const size_t parent = nodes.size();
+    nodes.push_back(node);
+    if (count > BVH_PARALLEL_THRESHOLD) {
+        std::vector<BvhNode> left, right;
+        parallelFor(0, 2, 1, [&](size_t first, size_t last) {
+            for (size_t child = first; child < last; child++) {
+                if (child == 0)
+                    buildNode(context, begin, mid, left);
+                else
+                    buildNode(context, mid, end, right);
+            }
+        });
+        appendSubtree(nodes, left);
+        nodes[parent].offset = static_cast<uint32_t>(nodes.size());
+        appendSubtree(nodes, right);
+    } else {
+        buildNode(context, begin, mid, nodes);
+        nodes[parent].offset = static_cast<uint32_t>(nodes.size());
+        buildNode(context, mid, end, nodes);
+    }
+}
+
+/**
+ * @brief Builds a BVH over an indexed triangle mesh.
+ * @param vertices Mesh vertices.
+ * @param indices Triangle list; triangles referencing missing vertices are skipped.
+ * @return std::unique_ptr<Bvh> The hierarchy, or `nullptr` if the mesh has no valid triangle.
+ */
+std::unique_ptr<Bvh> Bvh::build(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+    BvhBuildContext context;
+    const size_t triangleCount = indices.size() / 3;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (indices[t * 3] < vertices.size() && indices[t * 3 + 1] < vertices.size() &&
+            indices[t * 3 + 2] < vertices.size())
+            context.refs.push_back(static_cast<uint32_t>(t));
+    }
+    if (context.refs.empty())
+        return nullptr;
+
+    context.boxMin.resize(triangleCount);
+    context.boxMax.resize(triangleCount);
+    context.centroid.resize(triangleCount);
+    parallelFor(0, context.refs.size(), BVH_PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t t = context.refs[i];
+            const std::array<float, 3> &a = vertices[indices[t * 3]].position;
+            const std::array<float, 3> &b = vertices[indices[t * 3 + 1]].position;
+            const std::array<float, 3> &c = vertices[indices[t * 3 + 2]].position;
+            for (int axis = 0; axis < 3; axis++) {
+                context.boxMin[t][axis] = std::min({a[axis], b[axis], c[axis]});
+                context.boxMax[t][axis] = std::max({a[axis], b[axis], c[axis]});
+                context.centroid[t][axis] = (context.boxMin[t][axis] + context.boxMax[t][axis]) * 0.5f;
+            }
+        }
+    });
+
+    std::unique_ptr<Bvh> bvh(new Bvh());
+    buildNode(context, 0, static_cast<uint32_t>(context.refs.size()), bvh->m_nodes);
+
+    bvh->m_triangles.resize(context.refs.size());
+    bvh->m_triangleIds = context.refs;
+    parallelFor(0, context.refs.size(), BVH_PARALLEL_THRESHOLD, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const uint32_t t = context.refs[i];
+            const std::array<float, 3> &a = vertices[indices[t * 3]].position;
+            const std::array<float, 3> &b = vertices[indices[t * 3 + 1]].position;
+            const std::array<float, 3> &c = vertices[indices[t * 3 + 2]].position;
+            BvhTriangle &triangle = bvh->m_triangles[i];
+            triangle.v0 = a;
+            triangle.edge1 = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            triangle.edge2 = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        }
+    });
+    return bvh;
+}
+
+/**
+ * @brief Slab test of a single ray against a node box.
+ */
+static bool hitsBox(const BvhNode &node, const std::array<float, 3> &origin, const float inverse[3], float tMax) {
+    float tNear = 0.0f, tFar = tMax;
+    for (int a = 0; a < 3; a++) {
+        const float t0 = (node.min[a] - origin[a]) * inverse[a];
+        const float t1 = (node.max[a] - origin[a]) * inverse[a];
+        tNear = std::max(tNear, std::min(t0, t1));
+        tFar = std::min(tFar, std::max(t0, t1));
+    }
+    return tNear <= tFar;
+}
+
+/**
+ * @brief Moller-Trumbore test of a single ray; returns the distance or a negative value.
+ */
+static float hitsTriangle(const BvhTriangle &triangle, const std::array<float, 3> &origin,
+                          const std::array<float, 3> &direction, float &u, float &v) {
+    const std::array<float, 3> &e1 = triangle.edge1, &e2 = triangle.edge2;
+    const float p[3] = {direction[1] * e2[2] - direction[2] * e2[1], direction[2] * e2[0] - direction[0] * e2[2],
+                        direction[0] * e2[1] - direction[1] * e2[0]};
+    const float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+    if (det == 0.0f)
+        return -1.0f;
+    const float inverse = 1.0f / det;
+    const float s[3] = {origin[0] - triangle.v0[0], origin[1] - triangle.v0[1], origin[2] - triangle.v0[2]};
+    u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * inverse;
+    if (u < 0.0f || u > 1.0f)
+        return -1.0f;
+    const float q[3] = {s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0]};
+    v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * inverse;
+    if (v < 0.0f || u + v > 1.0f)
+        return -1.0f;
+    return (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * inverse;
+}
+
+/**
+ * @brief Finds the closest triangle hit by a ray.
+ * @param origin Ray origin.
+ * @param direction Ray direction, not necessarily normalized; distances are in units of its length.
+ * @param tMax Maximum distance.
+ * @param hit Receives the closest hit.
+ * @return bool true if a triangle was hit before tMax.
+ */
+bool Bvh::intersect(const std::array<float, 3> &origin, const std::array<float, 3> &direction, float tMax,
+                    BvhHit &hit) const {
+    const float inverse[3] = {1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]};
+    hit.t = tMax;
+    hit.triangle = BVH_NO_HIT;
+    uint32_t stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BvhNode &node = m_nodes[index];
+        if (!hitsBox(node, origin, inverse, hit.t))
+            continue;
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                float u, v;
+                const float t = hitsTriangle(m_triangles[i], origin, direction, u, v);
+                if (t > 0.0f && t < hit.t) {
+                    hit.t = t;
+                    hit.u = u;
+                    hit.v = v;
+                    hit.triangle = m_triangleIds[i];
+                }
+            }
+            continue;
+        }
+        // Visit the child on the side the ray comes from first
+        const bool reversed = direction[node.axis] < 0.0f;
+        stack[top++] = reversed ? index + 1 : node.offset;
+        stack[top++] = reversed ? node.offset : index + 1;
+    }
+    return hit.triangle != BVH_NO_HIT;
+}
+
+/**
+ * @brief Checks whether any triangle lies on a ray before tMax.
+ */
+bool Bvh::occluded(const std::array<float, 3> &origin, const std::array<float, 3> &direction, float tMax) const {
+    const float inverse[3] = {1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2]};
+    uint32_t stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const uint32_t index = stack[--top];
+        const BvhNode &node = m_nodes[index];
+        if (!hitsBox(node, origin, inverse, tMax))
+            continue;
+        if (node.count > 0) {
+            for (uint32_t i = node.offset; i < node.offset + node.count; i++) {
+                float u, v;
+                const float t = hitsTriangle(m_triangles[i], origin, direction, u, v);
+                if (t > 0.0f && t < tMax)
+                    return true;
+            }
+            continue;
+        }
+        stack[top++] = node.offset;
+        stack[top++] = index + 1;
+    }
+    return false;
+}
+
+static __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+/**
+ * @brief Traverses the tree with a 4-ray packet.
+ *
+ * A node is entered if any active lane hits its box; box and triangle tests
+ * run on the 4 lanes with SSE. With AnyHit, lanes stop at their first hit.
+ *
+ * @return int Mask of the lanes that hit a triangle.
+ */
+template<bool AnyHit>
+int Bvh::traverse(BvhPacket &packet) const {
+    const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    const __m128 inverse[3] = {_mm_div_ps(one, packet.direction[0]), _mm_div_ps(one, packet.direction[1]),
+                               _mm_div_ps(one, packet.direction[2])};
+    alignas(16) float directions[3][4];
+    for (int a = 0; a < 3; a++)
+        _mm_store_ps(directions[a], packet.direction[a]);
+    int active = packet.active;
+    int hitMask = 0;
+
+    uint32_t stack[BVH_STACK_SIZE];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0 && active) {
+        const uint32_t index = stack[--top];
+        const BvhNode &node = m_nodes[index];
+
+        __m128 tNear = zero, tFar = packet.t;
+        for (int a = 0; a < 3; a++) {
+            const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.min[a]), packet.origin[a]), inverse[a]);
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.max[a]), packet.origin[a]), inverse[a]);
+            tNear = _mm_max_ps(tNear, _mm_min_ps(t0, t1));
+            tFar = _mm_min_ps(tFar, _mm_max_ps(t0, t1));
+        }
+        if (!(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) & active))
+            continue;
+
+        if (node.count == 0) {
+            // Order the children with the direction of the first active lane
+            int lane = 0;
+            while (!(active & (1 << lane)))
+                lane++;
+            const bool reversed = directions[node.axis][lane] < 0.0f;
+            stack[top++] = reversed ? index + 1 : node.offset;
+            stack[top++] = reversed ? node.offset : index + 1;
+            continue;
+        }
+
+        for (uint32_t i = node.offset; i < node.offset + node.count && active; i++) {
+            const BvhTriangle &triangle = m_triangles[i];
+            const __m128 e1[3] = {_mm_set1_ps(triangle.edge1[0]), _mm_set1_ps(triangle.edge1[1]),
+                                  _mm_set1_ps(triangle.edge1[2])};
+            const __m128 e2[3] = {_mm_set1_ps(triangle.edge2[0]), _mm_set1_ps(triangle.edge2[1]),
+                                  _mm_set1_ps(triangle.edge2[2])};
+            const __m128 *d = packet.direction;
+            const __m128 p[3] = {
+                _mm_sub_ps(_mm_mul_ps(d[1], e2[2]), _mm_mul_ps(d[2], e2[1])),
+                _mm_sub_ps(_mm_mul_ps(d[2], e2[0]), _mm_mul_ps(d[0], e2[2])),
+                _mm_sub_ps(_mm_mul_ps(d[0], e2[1]), _mm_mul_ps(d[1], e2[0]))
+            };
+            const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1[0], p[0]), _mm_mul_ps(e1[1], p[1])),
+                                          _mm_mul_ps(e1[2], p[2]));
+            const __m128 inverseDet = _mm_div_ps(one, det);
+            const __m128 s[3] = {_mm_sub_ps(packet.origin[0], _mm_set1_ps(triangle.v0[0])),
+                                 _mm_sub_ps(packet.origin[1], _mm_set1_ps(triangle.v0[1])),
+                                 _mm_sub_ps(packet.origin[2], _mm_set1_ps(triangle.v0[2]))};
+            const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(s[0], p[0]), _mm_mul_ps(s[1], p[1])),
+                                                   _mm_mul_ps(s[2], p[2])), inverseDet);
+            const __m128 q[3] = {
+                _mm_sub_ps(_mm_mul_ps(s[1], e1[2]), _mm_mul_ps(s[2], e1[1])),
+                _mm_sub_ps(_mm_mul_ps(s[2], e1[0]), _mm_mul_ps(s[0], e1[2])),
+                _mm_sub_ps(_mm_mul_ps(s[0], e1[1]), _mm_mul_ps(s[1], e1[0]))
+            };
+            const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(d[0], q[0]), _mm_mul_ps(d[1], q[1])),
+                                                   _mm_mul_ps(d[2], q[2])), inverseDet);
+            const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2[0], q[0]), _mm_mul_ps(e2[1], q[1])),
+                                                   _mm_mul_ps(e2[2], q[2])), inverseDet);
+
+            __m128 hit = _mm_and_ps(_mm_cmpneq_ps(det, zero), _mm_cmpge_ps(u, zero));
+            hit = _mm_and_ps(hit, _mm_cmpge_ps(v, zero));
+            hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+            hit = _mm_and_ps(hit, _mm_cmpgt_ps(t, zero));
+            hit = _mm_and_ps(hit, _mm_cmplt_ps(t, packet.t));
+            const int mask = _mm_movemask_ps(hit) & active;
+            if (!mask)
+                continue;
+            const __m128 laneMask = _mm_castsi128_ps(_mm_set_epi32(mask & 8 ? -1 : 0, mask & 4 ? -1 : 0,
+                                                                   mask & 2 ? -1 : 0, mask & 1 ? -1 : 0));
+            packet.t = select(laneMask, t, packet.t);
+            packet.u = select(laneMask, u, packet.u);
+            packet.v = select(laneMask, v, packet.v);
+            packet.triangle = _mm_castps_si128(select(laneMask,
+                                                      _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(m_triangleIds[i]))),
+                                                      _mm_castsi128_ps(packet.triangle)));
+            hitMask |= mask;
+            if (AnyHit)
+                active &= ~mask;
+        }
+    }
+    return hitMask;
+}
+
+/**
+ * @brief Finds the closest hit of every active lane of a packet.
+ *
+ * `packet.t` holds the maximum distance of each lane on input and the hit
+ * distance on output; lanes that hit nothing keep BVH_NO_HIT in `triangle`.
+ */
+void Bvh::intersect(BvhPacket &packet) const {
+    packet.triangle = _mm_set1_epi32(static_cast<int>(BVH_NO_HIT));
+    traverse<false>(packet);
+}
+
+/**
+ * @brief Checks which active lanes of a packet are blocked before their `t`.
+ * @return int Mask of the occluded lanes.
+ */
+int Bvh::occluded(const BvhPacket &packet) const {
+    BvhPacket copy = packet;
+    return traverse<true>(copy);
+}
+
+size_t Bvh::getNodeCount() const {
+    return m_nodes.size();
+}
+
+size_t Bvh::getTriangleCount() const {
+    return m_triangles.size();
+}
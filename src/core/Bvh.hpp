@@ -0,0 +1,110 @@
+/**
+ * @file Bvh.hpp
+ * @author Patryk
+ * @brief Bvh class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_BVH_HPP
+#define SCOP_BVH_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <emmintrin.h>
+
+#include "Vertex.hpp"
+
+#define BVH_BINS 16
+#define BVH_LEAF_SIZE 4
+#define BVH_MAX_LEAF_SIZE 16
+#define BVH_PARALLEL_THRESHOLD 65536
+#define BVH_STACK_SIZE 64
+#define BVH_NO_HIT 0xFFFFFFFFu
+
+/**
+ * @brief Node of a Bvh, 32 bytes.
+ *
+ * Nodes are stored depth first: the left child of an inner node follows it
+ * directly and `offset` is the index of the right child. For leaves,
+ * `offset` is the first triangle and `count` the number of triangles.
+ */
+struct BvhNode {
+    float min[3];
+    uint32_t offset;
+    float max[3];
+    uint16_t count;
+    uint16_t axis;
+};
+
+/**
+ * @brief Triangle stored in leaf order, ready for Moller-Trumbore tests.
+ */
+struct BvhTriangle {
+    std::array<float, 3> v0;
+    std::array<float, 3> edge1;
+    std::array<float, 3> edge2;
+};
+
+/**
+ * @brief Closest hit of a ray: distance, barycentric coordinates and original triangle index.
+ */
+struct BvhHit {
+    float t;
+    float u, v;
+    uint32_t triangle = BVH_NO_HIT;
+};
+
+/**
+ * @brief Four rays traced together with SSE. Lanes outside `active` are ignored.
+ */
+struct BvhPacket {
+    __m128 origin[3];
+    __m128 direction[3];
+    __m128 t;
+    __m128 u, v;
+    __m128i triangle;
+    int active;
+};
+
+/**
+ * @brief Bounding volume hierarchy over the triangles of a mesh.
+ *
+ * Built top-down with a binned surface area heuristic; subtrees larger than
+ * BVH_PARALLEL_THRESHOLD triangles are built concurrently. Supports closest
+ * hit and any hit queries for single rays and for 4-ray packets, whose
+ * box and triangle tests run on all lanes at once.
+ */
+class Bvh {
+public:
+    static std::unique_ptr<Bvh> build(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+    Bvh(const Bvh&) = delete;
+    Bvh &operator=(const Bvh&) = delete;
+    ~Bvh() = default;
+
+    bool intersect(const std::array<float, 3> &origin, const std::array<float, 3> &direction, float tMax,
+                   BvhHit &hit) const;
+    bool occluded(const std::array<float, 3> &origin, const std::array<float, 3> &direction, float tMax) const;
+    void intersect(BvhPacket &packet) const;
+    int occluded(const BvhPacket &packet) const;
+
+    size_t getNodeCount() const;
+    size_t getTriangleCount() const;
+
+private:
+    Bvh() = default;
+
+    std::vector<BvhNode> m_nodes;
+    std::vector<BvhTriangle> m_triangles;
+    std::vector<uint32_t> m_triangleIds;
+
+    template<bool AnyHit>
+    int traverse(BvhPacket &packet) const;
+};
+
+#endif //SCOP_BVH_HPP
@@ -0,0 +1,332 @@
+/**
+ * @file ChunkStreamer.cpp
+ * @author Patryk
+ * @brief ChunkStreamer class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <sys/stat.h>
+
+#include "ChunkStreamer.hpp"
+
+static bool hasExtension(const std::string &path, const std::string &extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Multiplies a point by a column-major matrix, as the shaders do.
+ */
+static std::array<float, 4> transformPoint(const std::array<float, 16> &matrix, const std::array<float, 4> &point) {
+    std::array<float, 4> result;
+    for (int row = 0; row < 4; row++)
+        result[row] = matrix[row] * point[0] + matrix[4 + row] * point[1] + matrix[8 + row] * point[2] +
+                      matrix[12 + row] * point[3];
+    return result;
+}
+
+/**
+ * @brief Opens the chunked mesh of a model, writing it first if needed.
+ *
+ * A .schk file is opened as is. For a model, the `<model>.schk` file next
+ * to it is used if it is not older than the model; otherwise the model is
+ * loaded in full once to write it, which a model larger than memory does
+ * not allow: such models are split beforehand with `scop_mesh -c` on a
+ * machine that can hold them. A thread then reads the chunks requested by
+ * `update()`.
+ *
+ * @param filePath Model or .schk file.
+ * @param settings Memory budgets.
+ * @return std::unique_ptr<ChunkStreamer> The streamer, or `nullptr` if the chunked mesh cannot be opened or written.
+ */
+std::unique_ptr<ChunkStreamer> ChunkStreamer::create(const std::string &filePath, const ChunkSettings &settings) {
+    std::unique_ptr<ChunkStreamer> streamer(new ChunkStreamer());
+    streamer->m_settings = settings;
+    if (hasExtension(filePath, CHUNKED_EXTENSION)) {
+        streamer->m_filePath = filePath.substr(0, filePath.size() - std::string(CHUNKED_EXTENSION).size());
+        streamer->m_chunkPath = filePath;
+    } else {
+        streamer->m_filePath = filePath;
+        streamer->m_chunkPath = filePath + CHUNKED_EXTENSION;
+        struct stat source, chunked;
+        if (stat(filePath.c_str(), &source) != 0 || stat(streamer->m_chunkPath.c_str(), &chunked) != 0 ||
+            chunked.st_mtime < source.st_mtime) {
+            MeshSettings meshSettings = Object::getMeshSettings();
+            meshSettings.normals = true;
+            std::unique_ptr<Mesh> mesh = Mesh::load(filePath, meshSettings);
+            if (!mesh) {
+                fprintf(stderr, "Failed to load object: %s\n", filePath.c_str());
+                return nullptr;
+            }
+            if (!saveChunkedMesh(streamer->m_chunkPath, mesh->vertices, mesh->indices))
+                return nullptr;
+            printf("Chunks: loaded %s in full once to write %s\n", filePath.c_str(), streamer->m_chunkPath.c_str());
+        }
+    }
+    streamer->m_file = ChunkedFile::open(streamer->m_chunkPath);
+    if (!streamer->m_file) {
+        fprintf(stderr, "Failed to open chunked mesh %s\n", streamer->m_chunkPath.c_str());
+        return nullptr;
+    }
+
+    const std::vector<MeshChunk> &chunks = streamer->m_file->getChunks();
+    streamer->m_chunks.resize(chunks.size());
+    size_t total = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        streamer->m_chunks[i].bytes = chunks[i].vertexCount * sizeof(Vertex) + chunks[i].indexCount * sizeof(unsigned int);
+        total += streamer->m_chunks[i].bytes;
+    }
+    streamer->m_reader = std::thread(&ChunkStreamer::readerLoop, streamer.get());
+    printf("Chunks: %zu chunks, %zu triangles, %.1f MB decoded, budgets %.0f MB RAM and %.0f MB VRAM\n",
+           chunks.size(), streamer->m_file->getIndexCount() / 3, total / (1024.0 * 1024.0),
+           settings.ramBudget / (1024.0 * 1024.0), settings.vramBudget / (1024.0 * 1024.0));
+    return streamer;
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_requested.notify_all();
+    if (m_reader.joinable())
+        m_reader.join();
+}
+
+/**
+ * @brief Creates the object the chunks are drawn from, see `Object::createChunked()`.
+ * @return std::unique_ptr<Object> Object drawing no chunk until the first `update()`.
+ */
+std::unique_ptr<Object> ChunkStreamer::start() {
+    return Object::createChunked(m_filePath, m_file->getBounds());
+}
+
+/**
+ * @brief Pages chunks in and out for the current camera, called once per rendered frame on the main thread.
+ *
+ * Chunks are wanted in host memory down the ranking of `rankChunks()`
+ * until the RAM budget, and visible ones on the GPU until the VRAM budget;
+ * a chunk too large for what is left is skipped for smaller ones further
+ * down. Wanted chunks on disk are handed to the reader thread in ranking
+ * order. Wanted chunks in memory are uploaded, up to CHUNK_UPLOAD_BUDGET
+ * bytes per frame, after evicting the least recently drawn chunks that are
+ * not wanted this frame if the GPU is full. The visible uploaded chunks
+ * become the object's sub-meshes.
+ *
+ * @param object Object returned by `start()`.
+ * @param camera Camera the frame is drawn from.
+ */
+void ChunkStreamer::update(Object &object, Camera &camera) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<size_t> ranking;
+    rankChunks(object, camera, ranking);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_frame++;
+    m_requests.clear();
+    size_t ram = 0;
+    for (size_t id: ranking) {
+        ChunkEntry &chunk = m_chunks[id];
+        if (ram + chunk.bytes > m_settings.ramBudget)
+            continue;
+        ram += chunk.bytes;
+        chunk.lastWanted = m_frame;
+        if (chunk.state == CHUNK_ON_DISK && chunk.gpuSlot == CHUNK_NOT_UPLOADED)
+            m_requests.push_back(id);
+    }
+    if (!m_requests.empty())
+        m_requested.notify_one();
+
+    size_t vram = 0, uploaded = 0;
+    std::vector<size_t> wanted, slots;
+    for (size_t id: ranking) {
+        ChunkEntry &chunk = m_chunks[id];
+        if (!chunk.visible)
+            break;
+        if (vram + chunk.bytes > m_settings.vramBudget)
+            continue;
+        vram += chunk.bytes;
+        chunk.lastDrawn = m_frame;
+        wanted.push_back(id);
+    }
+    for (size_t id: wanted) {
+        ChunkEntry &chunk = m_chunks[id];
+        if (chunk.gpuSlot == CHUNK_NOT_UPLOADED) {
+            if (chunk.state != CHUNK_IN_MEMORY || uploaded + chunk.bytes > CHUNK_UPLOAD_BUDGET)
+                continue;
+            while (m_vramBytes + chunk.bytes > m_settings.vramBudget) {
+                ChunkEntry *oldest = nullptr;
+                for (ChunkEntry &candidate: m_chunks)
+                    if (candidate.gpuSlot != CHUNK_NOT_UPLOADED && candidate.lastDrawn < m_frame &&
+                        (!oldest || candidate.lastDrawn < oldest->lastDrawn))
+                        oldest = &candidate;
+                if (!oldest)
+                    break;
+                object.removeChunk(oldest->gpuSlot);
+                oldest->gpuSlot = CHUNK_NOT_UPLOADED;
+                m_vramBytes -= oldest->bytes;
+                m_vramEvictions++;
+            }
+            if (m_vramBytes + chunk.bytes > m_settings.vramBudget)
+                continue;
+            chunk.gpuSlot = object.addChunk(chunk.vertices, chunk.indices);
+            m_vramBytes += chunk.bytes;
+            uploaded += chunk.bytes;
+            m_uploadCount++;
+        }
+        slots.push_back(chunk.gpuSlot);
+    }
+    object.setDrawnChunks(slots);
+    evictMemory();
+
+    m_visibleCount = 0;
+    for (size_t id: ranking)
+        if (m_chunks[id].visible)
+            m_visibleCount++;
+    m_drawnCount = slots.size();
+    if (uploaded > 0) {
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        m_maxUploadTime = std::max(m_maxUploadTime, elapsed.count());
+    }
+}
+
+/**
+ * @brief One-line summary for the HUD: chunks drawn, memory in use against the budgets, reads pending.
+ */
+std::string ChunkStreamer::getStatus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t loading = 0;
+    for (const ChunkEntry &chunk: m_chunks)
+        if (chunk.state == CHUNK_LOADING)
+            loading++;
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "Chunks: %zu drawn of %zu visible, %zu total | VRAM %.0f/%.0f MB | "
+             "RAM %.0f/%.0f MB | reading %zu, queued %zu", m_drawnCount, m_visibleCount, m_chunks.size(),
+             m_vramBytes / (1024.0 * 1024.0), m_settings.vramBudget / (1024.0 * 1024.0),
+             m_ramBytes / (1024.0 * 1024.0), m_settings.ramBudget / (1024.0 * 1024.0), loading, m_requests.size());
+    return buffer;
+}
+
+/**
+ * @brief Prints the paging statistics: chunks read and uploaded, evictions, slowest paging frame.
+ */
+void ChunkStreamer::printStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    printf("Chunks: %zu read, %zu uploaded, %zu evicted from RAM, %zu from VRAM, slowest upload frame %.1f ms\n",
+           m_loadCount, m_uploadCount, m_ramEvictions, m_vramEvictions, m_maxUploadTime);
+}
+
+/**
+ * @brief Computes the visibility and camera distance of every chunk and sorts them for paging.
+ *
+ * A chunk is visible unless its bounding box lies entirely outside one
+ * plane of the view frustum, tested on the clip space corners. The ranking
+ * lists visible chunks first, each group nearest first.
+ *
+ * @param object Object the chunks belong to, for its model matrix.
+ * @param camera Camera the frame is drawn from.
+ * @param ranking Receives the chunk indices, in paging order.
+ */
+void ChunkStreamer::rankChunks(Object &object, Camera &camera, std::vector<size_t> &ranking) {
+    const std::array<float, 16> model = object.getMatrix();
+    const std::array<float, 16> &view = camera.getCamView();
+    const std::array<float, 16> &projection = camera.getCamProjection();
+    const std::array<float, 3> &eye = camera.getPosition();
+    const std::vector<MeshChunk> &chunks = m_file->getChunks();
+
+    // Only the main thread writes these fields
+    ranking.resize(chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const MeshChunk &bounds = chunks[i];
+        int outside[6] = {0, 0, 0, 0, 0, 0};
+        for (int corner = 0; corner < 8; corner++) {
+            const std::array<float, 4> point = {corner & 1 ? bounds.max[0] : bounds.min[0],
+                                                corner & 2 ? bounds.max[1] : bounds.min[1],
+                                                corner & 4 ? bounds.max[2] : bounds.min[2], 1.0f};
+            const std::array<float, 4> clip = transformPoint(projection, transformPoint(view, transformPoint(model, point)));
+            for (int axis = 0; axis < 3; axis++) {
+                outside[axis * 2] += clip[axis] < -clip[3];
+                outside[axis * 2 + 1] += clip[axis] > clip[3];
+            }
+        }
+        ChunkEntry &chunk = m_chunks[i];
+        chunk.visible = std::find(outside, outside + 6, 8) == outside + 6;
+
+        const std::array<float, 4> center = transformPoint(model, {(bounds.min[0] + bounds.max[0]) * 0.5f,
+                                                                   (bounds.min[1] + bounds.max[1]) * 0.5f,
+                                                                   (bounds.min[2] + bounds.max[2]) * 0.5f, 1.0f});
+        chunk.distance = std::sqrt((center[0] - eye[0]) * (center[0] - eye[0]) +
+                                   (center[1] - eye[1]) * (center[1] - eye[1]) +
+                                   (center[2] - eye[2]) * (center[2] - eye[2]));
+        ranking[i] = i;
+    }
+    std::sort(ranking.begin(), ranking.end(), [this](size_t a, size_t b) {
+        if (m_chunks[a].visible != m_chunks[b].visible)
+            return m_chunks[a].visible;
+        return m_chunks[a].distance < m_chunks[b].distance;
+    });
+}
+
+/**
+ * @brief Drops the least recently wanted chunks from host memory until it fits the RAM budget again.
+ *
+ * Only chunks not wanted this frame are dropped. Called with the mutex held.
+ */
+void ChunkStreamer::evictMemory() {
+    while (m_ramBytes > m_settings.ramBudget) {
+        ChunkEntry *oldest = nullptr;
+        for (ChunkEntry &chunk: m_chunks)
+            if (chunk.state == CHUNK_IN_MEMORY && chunk.lastWanted < m_frame &&
+                (!oldest || chunk.lastWanted < oldest->lastWanted))
+                oldest = &chunk;
+        if (!oldest)
+            return;
+        std::vector<Vertex>().swap(oldest->vertices);
+        std::vector<unsigned int>().swap(oldest->indices);
+        oldest->state = CHUNK_ON_DISK;
+        m_ramBytes -= oldest->bytes;
+        m_ramEvictions++;
+    }
+}
+
+/**
+ * @brief Reads and decodes the requested chunks, the first of the current request list first.
+ */
+void ChunkStreamer::readerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_requested.wait(lock, [this] { return m_stop || !m_requests.empty(); });
+        if (m_stop)
+            return;
+        const size_t id = m_requests.front();
+        m_requests.erase(m_requests.begin());
+        if (m_chunks[id].state != CHUNK_ON_DISK)
+            continue;
+        m_chunks[id].state = CHUNK_LOADING;
+        lock.unlock();
+
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        const bool ok = m_file->readChunk(id, vertices, indices);
+
+        lock.lock();
+        ChunkEntry &chunk = m_chunks[id];
+        if (!ok) {
+            chunk.state = CHUNK_FAILED;
+            continue;
+        }
+        chunk.vertices.swap(vertices);
+        chunk.indices.swap(indices);
+        chunk.state = CHUNK_IN_MEMORY;
+        m_ramBytes += chunk.bytes;
+        m_loadCount++;
+    }
+}
@@ -0,0 +1,129 @@
+/**
+ * @file ChunkStreamer.hpp
+ * @author Patryk
+ * @brief ChunkStreamer class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_CHUNK_STREAMER_HPP
+#define SCOP_CHUNK_STREAMER_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Object.hpp"
+#include "Camera.hpp"
+#include "ChunkedMesh.hpp"
+
+#define CHUNK_DEFAULT_RAM_MB 512
+#define CHUNK_DEFAULT_VRAM_MB 256
+// Bytes uploaded to the GPU per frame, so paging in never stalls a frame for long
+#define CHUNK_UPLOAD_BUDGET (8u * 1024 * 1024)
+#define CHUNK_NOT_UPLOADED static_cast<size_t>(-1)
+
+/**
+ * @brief Memory budgets of a ChunkStreamer.
+ */
+struct ChunkSettings {
+    size_t ramBudget = static_cast<size_t>(CHUNK_DEFAULT_RAM_MB) * 1024 * 1024;
+    size_t vramBudget = static_cast<size_t>(CHUNK_DEFAULT_VRAM_MB) * 1024 * 1024;
+};
+
+/**
+ * @brief Paging state of a chunk in host memory.
+ */
+enum ChunkState {
+    CHUNK_ON_DISK = 0,
+    CHUNK_LOADING,
+    CHUNK_IN_MEMORY,
+    CHUNK_FAILED
+};
+
+/**
+ * @brief One chunk of the mesh, with its decoded geometry while it is in memory.
+ *
+ * `gpuSlot` is the Object slot of the chunk while it is uploaded, or
+ * CHUNK_NOT_UPLOADED. `lastWanted` and `lastDrawn` are frame numbers used
+ * for least recently used eviction from host and GPU memory.
+ */
+struct ChunkEntry {
+    ChunkState state = CHUNK_ON_DISK;
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    size_t bytes = 0;
+    size_t gpuSlot = CHUNK_NOT_UPLOADED;
+    size_t lastWanted = 0;
+    size_t lastDrawn = 0;
+    bool visible = false;
+    float distance = 0.0f;
+};
+
+/**
+ * @brief Draws a mesh larger than host or GPU memory from its octree chunks, paging them in and out.
+ *
+ * The mesh is read from a .schk file (see `saveChunkedMesh()`). Each
+ * frame, `update()` tests every chunk's bounds against the view frustum
+ * and ranks the visible chunks by distance to the camera, then the others.
+ * Chunks are kept in host memory down that ranking until the RAM budget is
+ * reached and on the GPU, for visible ones, until the VRAM budget is; a
+ * thread reads and decodes the missing ones, nearest first, and the main
+ * thread uploads at most CHUNK_UPLOAD_BUDGET bytes per frame. When a budget
+ * is exceeded, the least recently wanted chunks leave host memory and the
+ * least recently drawn ones leave the GPU. Visible chunks that are not
+ * uploaded yet are simply not drawn, so the frame rate does not depend on
+ * the disk.
+ */
+class ChunkStreamer {
+public:
+    static std::unique_ptr<ChunkStreamer> create(const std::string &filePath, const ChunkSettings &settings);
+    ChunkStreamer(const ChunkStreamer&) = delete;
+    ~ChunkStreamer();
+
+    ChunkStreamer &operator=(const ChunkStreamer&) = delete;
+
+    std::unique_ptr<Object> start();
+    void update(Object &object, Camera &camera);
+
+    std::string getStatus() const;
+    void printStatistics() const;
+
+private:
+    ChunkStreamer() = default;
+
+    std::string m_filePath;
+    std::string m_chunkPath;
+    ChunkSettings m_settings;
+    std::unique_ptr<ChunkedFile> m_file = nullptr;
+    std::vector<ChunkEntry> m_chunks;
+    std::vector<size_t> m_requests;
+    size_t m_frame = 0;
+
+    size_t m_ramBytes = 0;
+    size_t m_vramBytes = 0;
+    size_t m_visibleCount = 0;
+    size_t m_drawnCount = 0;
+    size_t m_loadCount = 0;
+    size_t m_uploadCount = 0;
+    size_t m_ramEvictions = 0;
+    size_t m_vramEvictions = 0;
+    double m_maxUploadTime = 0.0;
+
+    std::thread m_reader;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_requested;
+    bool m_stop = false;
+
+    void rankChunks(Object &object, Camera &camera, std::vector<size_t> &ranking);
+    void evictMemory();
+    void readerLoop();
+};
+
+#endif //SCOP_CHUNK_STREAMER_HPP
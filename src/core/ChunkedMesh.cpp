@@ -0,0 +1,276 @@
+/**
+ * @file ChunkedMesh.cpp
+ * @author Patryk
+ * @brief Octree chunked mesh file implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+
+#include "ChunkedMesh.hpp"
+#include "../io/MeshCodec.hpp"
+
+/**
+ * @brief Layout of the start of a .schk file, followed by the chunk table and the chunks.
+ */
+struct ChunkedHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t chunkCount;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    float center[3];
+    float min[3];
+    float max[3];
+};
+
+/**
+ * @brief Octree cell being split by `partitionTriangles()`.
+ */
+struct OctreeCell {
+    size_t begin;
+    size_t end;
+    std::array<float, 3> min;
+    float size;
+    int depth;
+};
+
+/**
+ * @brief Sorts triangles into octree leaves of at most `maxTriangles` each, by centroid.
+ *
+ * Cells are split depth first, so consecutive leaves are close in space.
+ *
+ * @param centroids Centroid of every triangle.
+ * @param root Cube enclosing the mesh.
+ * @param maxTriangles Largest leaf, unless CHUNKED_MAX_DEPTH is reached first.
+ * @param order Receives the triangles, grouped by leaf.
+ * @return std::vector<std::pair<size_t, size_t>> Range of `order` covered by each non-empty leaf.
+ */
+static std::vector<std::pair<size_t, size_t>> partitionTriangles(const std::vector<std::array<float, 3>> &centroids,
+                                                                 const OctreeCell &root, size_t maxTriangles,
+                                                                 std::vector<uint32_t> &order) {
+    order.resize(centroids.size());
+    for (size_t t = 0; t < order.size(); t++)
+        order[t] = static_cast<uint32_t>(t);
+
+    std::vector<std::pair<size_t, size_t>> leaves;
+    std::vector<OctreeCell> stack(1, root);
+    std::vector<uint32_t> scratch;
+    while (!stack.empty()) {
+        const OctreeCell cell = stack.back();
+        stack.pop_back();
+        if (cell.end - cell.begin <= maxTriangles || cell.depth >= CHUNKED_MAX_DEPTH) {
+            if (cell.end > cell.begin)
+                leaves.push_back({cell.begin, cell.end});
+            continue;
+        }
+
+        // Counting sort of the cell's triangles by octant
+        const float half = cell.size * 0.5f;
+        auto octant = [&](uint32_t t) {
+            int index = 0;
+            for (int a = 0; a < 3; a++)
+                if (centroids[t][a] >= cell.min[a] + half)
+                    index |= 1 << a;
+            return index;
+        };
+        size_t start[9] = {};
+        for (size_t i = cell.begin; i < cell.end; i++)
+            start[octant(order[i]) + 1]++;
+        for (int o = 0; o < 8; o++)
+            start[o + 1] += start[o];
+        scratch.resize(cell.end - cell.begin);
+        size_t next[8];
+        std::copy(start, start + 8, next);
+        for (size_t i = cell.begin; i < cell.end; i++)
+            scratch[next[octant(order[i])]++] = order[i];
+        std::copy(scratch.begin(), scratch.end(), order.begin() + cell.begin);
+
+        // Pushed in reverse so octant 0 is split first
+        for (int o = 7; o >= 0; o--) {
+            OctreeCell child = {cell.begin + start[o], cell.begin + start[o + 1], cell.min, half, cell.depth + 1};
+            for (int a = 0; a < 3; a++)
+                if (o & (1 << a))
+                    child.min[a] += half;
+            stack.push_back(child);
+        }
+    }
+    return leaves;
+}
+
+/**
+ * @brief Partitions a mesh into octree chunks and writes them as a .schk file.
+ *
+ * Triangles are assigned to octree leaves by centroid (see
+ * `partitionTriangles()`); each leaf becomes a chunk with its own copy of
+ * the vertices it uses, numbered in order of first use, compressed with
+ * `encodeMesh()`, so a chunk is decoded without the rest of the mesh. The
+ * file holds a header with the counts and bounds of the whole mesh, the
+ * table of chunks with their bounds, then the chunks. Chunks are written
+ * one at a time, and the file goes through a temporary file renamed into
+ * place.
+ *
+ * @param path Output file path.
+ * @param vertices Vertices of the mesh.
+ * @param indices Triangle list of the mesh.
+ * @param maxTriangles Largest chunk, in triangles.
+ * @return bool true if the file was written, false if it could not be or the mesh has no triangles.
+ */
+bool saveChunkedMesh(const std::string &path, const std::vector<Vertex> &vertices,
+                     const std::vector<unsigned int> &indices, size_t maxTriangles) {
+    if (vertices.empty() || indices.size() < 3) {
+        fprintf(stderr, "%s: a chunked mesh needs triangles\n", path.c_str());
+        return false;
+    }
+    const MeshBounds bounds = computeMeshBounds(vertices);
+    const size_t triangleCount = indices.size() / 3;
+    std::vector<std::array<float, 3>> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++)
+        for (int a = 0; a < 3; a++)
+            centroids[t][a] = (vertices[indices[t * 3]].position[a] + vertices[indices[t * 3 + 1]].position[a] +
+                               vertices[indices[t * 3 + 2]].position[a]) / 3.0f;
+    OctreeCell root = {0, triangleCount, bounds.min, 0.0f, 0};
+    root.size = std::max({bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1],
+                          bounds.max[2] - bounds.min[2]});
+    std::vector<uint32_t> order;
+    const std::vector<std::pair<size_t, size_t>> leaves = partitionTriangles(centroids, root,
+                                                                             std::max<size_t>(maxTriangles, 1), order);
+
+    ChunkedHeader header = {CHUNKED_MAGIC, CHUNKED_VERSION, leaves.size(), 0, 0, {}, {}, {}};
+    for (int a = 0; a < 3; a++) {
+        header.center[a] = bounds.center[a];
+        header.min[a] = bounds.min[a];
+        header.max[a] = bounds.max[a];
+    }
+    std::vector<MeshChunk> table(leaves.size());
+
+    const std::string temporaryPath = path + ".tmp";
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", temporaryPath.c_str());
+        return false;
+    }
+    uint64_t offset = sizeof(header) + table.size() * sizeof(MeshChunk);
+    bool ok = fseek(file, static_cast<long>(offset), SEEK_SET) == 0;
+
+    const uint32_t unused = UINT32_MAX;
+    std::vector<uint32_t> remap(vertices.size(), unused);
+    std::vector<Vertex> chunkVertices;
+    std::vector<unsigned int> chunkIndices;
+    for (size_t c = 0; c < leaves.size() && ok; c++) {
+        chunkVertices.clear();
+        chunkIndices.clear();
+        for (size_t i = leaves[c].first; i < leaves[c].second; i++) {
+            for (size_t k = 0; k < 3; k++) {
+                const unsigned int index = indices[order[i] * 3 + k];
+                if (remap[index] == unused) {
+                    remap[index] = static_cast<uint32_t>(chunkVertices.size());
+                    chunkVertices.push_back(vertices[index]);
+                }
+                chunkIndices.push_back(remap[index]);
+            }
+        }
+        for (size_t i = leaves[c].first; i < leaves[c].second; i++)
+            for (size_t k = 0; k < 3; k++)
+                remap[indices[order[i] * 3 + k]] = unused;
+
+        const MeshBounds chunkBounds = computeMeshBounds(chunkVertices);
+        const std::vector<char> encoded = encodeMesh(chunkVertices, chunkIndices);
+        table[c] = {chunkBounds.min, chunkBounds.max, static_cast<uint32_t>(chunkVertices.size()),
+                    static_cast<uint32_t>(chunkIndices.size()), offset, encoded.size()};
+        header.vertexCount += chunkVertices.size();
+        header.indexCount += chunkIndices.size();
+        ok = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+        offset += encoded.size();
+    }
+    ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1 &&
+         fwrite(table.data(), sizeof(MeshChunk), table.size(), file) == table.size();
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a .schk file and reads its header and chunk table.
+ * @param path Chunked mesh file.
+ * @return std::unique_ptr<ChunkedFile> The open file, or nullptr if it is missing or not a valid chunked mesh.
+ */
+std::unique_ptr<ChunkedFile> ChunkedFile::open(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+        return nullptr;
+    std::unique_ptr<ChunkedFile> chunked(new ChunkedFile());
+    chunked->m_file = file;
+
+    ChunkedHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != CHUNKED_MAGIC ||
+        header.version != CHUNKED_VERSION || header.chunkCount == 0 || header.chunkCount > UINT32_MAX) {
+        fprintf(stderr, "%s is not a chunked mesh\n", path.c_str());
+        return nullptr;
+    }
+    chunked->m_chunks.resize(header.chunkCount);
+    if (fread(chunked->m_chunks.data(), sizeof(MeshChunk), chunked->m_chunks.size(), file) !=
+        chunked->m_chunks.size()) {
+        fprintf(stderr, "%s is truncated\n", path.c_str());
+        return nullptr;
+    }
+    chunked->m_vertexCount = header.vertexCount;
+    chunked->m_indexCount = header.indexCount;
+    for (int a = 0; a < 3; a++) {
+        chunked->m_bounds.center[a] = header.center[a];
+        chunked->m_bounds.min[a] = header.min[a];
+        chunked->m_bounds.max[a] = header.max[a];
+    }
+    return chunked;
+}
+
+ChunkedFile::~ChunkedFile() {
+    if (m_file)
+        fclose(m_file);
+}
+
+/**
+ * @brief Reads and decodes one chunk. Not safe to call from several threads at once.
+ * @param chunk Chunk index.
+ * @param vertices Receives the vertices of the chunk.
+ * @param indices Receives its triangle list, indexing `vertices`.
+ * @return bool true on success.
+ */
+bool ChunkedFile::readChunk(size_t chunk, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+    if (chunk >= m_chunks.size())
+        return false;
+    const MeshChunk &entry = m_chunks[chunk];
+    m_buffer.resize(entry.size);
+    if (fseek(m_file, static_cast<long>(entry.offset), SEEK_SET) != 0 ||
+        fread(m_buffer.data(), 1, m_buffer.size(), m_file) != m_buffer.size() ||
+        !decodeMesh(m_buffer.data(), m_buffer.size(), vertices, indices) || vertices.size() != entry.vertexCount ||
+        indices.size() != entry.indexCount) {
+        fprintf(stderr, "Failed to read chunk %zu of a chunked mesh\n", chunk);
+        return false;
+    }
+    return true;
+}
+
+const std::vector<MeshChunk> &ChunkedFile::getChunks() const {
+    return m_chunks;
+}
+
+const MeshBounds &ChunkedFile::getBounds() const {
+    return m_bounds;
+}
+
+size_t ChunkedFile::getVertexCount() const {
+    return m_vertexCount;
+}
+
+size_t ChunkedFile::getIndexCount() const {
+    return m_indexCount;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file ChunkedMesh.hpp
+ * @author Patryk
+ * @brief Octree chunked mesh file declarations
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_CHUNKED_MESH_HPP
+#define SCOP_CHUNKED_MESH_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Vertex.hpp"
+#include "Mesh.hpp"
+
+#define CHUNKED_MAGIC 0x4B484353u // "SCHK"
+#define CHUNKED_VERSION 1u
+#define CHUNKED_EXTENSION ".schk"
+// Octree cells holding more triangles than this are split in eight
+#define CHUNKED_MAX_TRIANGLES 32768
+#define CHUNKED_MAX_DEPTH 16
+
+/**
+ * @brief Table entry of one chunk: a leaf of the octree, stored as an .smesh stream.
+ *
+ * `min` and `max` bound the chunk's own vertices, which can reach outside
+ * its octree cell since triangles are assigned by centroid.
+ */
+struct MeshChunk {
+    std::array<float, 3> min;
+    std::array<float, 3> max;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint64_t offset;
+    uint64_t size;
+};
+
+bool saveChunkedMesh(const std::string &path, const std::vector<Vertex> &vertices,
+                     const std::vector<unsigned int> &indices, size_t maxTriangles = CHUNKED_MAX_TRIANGLES);
+
+/**
+ * @brief Chunked mesh file written by `saveChunkedMesh()`, read one chunk at a time.
+ *
+ * Opening reads only the header and the chunk table, so the size of the
+ * file does not matter. Chunks are decoded with `decodeMesh()`.
+ */
+class ChunkedFile {
+public:
+    static std::unique_ptr<ChunkedFile> open(const std::string &path);
+    ChunkedFile(const ChunkedFile&) = delete;
+    ~ChunkedFile();
+
+    ChunkedFile &operator=(const ChunkedFile&) = delete;
+
+    bool readChunk(size_t chunk, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+
+    const std::vector<MeshChunk> &getChunks() const;
+    const MeshBounds &getBounds() const;
+    size_t getVertexCount() const;
+    size_t getIndexCount() const;
+
+private:
+    ChunkedFile() = default;
+
+    FILE *m_file = nullptr;
+    std::vector<MeshChunk> m_chunks;
+    std::vector<char> m_buffer;
+    MeshBounds m_bounds;
+    size_t m_vertexCount = 0;
+    size_t m_indexCount = 0;
+};
+
+#endif //SCOP_CHUNKED_MESH_HPP
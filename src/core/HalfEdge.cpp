@@ -0,0 +1,179 @@
+/**
+ * @file HalfEdge.cpp
+ * @author Patryk
+ * @brief Half-edge adjacency built by bucketing edges
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+#include "HalfEdge.hpp"
+#include "../utils/Parallel.hpp"
+
+/**
+ * @brief Builds the half-edge adjacency of a triangle list in linear time.
+ *
+ * Half-edges are bucketed by their lower end point with a parallel
+ * counting sort, so both halves of an edge land in the same bucket. Every
+ * bucket is then sorted by the other end point and its runs are matched in
+ * parallel: a run of two half-edges is a pair of twins, a run of one a
+ * boundary and a longer run a non-manifold edge. Buckets hold only the
+ * edges of one vertex, so the whole build is linear for meshes of bounded
+ * valence. Each vertex finally gets an outgoing half-edge, a boundary one
+ * when it has any, so walking its ring starts at the boundary.
+ *
+ * Vertices split by the loader (e.g. along texture seams) are distinct, so
+ * edges between them are boundaries.
+ *
+ * @param indices Triangle list, three indices per triangle.
+ * @param vertexCount Number of vertices the indices refer to.
+ * @return std::unique_ptr<HalfEdgeMesh> Adjacency, or nullptr if the indices are invalid.
+ */
+std::unique_ptr<HalfEdgeMesh> HalfEdgeMesh::build(const std::vector<unsigned int> &indices, size_t vertexCount) {
+    if (indices.size() % 3 != 0 || indices.size() >= HALF_EDGE_NON_MANIFOLD || vertexCount >= HALF_EDGE_NON_MANIFOLD) {
+        fprintf(stderr, "Half-edges need a triangle list of fewer than 2^32 indices and vertices\n");
+        return nullptr;
+    }
+    const size_t count = indices.size();
+    for (unsigned int index: indices) {
+        if (index >= vertexCount) {
+            fprintf(stderr, "Half-edges: index %u out of range of %zu vertices\n", index, vertexCount);
+            return nullptr;
+        }
+    }
+    std::unique_ptr<HalfEdgeMesh> mesh(new HalfEdgeMesh());
+    mesh->m_origin.assign(indices.begin(), indices.end());
+    mesh->m_twin.assign(count, HALF_EDGE_NONE);
+    mesh->m_vertexHalfEdge.assign(vertexCount, HALF_EDGE_NONE);
+
+    // Counting sort of the half-edges by their lower end point
+    std::vector<std::atomic<uint32_t>> cursors(vertexCount + 1);
+    parallelFor(0, count, HALF_EDGE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t h = begin; h < end; h++) {
+            const uint32_t halfEdge = static_cast<uint32_t>(h);
+            cursors[std::min(mesh->getOrigin(halfEdge), mesh->getTarget(halfEdge)) + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::vector<uint32_t> bucketStart(vertexCount + 1, 0);
+    for (size_t v = 1; v <= vertexCount; v++) {
+        bucketStart[v] = bucketStart[v - 1] + cursors[v].load(std::memory_order_relaxed);
+        cursors[v - 1].store(bucketStart[v - 1], std::memory_order_relaxed);
+    }
+    std::vector<uint32_t> buckets(count);
+    parallelFor(0, count, HALF_EDGE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t h = begin; h < end; h++) {
+            const uint32_t halfEdge = static_cast<uint32_t>(h);
+            const uint32_t lower = std::min(mesh->getOrigin(halfEdge), mesh->getTarget(halfEdge));
+            buckets[cursors[lower].fetch_add(1, std::memory_order_relaxed)] = halfEdge;
+        }
+    });
+    mesh->matchEdges(bucketStart, buckets);
+
+    for (size_t h = 0; h < count; h++) {
+        uint32_t &outgoing = mesh->m_vertexHalfEdge[indices[h]];
+        if (outgoing == HALF_EDGE_NONE || (mesh->isBoundary(static_cast<uint32_t>(h)) && !mesh->isBoundary(outgoing)))
+            outgoing = static_cast<uint32_t>(h);
+    }
+    return mesh;
+}
+
+/**
+ * @brief Links the half-edges of every bucket that share both end points and counts the edge kinds.
+ *
+ * The buckets are filled concurrently, so each one is first sorted by
+ * (upper end point, half-edge) to make the result independent of the
+ * thread count.
+ *
+ * @param bucketStart First entry of every vertex bucket, plus the total.
+ * @param buckets Half-edges grouped by their lower end point.
+ */
+void HalfEdgeMesh::matchEdges(const std::vector<uint32_t> &bucketStart, std::vector<uint32_t> &buckets) {
+    std::atomic<size_t> edges(0), boundary(0), nonManifold(0), flipped(0);
+    parallelFor(0, bucketStart.size() - 1, HALF_EDGE_VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        size_t localEdges = 0, localBoundary = 0, localNonManifold = 0, localFlipped = 0;
+        for (size_t v = begin; v < end; v++) {
+            const uint32_t lower = static_cast<uint32_t>(v);
+            auto upper = [&](uint32_t halfEdge) {
+                return m_origin[halfEdge] == lower ? getTarget(halfEdge) : m_origin[halfEdge];
+            };
+            uint32_t *first = &buckets[bucketStart[v]], *last = &buckets[bucketStart[v + 1]];
+            std::sort(first, last, [&](uint32_t a, uint32_t b) {
+                const uint32_t upperA = upper(a), upperB = upper(b);
+                return upperA != upperB ? upperA < upperB : a < b;
+            });
+            for (uint32_t *run = first; run != last;) {
+                const uint32_t other = upper(*run);
+                uint32_t *runEnd = run + 1;
+                while (runEnd != last && upper(*runEnd) == other)
+                    runEnd++;
+                if (other == lower) {
+                    // Degenerate edges of collapsed triangles are left unmatched
+                } else if (runEnd - run == 1) {
+                    localEdges++;
+                    localBoundary++;
+                } else if (runEnd - run == 2) {
+                    m_twin[run[0]] = run[1];
+                    m_twin[run[1]] = run[0];
+                    localEdges++;
+                    if (m_origin[run[0]] == m_origin[run[1]])
+                        localFlipped++;
+                } else {
+                    for (uint32_t *halfEdge = run; halfEdge != runEnd; halfEdge++)
+                        m_twin[*halfEdge] = HALF_EDGE_NON_MANIFOLD;
+                    localEdges++;
+                    localNonManifold++;
+                }
+                run = runEnd;
+            }
+        }
+        edges += localEdges;
+        boundary += localBoundary;
+        nonManifold += localNonManifold;
+        flipped += localFlipped;
+    });
+    m_edgeCount = edges;
+    m_boundaryEdgeCount = boundary;
+    m_nonManifoldEdgeCount = nonManifold;
+    m_flippedEdgeCount = flipped;
+}
+
+size_t HalfEdgeMesh::getHalfEdgeCount() const {
+    return m_twin.size();
+}
+
+size_t HalfEdgeMesh::getFaceCount() const {
+    return m_twin.size() / 3;
+}
+
+size_t HalfEdgeMesh::getVertexCount() const {
+    return m_vertexHalfEdge.size();
+}
+
+/**
+ * @brief Returns the number of distinct edges, including boundary and non-manifold ones.
+ */
+size_t HalfEdgeMesh::getEdgeCount() const {
+    return m_edgeCount;
+}
+
+size_t HalfEdgeMesh::getBoundaryEdgeCount() const {
+    return m_boundaryEdgeCount;
+}
+
+size_t HalfEdgeMesh::getNonManifoldEdgeCount() const {
+    return m_nonManifoldEdgeCount;
+}
+
+size_t HalfEdgeMesh::getFlippedEdgeCount() const {
+    return m_flippedEdgeCount;
+}
+
+size_t HalfEdgeMesh::getMemoryUsage() const {
+    return (m_origin.size() + m_twin.size() + m_vertexHalfEdge.size()) * sizeof(uint32_t);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file HalfEdge.hpp
+ * @author Patryk
+ * @brief HalfEdgeMesh class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_HALF_EDGE_HPP
+#define SCOP_HALF_EDGE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#define HALF_EDGE_NONE 0xFFFFFFFFu
+#define HALF_EDGE_NON_MANIFOLD 0xFFFFFFFEu
+#define HALF_EDGE_GRAIN 65536
+#define HALF_EDGE_VERTEX_GRAIN 4096
+
+/**
+ * @brief Index-based half-edge adjacency of a triangle list.
+ *
+ * Half-edge `h` is corner `h % 3` of triangle `h / 3` and runs from that
+ * corner to the next one, so faces and `next`/`prev` are implicit and only
+ * the origin and twin of every half-edge are stored, as two 32-bit arrays,
+ * plus one outgoing half-edge per vertex.
+ *
+ * The twin of a boundary half-edge is HALF_EDGE_NONE. Edges shared by more
+ * than two triangles are non-manifold: their half-edges get
+ * HALF_EDGE_NON_MANIFOLD and are otherwise treated as boundaries. Two
+ * triangles sharing an edge in the same direction (inconsistent winding)
+ * are still twins, with the same origin; they are counted as flipped.
+ */
+class HalfEdgeMesh {
+public:
+    static std::unique_ptr<HalfEdgeMesh> build(const std::vector<unsigned int> &indices, size_t vertexCount);
+    HalfEdgeMesh(const HalfEdgeMesh&) = delete;
+    HalfEdgeMesh &operator=(const HalfEdgeMesh&) = delete;
+    ~HalfEdgeMesh() = default;
+
+    uint32_t getTwin(uint32_t halfEdge) const { return m_twin[halfEdge]; }
+    uint32_t getNext(uint32_t halfEdge) const { return halfEdge % 3 == 2 ? halfEdge - 2 : halfEdge + 1; }
+    uint32_t getPrev(uint32_t halfEdge) const { return halfEdge % 3 == 0 ? halfEdge + 2 : halfEdge - 1; }
+    uint32_t getFace(uint32_t halfEdge) const { return halfEdge / 3; }
+    uint32_t getOrigin(uint32_t halfEdge) const { return m_origin[halfEdge]; }
+    uint32_t getTarget(uint32_t halfEdge) const { return m_origin[getNext(halfEdge)]; }
+    uint32_t getVertexHalfEdge(uint32_t vertex) const { return m_vertexHalfEdge[vertex]; }
+    bool isBoundary(uint32_t halfEdge) const { return m_twin[halfEdge] >= HALF_EDGE_NON_MANIFOLD; }
+
+    size_t getHalfEdgeCount() const;
+    size_t getFaceCount() const;
+    size_t getVertexCount() const;
+    size_t getEdgeCount() const;
+    size_t getBoundaryEdgeCount() const;
+    size_t getNonManifoldEdgeCount() const;
+    size_t getFlippedEdgeCount() const;
+    size_t getMemoryUsage() const;
+
+private:
+    HalfEdgeMesh() = default;
+
+    std::vector<uint32_t> m_origin;
+    std::vector<uint32_t> m_twin;
+    std::vector<uint32_t> m_vertexHalfEdge;
+    size_t m_edgeCount = 0;
+    size_t m_boundaryEdgeCount = 0;
+    size_t m_nonManifoldEdgeCount = 0;
+    size_t m_flippedEdgeCount = 0;
+
+    void matchEdges(const std::vector<uint32_t> &bucketStart, std::vector<uint32_t> &buckets);
+};
+
+#endif //SCOP_HALF_EDGE_HPP
@@ -0,0 +1,373 @@
+/**
+ * @file Mesh.cpp
+ * @author Patryk
+ * @brief Mesh struct implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "Mesh.hpp"
+#include "../io/Asset.hpp"
+#include "../io/Ply.hpp"
+#include "../io/Stl.hpp"
+#include "../io/MeshCodec.hpp"
+#include "../utils/Kernels.hpp"
+#include "../utils/Vector.hpp"
+
+static bool hasExtension(const std::string &path, const std::string &extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Loads the geometry of an .obj, .ply, .stl or .smesh file.
+ *
+ * The file is resolved through `Asset`, so it can come from a mounted
+ * asset pack or from disk. .obj geometry goes through `cleanup()` unless
+ * disabled in `settings`; .stl corners are welded with the settings' weld
+ * tolerance. Texture coordinates are projected on the XY plane and smooth
+ * normals are computed for files without them, unless `settings.normals`
+ * is false, in which case `hasNormals` tells the caller to compute them.
+ * Makes no GL calls, so it is safe to call from any thread.
+ *
+ * @param filePath Path to the model file; .glb files are not handled here.
+ * @param settings Processing applied to the geometry.
+ * @param parser Parser keeping the chunks of a previous parse of the same .obj file, to re-parse only what changed.
+ * @return std::unique_ptr<Mesh> The mesh, or `nullptr` if the file could not be loaded.
+ */
+std::unique_ptr<Mesh> Mesh::load(const std::string &filePath, const MeshSettings &settings, ObjParser *parser) {
+    std::unique_ptr<Mesh> mesh(new Mesh());
+    int result;
+    if (hasExtension(filePath, ".ply")) {
+        result = mesh->loadPly(filePath);
+    } else if (hasExtension(filePath, ".stl")) {
+        result = mesh->loadStl(filePath, settings);
+    } else if (hasExtension(filePath, MESH_CODEC_EXTENSION)) {
+        result = mesh->loadCompressed(filePath);
+    } else if (hasExtension(filePath, ".glb")) {
+        fprintf(stderr, "%s: glTF files are not loaded as a single mesh\n", filePath.c_str());
+        result = 1;
+    } else {
+        ObjParser localParser;
+        result = mesh->parseObj(filePath, settings, parser ? *parser : localParser);
+    }
+    if (result)
+        return nullptr;
+
+    if (!mesh->hasNormals && settings.normals)
+        mesh->computeNormals();
+    return mesh;
+}
+
+/**
+ * @brief Parses an .obj file with ObjParser and cleans the result up.
+ *
+ * Quad faces are split into two triangles by the parser. What `cleanup()`
+ * removed is printed, unless `settings.verbose` is false.
+ *
+ * @param filePath The path to the .obj file.
+ * @param settings Whether to clean up, and the weld tolerance.
+ * @param parser Parser to use, possibly holding the chunks of a previous parse.
+ * @return int 0 on success, 1 if the file could not be opened or has no triangles.
+ */
+int Mesh::parseObj(const std::string &filePath, const MeshSettings &settings, ObjParser &parser) {
+    const std::unique_ptr<Asset> asset = Asset::load(filePath);
+    if (!asset) {
+        fprintf(stderr, "Failed to open file %s\n", filePath.c_str());
+        return 1;
+    }
+    parser.parse(asset->data(), asset->size());
+    parser.assemble(vertices, indices);
+
+    if (vertices.empty() || indices.empty())
+        return 1;
+    if (settings.cleanup) {
+        const auto start = std::chrono::steady_clock::now();
+        const size_t vertexCount = vertices.size(), triangleCount = indices.size() / 3;
+        const MeshCleanupReport report = cleanup(settings.weldTolerance);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (indices.empty()) {
+            fprintf(stderr, "%s: all triangles are degenerate\n", filePath.c_str());
+            return 1;
+        }
+        if (settings.verbose && (vertices.size() != vertexCount || indices.size() / 3 != triangleCount)) {
+            printf("Cleaned %s in %.1f ms: %zu degenerate and %zu duplicate triangles dropped, %zu vertices welded, "
+                   "%zu unreferenced vertices stripped\n", filePath.c_str(), elapsed.count(),
+                   report.degenerateTriangles, report.duplicateTriangles, report.weldedVertices,
+                   report.unreferencedVertices);
+        }
+    }
+    computeUV_XY();
+    return 0;
+}
+
+/**
+ * @brief Loads vertex, face and color data from a .ply file.
+ *
+ * The file is mapped and decoded by PlyModel. Point clouds without normals face +Z.
+ *
+ * @param filePath The path to the .ply file.
+ * @return int 0 on success, 1 if the file could not be loaded.
+ */
+int Mesh::loadPly(const std::string &filePath) {
+    const std::unique_ptr<Asset> asset = Asset::map(filePath);
+    if (!asset) {
+        fprintf(stderr, "Failed to open file %s\n", filePath.c_str());
+        return 1;
+    }
+    std::unique_ptr<PlyModel> model = PlyModel::load(asset->data(), asset->size(), filePath);
+    if (!model)
+        return 1;
+
+    vertices.swap(model->vertices);
+    indices.swap(model->indices);
+    colors.swap(model->colors);
+    hasNormals = model->hasNormals;
+    if (!hasNormals && indices.empty()) {
+        for (Vertex &v: vertices)
+            v.normal = {0.0f, 0.0f, 1.0f};
+        hasNormals = true;
+    }
+    computeUV_XY();
+    return 0;
+}
+
+/**
+ * @brief Loads an .stl file as welded, indexed geometry.
+ *
+ * Corners closer than the weld tolerance share a vertex, so
+ * `computeNormals()` produces smooth normals across facets.
+ *
+ * @param filePath The path to the .stl file.
+ * @param settings Weld tolerance to use.
+ * @return int 0 on success, 1 if the file could not be loaded.
+ */
+int Mesh::loadStl(const std::string &filePath, const MeshSettings &settings) {
+    const std::unique_ptr<Asset> asset = Asset::map(filePath);
+    if (!asset) {
+        fprintf(stderr, "Failed to open file %s\n", filePath.c_str());
+        return 1;
+    }
+    std::unique_ptr<StlModel> model = StlModel::load(asset->data(), asset->size(), filePath,
+                                                     settings.weldTolerance);
+    if (!model)
+        return 1;
+
+    vertices.swap(model->vertices);
+    indices.swap(model->indices);
+    computeUV_XY();
+    return 0;
+}
+
+/**
+ * @brief Loads a mesh written by `encodeMesh()`, with its texture coordinates and normals.
+ *
+ * The file is mapped and its chunks are decoded in parallel.
+ *
+ * @param filePath The path to the .smesh file.
+ * @return int 0 on success, 1 if the file could not be loaded.
+ */
+int Mesh::loadCompressed(const std::string &filePath) {
+    const std::unique_ptr<Asset> asset = Asset::map(filePath);
+    if (!asset) {
+        fprintf(stderr, "Failed to open file %s\n", filePath.c_str());
+        return 1;
+    }
+    if (!decodeMesh(asset->data(), asset->size(), vertices, indices) || vertices.empty()) {
+        fprintf(stderr, "%s: malformed compressed mesh\n", filePath.c_str());
+        return 1;
+    }
+    hasNormals = true;
+    return 0;
+}
+
+/**
+ * @brief Welds close vertices and drops degenerate and duplicate triangles, see `cleanupMesh()`.
+ *
+ * Vertex colors are dropped, as they would no longer match the vertices.
+ *
+ * @param weldTolerance Distance below which vertices are merged.
+ * @return MeshCleanupReport What was removed.
+ */
+MeshCleanupReport Mesh::cleanup(float weldTolerance) {
+    colors.clear();
+    return cleanupMesh(vertices, indices, weldTolerance);
+}
+
+/**
+ * @brief Computes smooth normals for all vertices of a triangle list.
+ *
+ * Calculates each vertex normal by averaging the normals of all
+ * triangles that share the vertex.
+ *
+ * @param vertices Vertices whose normals are overwritten.
+ * @param indices Triangle list indexing `vertices`.
+ */
+void computeMeshNormals(std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+    for (auto &v: vertices) {
+        v.normal = {0.0f, 0.0f, 0.0f};
+    }
+
+    // Face normals come from the vectorized kernel a block at a time; the scatter to shared vertices stays scalar
+    const KernelTable &kernels = getKernels();
+    std::vector<float> faceNormals(MESH_NORMAL_BLOCK * 3);
+    const size_t triangleCount = indices.size() / 3;
+    for (size_t first = 0; first < triangleCount; first += MESH_NORMAL_BLOCK) {
+        const size_t count = std::min<size_t>(MESH_NORMAL_BLOCK, triangleCount - first);
+        kernels.computeFaceNormals(vertices[0].position.data(), &indices[first * 3], count, faceNormals.data());
+        for (size_t t = 0; t < count; t++) {
+            const float *faceNormal = &faceNormals[t * 3];
+            for (size_t corner = 0; corner < 3; corner++) {
+                std::array<float, 3> &normal = vertices[indices[(first + t) * 3 + corner]].normal;
+                normal[0] += faceNormal[0];
+                normal[1] += faceNormal[1];
+                normal[2] += faceNormal[2];
+            }
+        }
+    }
+    for (auto &v: vertices) {
+        v.normal = normalizeVec(v.normal);
+    }
+}
+
+/**
+ * @brief Computes smooth normals for all vertices, see `computeMeshNormals()`.
+ */
+void Mesh::computeNormals() {
+    computeMeshNormals(vertices, indices);
+    hasNormals = true;
+}
+
+/**
+ * @brief Calculates UV coordinates using XY plane projection.
+ *
+ * The minimum and maximum X/Y values are used to map positions into the
+ * [0, 1] UV range.
+ */
+void Mesh::computeUV_XY() {
+    if (vertices.empty()) return;
+
+    float minX = vertices[0].position[0], maxX = vertices[0].position[0];
+    float minY = vertices[0].position[1], maxY = vertices[0].position[1];
+
+    for (const auto &v: vertices) {
+        if (v.position[0] < minX) minX = v.position[0];
+        if (v.position[0] > maxX) maxX = v.position[0];
+        if (v.position[1] < minY) minY = v.position[1];
+        if (v.position[1] > maxY) maxY = v.position[1];
+    }
+    for (auto &v: vertices) {
+        v.uv[0] = (v.position[0] - minX) / (maxX - minX);
+        v.uv[1] = (v.position[1] - minY) / (maxY - minY);
+    }
+}
+
+/**
+ * @brief Calculates UV coordinates using ZY plane projection.
+ *
+ * The minimum and maximum Z/Y values are used to map positions into the
+ * [0, 1] UV range.
+ */
+void Mesh::computeUV_ZY() {
+    if (vertices.empty()) return;
+
+    float minZ = vertices[0].position[2], maxZ = vertices[0].position[2];
+    float minY = vertices[0].position[1], maxY = vertices[0].position[1];
+
+    for (const auto &v: vertices) {
+        if (v.position[2] < minZ) minZ = v.position[2];
+        if (v.position[2] > maxZ) maxZ = v.position[2];
+        if (v.position[1] < minY) minY = v.position[1];
+        if (v.position[1] > maxY) maxY = v.position[1];
+    }
+    for (auto &v: vertices) {
+        v.uv[0] = (v.position[2] - minZ) / (maxZ - minZ);
+        v.uv[1] = (v.position[1] - minY) / (maxY - minY);
+    }
+}
+
+/**
+ * @brief Reorders the vertices in the order the triangles first use them.
+ *
+ * Vertices fetched by neighbouring triangles end up next to each other in
+ * memory, which helps the vertex fetch and the CPU passes walking the
+ * triangles. Unreferenced vertices move to the end. Point clouds are left
+ * as they are.
+ */
+void Mesh::optimizeVertexOrder() {
+    if (indices.empty())
+        return;
+    const unsigned int unused = static_cast<unsigned int>(-1);
+    std::vector<unsigned int> remap(vertices.size(), unused);
+    unsigned int next = 0;
+    for (unsigned int &index: indices) {
+        if (remap[index] == unused)
+            remap[index] = next++;
+        index = remap[index];
+    }
+    for (unsigned int &target: remap) {
+        if (target == unused)
+            target = next++;
+    }
+
+    std::vector<Vertex> ordered(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+        ordered[remap[i]] = vertices[i];
+    vertices.swap(ordered);
+    if (!colors.empty()) {
+        std::vector<std::array<unsigned char, 4>> orderedColors(colors.size());
+        for (size_t i = 0; i < colors.size(); i++)
+            orderedColors[remap[i]] = colors[i];
+        colors.swap(orderedColors);
+    }
+}
+
+/**
+ * @brief Computes the average position and the bounding box of a set of vertices.
+ *
+ * The center is the average rather than the middle of the box, so dense
+ * parts of the mesh pull it towards them.
+ *
+ * @param vertices Vertices to measure.
+ * @return MeshBounds Average position, minimum and maximum, all zero without vertices.
+ */
+MeshBounds computeMeshBounds(const std::vector<Vertex> &vertices) {
+    MeshBounds bounds = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+    if (vertices.empty())
+        return bounds;
+
+    float sum[KERNEL_VERTEX_FLOATS] = {}, min[KERNEL_VERTEX_FLOATS], max[KERNEL_VERTEX_FLOATS];
+    memcpy(min, &vertices[0], sizeof(min));
+    memcpy(max, &vertices[0], sizeof(max));
+    getKernels().accumulateBounds(vertices[0].position.data(), vertices.size(), sum, min, max);
+    for (int a = 0; a < 3; a++) {
+        bounds.min[a] = min[a];
+        bounds.max[a] = max[a];
+    }
+    for (int a = 0; a < 3; a++)
+        bounds.center[a] = sum[a] / vertices.size();
+    return bounds;
+}
+
+/**
+ * @brief Computes the average position and the bounding box of the vertices, see `computeMeshBounds()`.
+ */
+MeshBounds Mesh::computeBounds() const {
+    return computeMeshBounds(vertices);
+}
+
+/**
+ * @brief Returns the memory held by the vertex, index and color arrays, in bytes.
+ */
+size_t Mesh::getMemoryUsage() const {
+    return vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int) +
+           colors.capacity() * sizeof(colors[0]);
+}
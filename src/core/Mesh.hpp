@@ -0,0 +1,88 @@
+/**
+ * @file Mesh.hpp
+ * @author Patryk
+ * @brief Mesh struct declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_MESH_HPP
+#define SCOP_MESH_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Vertex.hpp"
+#include "ObjParser.hpp"
+#include "MeshCleanup.hpp"
+#include "Weld.hpp"
+
+// Triangles whose face normals are computed per kernel call
+#define MESH_NORMAL_BLOCK 4096
+
+/**
+ * @brief How `Mesh::load()` processes the geometry it reads.
+ */
+struct MeshSettings {
+    float weldTolerance = WELD_DEFAULT_TOLERANCE;
+    bool cleanup = true;
+    // false leaves missing normals to the caller, e.g. to compute them on the GPU
+    bool normals = true;
+    // Print what the cleanup removed
+    bool verbose = true;
+};
+
+/**
+ * @brief Vertex position statistics computed by `Mesh::computeBounds()` or `MeshCompute::computeBounds()`.
+ */
+struct MeshBounds {
+    std::array<float, 3> center;
+    std::array<float, 3> min;
+    std::array<float, 3> max;
+};
+
+void computeMeshNormals(std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+MeshBounds computeMeshBounds(const std::vector<Vertex> &vertices);
+
+/**
+ * @brief Geometry of an .obj, .ply, .stl or .smesh file, processed on the CPU only.
+ *
+ * Mesh is the OpenGL-free part of the model pipeline: parsing, cleanup,
+ * normals, texture coordinates, bounds and optimization passes. It is
+ * built into the `libscopmesh.a` library together with the parsers, so
+ * tools, benchmarks and worker threads can use it without a GL context;
+ * Object takes the geometry from it and uploads it to the GPU as a
+ * separate step. `indices` is a triangle list, empty for a point cloud.
+ * `colors` is empty unless the file has vertex colors.
+ */
+struct Mesh {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<std::array<unsigned char, 4>> colors;
+    bool hasNormals = false;
+
+    static std::unique_ptr<Mesh> load(const std::string &filePath, const MeshSettings &settings = MeshSettings(),
+                                      ObjParser *parser = nullptr);
+
+    MeshCleanupReport cleanup(float weldTolerance);
+    void computeNormals();
+    void computeUV_XY();
+    void computeUV_ZY();
+    void optimizeVertexOrder();
+
+    MeshBounds computeBounds() const;
+    size_t getMemoryUsage() const;
+
+private:
+    int parseObj(const std::string &filePath, const MeshSettings &settings, ObjParser &parser);
+    int loadPly(const std::string &filePath);
+    int loadStl(const std::string &filePath, const MeshSettings &settings);
+    int loadCompressed(const std::string &filePath);
+};
+
+#endif //SCOP_MESH_HPP
@@ -0,0 +1,217 @@
+/**
+ * @file MeshCleanup.cpp
+ * @author Patryk
+ * @brief Removal of degenerate and duplicate triangles, duplicate and unused vertices
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "MeshCleanup.hpp"
+#include "Weld.hpp"
+#include "../utils/Parallel.hpp"
+
+#define CLEANUP_VERTEX_GRAIN 4096
+
+/**
+ * @brief Rotates a triangle so its smallest index comes first, keeping the winding.
+ */
+static void canonicalTriangle(const unsigned int *triangle, unsigned int out[3]) {
+    const int first = triangle[0] < triangle[1] ? (triangle[0] < triangle[2] ? 0 : 2) : (triangle[1] < triangle[2] ? 1 : 2);
+    for (int k = 0; k < 3; k++)
+        out[k] = triangle[(first + k) % 3];
+}
+
+/**
+ * @brief Flags every triangle that repeats an earlier one with the same corners and winding.
+ *
+ * Triangles are bucketed by their smallest index with a parallel counting
+ * sort, and each bucket is sorted by the two other corners and then by
+ * triangle index, so the first triangle of every run is the one kept no
+ * matter how the buckets were filled.
+ *
+ * @param indices Triangle list.
+ * @param vertexCount Number of vertices the indices refer to.
+ * @param keep Per triangle flag; triangles already cleared are ignored, duplicates are cleared.
+ * @return size_t Number of duplicates cleared.
+ */
+static size_t removeDuplicateTriangles(const std::vector<unsigned int> &indices, size_t vertexCount,
+                                       std::vector<unsigned char> &keep) {
+    const size_t triangleCount = keep.size();
+    std::vector<std::atomic<unsigned int>> cursors(vertexCount + 1);
+    parallelFor(0, triangleCount, CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            const unsigned int *triangle = &indices[t * 3];
+            if (keep[t])
+                cursors[std::min({triangle[0], triangle[1], triangle[2]}) + 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::vector<unsigned int> bucketStart(vertexCount + 1, 0);
+    for (size_t v = 1; v <= vertexCount; v++) {
+        bucketStart[v] = bucketStart[v - 1] + cursors[v].load(std::memory_order_relaxed);
+        cursors[v - 1].store(bucketStart[v - 1], std::memory_order_relaxed);
+    }
+    std::vector<unsigned int> buckets(bucketStart[vertexCount]);
+    parallelFor(0, triangleCount, CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            const unsigned int *triangle = &indices[t * 3];
+            if (keep[t]) {
+                const unsigned int lowest = std::min({triangle[0], triangle[1], triangle[2]});
+                buckets[cursors[lowest].fetch_add(1, std::memory_order_relaxed)] = static_cast<unsigned int>(t);
+            }
+        }
+    });
+
+    std::atomic<size_t> duplicates(0);
+    parallelFor(0, vertexCount, CLEANUP_VERTEX_GRAIN, [&](size_t begin, size_t end) {
+        size_t localDuplicates = 0;
+        for (size_t v = begin; v < end; v++) {
+            unsigned int *first = buckets.data() + bucketStart[v], *last = buckets.data() + bucketStart[v + 1];
+            if (last - first < 2)
+                continue;
+            std::sort(first, last, [&](unsigned int a, unsigned int b) {
+                unsigned int ca[3], cb[3];
+                canonicalTriangle(&indices[a * 3], ca);
+                canonicalTriangle(&indices[b * 3], cb);
+                if (ca[1] != cb[1])
+                    return ca[1] < cb[1];
+                if (ca[2] != cb[2])
+                    return ca[2] < cb[2];
+                return a < b;
+            });
+            unsigned int previous[3];
+            canonicalTriangle(&indices[*first * 3], previous);
+            for (unsigned int *it = first + 1; it != last; it++) {
+                unsigned int current[3];
+                canonicalTriangle(&indices[*it * 3], current);
+                if (current[1] == previous[1] && current[2] == previous[2]) {
+                    keep[*it] = 0;
+                    localDuplicates++;
+                } else {
+                    std::copy(current, current + 3, previous);
+                }
+            }
+        }
+        duplicates += localDuplicates;
+    });
+    return duplicates;
+}
+
+/**
+ * @brief Removes what costs GPU time and memory without changing the shape of a mesh.
+ *
+ * Runs in four parallel passes:
+ * 1. Welds positions closer than `weldTolerance` with `weldPoints()`.
+ * 2. Drops triangles that collapsed to a line or a point.
+ * 3. Drops triangles repeating an earlier one (same corners and winding;
+ *    a back-facing copy is kept, as it may be intended as a double-sided face).
+ * 4. Strips vertices no triangle refers to and compacts the indices.
+ *
+ * The order of the remaining triangles and vertices is preserved. Only
+ * positions survive, so texture coordinates and normals must be computed
+ * afterwards.
+ *
+ * @param vertices Mesh vertices, replaced by the cleaned ones.
+ * @param indices Triangle list, replaced by the cleaned one.
+ * @param weldTolerance Weld distance as a fraction of the model size; 0 merges only identical positions.
+ * @return MeshCleanupReport Counts of what was removed.
+ */
+MeshCleanupReport cleanupMesh(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices, float weldTolerance) {
+    MeshCleanupReport report;
+    const size_t triangleCount = indices.size() / 3;
+    indices.resize(triangleCount * 3);
+
+    std::vector<std::array<float, 3>> points(vertices.size()), positions;
+    parallelFor(0, vertices.size(), CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            points[i] = vertices[i].position;
+    });
+    std::vector<unsigned int> remap;
+    weldPoints(points, weldTolerance, positions, remap);
+    report.weldedVertices = points.size() - positions.size();
+    points.clear();
+    points.shrink_to_fit();
+
+    std::vector<unsigned char> keep(triangleCount, 1);
+    std::atomic<size_t> degenerate(0);
+    parallelFor(0, triangleCount, CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        size_t localDegenerate = 0;
+        for (size_t t = begin; t < end; t++) {
+            unsigned int *triangle = &indices[t * 3];
+            for (int k = 0; k < 3; k++)
+                triangle[k] = remap[triangle[k]];
+            const std::array<float, 3> &p0 = positions[triangle[0]], &p1 = positions[triangle[1]],
+                                       &p2 = positions[triangle[2]];
+            const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            const float cross[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                                    e1[0] * e2[1] - e1[1] * e2[0]};
+            if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2] ||
+                (cross[0] == 0.0f && cross[1] == 0.0f && cross[2] == 0.0f)) {
+                keep[t] = 0;
+                localDegenerate++;
+            }
+        }
+        degenerate += localDegenerate;
+    });
+    report.degenerateTriangles = degenerate;
+    report.duplicateTriangles = removeDuplicateTriangles(indices, positions.size(), keep);
+
+    // Compact the kept triangles, block by block, and flag the vertices they use
+    const size_t blocks = (triangleCount + CLEANUP_GRAIN - 1) / CLEANUP_GRAIN;
+    std::vector<size_t> blockOffsets(blocks + 1, 0);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            for (size_t t = b * CLEANUP_GRAIN; t < std::min(triangleCount, (b + 1) * CLEANUP_GRAIN); t++)
+                blockOffsets[b + 1] += keep[t];
+        }
+    });
+    for (size_t b = 0; b < blocks; b++)
+        blockOffsets[b + 1] += blockOffsets[b];
+    std::vector<unsigned int> compacted(blockOffsets[blocks] * 3);
+    std::vector<std::atomic<unsigned char>> used(positions.size());
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            unsigned int *out = compacted.data() + blockOffsets[b] * 3;
+            for (size_t t = b * CLEANUP_GRAIN; t < std::min(triangleCount, (b + 1) * CLEANUP_GRAIN); t++) {
+                if (!keep[t])
+                    continue;
+                for (int k = 0; k < 3; k++) {
+                    *out++ = indices[t * 3 + k];
+                    used[indices[t * 3 + k]].store(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    indices.swap(compacted);
+
+    std::vector<unsigned int> newIndex(positions.size());
+    size_t usedCount = 0;
+    for (size_t v = 0; v < positions.size(); v++) {
+        newIndex[v] = static_cast<unsigned int>(usedCount);
+        usedCount += used[v].load(std::memory_order_relaxed);
+    }
+    report.unreferencedVertices = positions.size() - usedCount;
+
+    vertices.resize(usedCount);
+    parallelFor(0, positions.size(), CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; v++) {
+            if (!used[v].load(std::memory_order_relaxed))
+                continue;
+            Vertex &vertex = vertices[newIndex[v]];
+            vertex.position = positions[v];
+            vertex.uv = {0.0f, 0.0f};
+            vertex.normal = {0.0f, 0.0f, 0.0f};
+        }
+    });
+    parallelFor(0, indices.size(), CLEANUP_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            indices[i] = newIndex[indices[i]];
+    });
+    return report;
+}
@@ -0,0 +1,34 @@
+/**
+ * @file MeshCleanup.hpp
+ * @author Patryk
+ * @brief Mesh cleanup declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_MESH_CLEANUP_HPP
+#define SCOP_MESH_CLEANUP_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Vertex.hpp"
+
+#define CLEANUP_GRAIN 65536
+
+/**
+ * @brief What `cleanupMesh()` removed.
+ */
+struct MeshCleanupReport {
+    size_t weldedVertices = 0;
+    size_t degenerateTriangles = 0;
+    size_t duplicateTriangles = 0;
+    size_t unreferencedVertices = 0;
+};
+
+MeshCleanupReport cleanupMesh(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices, float weldTolerance);
+
+#endif //SCOP_MESH_CLEANUP_HPP
@@ -0,0 +1,365 @@
+/**
+ * @file ObjParser.cpp
+ * @author Patryk
+ * @brief ObjParser class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+
+#include "ObjParser.hpp"
+#include "../utils/Parallel.hpp"
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+/**
+ * @brief Hashes a byte range eight bytes at a time.
+ */
+static uint64_t hashBytes(const char *p, size_t size) {
+    uint64_t hash = size * 0x9E3779B97F4A7C15ull;
+    while (size >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        hash = (hash ^ mix64(word)) * 0x9E3779B97F4A7C15ull;
+        p += 8;
+        size -= 8;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, p, size);
+    return mix64(hash ^ mix64(tail));
+}
+
+static bool isSpace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * @brief Parses a decimal floating point number without locale or allocation.
+ *
+ * Accepts an optional sign, digits with an optional fraction and an optional
+ * exponent. Up to 19 significant digits are accumulated in an integer and
+ * scaled by an exact power of ten, which is enough for the float range.
+ * Never reads at or past `end`.
+ *
+ * @param p Current position; advanced past the number on success.
+ * @param end End of the buffer.
+ * @param value Parsed value.
+ * @return bool true if a number was parsed.
+ */
+bool parseFloat(const char *&p, const char *end, float &value) {
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char *s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        s++;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int digits = 0;
+    bool any = false;
+    for (; s < end && isDigit(*s); s++) {
+        any = true;
+        if (digits < 19) {
+            mantissa = mantissa * 10 + (*s - '0');
+            if (mantissa) digits++;
+        } else {
+            exponent++;
+        }
+    }
+    if (s < end && *s == '.') {
+        for (s++; s < end && isDigit(*s); s++) {
+            any = true;
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*s - '0');
+                if (mantissa) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any)
+        return false;
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        const char *e = s + 1;
+        bool negativeExponent = false;
+        if (e < end && (*e == '-' || *e == '+')) {
+            negativeExponent = *e == '-';
+            e++;
+        }
+        if (e < end && isDigit(*e)) {
+            int parsed = 0;
+            for (; e < end && isDigit(*e); e++) {
+                if (parsed < 10000)
+                    parsed = parsed * 10 + (*e - '0');
+            }
+            exponent += negativeExponent ? -parsed : parsed;
+            s = e;
+        }
+    }
+
+    double result = static_cast<double>(mantissa);
+    while (exponent < -22) {
+        result /= 1e22;
+        exponent += 22;
+    }
+    while (exponent > 22) {
+        result *= 1e22;
+        exponent -= 22;
+    }
+    result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+
+    value = static_cast<float>(negative ? -result : result);
+    p = s;
+    return true;
+}
+
+/**
+ * @brief Parses a signed decimal integer.
+ */
+static bool parseInt(const char *&p, const char *end, int64_t &value) {
+    const char *s = p;
+    bool negative = false;
+    if (s < end && (*s == '-' || *s == '+')) {
+        negative = *s == '-';
+        s++;
+    }
+    if (s >= end || !isDigit(*s))
+        return false;
+    int64_t result = 0;
+    for (; s < end && isDigit(*s); s++)
+        result = result * 10 + (*s - '0');
+    value = negative ? -result : result;
+    p = s;
+    return true;
+}
+
+/**
+ * @brief Splits the file into chunks and parses the chunks not seen before.
+ *
+ * Chunk boundaries are placed after lines whose hash matches
+ * OBJ_CHUNK_BOUNDARY_MASK, once a chunk holds at least OBJ_CHUNK_MIN_SIZE
+ * bytes (or unconditionally at OBJ_CHUNK_MAX_SIZE). Because boundaries
+ * depend on content and not on offsets, inserting or removing lines only
+ * affects the chunks around the edit. A chunk's hash combines its line
+ * hashes and its size.
+ *
+ * @param data File content.
+ * @param size File size in bytes.
+ */
+void ObjParser::parse(const char *data, size_t size) {
+    struct ChunkRange {
+        size_t begin;
+        size_t end;
+        uint64_t hash;
+    };
+
+    std::vector<ChunkRange> ranges;
+    size_t chunkBegin = 0;
+    uint64_t chunkHash = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        const char *newline = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+        const size_t lineEnd = newline ? static_cast<size_t>(newline - data) + 1 : size;
+        const uint64_t lineHash = hashBytes(data + pos, lineEnd - pos);
+        chunkHash = (chunkHash ^ lineHash) * 0x100000001b3ull;
+        pos = lineEnd;
+
+        const size_t chunkSize = pos - chunkBegin;
+        if ((chunkSize >= OBJ_CHUNK_MIN_SIZE && (lineHash & OBJ_CHUNK_BOUNDARY_MASK) == 0) ||
+            chunkSize >= OBJ_CHUNK_MAX_SIZE || pos == size) {
+            ranges.push_back({chunkBegin, pos, mix64(chunkHash ^ chunkSize)});
+            chunkBegin = pos;
+            chunkHash = 0;
+        }
+    }
+
+    std::unordered_map<uint64_t, std::shared_ptr<const ObjChunk>> previous;
+    for (const auto &chunk: m_chunks)
+        previous[chunk->hash] = chunk;
+
+    std::vector<std::shared_ptr<const ObjChunk>> chunks(ranges.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < ranges.size(); i++) {
+        auto it = previous.find(ranges[i].hash);
+        if (it != previous.end() && it->second->size == ranges[i].end - ranges[i].begin)
+            chunks[i] = it->second;
+        else
+            pending.push_back(i);
+    }
+
+    std::vector<std::shared_ptr<ObjChunk>> parsed(pending.size());
+    parallelFor(0, pending.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            const ChunkRange &range = ranges[pending[k]];
+            std::shared_ptr<ObjChunk> chunk = std::make_shared<ObjChunk>();
+            chunk->hash = range.hash;
+            chunk->size = range.end - range.begin;
+            parseChunk(data + range.begin, data + range.end, *chunk);
+            parsed[k] = chunk;
+        }
+    });
+    for (size_t k = 0; k < pending.size(); k++)
+        chunks[pending[k]] = parsed[k];
+
+    m_chunks.swap(chunks);
+    m_reparsed = pending.size();
+}
+
+/**
+ * @brief Concatenates the chunks into vertex and index arrays.
+ *
+ * Vertices get zero UVs and normals. Relative indices are resolved and
+ * triangles referencing missing vertices are dropped with a warning.
+ *
+ * @param vertices Output vertices.
+ * @param indices Output triangle indices.
+ */
+void ObjParser::assemble(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) const {
+    std::vector<size_t> vertexOffsets(m_chunks.size() + 1, 0);
+    std::vector<size_t> indexOffsets(m_chunks.size() + 1, 0);
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        vertexOffsets[i + 1] = vertexOffsets[i] + m_chunks[i]->positions.size();
+        indexOffsets[i + 1] = indexOffsets[i] + m_chunks[i]->triangles.size();
+    }
+    const size_t vertexCount = vertexOffsets.back();
+
+    vertices.resize(vertexCount);
+    indices.resize(indexOffsets.back());
+    std::vector<unsigned char> invalid(indexOffsets.back() / 3, 0);
+
+    parallelFor(0, m_chunks.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; c++) {
+            const ObjChunk &chunk = *m_chunks[c];
+            Vertex *v = vertices.data() + vertexOffsets[c];
+            for (size_t i = 0; i < chunk.positions.size(); i++) {
+                v[i].position = chunk.positions[i];
+                v[i].uv = {0.0f, 0.0f};
+                v[i].normal = {0.0f, 0.0f, 0.0f};
+            }
+
+            unsigned int *out = indices.data() + indexOffsets[c];
+            for (size_t i = 0; i < chunk.triangles.size(); i++) {
+                const int64_t raw = chunk.triangles[i];
+                const int64_t index = raw >= 0 ? raw
+                                               : static_cast<int64_t>(vertexOffsets[c]) + raw + OBJ_RELATIVE_INDEX_BIAS;
+                if (index < 0 || static_cast<size_t>(index) >= vertexCount) {
+                    invalid[(indexOffsets[c] + i) / 3] = 1;
+                    out[i] = 0;
+                } else {
+                    out[i] = static_cast<unsigned int>(index);
+                }
+            }
+        }
+    });
+
+    size_t kept = 0;
+    for (size_t t = 0; t < invalid.size(); t++) {
+        if (invalid[t])
+            continue;
+        if (kept != t)
+            memmove(&indices[kept * 3], &indices[t * 3], 3 * sizeof(unsigned int));
+        kept++;
+    }
+    if (kept != invalid.size()) {
+        fprintf(stderr, "Dropped %zu faces referencing missing vertices\n", invalid.size() - kept);
+        indices.resize(kept * 3);
+    }
+}
+
+size_t ObjParser::getChunkCount() const {
+    return m_chunks.size();
+}
+
+size_t ObjParser::getReparsedChunkCount() const {
+    return m_reparsed;
+}
+
+/**
+ * @brief Parses the `v` and `f` lines of one chunk.
+ *
+ * For faces, only the position index of each `v/vt/vn` token is used.
+ * Triangles are kept as-is and quads are split into two triangles; other
+ * polygons are ignored, as are faces with a zero index.
+ *
+ * @param begin First byte of the chunk.
+ * @param end One past the last byte of the chunk.
+ * @param chunk Output chunk.
+ */
+void ObjParser::parseChunk(const char *begin, const char *end, ObjChunk &chunk) {
+    const char *p = begin;
+    while (p < end) {
+        const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *lineEnd = newline ? newline : end;
+
+        while (p < lineEnd && isSpace(*p))
+            p++;
+
+        if (lineEnd - p >= 2 && p[0] == 'v' && isSpace(p[1])) {
+            std::array<float, 3> position = {0.0f, 0.0f, 0.0f};
+            p += 2;
+            for (int k = 0; k < 3; k++) {
+                while (p < lineEnd && isSpace(*p))
+                    p++;
+                if (!parseFloat(p, lineEnd, position[k]))
+                    break;
+            }
+            chunk.positions.push_back(position);
+        } else if (lineEnd - p >= 2 && p[0] == 'f' && isSpace(p[1])) {
+            int64_t face[4];
+            int count = 0;
+            bool valid = true;
+            p += 2;
+            while (true) {
+                while (p < lineEnd && isSpace(*p))
+                    p++;
+                int64_t index;
+                if (!parseInt(p, lineEnd, index))
+                    break;
+                while (p < lineEnd && !isSpace(*p))
+                    p++;
+
+                if (index == 0)
+                    valid = false;
+                else if (index < 0)
+                    index = static_cast<int64_t>(chunk.positions.size()) + index - OBJ_RELATIVE_INDEX_BIAS;
+                else
+                    index -= 1;
+
+                if (count < 4)
+                    face[count] = index;
+                count++;
+            }
+
+            if (valid && count == 3) {
+                chunk.triangles.insert(chunk.triangles.end(), face, face + 3);
+            } else if (valid && count == 4) {
+                const int64_t quad[6] = {face[0], face[1], face[2], face[0], face[2], face[3]};
+                chunk.triangles.insert(chunk.triangles.end(), quad, quad + 6);
+            }
+        }
+        p = newline ? newline + 1 : end;
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file ObjParser.hpp
+ * @author Patryk
+ * @brief ObjParser class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_OBJPARSER_HPP
+#define SCOP_OBJPARSER_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Vertex.hpp"
+
+#define OBJ_CHUNK_MIN_SIZE (256 * 1024)
+#define OBJ_CHUNK_MAX_SIZE (4 * 1024 * 1024)
+#define OBJ_CHUNK_BOUNDARY_MASK 0x3FFFu
+#define OBJ_RELATIVE_INDEX_BIAS (1ll << 40)
+
+/**
+ * @brief Parsed content of one chunk of an .obj file.
+ *
+ * Positive face indices are stored as absolute 0-based indices. Negative
+ * (relative) indices are resolved against the chunk start and stored minus
+ * OBJ_RELATIVE_INDEX_BIAS, so a chunk can be reused wherever it ends up in
+ * the file.
+ */
+struct ObjChunk {
+    uint64_t hash = 0;
+    size_t size = 0;
+    std::vector<std::array<float, 3>> positions;
+    std::vector<int64_t> triangles;
+};
+
+/**
+ * @brief Chunked .obj parser with a content-hash index of the previous parse.
+ *
+ * The file is split into chunks at content-defined line boundaries, so an
+ * edit only changes the hashes of the chunks it touches. On every call to
+ * `parse()`, chunks whose hash was already seen are reused and only new
+ * chunks are parsed, in parallel.
+ */
+class ObjParser {
+public:
+    ObjParser() = default;
+    ObjParser(const ObjParser &other) = delete;
+    ~ObjParser() = default;
+
+    ObjParser &operator=(const ObjParser &other) = delete;
+
+    void parse(const char *data, size_t size);
+    void assemble(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) const;
+
+    size_t getChunkCount() const;
+    size_t getReparsedChunkCount() const;
+
+private:
+    std::vector<std::shared_ptr<const ObjChunk>> m_chunks;
+    size_t m_reparsed = 0;
+
+    static void parseChunk(const char *begin, const char *end, ObjChunk &chunk);
+};
+
+bool parseFloat(const char *&p, const char *end, float &value);
+
+#endif //SCOP_OBJPARSER_HPP
@@ -9,53 +9,160 @@
  *
  */
 
+#include <chrono>
+#include <cstring>
+
 #include "./Object.hpp"
 #include "../textures/Material.hpp"
+#include "../io/Asset.hpp"
+#include "../utils/Parallel.hpp"
+
+float Object::s_weldTolerance = WELD_DEFAULT_TOLERANCE;
+bool Object::s_cleanup = true;
+size_t Object::s_occlusionRays = 0;
+bool Object::s_vertexPulling = false;
+bool Object::s_gpuCompute = false;
+std::unique_ptr<MeshCompute> Object::s_meshCompute = nullptr;
+size_t Object::s_revisions = 0;
 
 /**
  * @brief Creates and initializes an Object from a .obj file.
  *
+ * Loads the object on the CPU with `load()` and uploads it to the GPU
+ * with `upload()`. Requires a current OpenGL context.
+ *
+ * @param objFilePath Path to the .obj file to load.
+ * @param keepParseCache Keep the parsed chunks of the file so `reload()` can reuse them.
+ * @return std::unique_ptr<Object> Returns a unique pointer to the fully initialized Object on success, or `nullptr` if the file could not be parsed.
+ */
+std::unique_ptr<Object> Object::create(const std::string &objFilePath, bool keepParseCache) {
+    std::unique_ptr<Object> obj = load(objFilePath, keepParseCache);
+    if (!obj)
+        return nullptr;
+
+    obj->upload();
+    return obj;
+}
+
+static bool hasExtension(const std::string &path, const std::string &extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Points attributes 0-2 (position, uv, normal) of the bound VAO at the bound Vertex buffer.
+ * @param offset Byte offset of the first vertex in the buffer.
+ */
+static void setVertexAttributes(size_t offset = 0) {
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(offset + offsetof(Vertex, position)));
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(offset + offsetof(Vertex, uv)));
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(offset + offsetof(Vertex, normal)));
+}
+
+/**
+ * @brief Loads an Object from a .obj, .ply, .stl, .smesh or .glb file without touching OpenGL.
+ *
  * This static function performs the following steps:
  * 1. Allocates a new Object instance on the heap.
- * 2. Parses the specified .obj file using `parseFile()`. Returns `nullptr` if parsing fails.
- * 3. Initializes OpenGL buffers (VAO/VBO/IBO) via `initBuffers()`.
- * 4. Calculates the geometric center of the object and its scale factor.
- * 5. Sets the object's transformation matrices (`m_matrix`, `m_translationMatrix`, `m_rotationMatrix`) to identity.
+ * 2. Loads a .glb file with `loadGltf()`, or any other model with `Mesh::load()` using `getMeshSettings()`. Returns `nullptr` if loading fails.
+ * 3. Calculates the geometric center of the object and its scale factor.
+ * 4. Sets the object's transformation matrices (`m_matrix`, `m_translationMatrix`, `m_rotationMatrix`) to identity.
+ * 5. For .obj, .ply, .stl and .smesh files, loads the material from the .mtl file next to the object and creates a single sub-mesh, drawn as points if the file has no faces.
+ * 6. Bakes per-vertex ambient occlusion if enabled with `setAmbientOcclusionRays()`.
+ *
+ * Since no GL calls are made, this function is safe to call from worker
+ * threads. The returned object must be passed to `upload()` on the thread
+ * owning the GL context before it can be drawn.
  *
  * @param objFilePath Path to the .obj file to load.
- * @return std::unique_ptr<Object> Returns a unique pointer to the fully initialized Object on success, or `nullptr` if the file could not be parsed.
+ * @param keepParseCache Keep the parsed chunks of the file so `reload()` can reuse them.
+ * @return std::unique_ptr<Object> CPU-side object, or `nullptr` if the file could not be parsed.
  */
-std::unique_ptr<Object> Object::create(const std::string &objFilePath) {
+std::unique_ptr<Object> Object::load(const std::string &objFilePath, bool keepParseCache) {
     std::unique_ptr<Object> obj(new Object());
+    obj->m_filePath = objFilePath;
+    obj->m_matrix = getIdentityMat4();
+    obj->m_translationMatrix = getIdentityMat4();
+    obj->m_rotationMatrix = getIdentityMat4();
+
+    if (hasExtension(objFilePath, ".glb")) {
+        if (obj->loadGltf(objFilePath)) {
+            fprintf(stderr, "Failed to load object: %s\n", objFilePath.c_str());
+            return nullptr;
+        }
+        return obj;
+    }
 
-    if (obj->parseFile(objFilePath)) {
+    const bool objFormat = !hasExtension(objFilePath, ".ply") && !hasExtension(objFilePath, ".stl") &&
+                           !hasExtension(objFilePath, MESH_CODEC_EXTENSION);
+    if (keepParseCache && objFormat)
+        obj->m_parser = std::unique_ptr<ObjParser>(new ObjParser());
+    // Live reload patches the buffers from the CPU copy and the bake needs normals, so both stay on the CPU
+    obj->m_gpuBounds = s_gpuCompute && !obj->m_parser && s_occlusionRays == 0;
+
+    MeshSettings settings = getMeshSettings();
+    settings.normals = !obj->m_gpuBounds;
+    std::unique_ptr<Mesh> mesh = Mesh::load(objFilePath, settings, obj->m_parser.get());
+    if (!mesh) {
         fprintf(stderr, "Failed to load object: %s\n", objFilePath.c_str());
         return nullptr;
     }
+    obj->setMesh(*mesh);
 
-    obj->initBuffers();
-
-    obj->m_center = obj->calculateCenter();
-    obj->m_scaleFactor = 1.0f / obj->calculateScale();
+    if (obj->m_gpuBounds) {
+        obj->m_center = {0.0f, 0.0f, 0.0f};
+        obj->m_scaleFactor = 1.0f;
+    } else {
+        obj->computeBounds();
+    }
 
-    obj->m_matrix = getIdentityMat4();
-    obj->m_translationMatrix = getIdentityMat4();
-    obj->m_rotationMatrix = getIdentityMat4();
+    obj->m_materials.push_back(Material::create(objFilePath.substr(0, objFilePath.rfind('.')) + ".mtl"));
 
-    obj->m_material = Material::create(objFilePath.substr(0, objFilePath.rfind('.')) + ".mtl");
+    SubMesh subMesh;
+    subMesh.count = obj->m_indices.size();
+    subMesh.transform = getIdentityMat4();
+    if (obj->m_indices.empty()) {
+        // Point cloud
+        subMesh.mode = GL_POINTS;
+        subMesh.indexed = false;
+        subMesh.count = obj->m_vertices.size();
+    }
+    obj->m_subMeshes.push_back(subMesh);
+    if (s_occlusionRays > 0 && !obj->m_indices.empty())
+        obj->bakeOcclusion();
     return obj;
 }
 
 Object::Object(Object &&other) noexcept : m_vertices(std::move(other.m_vertices)),
                                           m_indices(std::move(other.m_indices)),
+                                          m_colors(std::move(other.m_colors)),
+                                          m_occlusion(std::move(other.m_occlusion)),
                                           m_center(other.m_center),
+                                          m_filePath(std::move(other.m_filePath)),
+                                          m_parser(std::move(other.m_parser)),
                                           m_translationMatrix(other.m_translationMatrix),
                                           m_rotationMatrix(other.m_rotationMatrix),
                                           m_matrix(other.m_matrix),
+                                          m_texture2D(std::move(other.m_texture2D)),
                                           m_scaleFactor(other.m_scaleFactor),
-                                          m_VAO(std::move(other.m_VAO)),
-                                          m_VBO(std::move(other.m_VBO)),
-                                          m_IBO(std::move(other.m_IBO)) {
+                                          m_subMeshes(std::move(other.m_subMeshes)),
+                                          m_VAOs(std::move(other.m_VAOs)),
+                                          m_VBOs(std::move(other.m_VBOs)),
+                                          m_IBOs(std::move(other.m_IBOs)),
+                                          m_SSBOs(std::move(other.m_SSBOs)),
+                                          m_materials(std::move(other.m_materials)),
+                                          m_textures(std::move(other.m_textures)),
+                                          m_gltf(std::move(other.m_gltf)),
+                                          m_gpuBounds(other.m_gpuBounds),
+                                          m_gpuNormals(other.m_gpuNormals),
+                                          m_stream(std::move(other.m_stream)),
+                                          m_revision(other.m_revision),
+                                          m_chunkCounts(std::move(other.m_chunkCounts)),
+                                          m_chunkUsed(std::move(other.m_chunkUsed)) {
 }
 
 Object &Object::operator=(Object &&other) noexcept {
@@ -63,29 +170,418 @@ Object &Object::operator=(Object &&other) noexcept {
         return *this;
     m_vertices = std::move(other.m_vertices);
     m_indices = std::move(other.m_indices);
+    m_colors = std::move(other.m_colors);
+    m_occlusion = std::move(other.m_occlusion);
     m_center = other.m_center;
+    m_filePath = std::move(other.m_filePath);
+    m_parser = std::move(other.m_parser);
     m_matrix = other.m_matrix;
     m_rotationMatrix = other.m_rotationMatrix;
     m_translationMatrix = other.m_translationMatrix;
+    m_texture2D = std::move(other.m_texture2D);
     m_scaleFactor = other.m_scaleFactor;
-    m_VAO = std::move(other.m_VAO);
-    m_VBO = std::move(other.m_VBO);
-    m_IBO = std::move(other.m_IBO);
+    m_subMeshes = std::move(other.m_subMeshes);
+    m_VAOs = std::move(other.m_VAOs);
+    m_VBOs = std::move(other.m_VBOs);
+    m_IBOs = std::move(other.m_IBOs);
+    m_SSBOs = std::move(other.m_SSBOs);
+    m_materials = std::move(other.m_materials);
+    m_textures = std::move(other.m_textures);
+    m_gltf = std::move(other.m_gltf);
+    m_gpuBounds = other.m_gpuBounds;
+    m_gpuNormals = other.m_gpuNormals;
+    m_stream = std::move(other.m_stream);
+    m_revision = other.m_revision;
+    m_chunkCounts = std::move(other.m_chunkCounts);
+    m_chunkUsed = std::move(other.m_chunkUsed);
     return *this;
 }
 
 /**
- * @brief Binds the object's Vertex Array Object (VAO) for rendering.
+ * @brief Uploads the object's geometry to the GPU.
+ *
+ * Creates the VAOs/VBOs/IBOs via `initBuffers()` or `initGltfBuffers()`,
+ * plus the storage buffers of `initStorageBuffers()` when vertex pulling is enabled.
+ * Normals and bounds left to the GPU by `load()` are computed here, see `computeOnGpu()`.
+ * Does nothing if the object is already uploaded. Must be called on the
+ * thread owning the GL context.
+ */
+void Object::upload() {
+    if (!m_VAOs.empty())
+        return;
+    if (m_gltf) {
+        initGltfBuffers();
+    } else {
+        initBuffers();
+        if (m_gpuBounds)
+            computeOnGpu();
+    }
+    m_revision = ++s_revisions;
+}
+
+/**
+ * @brief Re-reads the object's .obj file after it changed on disk.
+ *
+ * Only the chunks of the file whose content changed are parsed again (see
+ * ObjParser). If the vertex and index counts are unchanged, only the
+ * modified ranges of the GPU buffers are rewritten; otherwise the buffers
+ * are recreated. The previous geometry is kept if the new file cannot be
+ * parsed. Requires the object to be loaded with `keepParseCache`.
+ *
+ * @return bool true if the geometry was replaced.
+ */
+bool Object::reload() {
+    if (!m_parser)
+        return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<Vertex> oldVertices;
+    std::vector<unsigned int> oldIndices;
+    oldVertices.swap(m_vertices);
+    oldIndices.swap(m_indices);
+
+    std::unique_ptr<Mesh> mesh = Mesh::load(m_filePath, getMeshSettings(), m_parser.get());
+    if (!mesh) {
+        fprintf(stderr, "Failed to reload object: %s\n", m_filePath.c_str());
+        m_vertices.swap(oldVertices);
+        m_indices.swap(oldIndices);
+        return false;
+    }
+    setMesh(*mesh);
+    computeBounds();
+    m_subMeshes[0].count = m_indices.size();
+    if (!m_occlusion.empty())
+        bakeOcclusion();
+
+    // Baked occlusion changes everywhere with the geometry, and packed vertices are not
+    // patched in place, so their buffers are recreated
+    const char *update = "not uploaded";
+    if (isUploaded() && m_vertices.size() == oldVertices.size() && m_indices.size() == oldIndices.size() &&
+        m_occlusion.empty() && m_SSBOs.empty()) {
+        patchBuffers(oldVertices, oldIndices);
+        update = "patched buffers";
+    } else if (isUploaded()) {
+        initBuffers();
+        update = "recreated buffers";
+    }
+    m_revision = ++s_revisions;
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Reloaded %s in %.1f ms: %zu of %zu chunks re-parsed, %s\n", m_filePath.c_str(), elapsed.count(),
+           m_parser->getReparsedChunkCount(), m_parser->getChunkCount(), update);
+    return true;
+}
+
+/**
+ * @brief Loads only the geometry of an .obj, .ply, .stl or .smesh file, without material, occlusion or GL calls.
+ *
+ * Used for the frames of an animation, which share the material of the
+ * first frame. Goes through `Mesh::load()` with the same settings as
+ * `load()`, normals computed on the CPU. Safe to call from worker threads.
+ *
+ * @param filePath Path to the model file.
+ * @param vertices Receives the vertices.
+ * @param indices Receives the triangle list, empty for a point cloud.
+ * @return bool true on success.
+ */
+bool Object::loadGeometry(const std::string &filePath, std::vector<Vertex> &vertices,
+                          std::vector<unsigned int> &indices) {
+    std::unique_ptr<Mesh> mesh = Mesh::load(filePath, getMeshSettings());
+    if (!mesh)
+        return false;
+    vertices.swap(mesh->vertices);
+    indices.swap(mesh->indices);
+    return true;
+}
+
+/**
+ * @brief Replaces the geometry of an uploaded object with the next frame of an animation.
+ *
+ * The new vertices and indices are swapped in, so the caller gets the
+ * previous ones back and can reuse their memory. Each frame is written into
+ * the next region of a RingBuffer (see `initStreamBuffers()`) and the VAO
+ * is pointed at it, so uploading a frame only waits for the GPU when it is
+ * RING_BUFFER_REGIONS frames behind. The region of the previous frame is
+ * fenced here, as its draws have been issued by now. The vertex and index
+ * counts may change from one frame to the next; the ring is recreated when
+ * a frame outgrows it. The center and scale of the first frame are kept so
+ * the animation does not jump around; vertex colors, baked occlusion and
+ * storage buffers are dropped, as they would not match the new geometry.
+ *
+ * @param vertices Vertices of the new frame, receives the previous ones.
+ * @param indices Triangle list of the new frame (empty for points), receives the previous one.
+ */
+void Object::streamGeometry(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+    if (m_gltf || !isUploaded() || vertices.empty())
+        return;
+    m_vertices.swap(vertices);
+    m_indices.swap(indices);
+    m_colors.clear();
+    m_occlusion.clear();
+
+    const size_t vertexBytes = m_vertices.size() * sizeof(Vertex);
+    const size_t indexBytes = m_indices.size() * sizeof(unsigned int);
+    const size_t frameSize = vertexBytes + indexBytes + RING_BUFFER_ALIGNMENT;
+    if (!m_stream || m_stream->getRegionSize() < frameSize)
+        initStreamBuffers(frameSize);
+    else
+        m_stream->endFrame();
+    if (!m_stream)
+        return;
+
+    m_stream->beginFrame();
+    size_t vertexOffset = 0, indexOffset = 0;
+    void *destination = m_stream->allocate(vertexBytes, vertexOffset);
+    if (destination)
+        memcpy(destination, m_vertices.data(), vertexBytes);
+    m_stream->unmap();
+    if (indexBytes > 0) {
+        destination = m_stream->allocate(indexBytes, indexOffset);
+        if (destination)
+            memcpy(destination, m_indices.data(), indexBytes);
+        m_stream->unmap();
+    }
+
+    m_VAOs[0]->bind();
+    glBindBuffer(GL_ARRAY_BUFFER, m_stream->getId());
+    setVertexAttributes(vertexOffset);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_stream->getId());
+    m_VAOs[0]->unbind();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    SubMesh &subMesh = m_subMeshes[0];
+    subMesh.indexed = !m_indices.empty();
+    subMesh.mode = subMesh.indexed ? GL_TRIANGLES : GL_POINTS;
+    subMesh.count = subMesh.indexed ? m_indices.size() : m_vertices.size();
+    subMesh.indexOffset = indexOffset;
+    m_revision = ++s_revisions;
+}
+
+/**
+ * @brief Creates an Object showing the base level of a progressive mesh, see `buildProgressiveMesh()`.
+ *
+ * The GPU buffers are allocated for the full resolution mesh up front, so
+ * `refineGeometry()` only writes into them. The center and scale come from
+ * the bounds of the full mesh, so the object keeps its place and size as
+ * detail arrives. The material is loaded as in `load()`; vertex colors and
+ * ambient occlusion are not supported. Requires a current OpenGL context.
+ *
+ * @param filePath Path of the model, used to find its .mtl file.
+ * @param base Base level, emptied by the call.
+ * @param bounds Bounds of the full mesh.
+ * @param vertexCount Vertex count of the full mesh.
+ * @param indexCount Index count of the full mesh.
+ * @return std::unique_ptr<Object> Uploaded object, or `nullptr` if the base level has no triangles.
  */
-void Object::bind() const {
-    m_VAO.bind();
+std::unique_ptr<Object> Object::createProgressive(const std::string &filePath, ProgressiveLevel &base,
+                                                  const MeshBounds &bounds, size_t vertexCount, size_t indexCount) {
+    if (base.vertices.empty() || base.indices.empty()) {
+        fprintf(stderr, "Progressive mesh of %s has an empty base\n", filePath.c_str());
+        return nullptr;
+    }
+    std::unique_ptr<Object> obj(new Object());
+    obj->m_filePath = filePath;
+    obj->m_matrix = getIdentityMat4();
+    obj->m_translationMatrix = getIdentityMat4();
+    obj->m_rotationMatrix = getIdentityMat4();
+    obj->m_vertices.swap(base.vertices);
+    obj->m_indices.swap(base.indices);
+    obj->m_vertices.reserve(vertexCount);
+    obj->m_indices.reserve(indexCount);
+    obj->setBounds(bounds);
+    obj->m_materials.push_back(Material::create(filePath.substr(0, filePath.rfind('.')) + ".mtl"));
+
+    SubMesh subMesh;
+    subMesh.count = obj->m_indices.size();
+    subMesh.transform = getIdentityMat4();
+    obj->m_subMeshes.push_back(subMesh);
+
+    const size_t vertexBytes = std::max(vertexCount, obj->m_vertices.size()) * sizeof(Vertex);
+    const size_t indexBytes = std::max(indexCount, obj->m_indices.size()) * sizeof(unsigned int);
+    obj->m_VAOs.emplace_back(new VertexArray());
+    obj->m_VAOs[0]->bind();
+    obj->m_VBOs.emplace_back(new VertexBuffer(static_cast<const void *>(nullptr), vertexBytes, GL_DYNAMIC_DRAW));
+    obj->m_VBOs[0]->update(0, obj->m_vertices.data(), obj->m_vertices.size() * sizeof(Vertex));
+    obj->m_IBOs.emplace_back(new IndexBuffer(static_cast<const void *>(nullptr), indexBytes, GL_DYNAMIC_DRAW));
+    obj->m_IBOs[0]->update(0, obj->m_indices.data(), obj->m_indices.size() * sizeof(unsigned int));
+    setVertexAttributes();
+    obj->m_VAOs[0]->unbind();
+    obj->m_VBOs[0]->unbind();
+    obj->m_IBOs[0]->unbind();
+    if (s_vertexPulling)
+        obj->initStorageBuffers();
+    obj->m_revision = ++s_revisions;
+    return obj;
+}
+
+/**
+ * @brief Applies one refinement level of a progressive mesh to an object from `createProgressive()`.
+ *
+ * The new vertices and triangles are written after the current ones and
+ * the corners moved by the level are rewritten in place, coalesced like
+ * `patchBuffers()` does, so nothing already on the GPU is uploaded again.
+ * Storage buffers of vertex pulling hold packed vertices and are recreated.
+ *
+ * @param level Next level of the progressive mesh.
+ */
+void Object::refineGeometry(const ProgressiveLevel &level) {
+    if (m_gltf || m_stream || !isUploaded())
+        return;
+    const size_t firstVertex = m_vertices.size();
+    const size_t firstIndex = m_indices.size();
+    DirtyRanges moved;
+    for (const ProgressiveUpdate &update: level.updates) {
+        if (update.position >= firstIndex)
+            continue;
+        m_indices[update.position] = update.index;
+        moved.mark(update.position * sizeof(unsigned int), sizeof(unsigned int));
+    }
+    m_vertices.insert(m_vertices.end(), level.vertices.begin(), level.vertices.end());
+    m_indices.insert(m_indices.end(), level.indices.begin(), level.indices.end());
+    m_subMeshes[0].count = m_indices.size();
+    m_revision = ++s_revisions;
+
+    if (m_vertices.size() * sizeof(Vertex) > m_VBOs[0]->getSize() ||
+        m_indices.size() * sizeof(unsigned int) > m_IBOs[0]->getSize()) {
+        initBuffers();
+        return;
+    }
+    if (!level.vertices.empty())
+        m_VBOs[0]->update(firstVertex * sizeof(Vertex), &m_vertices[firstVertex], level.vertices.size() * sizeof(Vertex));
+    m_VBOs[0]->unbind();
+
+    m_VAOs[0]->bind();
+    m_IBOs[0]->updateRanges(m_indices.data(), moved.take(OBJECT_PATCH_GAP * sizeof(unsigned int)),
+                            OBJECT_PATCH_GAP * sizeof(unsigned int));
+    if (!level.indices.empty())
+        m_IBOs[0]->update(firstIndex * sizeof(unsigned int), &m_indices[firstIndex],
+                          level.indices.size() * sizeof(unsigned int));
+    m_VAOs[0]->unbind();
+    if (!m_SSBOs.empty())
+        initStorageBuffers();
+}
+
+/**
+ * @brief Creates an Object without geometry, whose chunks are added and removed by a ChunkStreamer.
+ *
+ * The center and scale come from the bounds of the whole mesh. The
+ * material is loaded as in `load()`. The CPU copy of the geometry stays
+ * empty: chunks only live on the GPU, each with its own VAO, VBO and IBO
+ * in a slot of `addChunk()`, and the sub-meshes are the chunks chosen by
+ * `setDrawnChunks()`.
+ *
+ * @param filePath Path of the model, used to find its .mtl file.
+ * @param bounds Bounds of the whole mesh.
+ * @return std::unique_ptr<Object> Object drawing no chunk yet.
+ */
+std::unique_ptr<Object> Object::createChunked(const std::string &filePath, const MeshBounds &bounds) {
+    std::unique_ptr<Object> obj(new Object());
+    obj->m_filePath = filePath;
+    obj->m_matrix = getIdentityMat4();
+    obj->m_translationMatrix = getIdentityMat4();
+    obj->m_rotationMatrix = getIdentityMat4();
+    obj->setBounds(bounds);
+    obj->m_materials.push_back(Material::create(filePath.substr(0, filePath.rfind('.')) + ".mtl"));
+    obj->m_revision = ++s_revisions;
+    return obj;
+}
+
+/**
+ * @brief Uploads one chunk of a chunked object into a free slot.
+ * @param vertices Vertices of the chunk.
+ * @param indices Triangle list of the chunk.
+ * @return size_t Slot of the chunk, for `removeChunk()` and `setDrawnChunks()`.
+ */
+size_t Object::addChunk(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+    size_t slot = 0;
+    while (slot < m_chunkUsed.size() && m_chunkUsed[slot])
+        slot++;
+    if (slot == m_chunkUsed.size()) {
+        m_chunkCounts.push_back(0);
+        m_chunkUsed.push_back(false);
+        m_VAOs.emplace_back();
+        m_VBOs.emplace_back();
+        m_IBOs.emplace_back();
+    }
+    m_VAOs[slot].reset(new VertexArray());
+    m_VAOs[slot]->bind();
+    m_VBOs[slot].reset(new VertexBuffer(vertices));
+    m_IBOs[slot].reset(new IndexBuffer(indices));
+    setVertexAttributes();
+    m_VAOs[slot]->unbind();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    m_chunkCounts[slot] = indices.size();
+    m_chunkUsed[slot] = true;
+    return slot;
+}
+
+/**
+ * @brief Frees the GPU buffers of a chunk. The slot must not be drawn anymore.
+ * @param slot Slot returned by `addChunk()`.
+ */
+void Object::removeChunk(size_t slot) {
+    if (slot >= m_chunkUsed.size() || !m_chunkUsed[slot])
+        return;
+    m_VAOs[slot].reset();
+    m_VBOs[slot].reset();
+    m_IBOs[slot].reset();
+    m_chunkCounts[slot] = 0;
+    m_chunkUsed[slot] = false;
+}
+
+/**
+ * @brief Replaces the sub-meshes with one per chunk to draw.
+ * @param slots Slots of uploaded chunks.
+ */
+void Object::setDrawnChunks(const std::vector<size_t> &slots) {
+    m_subMeshes.clear();
+    for (size_t slot: slots) {
+        if (slot >= m_chunkUsed.size() || !m_chunkUsed[slot] || m_chunkCounts[slot] == 0)
+            continue;
+        SubMesh subMesh;
+        subMesh.vertexArray = slot;
+        subMesh.count = m_chunkCounts[slot];
+        subMesh.transform = getIdentityMat4();
+        m_subMeshes.push_back(subMesh);
+    }
+}
+
+/**
+ * @brief Binds the Vertex Array Object (VAO) of a sub-mesh for rendering.
+ * @param subMesh Index of the sub-mesh.
+ */
+void Object::bind(size_t subMesh) const {
+    m_VAOs[m_subMeshes[subMesh].vertexArray]->bind();
 }
 
 /**
  * @brief Unbinds the object's Vertex Array Object (VAO).
  */
 void Object::unbind() const {
-    m_VAO.unbind();
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Binds the storage buffers read by vertex_pulling.glsl to their binding points.
+ *
+ * Buffers the object does not have (colors, occlusion) are left unbound;
+ * the shader does not read them then.
+ */
+void Object::bindStorage() const {
+    for (unsigned int binding = 0; binding < m_SSBOs.size(); binding++) {
+        if (m_SSBOs[binding])
+            m_SSBOs[binding]->bind(binding);
+    }
+}
+
+/**
+ * @brief Clears the binding points set by `bindStorage()`.
+ */
+void Object::unbindStorage() const {
+    for (unsigned int binding = 0; binding < m_SSBOs.size(); binding++) {
+        if (m_SSBOs[binding])
+            m_SSBOs[binding]->unbind(binding);
+    }
 }
 
 /**
@@ -142,18 +638,30 @@ void Object::moveZaxis(const float direction, const double deltaTime) {
     m_translationMatrix[14] += MOVE_SPEED * direction * deltaTime;
 }
 
-const VertexArray &Object::getVAO() const {
-    return m_VAO;
-}
-
 std::array<float, 3> Object::getCenter() const {
     return m_center;
 }
 
-std::vector<unsigned int> Object::getIndices() const {
+const std::vector<SubMesh> &Object::getSubMeshes() const {
+    return m_subMeshes;
+}
+
+const std::vector<Vertex> &Object::getVertices() const {
+    return m_vertices;
+}
+
+const std::vector<unsigned int> &Object::getIndices() const {
     return m_indices;
 }
 
+const std::vector<std::array<unsigned char, 4>> &Object::getVertexColors() const {
+    return m_colors;
+}
+
+const std::vector<unsigned char> &Object::getAmbientOcclusion() const {
+    return m_occlusion;
+}
+
 /**
  * @brief Computes and returns the object's model transformation matrix.
  *
@@ -179,8 +687,54 @@ const std::array<float, 3> Object::getPosition() const {
     return { m_translationMatrix[12], m_translationMatrix[13], m_translationMatrix[14] };
 }
 
-const std::unique_ptr<Material> &Object::getMaterial() {
-    return m_material;
+const std::unique_ptr<Material> &Object::getMaterial(size_t index) {
+    return m_materials[index];
+}
+
+const std::shared_ptr<Texture2D> &Object::getTexture(size_t index) const {
+    return m_textures[index];
+}
+
+/**
+ * @brief Estimates the CPU memory held by the object's geometry.
+ * @return size_t Size of the vertex, index and color arrays, plus the glTF data not yet uploaded, in bytes.
+ */
+size_t Object::getMemoryUsage() const {
+    return m_vertices.size() * sizeof(Vertex) + m_indices.size() * sizeof(unsigned int) +
+           m_colors.size() * sizeof(m_colors[0]) + m_occlusion.size() + (m_gltf ? m_gltf->getMemoryUsage() : 0);
+}
+
+bool Object::isUploaded() const {
+    return !m_VAOs.empty();
+}
+
+bool Object::hasVertexColors() const {
+    return !m_colors.empty();
+}
+
+bool Object::hasAmbientOcclusion() const {
+    return !m_occlusion.empty();
+}
+
+bool Object::hasStorageBuffers() const {
+    return !m_SSBOs.empty();
+}
+
+/**
+ * @brief Returns the ring buffer frames are streamed through, `nullptr` until `streamGeometry()` is called.
+ */
+const RingBuffer *Object::getStreamBuffer() const {
+    return m_stream.get();
+}
+
+/**
+ * @brief Number identifying the geometry on the GPU, changed by every upload, reload and streamed frame.
+ *
+ * Unique across objects, so caches of derived data such as impostors can
+ * tell when they are stale even if another object took this one's place.
+ */
+size_t Object::getRevision() const {
+    return m_revision;
 }
 
 void Object::setTexture2D(const std::shared_ptr<Texture2D> &texture) {
@@ -188,238 +742,409 @@ void Object::setTexture2D(const std::shared_ptr<Texture2D> &texture) {
 }
 
 /**
- * @brief Loads vertex and face data from an .obj file.
+ * @brief Sets the distance under which the vertices of .obj files and the corners of .stl files are welded.
  *
- * Parses the given .obj file line by line. Vertex positions (`v`) are stored
- * in m_vertices, and faces (`f`) are converted into triangle indices stored
- * in m_indices. Quad faces are automatically split into two triangles.
- * After parsing, texture UV coordinates are calculated using the ZY projection.
+ * Applies to objects loaded afterwards. Must not be called while models are
+ * being loaded on other threads.
  *
- * @param filePath The path to the .obj file to parse.
- * @return int Returns 0 if the file was successfully parsed and contains valid vertices and indices. Returns 1 if the file could not be opened or contains no valid geometry.
+ * @param tolerance Weld distance as a fraction of the model size; 0 merges only identical corners.
  */
-int Object::parseFile(const std::string &filePath) {
-    std::ifstream file(filePath);
-    if (!file) {
-        fprintf(stderr, "Failed to open file %s\n", filePath.c_str());
-        return 1;
-    }
+void Object::setWeldTolerance(float tolerance) {
+    s_weldTolerance = tolerance;
+}
 
-    std::string line;
-    while (getline(file, line)) {
-        if (line.empty() || line[0] == '#')
-            continue;
-        std::istringstream ss(line);
-        std::string prefix;
-        ss >> prefix;
-
-        if (prefix == "v") {
-            float x, y, z;
-            ss >> x >> y >> z;
-
-            Vertex v{};
-            v.position = {x, y, z};
-            v.uv = {0.0f, 0.0f};
-            m_vertices.push_back(v);
-        } else if (prefix == "f") {
-            std::vector<unsigned int> indices;
-            unsigned int index;
-            while (ss >> index)
-                indices.push_back(index - 1);
-
-            if (indices.size() == 3) {
-                m_indices.push_back(indices[0]);
-                m_indices.push_back(indices[1]);
-                m_indices.push_back(indices[2]);
-            } else if (indices.size() == 4) {
-                m_indices.push_back(indices[0]);
-                m_indices.push_back(indices[1]);
-                m_indices.push_back(indices[2]);
-
-                m_indices.push_back(indices[0]);
-                m_indices.push_back(indices[2]);
-                m_indices.push_back(indices[3]);
-            }
-        }
-    }
-    if (m_vertices.empty() || m_indices.empty())
-        return 1;
-    calculateUV_XY();
-    computeNormals();
-    return 0;
+/**
+ * @brief Enables the cleanup of .obj geometry with `cleanupMesh()` when it is parsed.
+ *
+ * Applies to objects loaded afterwards. Must not be called while models are
+ * being loaded on other threads.
+ *
+ * @param enabled false keeps the geometry exactly as written in the file.
+ */
+void Object::setMeshCleanup(bool enabled) {
+    s_cleanup = enabled;
 }
 
 /**
- * @brief Initializes OpenGL buffers for the object.
+ * @brief Enables baking per-vertex ambient occlusion when models are loaded.
  *
- * Creates and binds the Vertex Array Object (VAO), Vertex Buffer Object (VBO),
- * and Index Buffer Object (IBO). Sets up vertex attribute pointers for position
- * and texture coordinates, which are used by shaders during rendering.
- * After initialization, all buffers are unbound.
+ * Applies to objects loaded afterwards. Must not be called while models are
+ * being loaded on other threads.
+ *
+ * @param rays Hemisphere rays per vertex; 0 disables baking.
  */
-void Object::initBuffers() {
-    m_VAO.bind();
+void Object::setAmbientOcclusionRays(size_t rays) {
+    s_occlusionRays = rays;
+}
 
-    m_VBO = std::unique_ptr<VertexBuffer>(new VertexBuffer(m_vertices));
-    m_IBO = std::unique_ptr<IndexBuffer>(new IndexBuffer(m_indices));
+/**
+ * @brief Enables uploading the geometry of .obj, .ply, .stl and .smesh models to storage buffers too.
+ *
+ * The buffers feed vertex_pulling.glsl and require OpenGL 4.3. Applies to
+ * objects uploaded afterwards.
+ *
+ * @param enabled true to create the storage buffers next to the VBOs and IBO.
+ */
+void Object::setVertexPulling(bool enabled) {
+    s_vertexPulling = enabled;
+}
 
-    glEnableVertexAttribArray(0);
-    glEnableVertexAttribArray(1);
-    glEnableVertexAttribArray(2);
+/**
+ * @brief Moves the normals and bounds of .obj, .ply and .stl models from `load()` to compute shaders run by `upload()`.
+ *
+ * Requires OpenGL 4.3 when objects are uploaded. Models loaded for live
+ * reload or with ambient occlusion baking keep the CPU path, as both need
+ * the normals on the CPU. Once computed on the GPU, the normals only live
+ * in the GPU buffers. Applies to objects loaded afterwards. Must not be
+ * called while models are being loaded on other threads.
+ *
+ * @param enabled true to compute normals and bounds on the GPU.
+ */
+void Object::setGpuCompute(bool enabled) {
+    s_gpuCompute = enabled;
+}
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, uv));
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
+/**
+ * @brief Returns the weld tolerance and cleanup setting models are loaded with, for `Mesh::load()`.
+ */
+MeshSettings Object::getMeshSettings() {
+    MeshSettings settings;
+    settings.weldTolerance = s_weldTolerance;
+    settings.cleanup = s_cleanup;
+    return settings;
+}
 
-    m_VAO.unbind();
-    m_VBO->unbind();
-    m_IBO->unbind();
+/**
+ * @brief Takes the geometry of a freshly loaded Mesh.
+ *
+ * Normals the mesh was loaded without are left to `upload()`, see `computeOnGpu()`.
+ *
+ * @param mesh Loaded mesh, emptied by the call.
+ */
+void Object::setMesh(Mesh &mesh) {
+    m_vertices.swap(mesh.vertices);
+    m_indices.swap(mesh.indices);
+    m_colors.swap(mesh.colors);
+    m_gpuNormals = !mesh.hasNormals;
 }
 
 /**
- * @brief Calculates the geometric center of the object.
+ * @brief Loads a binary glTF file.
  *
- * Computes the average position of all vertices to determine the object's
- * center in local coordinates.
+ * The file stays mapped in m_gltf until `upload()`. Each primitive becomes
+ * a sub-mesh with its own VAO; the center and scale come from the bounds of
+ * the whole scene.
  *
- * @return std::array<float, 3> The computed center {x, y, z}.
+ * @param filePath The path to the .glb file.
+ * @return int Returns 0 on success, 1 if the file could not be loaded.
  */
-std::array<float, 3> Object::calculateCenter() const {
-    float sumX = 0, sumY = 0, sumZ = 0;
-    const size_t count = m_vertices.size();
+int Object::loadGltf(const std::string &filePath) {
+    m_gltf = GltfModel::load(filePath);
+    if (!m_gltf)
+        return 1;
 
-    for (const auto &v: m_vertices) {
-        sumX += v.position[0];
-        sumY += v.position[1];
-        sumZ += v.position[2];
+    for (size_t i = 0; i < m_gltf->primitives.size(); i++) {
+        const GltfPrimitive &primitive = m_gltf->primitives[i];
+        SubMesh subMesh;
+        subMesh.vertexArray = i;
+        subMesh.mode = primitive.mode;
+        subMesh.indexed = primitive.indexed;
+        subMesh.indexType = primitive.indexType;
+        subMesh.indexOffset = primitive.indexOffset;
+        subMesh.count = primitive.count;
+        subMesh.material = primitive.material;
+        subMesh.texture = m_gltf->materials[primitive.material].image;
+        subMesh.transform = primitive.transform;
+        m_subMeshes.push_back(subMesh);
     }
+    for (const GltfMaterial &material: m_gltf->materials)
+        m_materials.push_back(Material::create(material.params));
 
-    return { (sumX / count), (sumY / count), (sumZ / count) };
+    const std::array<float, 3> &min = m_gltf->min;
+    const std::array<float, 3> &max = m_gltf->max;
+    m_center = {(min[0] + max[0]) / 2.0f, (min[1] + max[1]) / 2.0f, (min[2] + max[2]) / 2.0f};
+    const float size = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+    m_scaleFactor = size > 0.0f ? 1.0f / size : 1.0f;
+    return 0;
 }
 
 /**
- * @brief Calculates the object's bounding scale.
- *
- * Determines the size of the object's bounding box along each axis and
- * returns the largest dimension. This scale factor can be used to
- * normalize the object size for consistent rendering.
+ * @brief Initializes OpenGL buffers for the object.
  *
- * @return float The maximum dimension of the object (scale factor).
+ * Creates and binds the Vertex Array Object (VAO), Vertex Buffer Object (VBO),
+ * and Index Buffer Object (IBO). Sets up vertex attribute pointers for position
+ * and texture coordinates, which are used by shaders during rendering. Vertex
+ * colors, if any, get a second VBO bound to location 3, and baked ambient
+ * occlusion one bound to location 4.
+ * After initialization, all buffers are unbound.
  */
-float Object::calculateScale() const {
-    if (m_vertices.empty()) return 0.0f;
+void Object::initBuffers() {
+    m_VAOs.clear();
+    m_VBOs.clear();
+    m_IBOs.clear();
+    m_stream.reset();
+    if (!m_subMeshes.empty()) {
+        m_subMeshes[0].vertexArray = 0;
+        m_subMeshes[0].indexOffset = 0;
+    }
 
-    const auto v = m_vertices.data();
-    std::array<float, 3> min = {v->position[0], v->position[1], v->position[2]};
-    std::array<float, 3> max = {v->position[0], v->position[1], v->position[2]};
+    m_VAOs.emplace_back(new VertexArray());
+    m_VAOs[0]->bind();
 
-    for (const auto &vp: m_vertices) {
-        const float x = vp.position[0];
-        const float y = vp.position[1];
-        const float z = vp.position[2];
+    // Models under live reload get patched in place, see `patchBuffers()`
+    const GLenum usage = m_parser ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW;
+    m_VBOs.emplace_back(new VertexBuffer(m_vertices, usage));
+    m_IBOs.emplace_back(new IndexBuffer(m_indices, usage));
 
-        if (x > max[0]) max[0] = x;
-        if (y > max[1]) max[1] = y;
-        if (z > max[2]) max[2] = z;
+    setVertexAttributes();
 
-        if (x < min[0]) min[0] = x;
-        if (y < min[1]) min[1] = y;
-        if (z < min[2]) min[2] = z;
+    if (!m_colors.empty()) {
+        m_VBOs.emplace_back(new VertexBuffer(m_colors.data(), m_colors.size() * sizeof(m_colors[0]), GL_STATIC_DRAW));
+        glEnableVertexAttribArray(OBJECT_LOCATION_COLOR);
+        glVertexAttribPointer(OBJECT_LOCATION_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(m_colors[0]), (void *)0);
+    }
+    if (!m_occlusion.empty()) {
+        m_VBOs.emplace_back(new VertexBuffer(m_occlusion.data(), m_occlusion.size(), GL_STATIC_DRAW));
+        glEnableVertexAttribArray(OBJECT_LOCATION_OCCLUSION);
+        glVertexAttribPointer(OBJECT_LOCATION_OCCLUSION, 1, GL_UNSIGNED_BYTE, GL_TRUE, 1, (void *)0);
     }
-    const float sizeX = max[0] - min[0];
-    const float sizeY = max[1] - min[1];
-    const float sizeZ = max[2] - min[2];
 
-    return std::max( {sizeX, sizeY, sizeZ} );
+    m_VAOs[0]->unbind();
+    m_VBOs[0]->unbind();
+    m_IBOs[0]->unbind();
+
+    m_SSBOs.clear();
+    if (s_vertexPulling)
+        initStorageBuffers();
 }
 
 /**
- * @brief Calculates UV coordinates using XY plane projection.
+ * @brief Replaces the buffers of `initBuffers()` with a single VAO reading from a RingBuffer.
+ *
+ * Regions get half as much room again as the current frame needs, so
+ * slowly growing frames do not recreate the ring every time.
  *
- * Computes normalized texture coordinates for each vertex based on their
- * X and Y positions. The minimum and maximum X/Y values are used to map
- * positions into the [0, 1] UV range.
+ * @param frameSize Bytes of vertices and indices of the frame about to be written.
  */
-void Object::calculateUV_XY() {
-    if (m_vertices.empty()) return;
+void Object::initStreamBuffers(size_t frameSize) {
+    m_VBOs.clear();
+    m_IBOs.clear();
+    m_SSBOs.clear();
+    m_stream = RingBuffer::create(frameSize + frameSize / 2, m_stream.get());
+    if (m_VAOs.size() != 1) {
+        m_VAOs.clear();
+        m_VAOs.emplace_back(new VertexArray());
+    }
+    m_subMeshes[0].vertexArray = 0;
+}
 
-    float minX = m_vertices[0].position[0], maxX = m_vertices[0].position[0];
-    float minY = m_vertices[0].position[1], maxY = m_vertices[0].position[1];
+/**
+ * @brief Computes the normals and bounds deferred by `load()` on the GPU, from the buffers just uploaded.
+ *
+ * Normals are written straight into the VBO (and the packed storage
+ * buffer), only the center and bounding box are read back to set the
+ * model scale. Falls back to the CPU if the compute shaders are unavailable.
+ */
+void Object::computeOnGpu() {
+    m_gpuBounds = false;
+    if (m_vertices.empty())
+        return;
+    const auto start = std::chrono::steady_clock::now();
+    if (!s_meshCompute)
+        s_meshCompute = MeshCompute::create();
+    if (!s_meshCompute) {
+        if (m_gpuNormals) {
+            computeMeshNormals(m_vertices, m_indices);
+            initBuffers();
+        }
+        m_gpuNormals = false;
+        computeBounds();
+        return;
+    }
 
-    for (const auto &v: m_vertices) {
-        if (v.position[0] < minX) minX = v.position[0];
-        if (v.position[0] > maxX) maxX = v.position[0];
-        if (v.position[1] < minY) minY = v.position[1];
-        if (v.position[1] > maxY) maxY = v.position[1];
+    if (m_gpuNormals)
+        s_meshCompute->computeNormals(*m_VBOs[0], m_vertices.size(), *m_IBOs[0], m_indices.size(),
+                                      m_SSBOs.empty() ? nullptr : m_SSBOs[OBJECT_BINDING_VERTICES].get());
+    const MeshBounds bounds = s_meshCompute->computeBounds(*m_VBOs[0], m_vertices.size());
+    m_center = bounds.center;
+    const float scale = std::max({bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1],
+                                  bounds.max[2] - bounds.min[2]});
+    m_scaleFactor = scale > 0.0f ? 1.0f / scale : 1.0f;
 
-    }
-    for (auto &v: m_vertices) {
-        v.uv[0] = (v.position[0] - minX) / (maxX - minX);
-        v.uv[1] = (v.position[1] - minY) / (maxY - minY);
-    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Computed %s of %s on the GPU in %.1f ms\n", m_gpuNormals ? "normals and bounds" : "bounds",
+           m_filePath.c_str(), elapsed.count());
+    m_gpuNormals = false;
 }
 
 /**
- * @brief Calculates UV coordinates using ZY plane projection.
+ * @brief Uploads the geometry again as storage buffers for vertex pulling.
  *
- * Computes normalized texture coordinates for each vertex based on their
- * Z and Y positions. The minimum and maximum Z/Y values are used to map
- * positions into the [0, 1] UV range.
+ * Vertices are packed to 20 bytes with `packVertices()` and bound to
+ * OBJECT_BINDING_VERTICES, indices to OBJECT_BINDING_INDICES. Vertex colors
+ * and baked occlusion, when present, get OBJECT_BINDING_COLORS and
+ * OBJECT_BINDING_OCCLUSION; occlusion bytes are padded to a whole number of
+ * 32-bit words since the shader reads them four at a time.
  */
-void Object::calculateUV_ZY() {
-    if (m_vertices.empty()) return;
+void Object::initStorageBuffers() {
+    m_SSBOs.resize(OBJECT_BINDING_OCCLUSION + 1);
 
-    float minZ = m_vertices[0].position[2], maxZ = m_vertices[0].position[2];
-    float minY = m_vertices[0].position[1], maxY = m_vertices[0].position[1];
+    std::vector<PackedVertex> packed;
+    packVertices(m_vertices, packed);
+    m_SSBOs[OBJECT_BINDING_VERTICES].reset(new StorageBuffer(packed.data(), packed.size() * sizeof(PackedVertex)));
+    m_SSBOs[OBJECT_BINDING_INDICES].reset(new StorageBuffer(m_indices.data(), m_indices.size() * sizeof(unsigned int)));
+    if (!m_colors.empty())
+        m_SSBOs[OBJECT_BINDING_COLORS].reset(new StorageBuffer(m_colors.data(), m_colors.size() * sizeof(m_colors[0])));
+    if (!m_occlusion.empty()) {
+        std::vector<unsigned char> words(m_occlusion);
+        words.resize((words.size() + 3) / 4 * 4, 0);
+        m_SSBOs[OBJECT_BINDING_OCCLUSION].reset(new StorageBuffer(words.data(), words.size()));
+    }
+}
 
-    for (const auto &v : m_vertices) {
-        if (v.position[2] < minZ) minZ = v.position[2];
-        if (v.position[2] > maxZ) maxZ = v.position[2];
-        if (v.position[1] < minY) minY = v.position[1];
-        if (v.position[1] > maxY) maxY = v.position[1];
+/**
+ * @brief Uploads a glTF model straight from its mapped buffer views.
+ *
+ * Every buffer view becomes one VBO or IBO filled directly from the mapped
+ * file, so interleaved attributes share a buffer. Each primitive gets a VAO
+ * whose attribute pointers keep the accessor's stride, offset and component
+ * type. Embedded images become textures. The mapping is released
+ * afterwards since the GPU holds its own copy.
+ */
+void Object::initGltfBuffers() {
+    const size_t none = static_cast<size_t>(-1);
+    std::vector<size_t> buffers(m_gltf->views.size(), none);
+    for (const GltfPrimitive &primitive: m_gltf->primitives) {
+        for (const GltfAttribute &attribute: primitive.attributes)
+            buffers[attribute.view] = 0;
+        if (primitive.indexed)
+            buffers[primitive.indexView] = 0;
+    }
+    for (size_t i = 0; i < buffers.size(); i++) {
+        if (buffers[i] == none)
+            continue;
+        const GltfBufferView &view = m_gltf->views[i];
+        if (view.indices) {
+            buffers[i] = m_IBOs.size();
+            m_IBOs.emplace_back(new IndexBuffer(view.data, view.size, GL_STATIC_DRAW));
+        } else {
+            buffers[i] = m_VBOs.size();
+            m_VBOs.emplace_back(new VertexBuffer(view.data, view.size, GL_STATIC_DRAW));
+        }
     }
 
-    for (auto &v : m_vertices) {
-        v.uv[0] = (v.position[2] - minZ) / (maxZ - minZ);
-        v.uv[1] = (v.position[1] - minY) / (maxY - minY);
+    for (const GltfPrimitive &primitive: m_gltf->primitives) {
+        m_VAOs.emplace_back(new VertexArray());
+        m_VAOs.back()->bind();
+        for (const GltfAttribute &attribute: primitive.attributes) {
+            m_VBOs[buffers[attribute.view]]->bind();
+            glEnableVertexAttribArray(attribute.location);
+            glVertexAttribPointer(attribute.location, attribute.components, attribute.componentType,
+                                  attribute.normalized ? GL_TRUE : GL_FALSE, static_cast<GLsizei>(attribute.stride),
+                                  reinterpret_cast<void *>(attribute.offset));
+        }
+        if (primitive.indexed)
+            m_IBOs[buffers[primitive.indexView]]->bind();
+        m_VAOs.back()->unbind();
     }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    for (const Image &image: m_gltf->images)
+        m_textures.push_back(Texture2D::create(image, GL_REPEAT, GL_REPEAT));
+    m_gltf.reset();
 }
 
 /**
- * @brief Computes smooth normals for all vertices of the object.
+ * @brief Finds the byte ranges that differ between two arrays of equal size.
+ *
+ * Each run of differing elements gives one range; nearby ranges are merged
+ * later by the buffer's `updateRanges()`.
  *
- * Calculates each vertex normal by averaging the normals of all
- * triangles that share the vertex. The result is used for lighting
- * and shading in 3D rendering.
+ * @return std::vector<BufferRange> Byte ranges, in order.
  */
-void Object::computeNormals() {
-    for (auto &v: m_vertices) {
-        v.normal = {0.0f, 0.0f, 0.0f};
+template<typename T>
+static std::vector<BufferRange> findDirtyRanges(const std::vector<T> &before, const std::vector<T> &after) {
+    std::vector<BufferRange> ranges;
+    size_t i = 0;
+    while (i < after.size()) {
+        if (!memcmp(&before[i], &after[i], sizeof(T))) {
+            i++;
+            continue;
+        }
+        const size_t begin = i;
+        while (i < after.size() && memcmp(&before[i], &after[i], sizeof(T)))
+            i++;
+        ranges.push_back({begin * sizeof(T), (i - begin) * sizeof(T)});
     }
+    return ranges;
+}
 
-    for (size_t i = 0; i < m_indices.size(); i += 3) {
-        const unsigned int i0 = m_indices[i];
-        const unsigned int i1 = m_indices[i + 1];
-        const unsigned int i2 = m_indices[i + 2];
+/**
+ * @brief Uploads only the parts of the geometry that changed since the last upload.
+ *
+ * Differences separated by fewer than OBJECT_PATCH_GAP equal elements are
+ * uploaded together, trading a few redundant bytes for fewer upload calls.
+ *
+ * @param oldVertices Vertices currently stored in the VBO.
+ * @param oldIndices Indices currently stored in the IBO.
+ */
+void Object::patchBuffers(const std::vector<Vertex> &oldVertices, const std::vector<unsigned int> &oldIndices) {
+    m_VBOs[0]->updateRanges(m_vertices.data(), findDirtyRanges(oldVertices, m_vertices),
+                            OBJECT_PATCH_GAP * sizeof(Vertex));
+    m_VBOs[0]->unbind();
 
-        std::array<float, 3> &v0 = m_vertices[i0].position;
-        std::array<float, 3> &v1 = m_vertices[i1].position;
-        std::array<float, 3> &v2 = m_vertices[i2].position;
+    m_VAOs[0]->bind();
+    m_IBOs[0]->updateRanges(m_indices.data(), findDirtyRanges(oldIndices, m_indices),
+                            OBJECT_PATCH_GAP * sizeof(unsigned int));
+    m_VAOs[0]->unbind();
+}
 
-        std::array<float, 3> edge1 = { v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2] };
-        std::array<float, 3> edge2 = { v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2] };
+/**
+ * @brief Sets the center and scale factor from the bounds of the vertices, see `computeMeshBounds()`.
+ *
+ * The scale factor normalizes the object's largest dimension to 1.
+ */
+void Object::computeBounds() {
+    setBounds(computeMeshBounds(m_vertices));
+}
 
-        std::array<float, 3> faceNormal = crossProdVec(edge1, edge2);
-        faceNormal = normalizeVec(faceNormal);
+/**
+ * @brief Sets the center and scale factor from precomputed bounds.
+ */
+void Object::setBounds(const MeshBounds &bounds) {
+    m_center = bounds.center;
+    const float scale = std::max({bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1],
+                                  bounds.max[2] - bounds.min[2]});
+    m_scaleFactor = scale > 0.0f ? 1.0f / scale : 1.0f;
+}
 
-        unsigned int indices[3] = { i0, i1, i2 };
-        for (const unsigned int idx: indices) {
-            m_vertices[idx].normal[0] += faceNormal[0];
-            m_vertices[idx].normal[1] += faceNormal[1];
-            m_vertices[idx].normal[2] += faceNormal[2];
-        }
+/**
+ * @brief Bakes per-vertex ambient occlusion into m_occlusion.
+ *
+ * The result is cached in a file next to the model (see
+ * AO_CACHE_EXTENSION) together with a hash of the geometry, so loading the
+ * same mesh again skips the bake. The bake time is printed, along with the
+ * time it would take for one million vertices.
+ */
+void Object::bakeOcclusion() {
+    const auto start = std::chrono::steady_clock::now();
+    const std::string cachePath = m_filePath + AO_CACHE_EXTENSION;
+    const uint64_t hash = hashAmbientOcclusionInput(m_vertices, m_indices, s_occlusionRays);
+    if (loadAmbientOcclusionCache(cachePath, hash, m_vertices.size(), m_occlusion)) {
+        printf("Ambient occlusion: loaded %s\n", cachePath.c_str());
+        return;
     }
-    for (auto &v: m_vertices) {
-        v.normal = normalizeVec(v.normal);
+
+    const std::unique_ptr<Bvh> bvh = Bvh::build(m_vertices, m_indices);
+    if (!bvh) {
+        m_occlusion.clear();
+        return;
     }
+    bakeAmbientOcclusion(*bvh, m_vertices, s_occlusionRays, m_occlusion);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Ambient occlusion: baked %zu vertices with %zu rays each in %.1f ms on %u threads "
+           "(%.2f s per million vertices)\n", m_vertices.size(), (s_occlusionRays + 3) / 4 * 4,
+           elapsed.count() * 1000.0, getWorkerCount(), elapsed.count() * 1e6 / m_vertices.size());
+    saveAmbientOcclusionCache(cachePath, hash, m_occlusion);
 }
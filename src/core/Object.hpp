@@ -26,28 +26,72 @@
 #include "../graphics/VertexArray.hpp"
 #include "../graphics/VertexBuffer.hpp"
 #include "../graphics/IndexBuffer.hpp"
+#include "../graphics/StorageBuffer.hpp"
+#include "../graphics/RingBuffer.hpp"
+#include "../graphics/MeshCompute.hpp"
+#include "Vertex.hpp"
+#include "Mesh.hpp"
+#include "ObjParser.hpp"
+#include "../io/Gltf.hpp"
+#include "../io/Ply.hpp"
+#include "../io/Stl.hpp"
+#include "../io/MeshCodec.hpp"
+#include "Weld.hpp"
+#include "MeshCleanup.hpp"
+#include "AmbientOcclusion.hpp"
+#include "Packing.hpp"
+#include "ProgressiveMesh.hpp"
+#include "ChunkedMesh.hpp"
 
 #define MOVE_SPEED 2.0
+#define OBJECT_PATCH_GAP 64
+#define OBJECT_LOCATION_COLOR 3
+#define OBJECT_LOCATION_OCCLUSION 4
+#define OBJECT_BINDING_VERTICES 0
+#define OBJECT_BINDING_INDICES 1
+#define OBJECT_BINDING_COLORS 2
+#define OBJECT_BINDING_OCCLUSION 3
 
 /**
- * @brief Represents a single vertex with position and texture coordinates.
+ * @brief One draw call of an Object.
+ *
+ * Describes which VAO to bind, the primitive range to draw and the
+ * material used for it. `transform` places the sub-mesh inside the object
+ * (node transforms of glTF files) and is applied before the object's
+ * model matrix.
  */
-struct Vertex {
-    std::array<float, 3> position;
-    std::array<float, 2> uv;
-    std::array<float, 3> normal;
+struct SubMesh {
+    size_t vertexArray = 0;
+    unsigned int mode = GL_TRIANGLES;
+    bool indexed = true;
+    unsigned int indexType = GL_UNSIGNED_INT;
+    size_t indexOffset = 0;
+    size_t count = 0;
+    size_t material = 0;
+    int texture = -1;
+    std::array<float, 16> transform;
 };
 
 /**
- * @brief Represents a 3D object loaded from an .obj file.
+ * @brief Represents a 3D object loaded from an .obj, .ply, .stl, .smesh or .glb file.
  *
  * Object contains vertex and index data, transformation matrices,
- * a texture, and OpenGL buffers (VAO, VBO, IBO).
+ * textures, materials, OpenGL buffers (VAOs, VBOs, IBOs) and the list of
+ * sub-meshes drawn from them. An .obj, .ply, .stl or .smesh file gives a single sub-mesh
+ * (points for a .ply without faces); a .glb file gives one sub-mesh per
+ * mesh primitive.
  */
 class Object {
 public:
     Object() = default;
-    static std::unique_ptr<Object> create(const std::string &objFilePath);
+    static std::unique_ptr<Object> create(const std::string &objFilePath, bool keepParseCache = false);
+    static std::unique_ptr<Object> load(const std::string &objFilePath, bool keepParseCache = false);
+    static bool loadGeometry(const std::string &filePath, std::vector<Vertex> &vertices,
+                             std::vector<unsigned int> &indices);
+    static std::unique_ptr<Object> createProgressive(const std::string &filePath, ProgressiveLevel &base,
+                                                     const MeshBounds &bounds, size_t vertexCount,
+                                                     size_t indexCount);
+    static std::unique_ptr<Object> createChunked(const std::string &filePath, const MeshBounds &bounds);
     Object(const Object&) = delete;
     Object(Object &&other) noexcept;
     ~Object() = default;
@@ -55,27 +99,57 @@ public:
     Object &operator=(const Object&) = delete;
     Object &operator=(Object &&other) noexcept;
 
-    void bind() const;
+    void upload();
+    bool reload();
+    void streamGeometry(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+    void refineGeometry(const ProgressiveLevel &level);
+    size_t addChunk(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+    void removeChunk(size_t slot);
+    void setDrawnChunks(const std::vector<size_t> &slots);
+    void bind(size_t subMesh) const;
     void unbind() const;
+    void bindStorage() const;
+    void unbindStorage() const;
     void updateRotationMatrixY(const float angle);
     void moveXaxis(const float direction, const double deltaTime);
     void moveYaxis(const float direction, const double deltaTime);
     void moveZaxis(const float direction, const double deltaTime);
 
-    const VertexArray &getVAO() const;
     std::array<float, 3> getCenter() const;
-    std::vector<unsigned int> getIndices() const;
+    const std::vector<SubMesh> &getSubMeshes() const;
+    const std::vector<Vertex> &getVertices() const;
+    const std::vector<unsigned int> &getIndices() const;
+    const std::vector<std::array<unsigned char, 4>> &getVertexColors() const;
+    const std::vector<unsigned char> &getAmbientOcclusion() const;
     std::array<float, 16> getMatrix();
     std::string getTexture2DPath() const;
     const std::array<float, 3> getPosition() const;
-    const std::unique_ptr<Material> &getMaterial();
+    const std::unique_ptr<Material> &getMaterial(size_t index = 0);
+    const std::shared_ptr<Texture2D> &getTexture(size_t index) const;
+    size_t getMemoryUsage() const;
+    bool isUploaded() const;
+    bool hasVertexColors() const;
+    bool hasAmbientOcclusion() const;
+    bool hasStorageBuffers() const;
+    const RingBuffer *getStreamBuffer() const;
+    size_t getRevision() const;
 
     void setTexture2D(const std::shared_ptr<Texture2D> &texture);
+    static void setWeldTolerance(float tolerance);
+    static void setMeshCleanup(bool enabled);
+    static void setAmbientOcclusionRays(size_t rays);
+    static void setVertexPulling(bool enabled);
+    static void setGpuCompute(bool enabled);
+    static MeshSettings getMeshSettings();
 
 private:
     std::vector<Vertex> m_vertices;
     std::vector<unsigned int> m_indices;
+    std::vector<std::array<unsigned char, 4>> m_colors;
+    std::vector<unsigned char> m_occlusion;
     std::array<float, 3> m_center;
+    std::string m_filePath;
+    std::unique_ptr<ObjParser> m_parser = nullptr;
 
     std::array<float, 16> m_translationMatrix;
     std::array<float, 16> m_rotationMatrix;
@@ -85,19 +159,44 @@ private:
 
     float m_scaleFactor;
 
-    VertexArray m_VAO;
-    std::unique_ptr<VertexBuffer> m_VBO = nullptr;
-    std::unique_ptr<IndexBuffer> m_IBO = nullptr;
-
-    std::unique_ptr<Material> m_material = nullptr;
-
-    int parseFile(const std::string &filePath);
+    std::vector<SubMesh> m_subMeshes;
+    std::vector<std::unique_ptr<VertexArray>> m_VAOs;
+    std::vector<std::unique_ptr<VertexBuffer>> m_VBOs;
+    std::vector<std::unique_ptr<IndexBuffer>> m_IBOs;
+    std::vector<std::unique_ptr<StorageBuffer>> m_SSBOs;
+
+    std::vector<std::unique_ptr<Material>> m_materials;
+    std::vector<std::shared_ptr<Texture2D>> m_textures;
+
+    std::unique_ptr<GltfModel> m_gltf = nullptr;
+
+    bool m_gpuBounds = false;
+    bool m_gpuNormals = false;
+    std::unique_ptr<RingBuffer> m_stream = nullptr;
+    size_t m_revision = 0;
+    std::vector<size_t> m_chunkCounts;
+    // Whether each chunk slot holds an uploaded chunk; a chunk may have no indices
+    std::vector<bool> m_chunkUsed;
+
+    static float s_weldTolerance;
+    static bool s_cleanup;
+    static size_t s_occlusionRays;
+    static bool s_vertexPulling;
+    static bool s_gpuCompute;
+    static std::unique_ptr<MeshCompute> s_meshCompute;
+    static size_t s_revisions;
+
+    int loadGltf(const std::string &filePath);
+    void setMesh(Mesh &mesh);
     void initBuffers();
-    std::array<float, 3> calculateCenter() const;
-    float calculateScale() const;
-    void calculateUV_XY();
-    void calculateUV_ZY();
-    void computeNormals();
+    void initGltfBuffers();
+    void initStorageBuffers();
+    void initStreamBuffers(size_t frameSize);
+    void computeOnGpu();
+    void patchBuffers(const std::vector<Vertex> &oldVertices, const std::vector<unsigned int> &oldIndices);
+    void computeBounds();
+    void setBounds(const MeshBounds &bounds);
+    void bakeOcclusion();
 };
 
 
@@ -0,0 +1,49 @@
+/**
+ * @file Packing.cpp
+ * @author Patryk
+ * @brief Compact vertex attribute encodings
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Packing.hpp"
+#include "PackingMath.hpp"
+#include "../utils/Kernels.hpp"
+#include "../utils/Parallel.hpp"
+
+/**
+ * @brief Maps a normal onto the octahedron unfolded in [-1, 1]^2.
+ * @param normal Normal, not necessarily unit length; a zero normal maps to (0, 0).
+ * @return std::array<float, 2> Octahedral coordinates.
+ */
+std::array<float, 2> encodeOctahedral(const std::array<float, 3> &normal) {
+    std::array<float, 2> octahedral;
+    octahedralFromNormal(normal.data(), octahedral.data());
+    return octahedral;
+}
+
+/**
+ * @brief Converts a float to an IEEE half float, rounding to nearest.
+ *
+ * Values beyond the half range become infinities, tiny values subnormals
+ * or zero, and NaN stays NaN.
+ */
+uint16_t floatToHalf(float value) {
+    return halfFromFloat(value);
+}
+
+/**
+ * @brief Converts vertices to PackedVertex, in parallel.
+ * @param vertices Vertices to convert.
+ * @param packed Receives one PackedVertex per vertex.
+ */
+void packVertices(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &packed) {
+    packed.resize(vertices.size());
+    const KernelTable &kernels = getKernels();
+    parallelFor(0, vertices.size(), PACKING_GRAIN, [&](size_t begin, size_t end) {
+        kernels.packVertices(vertices[begin].position.data(), end - begin, &packed[begin]);
+    });
+}
@@ -0,0 +1,39 @@
+/**
+ * @file Packing.hpp
+ * @author Patryk
+ * @brief Compact vertex attribute encodings declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PACKING_HPP
+#define SCOP_PACKING_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Vertex.hpp"
+
+#define PACKING_GRAIN 65536
+
+/**
+ * @brief Vertex in 20 bytes instead of 32: float position, half float
+ * texture coordinates and an octahedral normal in two 16-bit snorms.
+ *
+ * Matches `PackedVertex` of vertex_pulling.glsl (std430 layout).
+ */
+struct PackedVertex {
+    float position[3];
+    uint32_t uv;
+    uint32_t normal;
+};
+
+std::array<float, 2> encodeOctahedral(const std::array<float, 3> &normal);
+uint16_t floatToHalf(float value);
+void packVertices(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &packed);
+
+#endif //SCOP_PACKING_HPP
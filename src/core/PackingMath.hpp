@@ -0,0 +1,75 @@
+/**
+ * @file PackingMath.hpp
+ * @author Patryk
+ * @brief Inline conversions behind vertex packing
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PACKING_MATH_HPP
+#define SCOP_PACKING_MATH_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Everything here is static so that each kernels_<isa>.cpp gets its own copy
+// built for its instruction set; only plain C functions and builtins are used.
+
+/**
+ * @brief Converts a float to an IEEE half float, rounding to nearest; see `floatToHalf()`.
+ */
+static inline uint16_t halfFromFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t magnitude = bits & 0x7FFFFFFF;
+    if (magnitude >= 0x7F800000)
+        return sign | 0x7C00 | (magnitude > 0x7F800000 ? 0x200 : 0);
+    const int exponent = static_cast<int>(magnitude >> 23) - 127 + 15;
+    uint32_t mantissa = magnitude & 0x7FFFFF;
+    if (exponent >= 31)
+        return sign | 0x7C00;
+    if (exponent <= 0) {
+        if (exponent < -10)
+            return sign;
+        mantissa |= 0x800000;
+        const int shift = 14 - exponent;
+        const uint32_t half = (mantissa >> shift) + ((mantissa >> (shift - 1)) & 1);
+        return static_cast<uint16_t>(sign | half);
+    }
+    const uint32_t half = (static_cast<uint32_t>(exponent) << 10 | mantissa >> 13) + ((mantissa >> 12) & 1);
+    return static_cast<uint16_t>(sign | (half < 0x7C00 ? half : 0x7C00));
+}
+
+/**
+ * @brief Maps a normal onto the octahedron unfolded in [-1, 1]^2; see `encodeOctahedral()`.
+ */
+static inline void octahedralFromNormal(const float *normal, float *octahedral) {
+    const float sum = fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+    if (!(sum > 0.0f)) {
+        octahedral[0] = octahedral[1] = 0.0f;
+        return;
+    }
+    const float x = normal[0] / sum, y = normal[1] / sum;
+    if (normal[2] >= 0.0f) {
+        octahedral[0] = x;
+        octahedral[1] = y;
+        return;
+    }
+    octahedral[0] = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    octahedral[1] = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+}
+
+/**
+ * @brief Converts a value in [-1, 1] to a 16-bit snorm, in the low half of the result.
+ */
+static inline uint32_t snorm16FromFloat(float value) {
+    const float clamped = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+    return static_cast<uint16_t>(static_cast<int16_t>(lroundf(clamped * 32767.0f)));
+}
+
+#endif //SCOP_PACKING_MATH_HPP
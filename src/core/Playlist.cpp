@@ -0,0 +1,571 @@
+/**
+ * @file Playlist.cpp
+ * @author Patryk
+ * @brief Playlist class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <sstream>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "Playlist.hpp"
+#include "../io/Asset.hpp"
+#include "../io/AssetPack.hpp"
+#include "../io/MeshCodec.hpp"
+#include "../textures/TextureManager.hpp"
+
+extern std::unique_ptr<TextureManager> gTextureManager;
+
+static bool hasExtension(const std::string &path, const std::string &extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Checks whether a file is a model: .obj, .glb, .ply, .stl or .smesh, but not the .smesh cache of another model.
+ */
+static bool isModelFile(const std::string &path) {
+    if (hasExtension(path, MESH_CODEC_EXTENSION)) {
+        const std::string source = path.substr(0, path.size() - std::string(MESH_CODEC_EXTENSION).size());
+        return !hasExtension(source, ".obj") && !hasExtension(source, ".ply") && !hasExtension(source, ".stl");
+    }
+    return hasExtension(path, ".obj") || hasExtension(path, ".glb") || hasExtension(path, ".ply") ||
+           hasExtension(path, ".stl");
+}
+
+/**
+ * @brief Creates a playlist and starts its prefetch workers.
+ *
+ * The source can be:
+ * - a directory: every `.obj`, `.glb`, `.ply`, `.stl` and `.smesh` file inside it,
+ *   sorted by name; a `.png` with the same name is used as texture when present,
+ * - a list file: one `<obj_path> [texture_path]` per line, `#` starts a comment,
+ * - a directory inside a mounted asset pack.
+ *
+ * @param source Directory or list file.
+ * @param defaultTexture Texture used by entries without their own texture.
+ * @param settings Prefetch settings.
+ * @return std::unique_ptr<Playlist> Playlist, or `nullptr` if the source holds no models.
+ */
+std::unique_ptr<Playlist> Playlist::create(const std::string &source, const std::string &defaultTexture,
+                                           const PlaylistSettings &settings) {
+    std::unique_ptr<Playlist> playlist(new Playlist());
+    playlist->m_settings = settings;
+
+    if (!playlist->collectEntries(source, defaultTexture) || playlist->m_entries.empty()) {
+        fprintf(stderr, "Playlist %s contains no models\n", source.c_str());
+        return nullptr;
+    }
+    playlist->m_slots.resize(playlist->m_entries.size());
+    // The default texture is loaded by main() and stays resident
+    playlist->m_residentTextures.insert(defaultTexture);
+
+    unsigned int workerCount = std::min(2u, std::thread::hardware_concurrency());
+    if (workerCount == 0)
+        workerCount = 1;
+    for (unsigned int i = 0; i < workerCount; i++)
+        playlist->m_workers.push_back(std::thread(&Playlist::workerLoop, playlist.get()));
+
+    printf("Playlist: %zu models, prefetching %zu ahead with %u workers\n",
+           playlist->m_entries.size(), settings.prefetchCount, workerCount);
+    return playlist;
+}
+
+Playlist::~Playlist() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workAvailable.notify_all();
+    for (std::thread &worker: m_workers)
+        worker.join();
+}
+
+/**
+ * @brief Makes the given entry the current model.
+ *
+ * The previously displayed object is returned to the cache, the window
+ * around the new position is rescheduled and entries that left it are
+ * evicted. If the target has not been prefetched yet, it is queued with the
+ * highest priority and this call blocks until it is loaded. The object is
+ * uploaded to the GPU here, on the main thread.
+ *
+ * @param index Playlist position to display.
+ * @param current Currently displayed object, replaced by the selected one.
+ * @return bool true if the model was switched.
+ */
+bool Playlist::select(size_t index, std::unique_ptr<Object> &current) {
+    if (index >= m_entries.size())
+        return false;
+
+    std::vector<std::unique_ptr<Object>> evicted;
+    std::unique_ptr<Object> object;
+    Image image;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_started && index == m_current)
+            return true;
+        if (m_slots[index].state == PREFETCH_FAILED)
+            return false;
+
+        const size_t previousIndex = m_current;
+        const bool wasStarted = m_started;
+        if (m_started) {
+            PrefetchSlot &old = m_slots[m_current];
+            old.object = std::move(current);
+            old.state = old.object ? PREFETCH_READY : PREFETCH_EMPTY;
+        }
+        m_current = index;
+        m_started = true;
+        schedule(evicted);
+
+        PrefetchSlot &target = m_slots[index];
+        m_slotReady.wait(lock, [&target]() {
+            return target.state == PREFETCH_READY || target.state == PREFETCH_FAILED;
+        });
+
+        if (target.state == PREFETCH_FAILED) {
+            m_current = previousIndex;
+            m_started = wasStarted;
+            if (wasStarted && m_slots[previousIndex].object) {
+                current = std::move(m_slots[previousIndex].object);
+                m_slots[previousIndex].state = PREFETCH_ACTIVE;
+            }
+            schedule(evicted);
+            lock.unlock();
+            evicted.clear();
+            return false;
+        }
+
+        object = std::move(target.object);
+        image = std::move(target.image);
+        m_memoryUsed -= std::min(m_memoryUsed, image.getMemoryUsage());
+        target.memory = object->getMemoryUsage();
+        target.state = PREFETCH_ACTIVE;
+    }
+
+    // Destroy evicted objects outside the lock, on the thread owning the GL context
+    evicted.clear();
+    releaseTextures();
+
+    object->upload();
+    const std::string texturePath = attachTexture(*object, image, m_entries[index]);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_residentTextures.insert(texturePath);
+    }
+    current = std::move(object);
+    printf("Playlist: [%zu/%zu] %s\n", index + 1, m_entries.size(), m_entries[index].objPath.c_str());
+    return true;
+}
+
+/**
+ * @brief Displays the first entry that loads, skipping the ones that fail.
+ * @param current Receives the displayed object.
+ * @return bool false if no entry of the playlist loads.
+ */
+bool Playlist::start(std::unique_ptr<Object> &current) {
+    for (size_t index = 0; index < m_entries.size(); index++) {
+        if (select(index, current))
+            return true;
+    }
+    fprintf(stderr, "Playlist: none of the %zu models could be loaded\n", m_entries.size());
+    return false;
+}
+
+bool Playlist::next(std::unique_ptr<Object> &current) {
+    return step(true, current);
+}
+
+bool Playlist::previous(std::unique_ptr<Object> &current) {
+    return step(false, current);
+}
+
+/**
+ * @brief Selects the closest entry in one direction that loads, wrapping around, so a broken model is skipped.
+ * @return bool false if every other entry failed; the current one stays displayed.
+ */
+bool Playlist::step(bool forward, std::unique_ptr<Object> &current) {
+    const size_t count = m_entries.size();
+    for (size_t i = 1; i < count; i++) {
+        if (select(forward ? (m_current + i) % count : (m_current + count - i) % count, current))
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Per-frame maintenance, called on the main thread.
+ *
+ * Evicts the farthest prefetched entries while the memory budget is
+ * exceeded. With `uploadAhead` enabled, also uploads at most one prefetched
+ * entry (geometry and texture) per frame, so the following switch does not
+ * pay for the GPU upload either.
+ */
+void Playlist::update() {
+    std::vector<std::unique_ptr<Object>> evicted;
+    size_t uploadIndex = m_entries.size();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        enforceBudget(evicted);
+
+        if (m_settings.uploadAhead) {
+            size_t bestPriority = SIZE_MAX;
+            for (size_t i = 0; i < m_slots.size(); i++) {
+                const PrefetchSlot &slot = m_slots[i];
+                if (slot.state != PREFETCH_READY || (slot.object->isUploaded() && !slot.image.pixels))
+                    continue;
+                const size_t priority = getPriority(i);
+                if (priority < bestPriority) {
+                    bestPriority = priority;
+                    uploadIndex = i;
+                }
+            }
+        }
+    }
+    evicted.clear();
+
+    if (uploadIndex == m_entries.size())
+        return;
+
+    // READY slots are never touched by workers, so the upload can run unlocked
+    PrefetchSlot &slot = m_slots[uploadIndex];
+    const size_t imageMemory = slot.image.getMemoryUsage();
+    slot.object->upload();
+    const std::string texturePath = attachTexture(*slot.object, slot.image, m_entries[uploadIndex]);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_residentTextures.insert(texturePath);
+    m_memoryUsed -= std::min(m_memoryUsed, imageMemory);
+    slot.memory -= std::min(slot.memory, imageMemory);
+}
+
+size_t Playlist::size() const {
+    return m_entries.size();
+}
+
+size_t Playlist::getCurrentIndex() const {
+    return m_current;
+}
+
+/**
+ * @brief Returns a one-line description of the playlist for the HUD.
+ * @return std::string Current position, model name, prefetched entries and cache size.
+ */
+std::string Playlist::getStatus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t ready = 0;
+    for (const PrefetchSlot &slot: m_slots) {
+        if (slot.state == PREFETCH_READY)
+            ready++;
+    }
+
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "Model %zu/%zu: %s | prefetched %zu | cache %.1f MB | next/prev: ]/[",
+             m_current + 1, m_entries.size(), m_entries[m_current].objPath.c_str(), ready,
+             m_memoryUsed / (1024.0 * 1024.0));
+    return buffer;
+}
+
+/**
+ * @brief Fills the entry list from a directory, a list file or a packed directory.
+ * @param source Directory or list file.
+ * @param defaultTexture Texture used by entries without their own texture.
+ * @return bool true if the source could be read.
+ */
+bool Playlist::collectEntries(const std::string &source, const std::string &defaultTexture) {
+    m_defaultTexture = defaultTexture;
+
+    struct stat st;
+    if (stat(source.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(source.c_str());
+        if (!dir)
+            return false;
+        std::vector<std::string> names;
+        while (const dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.' && isModelFile(entry->d_name))
+                names.push_back(entry->d_name);
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end());
+
+        for (const std::string &name: names) {
+            PlaylistEntry entry;
+            entry.objPath = source + "/" + name;
+            const std::string texture = entry.objPath.substr(0, entry.objPath.rfind('.')) + ".png";
+            entry.texturePath = Asset::exists(texture) ? texture : defaultTexture;
+            m_entries.push_back(entry);
+        }
+        return true;
+    }
+
+    const std::unique_ptr<Asset> list = Asset::load(source);
+    if (list) {
+        AssetStream stream(*list);
+        std::string line;
+        while (getline(stream, line)) {
+            std::istringstream ss(line);
+            PlaylistEntry entry;
+            if (!(ss >> entry.objPath) || entry.objPath[0] == '#')
+                continue;
+            if (!(ss >> entry.texturePath) || entry.texturePath[0] == '#')
+                entry.texturePath = defaultTexture;
+            m_entries.push_back(entry);
+        }
+        return true;
+    }
+
+    for (const auto &pack: AssetPack::getMounted()) {
+        for (const std::string &path: pack->list(source + "/")) {
+            if (!isModelFile(path))
+                continue;
+            PlaylistEntry entry;
+            entry.objPath = path;
+            const std::string texture = path.substr(0, path.rfind('.')) + ".png";
+            entry.texturePath = Asset::exists(texture) ? texture : defaultTexture;
+            m_entries.push_back(entry);
+        }
+        if (!m_entries.empty())
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Body of the prefetch worker threads.
+ *
+ * Repeatedly picks the queued entry closest to the current position, parses
+ * the model and decodes its texture without holding the lock, and stores the
+ * result unless the entry was evicted in the meantime (detected through the
+ * slot generation).
+ */
+void Playlist::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        size_t index = 0;
+        m_workAvailable.wait(lock, [this, &index]() { return m_stop || findJob(index); });
+        if (m_stop)
+            return;
+
+        PrefetchSlot &slot = m_slots[index];
+        slot.state = PREFETCH_LOADING;
+        const unsigned int generation = slot.generation;
+        const PlaylistEntry entry = m_entries[index];
+        const bool decodeImage = needsImage(entry.texturePath, index);
+        lock.unlock();
+
+        std::unique_ptr<Object> object = Object::load(entry.objPath);
+        Image image;
+        if (object && decodeImage && !Texture2D::decode(entry.texturePath, image))
+            fprintf(stderr, "Failed to decode texture: %s\n", entry.texturePath.c_str());
+
+        lock.lock();
+        if (slot.generation != generation || slot.state != PREFETCH_LOADING)
+            continue;
+        if (!object) {
+            slot.state = PREFETCH_FAILED;
+        } else {
+            slot.memory = object->getMemoryUsage() + image.getMemoryUsage();
+            slot.object = std::move(object);
+            slot.image = std::move(image);
+            slot.state = PREFETCH_READY;
+            m_memoryUsed += slot.memory;
+        }
+        m_slotReady.notify_all();
+    }
+}
+
+/**
+ * @brief Finds the queued entry with the highest priority.
+ *
+ * The current entry is always eligible; other entries only while the cache
+ * stays under the memory budget. Must be called with the mutex held.
+ *
+ * @param index Output index of the entry to load.
+ * @return bool true if a job is available.
+ */
+bool Playlist::findJob(size_t &index) const {
+    size_t bestPriority = SIZE_MAX;
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (m_slots[i].state != PREFETCH_QUEUED)
+            continue;
+        const size_t priority = getPriority(i);
+        if (priority < bestPriority) {
+            bestPriority = priority;
+            index = i;
+        }
+    }
+    if (bestPriority == SIZE_MAX)
+        return false;
+    return bestPriority == 0 || m_memoryUsed < m_settings.memoryBudget;
+}
+
+/**
+ * @brief Returns the load priority of an entry (lower loads first).
+ *
+ * 0 is the current entry, 1..prefetchCount are the following entries and
+ * prefetchCount + 1 is the previous one. Entries outside this window get
+ * SIZE_MAX. The playlist wraps around.
+ *
+ * @param index Entry index.
+ * @return size_t Priority of the entry.
+ */
+size_t Playlist::getPriority(size_t index) const {
+    const size_t count = m_entries.size();
+    const size_t forward = (index + count - m_current) % count;
+    if (forward <= m_settings.prefetchCount)
+        return forward;
+    if (forward == count - 1)
+        return m_settings.prefetchCount + 1;
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Checks whether a worker has to decode the given texture.
+ *
+ * Textures already on the GPU or already decoded for another entry are
+ * shared instead of decoded again. Must be called with the mutex held.
+ *
+ * @param texturePath Texture of the entry being loaded.
+ * @param except Index of the entry being loaded.
+ * @return bool true if the texture must be decoded.
+ */
+bool Playlist::needsImage(const std::string &texturePath, size_t except) const {
+    if (m_residentTextures.count(texturePath))
+        return false;
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        if (i != except && m_slots[i].image.pixels && m_slots[i].image.path == texturePath)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Evicts entries outside the prefetch window and queues missing ones.
+ *
+ * Must be called with the mutex held, on the main thread.
+ *
+ * @param evicted Receives evicted objects, to be destroyed after unlocking.
+ */
+void Playlist::schedule(std::vector<std::unique_ptr<Object>> &evicted) {
+    for (size_t i = 0; i < m_slots.size(); i++) {
+        PrefetchSlot &slot = m_slots[i];
+        if (getPriority(i) == SIZE_MAX) {
+            if (slot.state != PREFETCH_FAILED)
+                evict(i, evicted);
+        } else if (slot.state == PREFETCH_EMPTY) {
+            slot.state = PREFETCH_QUEUED;
+        }
+    }
+    m_workAvailable.notify_all();
+}
+
+/**
+ * @brief Drops the cached data of an entry.
+ *
+ * Bumping the generation makes an in-flight worker discard its result.
+ * Must be called with the mutex held.
+ *
+ * @param index Entry to evict.
+ * @param evicted Receives the evicted object, to be destroyed after unlocking.
+ */
+void Playlist::evict(size_t index, std::vector<std::unique_ptr<Object>> &evicted) {
+    PrefetchSlot &slot = m_slots[index];
+    if (slot.state == PREFETCH_ACTIVE)
+        return;
+    slot.generation++;
+    m_memoryUsed -= std::min(m_memoryUsed, slot.memory);
+    slot.memory = 0;
+    if (slot.object)
+        evicted.push_back(std::move(slot.object));
+    slot.image.pixels.reset();
+    slot.state = PREFETCH_EMPTY;
+}
+
+/**
+ * @brief Evicts the farthest prefetched entries until the cache fits the budget.
+ *
+ * Evicted entries stay empty until the next switch reschedules the window.
+ * Must be called with the mutex held, on the main thread.
+ *
+ * @param evicted Receives evicted objects, to be destroyed after unlocking.
+ */
+void Playlist::enforceBudget(std::vector<std::unique_ptr<Object>> &evicted) {
+    while (m_memoryUsed > m_settings.memoryBudget) {
+        size_t farthest = m_slots.size();
+        size_t farthestPriority = 0;
+        for (size_t i = 0; i < m_slots.size(); i++) {
+            if (m_slots[i].state != PREFETCH_READY)
+                continue;
+            const size_t priority = getPriority(i);
+            if (priority > farthestPriority) {
+                farthestPriority = priority;
+                farthest = i;
+            }
+        }
+        if (farthest == m_slots.size())
+            return;
+        evict(farthest, evicted);
+    }
+}
+
+/**
+ * @brief Unloads GPU textures no longer used by any entry of the window.
+ *
+ * Called on the main thread after evicted objects have been destroyed.
+ */
+void Playlist::releaseTextures() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unordered_set<std::string> used;
+    used.insert(m_defaultTexture);
+    for (size_t i = 0; i < m_entries.size(); i++) {
+        if (getPriority(i) != SIZE_MAX)
+            used.insert(m_entries[i].texturePath);
+    }
+
+    for (auto it = m_residentTextures.begin(); it != m_residentTextures.end();) {
+        if (used.count(*it)) {
+            ++it;
+            continue;
+        }
+        gTextureManager->unloadTexture2D(*it);
+        it = m_residentTextures.erase(it);
+    }
+}
+
+/**
+ * @brief Creates or reuses the GPU texture of an entry and assigns it to the object.
+ *
+ * Uses the prefetched image when there is one, otherwise the texture already
+ * resident in the TextureManager (loading it synchronously as a last resort),
+ * and falls back to the default texture. The image pixels are released once
+ * uploaded. Must be called on the main thread.
+ *
+ * @param object Object receiving the texture.
+ * @param image Prefetched image, possibly empty.
+ * @param entry Playlist entry of the object.
+ * @return std::string Path of the texture that was assigned.
+ */
+std::string Playlist::attachTexture(Object &object, Image &image, const PlaylistEntry &entry) {
+    std::shared_ptr<Texture2D> texture;
+    if (image.pixels)
+        texture = gTextureManager->loadTexture2D(image);
+    if (!texture)
+        texture = gTextureManager->loadTexture2D(entry.texturePath);
+    if (!texture)
+        texture = gTextureManager->loadTexture2D(m_defaultTexture);
+    image.pixels.reset();
+
+    object.setTexture2D(texture);
+    return texture ? texture->getPath() : m_defaultTexture;
+}
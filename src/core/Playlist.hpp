@@ -0,0 +1,129 @@
+/**
+ * @file Playlist.hpp
+ * @author Patryk
+ * @brief Playlist class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PLAYLIST_HPP
+#define SCOP_PLAYLIST_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "Object.hpp"
+#include "../textures/Texture2D.hpp"
+
+#define PLAYLIST_DEFAULT_PREFETCH 3
+#define PLAYLIST_DEFAULT_BUDGET_MB 1024
+
+/**
+ * @brief One model of the playlist with the texture it is shown with.
+ */
+struct PlaylistEntry {
+    std::string objPath;
+    std::string texturePath;
+};
+
+/**
+ * @brief Prefetch settings of a Playlist.
+ */
+struct PlaylistSettings {
+    size_t prefetchCount = PLAYLIST_DEFAULT_PREFETCH;
+    size_t memoryBudget = static_cast<size_t>(PLAYLIST_DEFAULT_BUDGET_MB) * 1024 * 1024;
+    bool uploadAhead = false;
+};
+
+/**
+ * @brief Loading state of a playlist entry.
+ */
+enum PrefetchState {
+    PREFETCH_EMPTY = 0,
+    PREFETCH_QUEUED,
+    PREFETCH_LOADING,
+    PREFETCH_READY,
+    PREFETCH_ACTIVE,
+    PREFETCH_FAILED
+};
+
+/**
+ * @brief Cached data of one playlist entry.
+ */
+struct PrefetchSlot {
+    PrefetchState state = PREFETCH_EMPTY;
+    unsigned int generation = 0;
+    std::unique_ptr<Object> object;
+    Image image;
+    size_t memory = 0;
+};
+
+/**
+ * @brief Ordered list of models with background prefetching.
+ *
+ * Worker threads parse the next models and decode their textures while the
+ * current one is displayed, so switching models is instant. Entries outside
+ * the prefetch window (the previous model and the next `prefetchCount`)
+ * are evicted, and prefetching pauses while the memory budget is exceeded.
+ * All GL work (uploads and destruction of uploaded objects) stays on the
+ * main thread.
+ */
+class Playlist {
+public:
+    Playlist() = default;
+    static std::unique_ptr<Playlist> create(const std::string &source, const std::string &defaultTexture,
+                                            const PlaylistSettings &settings);
+    Playlist(const Playlist &other) = delete;
+    ~Playlist();
+
+    Playlist &operator=(const Playlist &other) = delete;
+
+    bool start(std::unique_ptr<Object> &current);
+    bool select(size_t index, std::unique_ptr<Object> &current);
+    bool next(std::unique_ptr<Object> &current);
+    bool previous(std::unique_ptr<Object> &current);
+    void update();
+
+    size_t size() const;
+    size_t getCurrentIndex() const;
+    std::string getStatus() const;
+
+private:
+    std::vector<PlaylistEntry> m_entries;
+    std::vector<PrefetchSlot> m_slots;
+    PlaylistSettings m_settings;
+    std::string m_defaultTexture;
+    size_t m_current = 0;
+    size_t m_memoryUsed = 0;
+    bool m_started = false;
+
+    std::unordered_set<std::string> m_residentTextures;
+
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_slotReady;
+    bool m_stop = false;
+
+    bool collectEntries(const std::string &source, const std::string &defaultTexture);
+    bool step(bool forward, std::unique_ptr<Object> &current);
+    void workerLoop();
+    bool findJob(size_t &index) const;
+    size_t getPriority(size_t index) const;
+    bool needsImage(const std::string &texturePath, size_t except) const;
+    void schedule(std::vector<std::unique_ptr<Object>> &evicted);
+    void evict(size_t index, std::vector<std::unique_ptr<Object>> &evicted);
+    void enforceBudget(std::vector<std::unique_ptr<Object>> &evicted);
+    void releaseTextures();
+    std::string attachTexture(Object &object, Image &image, const PlaylistEntry &entry);
+};
+
+#endif //SCOP_PLAYLIST_HPP
@@ -0,0 +1,183 @@
+/**
+ * @file ProgressiveLoader.cpp
+ * @author Patryk
+ * @brief ProgressiveLoader class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <sys/stat.h>
+
+#include "ProgressiveLoader.hpp"
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Opens the progressive mesh of a model, building it and its cache first if needed.
+ *
+ * A `<model>.spm` file next to the model and not older than it is used as
+ * is: its base level is read now and the other levels by a thread. Otherwise
+ * the model is loaded in full and split into levels, all available at once,
+ * and the cache is written for the next load. Models inside asset packs are
+ * split every time, as there is nowhere to write their cache.
+ *
+ * @param filePath Path to an .obj, .ply, .stl or .smesh model.
+ * @return std::unique_ptr<ProgressiveLoader> The loader, or `nullptr` if the model cannot be loaded or has no triangles.
+ */
+std::unique_ptr<ProgressiveLoader> ProgressiveLoader::create(const std::string &filePath) {
+    std::unique_ptr<ProgressiveLoader> loader(new ProgressiveLoader());
+    loader->m_filePath = filePath;
+    loader->m_startTime = std::chrono::steady_clock::now();
+
+    const std::string cachePath = filePath + PROGRESSIVE_EXTENSION;
+    struct stat source, cache;
+    const bool onDisk = stat(filePath.c_str(), &source) == 0;
+    if (onDisk && stat(cachePath.c_str(), &cache) == 0 && cache.st_mtime >= source.st_mtime)
+        loader->m_file = ProgressiveFile::open(cachePath);
+
+    if (loader->m_file) {
+        loader->m_levels.resize(loader->m_file->getLevelCount());
+        loader->m_bounds = loader->m_file->getBounds();
+        loader->m_vertexCount = loader->m_file->getVertexCount();
+        loader->m_indexCount = loader->m_file->getIndexCount();
+        if (!loader->m_file->readLevel(0, loader->m_levels[0]))
+            return nullptr;
+        loader->m_readCount = 1;
+        if (loader->m_levels.size() > 1)
+            loader->m_reader = std::thread(&ProgressiveLoader::readerLoop, loader.get());
+    } else if (!loader->build(cachePath, onDisk)) {
+        return nullptr;
+    }
+    printf("Progressive: %zu levels%s\n", loader->m_levels.size(),
+           loader->m_file ? ", read from " PROGRESSIVE_EXTENSION " cache" : "");
+    return loader;
+}
+
+ProgressiveLoader::~ProgressiveLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    if (m_reader.joinable())
+        m_reader.join();
+}
+
+/**
+ * @brief Uploads the base level, called on the thread owning the GL context.
+ * @return std::unique_ptr<Object> Object displaying the base level, or `nullptr` on failure.
+ */
+std::unique_ptr<Object> ProgressiveLoader::start() {
+    ProgressiveLevel base;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        base = std::move(m_levels[0]);
+    }
+    const size_t baseIndices = base.indices.size();
+    std::unique_ptr<Object> object = Object::createProgressive(m_filePath, base, m_bounds, m_vertexCount,
+                                                               m_indexCount);
+    if (!object)
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_appliedCount = 1;
+    m_shownIndexCount = baseIndices;
+    printf("Progressive: base of %zu triangles (%.1f%% of %zu) shown %.1f ms after the start of the load\n",
+           baseIndices / 3, m_indexCount ? 100.0 * baseIndices / m_indexCount : 0.0, m_indexCount / 3,
+           millisecondsSince(m_startTime));
+    return object;
+}
+
+/**
+ * @brief Applies the next refinement level if it has been read, called once per rendered frame on the main thread.
+ *
+ * At most one level is applied per frame, so the upload cost is spread
+ * over the frames following the load.
+ *
+ * @param object Object returned by `start()`.
+ */
+void ProgressiveLoader::update(Object &object) {
+    ProgressiveLevel level;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_appliedCount == 0 || m_appliedCount >= m_readCount)
+            return;
+        level = std::move(m_levels[m_appliedCount]);
+    }
+    object.refineGeometry(level);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_appliedCount++;
+    m_shownIndexCount += level.indices.size();
+    if (m_appliedCount == m_levels.size())
+        printf("Progressive: full resolution of %zu triangles shown %.1f ms after the start of the load\n",
+               m_shownIndexCount / 3, millisecondsSince(m_startTime));
+}
+
+/**
+ * @brief One-line summary for the HUD: levels shown and triangles displayed.
+ */
+std::string ProgressiveLoader::getStatus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    char buffer[160];
+    snprintf(buffer, sizeof(buffer), "Level %zu/%zu, %zu of %zu triangles%s", m_appliedCount, m_levels.size(),
+             m_shownIndexCount / 3, m_indexCount / 3, m_failed ? " | cache read failed" : "");
+    return buffer;
+}
+
+/**
+ * @brief Loads the whole model and splits it into levels, writing the cache if possible.
+ * @param cachePath Path of the .spm cache.
+ * @param writeCache Whether the model is a file the cache can be written next to.
+ * @return bool true on success.
+ */
+bool ProgressiveLoader::build(const std::string &cachePath, bool writeCache) {
+    MeshSettings settings = Object::getMeshSettings();
+    settings.normals = true;
+    std::unique_ptr<Mesh> mesh = Mesh::load(m_filePath, settings);
+    if (!mesh) {
+        fprintf(stderr, "Failed to load object: %s\n", m_filePath.c_str());
+        return false;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    if (!buildProgressiveMesh(mesh->vertices, mesh->indices, m_levels)) {
+        fprintf(stderr, "%s has no triangles to refine\n", m_filePath.c_str());
+        return false;
+    }
+    m_bounds = mesh->computeBounds();
+    m_vertexCount = mesh->vertices.size();
+    m_indexCount = 0;
+    for (const ProgressiveLevel &level: m_levels)
+        m_indexCount += level.indices.size();
+    m_readCount = m_levels.size();
+    printf("Progressive: split %s in %.1f ms\n", m_filePath.c_str(), millisecondsSince(start));
+    if (writeCache && saveProgressiveMesh(cachePath, m_bounds, m_levels))
+        printf("Progressive: wrote %s\n", cachePath.c_str());
+    return true;
+}
+
+/**
+ * @brief Reads the refinement levels from the cache, in order, for `update()` to apply.
+ */
+void ProgressiveLoader::readerLoop() {
+    for (size_t i = 1; i < m_levels.size(); i++) {
+        ProgressiveLevel level;
+        const bool ok = m_file->readLevel(i, level);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stop)
+            return;
+        if (!ok) {
+            m_failed = true;
+            return;
+        }
+        m_levels[i] = std::move(level);
+        m_readCount = i + 1;
+    }
+}
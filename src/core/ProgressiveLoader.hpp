@@ -0,0 +1,72 @@
+/**
+ * @file ProgressiveLoader.hpp
+ * @author Patryk
+ * @brief ProgressiveLoader class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PROGRESSIVE_LOADER_HPP
+#define SCOP_PROGRESSIVE_LOADER_HPP
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Object.hpp"
+#include "ProgressiveMesh.hpp"
+
+/**
+ * @brief Displays a model coarse to fine from its progressive mesh cache.
+ *
+ * The first load of a model parses it in full, splits it with
+ * `buildProgressiveMesh()` and writes `<model>.spm` next to it; later loads
+ * read only the base level before showing the model, while a thread reads
+ * the refinement levels from the cache. Each rendered frame, `update()`
+ * applies the next level that has been read to the displayed object with
+ * `Object::refineGeometry()`, until the full resolution mesh is shown. All
+ * GL work stays on the main thread.
+ */
+class ProgressiveLoader {
+public:
+    static std::unique_ptr<ProgressiveLoader> create(const std::string &filePath);
+    ProgressiveLoader(const ProgressiveLoader&) = delete;
+    ~ProgressiveLoader();
+
+    ProgressiveLoader &operator=(const ProgressiveLoader&) = delete;
+
+    std::unique_ptr<Object> start();
+    void update(Object &object);
+
+    std::string getStatus() const;
+
+private:
+    ProgressiveLoader() = default;
+
+    std::string m_filePath;
+    std::unique_ptr<ProgressiveFile> m_file = nullptr;
+    std::vector<ProgressiveLevel> m_levels;
+    MeshBounds m_bounds;
+    size_t m_vertexCount = 0;
+    size_t m_indexCount = 0;
+    size_t m_shownIndexCount = 0;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    size_t m_readCount = 0;
+    size_t m_appliedCount = 0;
+    bool m_failed = false;
+    bool m_stop = false;
+    std::thread m_reader;
+    mutable std::mutex m_mutex;
+
+    bool build(const std::string &cachePath, bool writeCache);
+    void readerLoop();
+};
+
+#endif //SCOP_PROGRESSIVE_LOADER_HPP
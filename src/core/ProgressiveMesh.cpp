@@ -0,0 +1,366 @@
+/**
+ * @file ProgressiveMesh.cpp
+ * @author Patryk
+ * @brief Progressive mesh construction and cache file implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "ProgressiveMesh.hpp"
+
+/**
+ * @brief Layout of the start of a .spm file, followed by one level table entry per level.
+ */
+struct ProgressiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint32_t levelCount;
+    float center[3];
+    float min[3];
+    float max[3];
+};
+
+/**
+ * @brief Splits a mesh into a coarse base and refinement levels, by hierarchical vertex clustering.
+ *
+ * Vertices are snapped to a grid of 2^PROGRESSIVE_BASE_BITS cells per axis
+ * over the bounding cube, then to grids twice as fine up to
+ * 2^PROGRESSIVE_MAX_BITS, and a last level separates the vertices still
+ * sharing a cell. Each cell is represented by one of its own vertices, the
+ * one closest to the cell's average position; a cell keeps the vertex of
+ * its parent cell when it contains it, so refining a level only adds
+ * vertices (vertex splits) and never moves existing ones. A triangle
+ * appears at the first level where its three corners fall in different
+ * cells, and stays from then on since finer cells never merge again.
+ *
+ * Vertices and triangles are reordered by the level that introduces them,
+ * so the vertex and index buffers of every level are a prefix of the full
+ * ones. Corners of existing triangles that move to a newly split vertex
+ * are listed as updates of the level. Applying every level gives the
+ * original triangles over the original vertices, in a different order;
+ * triangles degenerate at full resolution are dropped.
+ *
+ * @param vertices Vertices of the mesh.
+ * @param indices Triangle list of the mesh.
+ * @param levels Receives the levels, base first.
+ * @return bool false if the mesh has no triangles.
+ */
+bool buildProgressiveMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                          std::vector<ProgressiveLevel> &levels) {
+    levels.clear();
+    if (vertices.empty() || indices.size() < 3)
+        return false;
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+
+    const MeshBounds bounds = computeMeshBounds(vertices);
+    float size = std::max({bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1],
+                           bounds.max[2] - bounds.min[2]});
+    if (!(size > 0.0f))
+        size = 1.0f;
+    const uint32_t cells = 1u << PROGRESSIVE_MAX_BITS;
+    std::vector<std::array<uint32_t, 3>> cell(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        for (int a = 0; a < 3; a++) {
+            const float t = (vertices[v].position[a] - bounds.min[a]) / size * static_cast<float>(cells);
+            cell[v][a] = t > 0.0f ? std::min(cells - 1, static_cast<uint32_t>(t)) : 0;
+        }
+    }
+    auto cellKey = [&cell](size_t v, int bits) {
+        const int shift = PROGRESSIVE_MAX_BITS - bits;
+        return static_cast<uint64_t>(cell[v][0] >> shift) | static_cast<uint64_t>(cell[v][1] >> shift) << bits |
+               static_cast<uint64_t>(cell[v][2] >> shift) << (2 * bits);
+    };
+
+    // Representative vertex of every vertex at each level, coarsest first
+    std::vector<std::vector<uint32_t>> reps;
+    std::vector<uint64_t> keyed(vertexCount);
+    size_t clusterCount = 0;
+    for (int bits = PROGRESSIVE_BASE_BITS; bits <= PROGRESSIVE_MAX_BITS && clusterCount < vertexCount; bits++) {
+        for (size_t v = 0; v < vertexCount; v++)
+            keyed[v] = cellKey(v, bits) << 32 | v;
+        std::sort(keyed.begin(), keyed.end());
+
+        std::vector<uint32_t> rep(vertexCount);
+        size_t count = 0;
+        for (size_t begin = 0, end = 0; begin < vertexCount; begin = end) {
+            const uint64_t key = keyed[begin] >> 32;
+            end = begin + 1;
+            while (end < vertexCount && keyed[end] >> 32 == key)
+                end++;
+            count++;
+
+            uint32_t chosen = static_cast<uint32_t>(keyed[begin]);
+            const bool inherited = !reps.empty() && cellKey(reps.back()[chosen], bits) == key;
+            if (inherited) {
+                chosen = reps.back()[chosen];
+            } else {
+                double mean[3] = {0.0, 0.0, 0.0};
+                for (size_t i = begin; i < end; i++)
+                    for (int a = 0; a < 3; a++)
+                        mean[a] += vertices[static_cast<uint32_t>(keyed[i])].position[a];
+                double best = INFINITY;
+                for (size_t i = begin; i < end; i++) {
+                    const Vertex &vertex = vertices[static_cast<uint32_t>(keyed[i])];
+                    double distance = 0.0;
+                    for (int a = 0; a < 3; a++) {
+                        const double d = vertex.position[a] - mean[a] / static_cast<double>(end - begin);
+                        distance += d * d;
+                    }
+                    if (distance < best) {
+                        best = distance;
+                        chosen = static_cast<uint32_t>(keyed[i]);
+                    }
+                }
+            }
+            for (size_t i = begin; i < end; i++)
+                rep[static_cast<uint32_t>(keyed[i])] = chosen;
+        }
+        // A resolution that splits no cell would give an empty level
+        if (count == clusterCount)
+            continue;
+        clusterCount = count;
+        reps.push_back(std::move(rep));
+    }
+    if (clusterCount < vertexCount) {
+        std::vector<uint32_t> rep(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+            rep[v] = static_cast<uint32_t>(v);
+        reps.push_back(std::move(rep));
+    }
+    const size_t levelCount = reps.size();
+
+    // Vertices are introduced at the first level representing them, and renumbered in that order
+    std::vector<uint32_t> vertexLevel(vertexCount);
+    std::vector<size_t> vertexStart(levelCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) {
+        size_t level = 0;
+        while (reps[level][v] != v)
+            level++;
+        vertexLevel[v] = static_cast<uint32_t>(level);
+        vertexStart[level + 1]++;
+    }
+    for (size_t level = 0; level < levelCount; level++)
+        vertexStart[level + 1] += vertexStart[level];
+    levels.resize(levelCount);
+    std::vector<uint32_t> newIndex(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) {
+        std::vector<Vertex> &added = levels[vertexLevel[v]].vertices;
+        newIndex[v] = static_cast<uint32_t>(vertexStart[vertexLevel[v]] + added.size());
+        added.push_back(vertices[v]);
+    }
+
+    // Triangles are introduced at the first level where their corners are distinct
+    const uint32_t never = static_cast<uint32_t>(levelCount);
+    std::vector<uint32_t> triangleLevel(triangleCount, never);
+    std::vector<size_t> triangleStart(levelCount + 1, 0);
+    for (size_t t = 0; t < triangleCount; t++) {
+        const unsigned int *corner = &indices[t * 3];
+        for (size_t level = 0; level < levelCount; level++) {
+            const std::vector<uint32_t> &rep = reps[level];
+            if (rep[corner[0]] != rep[corner[1]] && rep[corner[1]] != rep[corner[2]] &&
+                rep[corner[2]] != rep[corner[0]]) {
+                triangleLevel[t] = static_cast<uint32_t>(level);
+                triangleStart[level + 1]++;
+                break;
+            }
+        }
+    }
+    for (size_t level = 0; level < levelCount; level++)
+        triangleStart[level + 1] += triangleStart[level];
+    std::vector<uint32_t> order(triangleStart[levelCount]);
+    std::vector<size_t> next(triangleStart.begin(), triangleStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++)
+        if (triangleLevel[t] != never)
+            order[next[triangleLevel[t]]++] = static_cast<uint32_t>(t);
+
+    for (size_t level = 0; level < levelCount; level++) {
+        const std::vector<uint32_t> &rep = reps[level];
+        ProgressiveLevel &out = levels[level];
+        if (level > 0) {
+            const std::vector<uint32_t> &previous = reps[level - 1];
+            for (size_t slot = 0; slot < triangleStart[level]; slot++) {
+                for (size_t k = 0; k < 3; k++) {
+                    const unsigned int corner = indices[order[slot] * 3 + k];
+                    if (rep[corner] != previous[corner])
+                        out.updates.push_back({static_cast<uint32_t>(slot * 3 + k), newIndex[rep[corner]]});
+                }
+            }
+        }
+        out.indices.reserve((triangleStart[level + 1] - triangleStart[level]) * 3);
+        for (size_t slot = triangleStart[level]; slot < triangleStart[level + 1]; slot++)
+            for (size_t k = 0; k < 3; k++)
+                out.indices.push_back(newIndex[rep[indices[order[slot] * 3 + k]]]);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the levels of `buildProgressiveMesh()` to a .spm cache file.
+ *
+ * The file holds a header with the full resolution counts and the bounds of
+ * the original mesh, a table with the offset and counts of every level,
+ * then the levels in order, each as raw vertices, indices and updates. It
+ * is written to a temporary file renamed into place, so a reader never
+ * sees it half written.
+ *
+ * @param path Output file path.
+ * @param bounds Bounds of the full mesh, so the object does not move as levels arrive.
+ * @param levels Levels to write, base first.
+ * @return bool true if the file was written.
+ */
+bool saveProgressiveMesh(const std::string &path, const MeshBounds &bounds,
+                         const std::vector<ProgressiveLevel> &levels) {
+    ProgressiveHeader header = {PROGRESSIVE_MAGIC, PROGRESSIVE_VERSION, 0, 0,
+                                static_cast<uint32_t>(levels.size()), {}, {}, {}};
+    for (int a = 0; a < 3; a++) {
+        header.center[a] = bounds.center[a];
+        header.min[a] = bounds.min[a];
+        header.max[a] = bounds.max[a];
+    }
+    uint64_t offset = sizeof(header) + levels.size() * 4 * sizeof(uint64_t);
+    std::vector<uint64_t> table;
+    for (const ProgressiveLevel &level: levels) {
+        header.vertexCount += level.vertices.size();
+        header.indexCount += level.indices.size();
+        table.insert(table.end(), {offset, level.vertices.size(), level.indices.size(), level.updates.size()});
+        offset += level.vertices.size() * sizeof(Vertex) + level.indices.size() * sizeof(unsigned int) +
+                  level.updates.size() * sizeof(ProgressiveUpdate);
+    }
+
+    const std::string temporaryPath = path + ".tmp";
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", temporaryPath.c_str());
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(table.data(), sizeof(uint64_t), table.size(), file) == table.size();
+    for (const ProgressiveLevel &level: levels) {
+        ok = ok && fwrite(level.vertices.data(), sizeof(Vertex), level.vertices.size(), file) == level.vertices.size();
+        ok = ok && fwrite(level.indices.data(), sizeof(unsigned int), level.indices.size(), file) == level.indices.size();
+        ok = ok && fwrite(level.updates.data(), sizeof(ProgressiveUpdate), level.updates.size(), file) ==
+                   level.updates.size();
+    }
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+        remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Opens a .spm file and reads its header and level table.
+ * @param path Cache file.
+ * @return std::unique_ptr<ProgressiveFile> The open file, or nullptr if it is missing or not a valid cache.
+ */
+std::unique_ptr<ProgressiveFile> ProgressiveFile::open(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file)
+        return nullptr;
+    std::unique_ptr<ProgressiveFile> progressive(new ProgressiveFile());
+    progressive->m_file = file;
+
+    ProgressiveHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != PROGRESSIVE_MAGIC ||
+        header.version != PROGRESSIVE_VERSION || header.levelCount == 0) {
+        fprintf(stderr, "%s is not a progressive mesh\n", path.c_str());
+        return nullptr;
+    }
+    progressive->m_levels.resize(header.levelCount);
+    uint64_t vertexCount = 0, indexCount = 0;
+    for (LevelEntry &entry: progressive->m_levels) {
+        if (fread(&entry, sizeof(entry), 1, file) != 1) {
+            fprintf(stderr, "%s is truncated\n", path.c_str());
+            return nullptr;
+        }
+        vertexCount += entry.vertexCount;
+        indexCount += entry.indexCount;
+    }
+    if (vertexCount != header.vertexCount || indexCount != header.indexCount) {
+        fprintf(stderr, "%s has an inconsistent level table\n", path.c_str());
+        return nullptr;
+    }
+    progressive->m_vertexCount = header.vertexCount;
+    progressive->m_indexCount = header.indexCount;
+    for (int a = 0; a < 3; a++) {
+        progressive->m_bounds.center[a] = header.center[a];
+        progressive->m_bounds.min[a] = header.min[a];
+        progressive->m_bounds.max[a] = header.max[a];
+    }
+    return progressive;
+}
+
+ProgressiveFile::~ProgressiveFile() {
+    if (m_file)
+        fclose(m_file);
+}
+
+/**
+ * @brief Reads one level and checks that it only refers to vertices and triangles that exist by then.
+ *
+ * Levels may be read in any order, but not from several threads at once.
+ *
+ * @param level Level index, 0 for the base.
+ * @param out Receives the level.
+ * @return bool true on success.
+ */
+bool ProgressiveFile::readLevel(size_t level, ProgressiveLevel &out) {
+    if (level >= m_levels.size())
+        return false;
+    const LevelEntry &entry = m_levels[level];
+    out.vertices.resize(entry.vertexCount);
+    out.indices.resize(entry.indexCount);
+    out.updates.resize(entry.updateCount);
+    const bool ok = fseek(m_file, static_cast<long>(entry.offset), SEEK_SET) == 0 &&
+                    fread(out.vertices.data(), sizeof(Vertex), out.vertices.size(), m_file) == out.vertices.size() &&
+                    fread(out.indices.data(), sizeof(unsigned int), out.indices.size(), m_file) == out.indices.size() &&
+                    fread(out.updates.data(), sizeof(ProgressiveUpdate), out.updates.size(), m_file) ==
+                    out.updates.size();
+    if (!ok) {
+        fprintf(stderr, "Failed to read level %zu of a progressive mesh\n", level);
+        return false;
+    }
+
+    // Indices may only refer to vertices of this level or earlier ones, updates to triangles of earlier levels
+    uint64_t vertexCount = 0, indexCount = 0;
+    for (size_t i = 0; i < level; i++) {
+        vertexCount += m_levels[i].vertexCount;
+        indexCount += m_levels[i].indexCount;
+    }
+    vertexCount += entry.vertexCount;
+    bool valid = true;
+    for (unsigned int index: out.indices)
+        valid = valid && index < vertexCount;
+    for (const ProgressiveUpdate &update: out.updates)
+        valid = valid && update.position < indexCount && update.index < vertexCount;
+    if (!valid)
+        fprintf(stderr, "Level %zu of a progressive mesh refers to missing vertices\n", level);
+    return valid;
+}
+
+size_t ProgressiveFile::getLevelCount() const {
+    return m_levels.size();
+}
+
+size_t ProgressiveFile::getVertexCount() const {
+    return m_vertexCount;
+}
+
+size_t ProgressiveFile::getIndexCount() const {
+    return m_indexCount;
+}
+
+const MeshBounds &ProgressiveFile::getBounds() const {
+    return m_bounds;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file ProgressiveMesh.hpp
+ * @author Patryk
+ * @brief Progressive mesh construction and cache file declarations
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PROGRESSIVE_MESH_HPP
+#define SCOP_PROGRESSIVE_MESH_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Vertex.hpp"
+#include "Mesh.hpp"
+
+#define PROGRESSIVE_MAGIC 0x47525053u // "SPRG"
+#define PROGRESSIVE_VERSION 1u
+#define PROGRESSIVE_EXTENSION ".spm"
+// The base level clusters vertices on a grid of 2^PROGRESSIVE_BASE_BITS cells per axis,
+// each further level doubles the resolution up to 2^PROGRESSIVE_MAX_BITS
+#define PROGRESSIVE_BASE_BITS 3
+#define PROGRESSIVE_MAX_BITS 10
+
+/**
+ * @brief Index buffer corner moved to a finer vertex by a refinement level.
+ */
+struct ProgressiveUpdate {
+    uint32_t position;
+    uint32_t index;
+};
+
+/**
+ * @brief One level of a progressive mesh, applied on top of the previous ones.
+ *
+ * `vertices` are appended to the vertex buffer and `indices` (whole
+ * triangles) to the index buffer; `updates` rewrite corners of triangles
+ * added by earlier levels, so they refer to vertices of this level.
+ */
+struct ProgressiveLevel {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<ProgressiveUpdate> updates;
+};
+
+bool buildProgressiveMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices,
+                          std::vector<ProgressiveLevel> &levels);
+bool saveProgressiveMesh(const std::string &path, const MeshBounds &bounds,
+                         const std::vector<ProgressiveLevel> &levels);
+
+/**
+ * @brief Progressive mesh cache written by `saveProgressiveMesh()`, read one level at a time.
+ *
+ * Only the header and level table are read when the file is opened, so the
+ * base level can be displayed before the rest of the file is touched.
+ */
+class ProgressiveFile {
+public:
+    static std::unique_ptr<ProgressiveFile> open(const std::string &path);
+    ProgressiveFile(const ProgressiveFile&) = delete;
+    ~ProgressiveFile();
+
+    ProgressiveFile &operator=(const ProgressiveFile&) = delete;
+
+    bool readLevel(size_t level, ProgressiveLevel &out);
+
+    size_t getLevelCount() const;
+    size_t getVertexCount() const;
+    size_t getIndexCount() const;
+    const MeshBounds &getBounds() const;
+
+private:
+    ProgressiveFile() = default;
+
+    struct LevelEntry {
+        uint64_t offset;
+        uint64_t vertexCount;
+        uint64_t indexCount;
+        uint64_t updateCount;
+    };
+
+    FILE *m_file = nullptr;
+    std::vector<LevelEntry> m_levels;
+    size_t m_vertexCount = 0;
+    size_t m_indexCount = 0;
+    MeshBounds m_bounds;
+};
+
+#endif //SCOP_PROGRESSIVE_MESH_HPP
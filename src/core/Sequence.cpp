@@ -0,0 +1,409 @@
+/**
+ * @file Sequence.cpp
+ * @author Patryk
+ * @brief Sequence class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "Sequence.hpp"
+#include "../io/Asset.hpp"
+#include "../io/AssetPack.hpp"
+
+static bool hasExtension(const std::string &path, const std::string &extension) {
+    return path.size() > extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * @brief Checks whether a file can be a frame: .obj, .ply, .stl or .smesh, but not the .smesh cache of another frame.
+ */
+static bool isFrameFile(const std::string &path) {
+    if (hasExtension(path, MESH_CODEC_EXTENSION)) {
+        const std::string source = path.substr(0, path.size() - std::string(MESH_CODEC_EXTENSION).size());
+        return !hasExtension(source, ".obj") && !hasExtension(source, ".ply") && !hasExtension(source, ".stl");
+    }
+    return hasExtension(path, ".obj") || hasExtension(path, ".ply") || hasExtension(path, ".stl");
+}
+
+/**
+ * @brief Orders file names with digit runs compared as numbers, so `frame_9` comes before `frame_10`.
+ */
+static bool naturalLess(const std::string &a, const std::string &b) {
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        if (isdigit(static_cast<unsigned char>(a[i])) && isdigit(static_cast<unsigned char>(b[j]))) {
+            size_t endA = i, endB = j;
+            while (endA < a.size() && isdigit(static_cast<unsigned char>(a[endA])))
+                endA++;
+            while (endB < b.size() && isdigit(static_cast<unsigned char>(b[endB])))
+                endB++;
+            // Skip leading zeros, then the longer number is the larger one
+            while (i + 1 < endA && a[i] == '0')
+                i++;
+            while (j + 1 < endB && b[j] == '0')
+                j++;
+            if (endA - i != endB - j)
+                return endA - i < endB - j;
+            const int order = a.compare(i, endA - i, b, j, endB - j);
+            if (order != 0)
+                return order < 0;
+            i = endA;
+            j = endB;
+        } else {
+            if (a[i] != b[j])
+                return a[i] < b[j];
+            i++;
+            j++;
+        }
+    }
+    return a.size() - i < b.size() - j;
+}
+
+/**
+ * @brief Creates a sequence and starts its decoding workers.
+ *
+ * The source can be:
+ * - a directory: every `.obj`, `.ply`, `.stl` and `.smesh` file inside it, in
+ *   natural name order (`frame_2` before `frame_10`),
+ * - a list file: one frame path per line, `#` starts a comment,
+ * - a directory inside a mounted asset pack.
+ *
+ * @param source Directory or list file.
+ * @param settings Playback settings.
+ * @return std::unique_ptr<Sequence> Sequence, or `nullptr` if the source holds no frames.
+ */
+std::unique_ptr<Sequence> Sequence::create(const std::string &source, const SequenceSettings &settings) {
+    std::unique_ptr<Sequence> sequence(new Sequence());
+    sequence->m_settings = settings;
+
+    if (!sequence->collectFrames(source) || sequence->m_frames.empty()) {
+        fprintf(stderr, "Sequence %s contains no frames\n", source.c_str());
+        return nullptr;
+    }
+    sequence->m_slots.resize(settings.ringSize);
+
+    // A single frame never changes, so there is nothing to decode ahead
+    unsigned int workerCount = std::min(static_cast<unsigned int>(SEQUENCE_WORKERS), std::thread::hardware_concurrency());
+    if (workerCount == 0)
+        workerCount = 1;
+    if (sequence->m_frames.size() == 1)
+        workerCount = 0;
+    for (unsigned int i = 0; i < workerCount; i++)
+        sequence->m_workers.push_back(std::thread(&Sequence::workerLoop, sequence.get()));
+
+    printf("Sequence: %zu frames at %g fps, decoding %zu ahead with %u workers%s\n", sequence->m_frames.size(),
+           settings.fps, settings.ringSize, workerCount, settings.cache ? ", through the " MESH_CODEC_EXTENSION " cache" : "");
+    return sequence;
+}
+
+Sequence::~Sequence() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_slotFree.notify_all();
+    for (std::thread &worker: m_workers)
+        worker.join();
+}
+
+/**
+ * @brief Loads and uploads the first frame, and starts the playback clock.
+ *
+ * The first frame is loaded like a regular model, so its material and
+ * sub-mesh are those of the whole animation; later frames only replace its
+ * geometry. Must be called on the thread owning the GL context.
+ *
+ * @return std::unique_ptr<Object> Object displaying the sequence, or `nullptr` if the first frame cannot be loaded.
+ */
+std::unique_ptr<Object> Sequence::start() {
+    std::unique_ptr<Object> object = Object::create(m_frames[0]);
+    if (!object)
+        return nullptr;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_startTime = std::chrono::steady_clock::now();
+    m_shownCount = 1;
+    return object;
+}
+
+/**
+ * @brief Shows the frame due at the target rate, called once per rendered frame on the main thread.
+ *
+ * Takes the newest decoded frame not later than the one due: frames
+ * between it and the previously shown one are counted as dropped, and a
+ * frame shown after its time has passed as late. If nothing newer has been
+ * decoded, the current frame stays on screen. The geometry is uploaded
+ * outside the lock with `Object::streamGeometry()`.
+ *
+ * @param object Object returned by `start()`.
+ */
+void Sequence::update(Object &object) {
+    if (m_workers.empty())
+        return;
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+    const size_t due = static_cast<size_t>(elapsed.count() * m_settings.fps);
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (due <= m_shownTicket)
+            return;
+        m_dueTicket = due;
+
+        SequenceSlot *best = nullptr;
+        for (SequenceSlot &slot: m_slots) {
+            if ((slot.state == SEQUENCE_READY || slot.state == SEQUENCE_FAILED) && slot.ticket > m_shownTicket &&
+                slot.ticket <= due && (!best || slot.ticket > best->ticket))
+                best = &slot;
+        }
+        if (!best) {
+            m_slotFree.notify_all();
+            return;
+        }
+
+        m_droppedCount += best->ticket - m_shownTicket - 1;
+        m_shownTicket = best->ticket;
+        if (best->state == SEQUENCE_FAILED) {
+            m_droppedCount++;
+        } else {
+            vertices.swap(best->vertices);
+            indices.swap(best->indices);
+            m_shownCount++;
+            if (best->ticket < due)
+                m_lateCount++;
+        }
+        // Frames older than the one shown will never be displayed
+        for (SequenceSlot &slot: m_slots) {
+            if (slot.state != SEQUENCE_LOADING && slot.ticket <= m_shownTicket) {
+                slot.state = SEQUENCE_EMPTY;
+                slot.vertices.clear();
+                slot.indices.clear();
+            }
+        }
+    }
+    m_slotFree.notify_all();
+    if (vertices.empty())
+        return;
+
+    const auto start = std::chrono::steady_clock::now();
+    object.streamGeometry(vertices, indices);
+    const std::chrono::duration<double, std::milli> uploadTime = std::chrono::steady_clock::now() - start;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_uploadTime += uploadTime.count();
+    if (const RingBuffer *ring = object.getStreamBuffer()) {
+        m_stallCount = ring->getStallCount();
+        m_stallTime = ring->getStallTime();
+        m_persistent = ring->isPersistent();
+    }
+}
+
+size_t Sequence::size() const {
+    return m_frames.size();
+}
+
+/**
+ * @brief Returns a one-line description of the playback for the HUD.
+ * @return std::string Current frame, decoded frames in the ring, dropped frames and upload stalls.
+ */
+std::string Sequence::getStatus() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t ready = 0;
+    for (const SequenceSlot &slot: m_slots) {
+        if (slot.state == SEQUENCE_READY && slot.ticket > m_shownTicket)
+            ready++;
+    }
+    const size_t total = m_shownCount + m_droppedCount;
+    char buffer[512];
+    snprintf(buffer, sizeof(buffer), "Frame %zu/%zu at %g fps | decoded ahead %zu/%zu | dropped %zu (%.1f%%), late %zu | "
+             "%s upload stalls %zu", m_shownTicket % m_frames.size() + 1, m_frames.size(), m_settings.fps, ready,
+             m_slots.size(), m_droppedCount, total ? 100.0 * m_droppedCount / total : 0.0, m_lateCount,
+             m_persistent ? "persistent" : "unsynchronized", m_stallCount);
+    return buffer;
+}
+
+/**
+ * @brief Prints the playback statistics: frames shown and dropped, effective rate, decode and upload times, upload stalls.
+ */
+void Sequence::printStatistics() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_startTime;
+    const size_t total = m_shownCount + m_droppedCount;
+    printf("Sequence: %zu frames shown in %.1f s (%.1f fps, target %g), %zu dropped (%.1f%%), %zu late\n",
+           m_shownCount, elapsed.count(), elapsed.count() > 0.0 ? m_shownCount / elapsed.count() : 0.0,
+           m_settings.fps, m_droppedCount, total ? 100.0 * m_droppedCount / total : 0.0, m_lateCount);
+    printf("Sequence: %.1f ms decode per frame on %zu workers, %.2f ms upload per frame (%s mapping, %zu stalls, "
+           "%.1f ms waiting)\n", m_decodedCount ? m_decodeTime / m_decodedCount : 0.0, m_workers.size(),
+           m_shownCount > 1 ? m_uploadTime / (m_shownCount - 1) : 0.0, m_persistent ? "persistent" : "unsynchronized",
+           m_stallCount, m_stallTime);
+}
+
+/**
+ * @brief Fills the frame list from a directory, a list file or a packed directory.
+ * @param source Directory or list file.
+ * @return bool true if the source could be read.
+ */
+bool Sequence::collectFrames(const std::string &source) {
+    struct stat st;
+    if (stat(source.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR *dir = opendir(source.c_str());
+        if (!dir)
+            return false;
+        std::vector<std::string> names;
+        while (const dirent *entry = readdir(dir)) {
+            if (entry->d_name[0] != '.' && isFrameFile(entry->d_name))
+                names.push_back(entry->d_name);
+        }
+        closedir(dir);
+        std::sort(names.begin(), names.end(), naturalLess);
+        for (const std::string &name: names)
+            m_frames.push_back(source + "/" + name);
+        return true;
+    }
+
+    const std::unique_ptr<Asset> list = Asset::load(source);
+    if (list) {
+        AssetStream stream(*list);
+        std::string line;
+        while (getline(stream, line)) {
+            std::istringstream ss(line);
+            std::string path;
+            if ((ss >> path) && path[0] != '#')
+                m_frames.push_back(path);
+        }
+        return true;
+    }
+
+    for (const auto &pack: AssetPack::getMounted()) {
+        for (const std::string &path: pack->list(source + "/")) {
+            if (isFrameFile(path))
+                m_frames.push_back(path);
+        }
+        if (!m_frames.empty()) {
+            std::sort(m_frames.begin(), m_frames.end(), naturalLess);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Body of the decoding worker threads.
+ *
+ * Claims the next ticket whose ring slot is free, decodes the frame
+ * without holding the lock and publishes it. A slot is not overwritten
+ * while it holds a frame that may still be shown, which bounds how far
+ * ahead the workers run.
+ */
+void Sequence::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        size_t ticket = 0;
+        m_slotFree.wait(lock, [this, &ticket]() { return m_stop || claimTicket(ticket); });
+        if (m_stop)
+            return;
+
+        SequenceSlot &slot = m_slots[ticket % m_slots.size()];
+        slot.state = SEQUENCE_LOADING;
+        slot.ticket = ticket;
+        const std::string path = m_frames[ticket % m_frames.size()];
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        const bool loaded = decodeFrame(path, ticket, vertices, indices) && !vertices.empty();
+        const std::chrono::duration<double, std::milli> decodeTime = std::chrono::steady_clock::now() - start;
+        if (!loaded)
+            fprintf(stderr, "Sequence: failed to load frame %s\n", path.c_str());
+
+        lock.lock();
+        slot.vertices.swap(vertices);
+        slot.indices.swap(indices);
+        slot.state = loaded ? SEQUENCE_READY : SEQUENCE_FAILED;
+        m_decodeTime += decodeTime.count();
+        m_decodedCount++;
+        lock.unlock();
+        // Release the previous contents of the slot outside the lock
+        vertices.clear();
+        vertices.shrink_to_fit();
+        indices.clear();
+        indices.shrink_to_fit();
+        lock.lock();
+    }
+}
+
+/**
+ * @brief Picks the next ticket to decode, skipping the frames already overdue.
+ *
+ * Must be called with the mutex held.
+ *
+ * @param ticket Output ticket.
+ * @return bool true if the ticket's ring slot is free to be filled.
+ */
+bool Sequence::claimTicket(size_t &ticket) {
+    const size_t next = std::max(m_nextTicket, m_dueTicket);
+    const SequenceSlot &slot = m_slots[next % m_slots.size()];
+    if (slot.state == SEQUENCE_LOADING)
+        return false;
+    // A finished frame may still be shown until a newer frame is due
+    if (slot.state != SEQUENCE_EMPTY && slot.ticket >= m_dueTicket)
+        return false;
+    ticket = next;
+    m_nextTicket = next + 1;
+    return true;
+}
+
+/**
+ * @brief Loads the geometry of one frame, through its .smesh cache when enabled.
+ *
+ * With the cache enabled, a `<frame>.smesh` file next to the frame and not
+ * older than it is decoded instead of the frame itself; otherwise the frame
+ * is loaded and the cache written, through a temporary file renamed into
+ * place so other workers never read it half written. Frames inside asset
+ * packs are not cached.
+ *
+ * @param path Frame file.
+ * @param ticket Ticket of the frame, used to name the temporary file.
+ * @param vertices Receives the vertices.
+ * @param indices Receives the triangle list.
+ * @return bool true on success.
+ */
+bool Sequence::decodeFrame(const std::string &path, size_t ticket, std::vector<Vertex> &vertices,
+                           std::vector<unsigned int> &indices) const {
+    struct stat source;
+    if (!m_settings.cache || hasExtension(path, MESH_CODEC_EXTENSION) || stat(path.c_str(), &source) != 0)
+        return Object::loadGeometry(path, vertices, indices);
+
+    const std::string cachePath = path + MESH_CODEC_EXTENSION;
+    struct stat cache;
+    if (stat(cachePath.c_str(), &cache) == 0 && cache.st_mtime >= source.st_mtime &&
+        Object::loadGeometry(cachePath, vertices, indices))
+        return true;
+    if (!Object::loadGeometry(path, vertices, indices))
+        return false;
+
+    const std::vector<char> encoded = encodeMesh(vertices, indices);
+    const std::string temporaryPath = cachePath + "." + std::to_string(ticket);
+    FILE *file = fopen(temporaryPath.c_str(), "wb");
+    if (!file)
+        return true;
+    const bool written = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+    if (fclose(file) != 0 || !written || rename(temporaryPath.c_str(), cachePath.c_str()) != 0) {
+        fprintf(stderr, "Failed to write frame cache %s\n", cachePath.c_str());
+        remove(temporaryPath.c_str());
+    }
+    return true;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file Sequence.hpp
+ * @author Patryk
+ * @brief Sequence class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_SEQUENCE_HPP
+#define SCOP_SEQUENCE_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Object.hpp"
+
+#define SEQUENCE_DEFAULT_FPS 30.0f
+#define SEQUENCE_DEFAULT_RING 8
+#define SEQUENCE_WORKERS 2
+
+/**
+ * @brief Playback settings of a Sequence.
+ */
+struct SequenceSettings {
+    float fps = SEQUENCE_DEFAULT_FPS;
+    size_t ringSize = SEQUENCE_DEFAULT_RING;
+    bool cache = false;
+};
+
+/**
+ * @brief Decoding state of a ring slot.
+ */
+enum SequenceSlotState {
+    SEQUENCE_EMPTY = 0,
+    SEQUENCE_LOADING,
+    SEQUENCE_READY,
+    SEQUENCE_FAILED
+};
+
+/**
+ * @brief One decoded frame waiting in the ring.
+ *
+ * `ticket` counts frames since the start of playback, so it keeps growing
+ * when the sequence loops; the file shown is `ticket % frame count`.
+ */
+struct SequenceSlot {
+    SequenceSlotState state = SEQUENCE_EMPTY;
+    size_t ticket = 0;
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+};
+
+/**
+ * @brief Plays a series of model files as a mesh animation.
+ *
+ * Worker threads decode the upcoming frames into a bounded ring while the
+ * current one is displayed. Each rendered frame, `update()` picks the frame
+ * due at the target rate, streams its geometry into the displayed object
+ * and counts the frames that were skipped because they were not decoded in
+ * time. When playback falls behind, workers skip ahead to the frame due
+ * instead of decoding frames that would be dropped anyway. All GL work stays
+ * on the main thread.
+ */
+class Sequence {
+public:
+    Sequence() = default;
+    static std::unique_ptr<Sequence> create(const std::string &source, const SequenceSettings &settings);
+    Sequence(const Sequence &other) = delete;
+    ~Sequence();
+
+    Sequence &operator=(const Sequence &other) = delete;
+
+    std::unique_ptr<Object> start();
+    void update(Object &object);
+
+    size_t size() const;
+    std::string getStatus() const;
+    void printStatistics() const;
+
+private:
+    std::vector<std::string> m_frames;
+    std::vector<SequenceSlot> m_slots;
+    SequenceSettings m_settings;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    size_t m_nextTicket = 1;
+    size_t m_dueTicket = 0;
+    size_t m_shownTicket = 0;
+    size_t m_shownCount = 0;
+    size_t m_droppedCount = 0;
+    size_t m_lateCount = 0;
+    size_t m_decodedCount = 0;
+    double m_decodeTime = 0.0;
+    double m_uploadTime = 0.0;
+    size_t m_stallCount = 0;
+    double m_stallTime = 0.0;
+    bool m_persistent = false;
+
+    std::vector<std::thread> m_workers;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_slotFree;
+    bool m_stop = false;
+
+    bool collectFrames(const std::string &source);
+    void workerLoop();
+    bool claimTicket(size_t &ticket);
+    bool decodeFrame(const std::string &path, size_t ticket, std::vector<Vertex> &vertices,
+                     std::vector<unsigned int> &indices) const;
+};
+
+#endif //SCOP_SEQUENCE_HPP
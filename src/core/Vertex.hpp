@@ -0,0 +1,26 @@
+/**
+ * @file Vertex.hpp
+ * @author Patryk
+ * @brief Vertex structure declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_VERTEX_HPP
+#define SCOP_VERTEX_HPP
+
+#include <array>
+
+/**
+ * @brief Represents a single vertex with position and texture coordinates.
+ */
+struct Vertex {
+    std::array<float, 3> position;
+    std::array<float, 2> uv;
+    std::array<float, 3> normal;
+};
+
+#endif //SCOP_VERTEX_HPP
@@ -0,0 +1,283 @@
+/**
+ * @file Weld.cpp
+ * @author Patryk
+ * @brief Vertex welding through a spatial hash grid
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "Weld.hpp"
+#include "../utils/Parallel.hpp"
+
+#define WELD_NONE 0xFFFFFFFFu
+#define WELD_EMPTY_KEY 0xFFFFFFFFFFFFFFFFull
+#define WELD_AXIS_BITS 21
+#define WELD_AXIS_MAX ((1u << WELD_AXIS_BITS) - 2)
+
+static uint64_t mixBits(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief Open-addressing map from a grid cell to the last point registered in it.
+ */
+class CellTable {
+public:
+    void reserve(size_t count) {
+        size_t capacity = 16;
+        while (capacity < count * 2)
+            capacity *= 2;
+        m_slots.assign(capacity, Slot());
+        m_mask = capacity - 1;
+    }
+
+    unsigned int find(uint64_t key, uint64_t hash) const {
+        for (size_t slot = hash & m_mask;; slot = (slot + 1) & m_mask) {
+            if (m_slots[slot].key == key)
+                return m_slots[slot].head;
+            if (m_slots[slot].key == WELD_EMPTY_KEY)
+                return WELD_NONE;
+        }
+    }
+
+    unsigned int &insert(uint64_t key, uint64_t hash) {
+        size_t slot = hash & m_mask;
+        while (m_slots[slot].key != key && m_slots[slot].key != WELD_EMPTY_KEY)
+            slot = (slot + 1) & m_mask;
+        m_slots[slot].key = key;
+        return m_slots[slot].head;
+    }
+
+private:
+    struct Slot {
+        uint64_t key = WELD_EMPTY_KEY;
+        unsigned int head = WELD_NONE;
+    };
+
+    std::vector<Slot> m_slots;
+    size_t m_mask = 0;
+};
+
+/**
+ * @brief Merges points closer than a tolerance into shared vertices.
+ *
+ * Points are binned into a hash grid whose cells are twice the weld
+ * distance wide, so a point only has to be compared with the points of its
+ * own cell and of the (at most 7) neighbouring cells on the sides it is
+ * closest to. Cells are split into partitions by hash and every partition
+ * is welded by one thread with its own table; a second parallel pass merges
+ * representatives that ended up in neighbouring cells. A point is always
+ * mapped to a point with a lower index, so the result does not depend on
+ * the thread count.
+ *
+ * With a tolerance below WELD_MIN_TOLERANCE only bitwise identical
+ * positions are merged.
+ *
+ * @param points Input positions, e.g. three per triangle.
+ * @param tolerance Weld distance as a fraction of the largest bounding box dimension.
+ * @param unique Receives the welded positions, in order of first appearance.
+ * @param remap Receives, for every input point, the index of its welded position.
+ */
+void weldPoints(const std::vector<std::array<float, 3>> &points, float tolerance,
+                std::vector<std::array<float, 3>> &unique, std::vector<unsigned int> &remap) {
+    const size_t count = points.size();
+    const size_t blocks = (count + WELD_GRAIN - 1) / WELD_GRAIN;
+    unique.clear();
+    remap.assign(count, 0);
+    if (count == 0)
+        return;
+
+    // Bounds, reduced per block
+    std::vector<std::array<float, 3>> blockMin(blocks, points[0]), blockMax(blocks, points[0]);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            for (size_t i = b * WELD_GRAIN; i < std::min(count, (b + 1) * WELD_GRAIN); i++) {
+                for (int a = 0; a < 3; a++) {
+                    blockMin[b][a] = std::min(blockMin[b][a], points[i][a]);
+                    blockMax[b][a] = std::max(blockMax[b][a], points[i][a]);
+                }
+            }
+        }
+    });
+    std::array<float, 3> min = blockMin[0], max = blockMax[0];
+    for (size_t b = 1; b < blocks; b++) {
+        for (int a = 0; a < 3; a++) {
+            min[a] = std::min(min[a], blockMin[b][a]);
+            max[a] = std::max(max[a], blockMax[b][a]);
+        }
+    }
+    const float extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+    const bool exact = tolerance < WELD_MIN_TOLERANCE || !(extent > 0.0f);
+    const float distance = exact ? 0.0f : tolerance * extent;
+    const float distanceSquared = distance * distance;
+    const float inverseCell = exact ? 0.0f : 1.0f / (2.0f * distance);
+
+    auto cellOf = [&](const std::array<float, 3> &p, int axis) {
+        const float q = (p[axis] - min[axis]) * inverseCell;
+        return std::min(static_cast<uint64_t>(q), static_cast<uint64_t>(WELD_AXIS_MAX));
+    };
+    auto same = [&](const std::array<float, 3> &a, const std::array<float, 3> &b) {
+        if (exact)
+            return !memcmp(a.data(), b.data(), sizeof(a));
+        const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+        return dx * dx + dy * dy + dz * dz <= distanceSquared;
+    };
+
+    std::vector<uint64_t> keys(count);
+    parallelFor(0, count, WELD_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const std::array<float, 3> &p = points[i];
+            uint64_t key;
+            if (exact) {
+                uint32_t bits[3];
+                memcpy(bits, p.data(), sizeof(bits));
+                key = mixBits(bits[0] | static_cast<uint64_t>(bits[1]) << 32) ^ bits[2];
+            } else {
+                key = cellOf(p, 0) | cellOf(p, 1) << WELD_AXIS_BITS | cellOf(p, 2) << (2 * WELD_AXIS_BITS);
+            }
+            keys[i] = key == WELD_EMPTY_KEY ? key - 1 : key;
+        }
+    });
+
+    // Stable counting scatter of the points into partitions of cells
+    const size_t partitions = std::max<size_t>(1, getWorkerCount() * 4);
+    auto partitionOf = [partitions](uint64_t hash) { return static_cast<size_t>(hash >> 40) % partitions; };
+    std::vector<size_t> offsets(blocks * partitions, 0);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            for (size_t i = b * WELD_GRAIN; i < std::min(count, (b + 1) * WELD_GRAIN); i++)
+                offsets[b * partitions + partitionOf(mixBits(keys[i]))]++;
+        }
+    });
+    std::vector<size_t> partitionStart(partitions + 1, 0);
+    size_t total = 0;
+    for (size_t part = 0; part < partitions; part++) {
+        partitionStart[part] = total;
+        for (size_t b = 0; b < blocks; b++) {
+            const size_t size = offsets[b * partitions + part];
+            offsets[b * partitions + part] = total;
+            total += size;
+        }
+    }
+    partitionStart[partitions] = total;
+    std::vector<unsigned int> order(count);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            for (size_t i = b * WELD_GRAIN; i < std::min(count, (b + 1) * WELD_GRAIN); i++)
+                order[offsets[b * partitions + partitionOf(mixBits(keys[i]))]++] = static_cast<unsigned int>(i);
+        }
+    });
+
+    // Weld inside each cell; `links` points every point to an earlier representative
+    std::vector<CellTable> tables(partitions);
+    std::vector<unsigned int> next(count, WELD_NONE);
+    std::vector<unsigned int> links(count);
+    parallelFor(0, partitions, 1, [&](size_t partBegin, size_t partEnd) {
+        for (size_t part = partBegin; part < partEnd; part++) {
+            CellTable &table = tables[part];
+            table.reserve(partitionStart[part + 1] - partitionStart[part]);
+            for (size_t k = partitionStart[part]; k < partitionStart[part + 1]; k++) {
+                const unsigned int i = order[k];
+                unsigned int &head = table.insert(keys[i], mixBits(keys[i]));
+                unsigned int representative = head;
+                while (representative != WELD_NONE && !same(points[representative], points[i]))
+                    representative = next[representative];
+                if (representative != WELD_NONE) {
+                    links[i] = representative;
+                } else {
+                    links[i] = i;
+                    next[i] = head;
+                    head = i;
+                }
+            }
+        }
+    });
+
+    // Merge representatives with earlier ones in the neighbouring cells
+    if (!exact) {
+        parallelFor(0, partitions, 1, [&](size_t partBegin, size_t partEnd) {
+            for (size_t part = partBegin; part < partEnd; part++) {
+                for (size_t k = partitionStart[part]; k < partitionStart[part + 1]; k++) {
+                    const unsigned int r = order[k];
+                    if (links[r] != r)
+                        continue;
+                    const std::array<float, 3> &p = points[r];
+                    uint64_t cell[3];
+                    int side[3];
+                    for (int a = 0; a < 3; a++) {
+                        cell[a] = cellOf(p, a);
+                        const float fraction = (p[a] - min[a]) * inverseCell - static_cast<float>(cell[a]);
+                        side[a] = fraction < 0.5f ? -1 : 1;
+                    }
+                    unsigned int best = r;
+                    for (int mask = 1; mask < 8; mask++) {
+                        uint64_t neighbour[3];
+                        bool valid = true;
+                        for (int a = 0; a < 3; a++) {
+                            neighbour[a] = cell[a] + ((mask >> a) & 1 ? side[a] : 0);
+                            valid = valid && neighbour[a] <= WELD_AXIS_MAX;
+                        }
+                        if (!valid)
+                            continue;
+                        const uint64_t key = neighbour[0] | neighbour[1] << WELD_AXIS_BITS |
+                                             neighbour[2] << (2 * WELD_AXIS_BITS);
+                        const uint64_t hash = mixBits(key);
+                        for (unsigned int s = tables[partitionOf(hash)].find(key, hash); s != WELD_NONE; s = next[s]) {
+                            if (s < best && same(points[s], p))
+                                best = s;
+                        }
+                    }
+                    links[r] = best;
+                }
+            }
+        });
+    }
+
+    // Number the roots in input order, then map every point to its root
+    std::vector<size_t> blockRoots(blocks, 0);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            for (size_t i = b * WELD_GRAIN; i < std::min(count, (b + 1) * WELD_GRAIN); i++)
+                blockRoots[b] += links[i] == i;
+        }
+    });
+    size_t roots = 0;
+    for (size_t b = 0; b < blocks; b++) {
+        const size_t size = blockRoots[b];
+        blockRoots[b] = roots;
+        roots += size;
+    }
+    unique.resize(roots);
+    parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+        for (size_t b = blockBegin; b < blockEnd; b++) {
+            size_t id = blockRoots[b];
+            for (size_t i = b * WELD_GRAIN; i < std::min(count, (b + 1) * WELD_GRAIN); i++) {
+                if (links[i] != i)
+                    continue;
+                remap[i] = static_cast<unsigned int>(id);
+                unique[id++] = points[i];
+            }
+        }
+    });
+    parallelFor(0, count, WELD_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            unsigned int root = links[i];
+            while (links[root] != root)
+                root = links[root];
+            if (root != i)
+                remap[i] = remap[root];
+        }
+    });
+}
@@ -0,0 +1,25 @@
+/**
+ * @file Weld.hpp
+ * @author Patryk
+ * @brief Vertex welding declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_WELD_HPP
+#define SCOP_WELD_HPP
+
+#include <array>
+#include <vector>
+
+#define WELD_DEFAULT_TOLERANCE 1e-5f
+#define WELD_MIN_TOLERANCE 1e-6f
+#define WELD_GRAIN 65536
+
+void weldPoints(const std::vector<std::array<float, 3>> &points, float tolerance,
+                std::vector<std::array<float, 3>> &unique, std::vector<unsigned int> &remap);
+
+#endif //SCOP_WELD_HPP
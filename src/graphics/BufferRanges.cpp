@@ -0,0 +1,86 @@
+/**
+ * @file BufferRanges.cpp
+ * @author Patryk
+ * @brief Dirty byte ranges of GPU buffers implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+
+#include "BufferRanges.hpp"
+
+/**
+ * @brief Sorts ranges and merges those that overlap or are separated by fewer than `gap` bytes.
+ *
+ * Each glBufferSubData call has a fixed cost, so re-uploading a few
+ * unchanged bytes between two edits is cheaper than a second call.
+ * Empty ranges are dropped.
+ *
+ * @param ranges Ranges to coalesce, replaced by the result.
+ * @param gap Largest number of unchanged bytes merged into a range.
+ */
+void coalesceRanges(std::vector<BufferRange> &ranges, size_t gap) {
+    ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [](const BufferRange &range) {
+        return range.size == 0;
+    }), ranges.end());
+    if (ranges.empty())
+        return;
+    std::sort(ranges.begin(), ranges.end(), [](const BufferRange &a, const BufferRange &b) {
+        return a.offset < b.offset;
+    });
+
+    size_t last = 0;
+    for (size_t i = 1; i < ranges.size(); i++) {
+        BufferRange &current = ranges[last];
+        const size_t end = current.offset + current.size;
+        if (ranges[i].offset <= end + gap) {
+            current.size = std::max(end, ranges[i].offset + ranges[i].size) - current.offset;
+        } else {
+            ranges[++last] = ranges[i];
+        }
+    }
+    ranges.resize(last + 1);
+}
+
+/**
+ * @brief Records a modified byte range.
+ * @param offset Offset in bytes of the first modified byte.
+ * @param size Number of modified bytes.
+ */
+void DirtyRanges::mark(size_t offset, size_t size) {
+    if (size == 0)
+        return;
+    // Consecutive edits (e.g. a brush stroke) usually extend the previous range
+    if (!m_ranges.empty()) {
+        BufferRange &previous = m_ranges.back();
+        if (offset >= previous.offset && offset <= previous.offset + previous.size) {
+            previous.size = std::max(previous.size, offset + size - previous.offset);
+            return;
+        }
+    }
+    m_ranges.push_back({offset, size});
+}
+
+/**
+ * @brief Returns the coalesced ranges marked so far and forgets them.
+ * @param gap Largest number of unchanged bytes merged into a range.
+ * @return std::vector<BufferRange> Sorted, non-overlapping ranges.
+ */
+std::vector<BufferRange> DirtyRanges::take(size_t gap) {
+    std::vector<BufferRange> ranges;
+    ranges.swap(m_ranges);
+    coalesceRanges(ranges, gap);
+    return ranges;
+}
+
+bool DirtyRanges::empty() const {
+    return m_ranges.empty();
+}
+
+void DirtyRanges::clear() {
+    m_ranges.clear();
+}
@@ -0,0 +1,51 @@
+/**
+ * @file BufferRanges.hpp
+ * @author Patryk
+ * @brief Dirty byte ranges of GPU buffers declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_BUFFER_RANGES_HPP
+#define SCOP_BUFFER_RANGES_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Ranges closer than this many bytes are uploaded as one
+#define BUFFER_COALESCE_GAP 1024
+
+/**
+ * @brief A byte range of a buffer.
+ */
+struct BufferRange {
+    size_t offset;
+    size_t size;
+};
+
+void coalesceRanges(std::vector<BufferRange> &ranges, size_t gap = BUFFER_COALESCE_GAP);
+
+/**
+ * @brief Collects the parts of a CPU copy modified since its last upload.
+ *
+ * Edits are marked as they happen, in any order and possibly overlapping;
+ * `take()` returns them sorted and coalesced, ready for
+ * `VertexBuffer::updateRanges()` or `IndexBuffer::updateRanges()`.
+ */
+class DirtyRanges {
+public:
+    DirtyRanges() = default;
+
+    void mark(size_t offset, size_t size);
+    std::vector<BufferRange> take(size_t gap = BUFFER_COALESCE_GAP);
+    bool empty() const;
+    void clear();
+
+private:
+    std::vector<BufferRange> m_ranges;
+};
+
+#endif //SCOP_BUFFER_RANGES_HPP
@@ -0,0 +1,162 @@
+/**
+ * @file Impostor.cpp
+ * @author Patryk
+ * @brief Impostor class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "Impostor.hpp"
+
+/**
+ * @brief Creates the atlas textures, depth buffer and framebuffer.
+ * @param center Center of the mesh's bounding sphere, in object space.
+ * @param radius Radius of the bounding sphere.
+ * @return std::unique_ptr<Impostor> The atlas, or nullptr if the framebuffer is incomplete.
+ */
+std::unique_ptr<Impostor> Impostor::create(const std::array<float, 3> &center, float radius) {
+    std::unique_ptr<Impostor> impostor(new Impostor());
+    impostor->m_center = center;
+    impostor->m_radius = radius > 0.0f ? radius : 1.0f;
+
+    const int width = IMPOSTOR_AZIMUTHS * IMPOSTOR_VIEW_SIZE;
+    const int height = IMPOSTOR_ELEVATIONS * IMPOSTOR_VIEW_SIZE;
+    glGenTextures(IMPOSTOR_TARGETS, impostor->m_textures);
+    for (unsigned int texture: impostor->m_textures) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, IMPOSTOR_MIP_LEVELS);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &impostor->m_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, impostor->m_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &impostor->m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, impostor->m_framebuffer);
+    for (int i = 0; i < IMPOSTOR_TARGETS; i++)
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, GL_TEXTURE_2D, impostor->m_textures[i], 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, impostor->m_depth);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "Impostor atlas is incomplete (status 0x%x)\n", status);
+        return nullptr;
+    }
+    return impostor;
+}
+
+Impostor::~Impostor() {
+    if (m_framebuffer)
+        glDeleteFramebuffers(1, &m_framebuffer);
+    if (m_depth)
+        glDeleteRenderbuffers(1, &m_depth);
+    if (m_textures[0])
+        glDeleteTextures(IMPOSTOR_TARGETS, m_textures);
+}
+
+/**
+ * @brief Binds the framebuffer with its three targets and clears the whole atlas.
+ *
+ * Saves the viewport, restored by `unbind()`.
+ */
+void Impostor::bind() {
+    static const GLenum targets[IMPOSTOR_TARGETS] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1,
+                                                     GL_COLOR_ATTACHMENT2};
+    static const GLfloat empty[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    glGetIntegerv(GL_VIEWPORT, m_viewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glDrawBuffers(IMPOSTOR_TARGETS, targets);
+    glViewport(0, 0, IMPOSTOR_AZIMUTHS * IMPOSTOR_VIEW_SIZE, IMPOSTOR_ELEVATIONS * IMPOSTOR_VIEW_SIZE);
+    for (int i = 0; i < IMPOSTOR_TARGETS; i++)
+        glClearBufferfv(GL_COLOR, i, empty);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Restricts drawing to the cell of one view.
+ * @param view View index, azimuth first, see `getViewDirection()`.
+ */
+void Impostor::bindView(size_t view) const {
+    glViewport(static_cast<GLint>(view % IMPOSTOR_AZIMUTHS) * IMPOSTOR_VIEW_SIZE,
+               static_cast<GLint>(view / IMPOSTOR_AZIMUTHS) * IMPOSTOR_VIEW_SIZE, IMPOSTOR_VIEW_SIZE,
+               IMPOSTOR_VIEW_SIZE);
+}
+
+/**
+ * @brief Binds the default framebuffer back, restores the viewport and builds the mip levels of the atlas.
+ */
+void Impostor::unbind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(m_viewport[0], m_viewport[1], m_viewport[2], m_viewport[3]);
+    for (unsigned int texture: m_textures) {
+        glBindTexture(GL_TEXTURE_2D, texture);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * @brief Binds the three targets to consecutive texture units.
+ * @param firstSlot Texture unit of the color target; the vertex color and normal targets follow.
+ */
+void Impostor::bindTextures(unsigned int firstSlot) const {
+    for (unsigned int i = 0; i < IMPOSTOR_TARGETS; i++) {
+        glActiveTexture(GL_TEXTURE0 + firstSlot + i);
+        glBindTexture(GL_TEXTURE_2D, m_textures[i]);
+    }
+}
+
+const std::array<float, 3> &Impostor::getCenter() const {
+    return m_center;
+}
+
+float Impostor::getRadius() const {
+    return m_radius;
+}
+
+/**
+ * @brief Size of the atlas on the GPU, mip levels included.
+ */
+size_t Impostor::getMemoryUsage() const {
+    const size_t texels = static_cast<size_t>(IMPOSTOR_AZIMUTHS * IMPOSTOR_VIEW_SIZE) *
+                          IMPOSTOR_ELEVATIONS * IMPOSTOR_VIEW_SIZE;
+    return texels * 4 * IMPOSTOR_TARGETS * 4 / 3 + texels * 4;
+}
+
+/**
+ * @brief Direction from the mesh towards the camera of a view, in object space.
+ *
+ * Views are laid out azimuth first: view `i + j * IMPOSTOR_AZIMUTHS` looks
+ * from azimuth `i` around the Y axis and elevation `j`, from below to
+ * above. Elevations are offset by half a step, so no view looks straight
+ * along Y. impostor_fragment.glsl computes the same directions.
+ *
+ * @param view View index.
+ * @return std::array<float, 3> Unit direction.
+ */
+std::array<float, 3> Impostor::getViewDirection(size_t view) {
+    const double azimuth = 2.0 * M_PI * static_cast<double>(view % IMPOSTOR_AZIMUTHS) / IMPOSTOR_AZIMUTHS;
+    const double elevation = M_PI * ((static_cast<double>(view / IMPOSTOR_AZIMUTHS) + 0.5) / IMPOSTOR_ELEVATIONS - 0.5);
+    return {static_cast<float>(std::cos(elevation) * std::sin(azimuth)), static_cast<float>(std::sin(elevation)),
+            static_cast<float>(std::cos(elevation) * std::cos(azimuth))};
+}
+
+/**
+ * @brief Part of a view's cell covered by the bounding sphere, the rest being padding.
+ */
+float Impostor::getViewScale() {
+    return static_cast<float>(IMPOSTOR_VIEW_SIZE - 2 * IMPOSTOR_VIEW_PADDING) / IMPOSTOR_VIEW_SIZE;
+}
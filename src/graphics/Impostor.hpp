@@ -0,0 +1,74 @@
+/**
+ * @file Impostor.hpp
+ * @author Patryk
+ * @brief Impostor class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_IMPOSTOR_HPP
+#define SCOP_IMPOSTOR_HPP
+#include <array>
+#include <memory>
+#include <GL/glew.h>
+
+#define IMPOSTOR_AZIMUTHS 12
+#define IMPOSTOR_ELEVATIONS 6
+#define IMPOSTOR_VIEWS (IMPOSTOR_AZIMUTHS * IMPOSTOR_ELEVATIONS)
+#define IMPOSTOR_VIEW_SIZE 128
+// Empty texels around each view, so filtering never reads the neighbouring one
+#define IMPOSTOR_VIEW_PADDING 4
+#define IMPOSTOR_MIP_LEVELS 2
+#define IMPOSTOR_TARGETS 3
+#define IMPOSTOR_DEFAULT_DISTANCE 4.0f
+// Width of the crossfade band, relative to the switch distance
+#define IMPOSTOR_FADE_FRACTION 0.25f
+
+/**
+ * @brief Atlas of pre-rendered views of a mesh, drawn instead of the mesh on camera-facing quads.
+ *
+ * The atlas holds IMPOSTOR_VIEWS views on an azimuth by elevation grid
+ * around the mesh's bounding sphere, each IMPOSTOR_VIEW_SIZE pixels wide,
+ * in three targets: texture color with coverage in alpha, vertex color with
+ * ambient occlusion in alpha, and object space normal with depth in alpha.
+ * Keeping the inputs of fragment.glsl rather than a lit color lets the
+ * impostor be lit like the mesh, as the object rotates and the color mode
+ * changes. Targets are cleared to 0, so filtered values are premultiplied by
+ * coverage.
+ */
+class Impostor {
+public:
+    static std::unique_ptr<Impostor> create(const std::array<float, 3> &center, float radius);
+    Impostor(const Impostor&) = delete;
+    ~Impostor();
+
+    Impostor &operator=(const Impostor&) = delete;
+
+    void bind();
+    void bindView(size_t view) const;
+    void unbind();
+    void bindTextures(unsigned int firstSlot) const;
+
+    const std::array<float, 3> &getCenter() const;
+    float getRadius() const;
+    size_t getMemoryUsage() const;
+
+    static std::array<float, 3> getViewDirection(size_t view);
+    static float getViewScale();
+
+private:
+    Impostor() = default;
+
+    unsigned int m_framebuffer = 0;
+    unsigned int m_textures[IMPOSTOR_TARGETS] = {0, 0, 0};
+    unsigned int m_depth = 0;
+    GLint m_viewport[4] = {0, 0, 0, 0};
+    std::array<float, 3> m_center;
+    float m_radius = 0.0f;
+};
+
+
+#endif //SCOP_IMPOSTOR_HPP
@@ -9,6 +9,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "IndexBuffer.hpp"
 
 /**
@@ -19,11 +21,13 @@
  *
  * @param indices List of object's indexes
  * @param size Index count
+ * @param usage Usage hint: GL_STATIC_DRAW, GL_DYNAMIC_DRAW for edited data or GL_STREAM_DRAW for data replaced every frame.
  */
-IndexBuffer::IndexBuffer(const unsigned int *indices, const size_t size) : m_id(0) {
+IndexBuffer::IndexBuffer(const unsigned int *indices, const size_t size, const GLenum usage)
+    : m_id(0), m_size(size * sizeof(unsigned int)), m_usage(usage) {
     glGenBuffers(1, &m_id);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(unsigned int), indices, GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size * sizeof(unsigned int), indices, usage);
 }
 
 /**
@@ -33,16 +37,35 @@ IndexBuffer::IndexBuffer(const unsigned int *indices, const size_t size) : m_id(
  * binds it, and fills it with the indices contained in the vector.
  *
  * @param indices Vector of unsigned integers representing the object's indices.
+ * @param usage Usage hint, see above.
  */
-IndexBuffer::IndexBuffer(const std::vector<unsigned int> &indices) : m_id(0) {
+IndexBuffer::IndexBuffer(const std::vector<unsigned int> &indices, const GLenum usage)
+    : m_id(0), m_size(indices.size() * sizeof(unsigned int)), m_usage(usage) {
     glGenBuffers(1, &m_id);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), usage);
+}
+
+/**
+ * @brief Creates a IndexBuffer from raw bytes, e.g. a buffer view of a mapped model file.
+ *
+ * The bytes are passed to glBufferData as they are, without conversion.
+ *
+ * @param data Buffer content.
+ * @param byteSize Size of the content in bytes.
+ * @param usage Usage hint such as GL_STATIC_DRAW.
+ */
+IndexBuffer::IndexBuffer(const void *data, const size_t byteSize, const GLenum usage)
+    : m_id(0), m_size(byteSize), m_usage(usage) {
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, byteSize, data, usage);
 }
 
 IndexBuffer::IndexBuffer(IndexBuffer &&other) noexcept
-    : m_id(other.m_id) {
+    : m_id(other.m_id), m_size(other.m_size), m_usage(other.m_usage) {
     other.m_id = 0;
+    other.m_size = 0;
 }
 
 IndexBuffer::~IndexBuffer() {
@@ -53,8 +76,13 @@ IndexBuffer::~IndexBuffer() {
 IndexBuffer & IndexBuffer::operator=(IndexBuffer &&other) noexcept {
     if (this == &other)
         return *this;
+    if (m_id)
+        glDeleteBuffers(1, &m_id);
     m_id = other.m_id;
+    m_size = other.m_size;
+    m_usage = other.m_usage;
     other.m_id = 0;
+    other.m_size = 0;
     return *this;
 }
 
@@ -70,4 +98,78 @@ void IndexBuffer::bind() const {
  */
 void IndexBuffer::unbind() const {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Replaces part of the buffer's content with glBufferSubData.
+ *
+ * The element array binding is part of the VAO state, so the owning VAO
+ * should be bound while updating.
+ *
+ * @param offset Offset in bytes from the start of the buffer.
+ * @param data New content.
+ * @param size Size of the new content in bytes.
+ */
+void IndexBuffer::update(const size_t offset, const void *data, const size_t size) const {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data);
+}
+
+/**
+ * @brief Uploads several modified ranges of a CPU copy of the buffer.
+ *
+ * The ranges are coalesced first (see `coalesceRanges()`), so edits close
+ * to each other cost a single glBufferSubData call. Ranges are clamped to
+ * the buffer size.
+ *
+ * The element array binding is part of the VAO state, so the owning VAO
+ * should be bound while updating.
+ *
+ * @param data Start of the CPU copy of the whole buffer.
+ * @param ranges Modified byte ranges, in any order.
+ * @param gap Largest number of unchanged bytes merged into a range.
+ */
+void IndexBuffer::updateRanges(const void *data, std::vector<BufferRange> ranges, size_t gap) const {
+    coalesceRanges(ranges, gap);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    for (const BufferRange &range: ranges) {
+        if (range.offset >= m_size)
+            break;
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.offset, std::min(range.size, m_size - range.offset),
+                        static_cast<const char *>(data) + range.offset);
+    }
+}
+
+/**
+ * @brief Replaces the whole content of the buffer, orphaning the previous storage.
+ *
+ * The storage is first re-specified without data, with the buffer's usage
+ * hint, so the driver can hand out fresh memory instead of waiting for draws
+ * still reading the old content; it is then filled with glBufferSubData.
+ * The size may differ from the previous one.
+ *
+ * The element array binding is part of the VAO state, so the owning VAO
+ * must be bound first.
+ *
+ * @param data New content.
+ * @param size Size of the new content in bytes.
+ */
+void IndexBuffer::replace(const void *data, const size_t size) {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, nullptr, m_usage);
+    if (size > 0)
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data);
+    m_size = size;
+}
+
+unsigned int IndexBuffer::getId() const {
+    return m_id;
+}
+
+size_t IndexBuffer::getSize() const {
+    return m_size;
+}
+
+GLenum IndexBuffer::getUsage() const {
+    return m_usage;
+}
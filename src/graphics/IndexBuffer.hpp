@@ -14,6 +14,8 @@
 #include <vector>
 #include <GL/glew.h>
 
+#include "BufferRanges.hpp"
+
 /**
  * @brief Wraps an OpenGL IndexBuffer (element array buffer).
  *
@@ -24,8 +26,9 @@
 class IndexBuffer {
 public:
     IndexBuffer() = delete;
-    explicit IndexBuffer(const unsigned int *indices, const size_t size);
-    explicit IndexBuffer(const std::vector<unsigned int> &indices);
+    explicit IndexBuffer(const unsigned int *indices, const size_t size, const GLenum usage = GL_STATIC_DRAW);
+    explicit IndexBuffer(const std::vector<unsigned int> &indices, const GLenum usage = GL_STATIC_DRAW);
+    explicit IndexBuffer(const void *data, const size_t byteSize, const GLenum usage);
     IndexBuffer(const IndexBuffer&) = delete;
     IndexBuffer(IndexBuffer &&other) noexcept;
     ~IndexBuffer();
@@ -35,9 +38,17 @@ public:
 
     void bind() const;
     void unbind() const;
+    void update(const size_t offset, const void *data, const size_t size) const;
+    void updateRanges(const void *data, std::vector<BufferRange> ranges, size_t gap = BUFFER_COALESCE_GAP) const;
+    void replace(const void *data, const size_t size);
+    unsigned int getId() const;
+    size_t getSize() const;
+    GLenum getUsage() const;
 
 private:
     unsigned int m_id;
+    size_t m_size;
+    GLenum m_usage;
 };
 
 
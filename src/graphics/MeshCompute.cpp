@@ -0,0 +1,143 @@
+/**
+ * @file MeshCompute.cpp
+ * @author Patryk
+ * @brief MeshCompute class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+
+#include "MeshCompute.hpp"
+#include "../core/Vertex.hpp"
+
+/**
+ * @brief Layout of the partial results of mesh_bounds.glsl (std430).
+ */
+struct GpuBounds {
+    float sum[4];
+    float min[4];
+    float max[4];
+};
+
+/**
+ * @brief Work groups needed to cover `count` items; shaders loop over the rest beyond MESH_COMPUTE_MAX_GROUPS.
+ */
+static GLuint groupCount(size_t count, size_t maxGroups) {
+    const size_t groups = (count + MESH_COMPUTE_GROUP_SIZE - 1) / MESH_COMPUTE_GROUP_SIZE;
+    return static_cast<GLuint>(std::max<size_t>(1, std::min(groups, maxGroups)));
+}
+
+/**
+ * @brief Compiles the compute shaders.
+ * @return std::unique_ptr<MeshCompute> The instance, or nullptr without OpenGL 4.3.
+ */
+std::unique_ptr<MeshCompute> MeshCompute::create() {
+    if (!GLEW_VERSION_4_3) {
+        fprintf(stderr, "Compute shaders require OpenGL 4.3\n");
+        return nullptr;
+    }
+    std::unique_ptr<MeshCompute> compute(new MeshCompute());
+    compute->m_normals = std::unique_ptr<Shader>(new Shader(MESH_COMPUTE_NORMALS_SHADER));
+    compute->m_bounds = std::unique_ptr<Shader>(new Shader(MESH_COMPUTE_BOUNDS_SHADER));
+    return compute;
+}
+
+/**
+ * @brief Writes smooth normals, the normalized sum of the unit normals of the adjacent triangles, into the VBO.
+ *
+ * Gives the same normals as `computeMeshNormals()`. Face normals are
+ * accumulated into a scratch buffer of 16.16 fixed-point sums with integer
+ * atomics, one invocation per triangle, then normalized by one invocation
+ * per vertex.
+ *
+ * @param vertices VBO of Vertex structs; only the normals are written.
+ * @param vertexCount Number of vertices.
+ * @param indices IBO of the triangle list.
+ * @param indexCount Number of indices.
+ * @param packedVertices Buffer of PackedVertex whose normals are updated too, or nullptr.
+ */
+void MeshCompute::computeNormals(const VertexBuffer &vertices, size_t vertexCount, const IndexBuffer &indices,
+                                 size_t indexCount, const StorageBuffer *packedVertices) {
+    StorageBuffer sums(nullptr, vertexCount * 3 * sizeof(int));
+    sums.clear();
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertices.getId());
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, indices.getId());
+    sums.bind(2);
+    if (packedVertices)
+        packedVertices->bind(3);
+
+    m_normals->bind();
+    m_normals->setUnsigned("uVertexStride", sizeof(Vertex) / sizeof(float));
+    m_normals->setUnsigned("uNormalOffset", offsetof(Vertex, normal) / sizeof(float));
+    m_normals->setInt("uPacked", packedVertices ? 1 : 0);
+
+    const size_t triangleCount = indexCount / 3;
+    m_normals->setInt("uPass", 0);
+    m_normals->setUnsigned("uCount", static_cast<unsigned int>(triangleCount));
+    glDispatchCompute(groupCount(triangleCount, MESH_COMPUTE_MAX_GROUPS), 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    m_normals->setInt("uPass", 1);
+    m_normals->setUnsigned("uCount", static_cast<unsigned int>(vertexCount));
+    glDispatchCompute(groupCount(vertexCount, MESH_COMPUTE_MAX_GROUPS), 1, 1);
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+    m_normals->unbind();
+    for (unsigned int binding = 0; binding < 4; binding++)
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+}
+
+/**
+ * @brief Computes the average position and the bounding box of the vertices with a parallel reduction.
+ *
+ * A first dispatch of at most MESH_COMPUTE_BOUNDS_GROUPS work groups
+ * reduces the vertices to one partial result per group in shared memory,
+ * a second one reduces the partials. Only the final 48 bytes are read back.
+ *
+ * @param vertices VBO of Vertex structs.
+ * @param vertexCount Number of vertices, at least 1.
+ * @return MeshBounds Average position, minimum and maximum.
+ */
+MeshBounds MeshCompute::computeBounds(const VertexBuffer &vertices, size_t vertexCount) {
+    const GLuint groups = groupCount(vertexCount, MESH_COMPUTE_BOUNDS_GROUPS);
+    StorageBuffer partials(nullptr, groups * sizeof(GpuBounds));
+    StorageBuffer result(nullptr, sizeof(GpuBounds));
+
+    m_bounds->bind();
+    m_bounds->setUnsigned("uVertexStride", sizeof(Vertex) / sizeof(float));
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertices.getId());
+    partials.bind(2);
+    m_bounds->setInt("uFromVertices", 1);
+    m_bounds->setUnsigned("uCount", static_cast<unsigned int>(vertexCount));
+    glDispatchCompute(groups, 1, 1);
+    glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+    partials.bind(1);
+    result.bind(2);
+    m_bounds->setInt("uFromVertices", 0);
+    m_bounds->setUnsigned("uCount", groups);
+    glDispatchCompute(1, 1, 1);
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+    m_bounds->unbind();
+    for (unsigned int binding = 0; binding < 3; binding++)
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+
+    GpuBounds gpu;
+    result.read(0, &gpu, sizeof(gpu));
+    MeshBounds bounds;
+    for (int a = 0; a < 3; a++) {
+        bounds.center[a] = gpu.sum[a] / vertexCount;
+        bounds.min[a] = gpu.min[a];
+        bounds.max[a] = gpu.max[a];
+    }
+    return bounds;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file MeshCompute.hpp
+ * @author Patryk
+ * @brief MeshCompute class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_MESHCOMPUTE_HPP
+#define SCOP_MESHCOMPUTE_HPP
+
+#include <array>
+#include <memory>
+
+#include "Shader.hpp"
+#include "StorageBuffer.hpp"
+#include "VertexBuffer.hpp"
+#include "IndexBuffer.hpp"
+#include "../core/Mesh.hpp"
+
+#define MESH_COMPUTE_NORMALS_SHADER "./res/shaders/mesh_normals.glsl"
+#define MESH_COMPUTE_BOUNDS_SHADER "./res/shaders/mesh_bounds.glsl"
+#define MESH_COMPUTE_GROUP_SIZE 256
+#define MESH_COMPUTE_MAX_GROUPS 65535
+#define MESH_COMPUTE_BOUNDS_GROUPS 1024
+
+/**
+ * @brief Computes vertex normals and bounds of uploaded geometry with compute shaders.
+ *
+ * Works on the Vertex VBO and the IBO created by `Object::upload()`, so
+ * the positions are read where they already are. Requires OpenGL 4.3.
+ */
+class MeshCompute {
+public:
+    static std::unique_ptr<MeshCompute> create();
+    MeshCompute(const MeshCompute&) = delete;
+    ~MeshCompute() = default;
+
+    MeshCompute &operator=(const MeshCompute&) = delete;
+
+    void computeNormals(const VertexBuffer &vertices, size_t vertexCount, const IndexBuffer &indices,
+                        size_t indexCount, const StorageBuffer *packedVertices);
+    MeshBounds computeBounds(const VertexBuffer &vertices, size_t vertexCount);
+
+private:
+    MeshCompute() = default;
+
+    std::unique_ptr<Shader> m_normals;
+    std::unique_ptr<Shader> m_bounds;
+};
+
+#endif //SCOP_MESHCOMPUTE_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file RingBuffer.cpp
+ * @author Patryk
+ * @brief RingBuffer class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+
+#include "RingBuffer.hpp"
+
+bool RingBuffer::s_persistentMapping = true;
+
+/**
+ * @brief Creates a ring of RING_BUFFER_REGIONS regions of at least `regionSize` bytes.
+ *
+ * Uses immutable storage mapped persistently and coherently when OpenGL
+ * 4.4 or ARB_buffer_storage is available and persistent mapping is
+ * enabled, and a regular GL_STREAM_DRAW buffer otherwise.
+ *
+ * @param regionSize Bytes written per frame, rounded up to RING_BUFFER_ALIGNMENT.
+ * @param previous Ring being replaced by a larger one, whose stall statistics are carried over.
+ * @return std::unique_ptr<RingBuffer> Ring buffer, or `nullptr` if the storage could not be mapped.
+ */
+std::unique_ptr<RingBuffer> RingBuffer::create(size_t regionSize, const RingBuffer *previous) {
+    std::unique_ptr<RingBuffer> ring(new RingBuffer());
+    if (previous) {
+        ring->m_stallCount = previous->m_stallCount;
+        ring->m_stallTime = previous->m_stallTime;
+    }
+    ring->m_regionSize = (regionSize + RING_BUFFER_ALIGNMENT - 1) / RING_BUFFER_ALIGNMENT * RING_BUFFER_ALIGNMENT;
+    const size_t totalSize = ring->m_regionSize * RING_BUFFER_REGIONS;
+    ring->m_persistent = s_persistentMapping && (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage);
+
+    glGenBuffers(1, &ring->m_id);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ring->m_id);
+    if (ring->m_persistent) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        ring->m_pointer = static_cast<char *>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+        if (!ring->m_pointer) {
+            fprintf(stderr, "Failed to map a %zu byte ring buffer\n", totalSize);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            ring->m_persistent = false;
+            return nullptr;
+        }
+    } else {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    return ring;
+}
+
+RingBuffer::~RingBuffer() {
+    for (GLsync fence: m_fences) {
+        if (fence)
+            glDeleteSync(fence);
+    }
+    if (m_id && (m_persistent || m_mapped)) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+    if (m_id)
+        glDeleteBuffers(1, &m_id);
+}
+
+/**
+ * @brief Moves to the next region, waiting until the GPU is done with it.
+ *
+ * With persistent mapping, the region's fence is polled first; if the GPU
+ * has not passed it yet, the wait is counted as a stall and timed. Without
+ * it, the whole buffer is orphaned when writing wraps around to the first
+ * region.
+ */
+void RingBuffer::beginFrame() {
+    m_region = (m_region + 1) % RING_BUFFER_REGIONS;
+    m_used = 0;
+
+    GLsync &fence = m_fences[m_region];
+    if (fence) {
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            const auto start = std::chrono::steady_clock::now();
+            do {
+                status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, RING_BUFFER_WAIT_TIMEOUT);
+            } while (status == GL_TIMEOUT_EXPIRED);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            m_stallTime += elapsed.count();
+            m_stallCount++;
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (!m_persistent && m_region == 0) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+        glBufferData(GL_COPY_WRITE_BUFFER, m_regionSize * RING_BUFFER_REGIONS, nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+}
+
+/**
+ * @brief Reserves `size` bytes of the current region and returns where to write them.
+ *
+ * Without persistent mapping the range is mapped here and must be released
+ * with `unmap()` before the next allocation or draw.
+ *
+ * @param size Number of bytes to write, greater than 0.
+ * @param offset Receives the byte offset of the allocation in the buffer, a multiple of RING_BUFFER_ALIGNMENT.
+ * @return void* Write pointer, or `nullptr` if the region is full.
+ */
+void *RingBuffer::allocate(size_t size, size_t &offset) {
+    const size_t start = (m_used + RING_BUFFER_ALIGNMENT - 1) / RING_BUFFER_ALIGNMENT * RING_BUFFER_ALIGNMENT;
+    if (size == 0 || start + size > m_regionSize)
+        return nullptr;
+    offset = m_region * m_regionSize + start;
+    m_used = start + size;
+    if (m_persistent)
+        return m_pointer + offset;
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    void *pointer = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+                                     GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_mapped = pointer != nullptr;
+    return pointer;
+}
+
+/**
+ * @brief Releases the range mapped by the last `allocate()`; nothing to do with persistent mapping.
+ */
+void RingBuffer::unmap() {
+    if (!m_mapped)
+        return;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+    glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    m_mapped = false;
+}
+
+/**
+ * @brief Guards the current region with a fence, once the commands reading it have been issued.
+ *
+ * Only needed with persistent mapping; the orphaning fallback does not wait on fences.
+ */
+void RingBuffer::endFrame() {
+    if (!m_persistent)
+        return;
+    if (m_fences[m_region])
+        glDeleteSync(m_fences[m_region]);
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+unsigned int RingBuffer::getId() const {
+    return m_id;
+}
+
+size_t RingBuffer::getRegionSize() const {
+    return m_regionSize;
+}
+
+bool RingBuffer::isPersistent() const {
+    return m_persistent;
+}
+
+/**
+ * @brief Returns how many times `beginFrame()` had to wait for the GPU.
+ */
+size_t RingBuffer::getStallCount() const {
+    return m_stallCount;
+}
+
+/**
+ * @brief Returns the total time spent waiting in `beginFrame()`, in milliseconds.
+ */
+double RingBuffer::getStallTime() const {
+    return m_stallTime;
+}
+
+/**
+ * @brief Enables or disables persistent mapping for ring buffers created afterwards.
+ *
+ * Disabling it forces the OpenGL 3.3 path, e.g. to compare both.
+ *
+ * @param enabled false to always map with GL_MAP_UNSYNCHRONIZED_BIT and orphan.
+ */
+void RingBuffer::setPersistentMapping(bool enabled) {
+    s_persistentMapping = enabled;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file RingBuffer.hpp
+ * @author Patryk
+ * @brief RingBuffer class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_RING_BUFFER_HPP
+#define SCOP_RING_BUFFER_HPP
+
+#include <memory>
+#include <GL/glew.h>
+
+// Frames the CPU may write ahead of the GPU
+#define RING_BUFFER_REGIONS 3
+// Offsets returned by allocate() are multiples of this
+#define RING_BUFFER_ALIGNMENT 256
+#define RING_BUFFER_WAIT_TIMEOUT 1000000000ull
+
+/**
+ * @brief Buffer for data rewritten every frame, split into per-frame regions.
+ *
+ * Each frame writes into the next region, and a fence placed after the
+ * frame's commands guards the region until the GPU has consumed it, so
+ * the CPU only waits when it gets RING_BUFFER_REGIONS frames ahead. With
+ * OpenGL 4.4 (or ARB_buffer_storage) the buffer is mapped once,
+ * persistently and coherently, and written directly. Otherwise each write
+ * maps its range with GL_MAP_UNSYNCHRONIZED_BIT, and the whole buffer is
+ * orphaned each time writing wraps around to the first region, so the
+ * driver never has to synchronize either.
+ *
+ * The buffer is not tied to a target: it can be bound as vertex, index
+ * or storage buffer at the offsets returned by `allocate()`.
+ */
+class RingBuffer {
+public:
+    static std::unique_ptr<RingBuffer> create(size_t regionSize, const RingBuffer *previous = nullptr);
+    RingBuffer(const RingBuffer&) = delete;
+    ~RingBuffer();
+
+    RingBuffer &operator=(const RingBuffer&) = delete;
+
+    void beginFrame();
+    void *allocate(size_t size, size_t &offset);
+    void unmap();
+    void endFrame();
+
+    unsigned int getId() const;
+    size_t getRegionSize() const;
+    bool isPersistent() const;
+    size_t getStallCount() const;
+    double getStallTime() const;
+
+    static void setPersistentMapping(bool enabled);
+
+private:
+    RingBuffer() = default;
+
+    unsigned int m_id = 0;
+    size_t m_regionSize = 0;
+    size_t m_region = RING_BUFFER_REGIONS - 1;
+    size_t m_used = 0;
+    bool m_persistent = false;
+    bool m_mapped = false;
+    char *m_pointer = nullptr;
+    GLsync m_fences[RING_BUFFER_REGIONS] = {};
+
+    size_t m_stallCount = 0;
+    double m_stallTime = 0.0;
+
+    static bool s_persistentMapping;
+};
+
+#endif //SCOP_RING_BUFFER_HPP
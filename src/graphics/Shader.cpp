@@ -9,26 +9,23 @@
  *
  */
 
-#include <fstream>
-#include <sstream>
 #include "Shader.hpp"
+#include "../io/Asset.hpp"
 
 /**
- * @brief Reads the contents of a shader file and returns it as a string.
+ * @brief Reads the contents of a shader file (loose or packed) and returns it as a string.
  * @param path Path to the shader file.
  * @return std::string Contents of the shader file, or an empty string if the file could not be opened.
  */
 std::string parseShaderFile(const std::string &path) {
-    std::ifstream file(path.c_str());
+    const std::unique_ptr<Asset> asset = Asset::load(path);
 
-    if (!file.is_open()) {
+    if (!asset) {
         fprintf(stderr, "Error opening file!\n");
         return "";
     }
 
-    std::stringstream ss;
-    ss << file.rdbuf();
-    return ss.str();
+    return std::string(asset->data(), asset->size());
 }
 
 /**
@@ -45,6 +42,9 @@ void checkShaderCompilationStatus(unsigned int shader, unsigned int type) {
         case GL_FRAGMENT_SHADER:
             shaderName = "fragment";
             break;
+        case GL_COMPUTE_SHADER:
+            shaderName = "compute";
+            break;
         default:
             shaderName = "unknown";
     }
@@ -82,6 +82,22 @@ Shader::Shader(const std::string &vertex, const std::string &fragment) : m_id(0)
     glDeleteShader(m_fragmentShader);
 }
 
+/**
+ * @brief Creates a compute program from a single compute shader file.
+ *
+ * Requires OpenGL 4.3. Run it with glDispatchCompute after `bind()`.
+ *
+ * @param compute Path to the compute shader source file.
+ */
+Shader::Shader(const std::string &compute) : m_id(0), m_vertexShader(0), m_fragmentShader(0) {
+    const unsigned int shader = compileShader(compute, GL_COMPUTE_SHADER);
+
+    m_id = glCreateProgram();
+    glAttachShader(m_id, shader);
+    glLinkProgram(m_id);
+    glDeleteShader(shader);
+}
+
 Shader::Shader(Shader &&other) noexcept : m_id(other.m_id), m_vertexShader(other.m_vertexShader), m_fragmentShader(other.m_fragmentShader) {
     other.m_id = 0;
     other.m_vertexShader = 0;
@@ -179,6 +195,18 @@ void Shader::setFloat(const std::string &name, float value) {
     glUniform1f(location, value);
 }
 
+/**
+ * @brief Sets an unsigned integer uniform in the shader program.
+ * @param name Name of the uniform variable.
+ * @param value Unsigned value to set.
+ */
+void Shader::setUnsigned(const std::string &name, unsigned int value) {
+    bind();
+
+    const int location = findLoc(name);
+    glUniform1ui(location, value);
+}
+
 /**
  * @brief Compiles a shader from a source file.
  *
@@ -20,12 +20,13 @@
  * @brief Wraps an OpenGL Shader Program.
  *
  * The Shader class is responsible for loading, compiling, and linking
- * vertex and fragment shaders into an OpenGL shader program.
+ * vertex and fragment shaders, or a single compute shader, into an OpenGL shader program.
  * It also provides methods to bind/unbind the program and set uniform variables.
  */
 class Shader {
 public:
     Shader(const std::string &vertex, const std::string &fragment);
+    explicit Shader(const std::string &compute);
     Shader(const Shader& other) = delete;
     Shader(Shader &&other) noexcept;
     ~Shader();
@@ -41,6 +42,7 @@ public:
     void setUniformVec3(const std::string &name, const std::array<float, 3> &vec);
     void setInt(const std::string &name, int value);
     void setFloat(const std::string &name, float value);
+    void setUnsigned(const std::string &name, unsigned int value);
 
 private:
     unsigned int m_id;
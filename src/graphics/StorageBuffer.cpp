@@ -0,0 +1,90 @@
+/**
+ * @file StorageBuffer.cpp
+ * @author Patryk
+ * @brief StorageBuffer (SSBO) class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "StorageBuffer.hpp"
+
+/**
+ * @brief Creates a StorageBuffer and fills it with raw bytes.
+ *
+ * An empty buffer still gets 4 bytes, as binding a zero-sized SSBO is an error.
+ *
+ * @param data Buffer content, or nullptr to leave it uninitialized.
+ * @param byteSize Size of the content in bytes.
+ */
+StorageBuffer::StorageBuffer(const void *data, const size_t byteSize) : m_id(0) {
+    static const unsigned int empty = 0;
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+    if (byteSize)
+        glBufferData(GL_SHADER_STORAGE_BUFFER, byteSize, data, GL_STATIC_DRAW);
+    else
+        glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(empty), &empty, GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+StorageBuffer::StorageBuffer(StorageBuffer &&other) noexcept
+    : m_id(other.m_id) {
+    other.m_id = 0;
+}
+
+StorageBuffer::~StorageBuffer() {
+    if (m_id)
+        glDeleteBuffers(1, &m_id);
+}
+
+StorageBuffer & StorageBuffer::operator=(StorageBuffer &&other) noexcept {
+    if (this == &other)
+        return *this;
+    m_id = other.m_id;
+    other.m_id = 0;
+    return *this;
+}
+
+/**
+ * @brief Binds the buffer to a shader storage binding point.
+ * @param binding Index given by `layout(binding = ...)` in the shader.
+ */
+void StorageBuffer::bind(const unsigned int binding) const {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_id);
+}
+
+/**
+ * @brief Clears a shader storage binding point.
+ * @param binding Index given by `layout(binding = ...)` in the shader.
+ */
+void StorageBuffer::unbind(const unsigned int binding) const {
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+}
+
+/**
+ * @brief Fills the whole buffer with zeros.
+ */
+void StorageBuffer::clear() const {
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+    glClearBufferData(GL_SHADER_STORAGE_BUFFER, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+/**
+ * @brief Copies part of the buffer back to the CPU, waiting for the GPU if needed.
+ * @param offset Offset in bytes from the start of the buffer.
+ * @param data Destination.
+ * @param size Number of bytes to copy.
+ */
+void StorageBuffer::read(const size_t offset, void *data, const size_t size) const {
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_id);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, offset, size, data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+}
+
+unsigned int StorageBuffer::getId() const {
+    return m_id;
+}
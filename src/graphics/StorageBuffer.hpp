@@ -0,0 +1,45 @@
+/**
+ * @file StorageBuffer.hpp
+ * @author Patryk
+ * @brief StorageBuffer (SSBO) class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_STORAGEBUFFER_HPP
+#define SCOP_STORAGEBUFFER_HPP
+#include <cstddef>
+#include <GL/glew.h>
+
+/**
+ * @brief Wraps an OpenGL Shader Storage Buffer Object (SSBO).
+ *
+ * Holds read-only data fetched by shaders through a `buffer` block bound
+ * to an indexed binding point. Requires OpenGL 4.3.
+ */
+class StorageBuffer {
+public:
+    StorageBuffer() = delete;
+    explicit StorageBuffer(const void *data, const size_t byteSize);
+    StorageBuffer(const StorageBuffer&) = delete;
+    StorageBuffer(StorageBuffer &&other) noexcept;
+    ~StorageBuffer();
+
+    StorageBuffer &operator=(const StorageBuffer&) = delete;
+    StorageBuffer &operator=(StorageBuffer &&other) noexcept;
+
+    void bind(const unsigned int binding) const;
+    void unbind(const unsigned int binding) const;
+    void clear() const;
+    void read(const size_t offset, void *data, const size_t size) const;
+    unsigned int getId() const;
+
+private:
+    unsigned int m_id;
+};
+
+
+#endif //SCOP_STORAGEBUFFER_HPP
@@ -9,6 +9,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "VertexBuffer.hpp"
 #include "../core/Object.hpp"
 
@@ -21,11 +23,13 @@
  *
  * @param vertices Pointer to an array of floats representing vertex data.
  * @param size Number of floats in the array.
+ * @param usage Usage hint: GL_STATIC_DRAW, GL_DYNAMIC_DRAW for edited data or GL_STREAM_DRAW for data replaced every frame.
  */
-VertexBuffer::VertexBuffer(const float *vertices, const size_t size) : m_id(0) {
+VertexBuffer::VertexBuffer(const float *vertices, const size_t size, const GLenum usage)
+    : m_id(0), m_size(size * sizeof(float)), m_usage(usage) {
     glGenBuffers(1, &m_id);
     glBindBuffer(GL_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), vertices, usage);
 }
 
 /**
@@ -36,11 +40,13 @@ VertexBuffer::VertexBuffer(const float *vertices, const size_t size) : m_id(0) {
  * contained in the vector.
  *
  * @param vertices Vector containing floats representing vertex data.
+ * @param usage Usage hint, see above.
  */
-VertexBuffer::VertexBuffer(const std::vector<float> &vertices) : m_id(0) {
+VertexBuffer::VertexBuffer(const std::vector<float> &vertices, const GLenum usage)
+    : m_id(0), m_size(vertices.size() * sizeof(float)), m_usage(usage) {
     glGenBuffers(1, &m_id);
     glBindBuffer(GL_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), usage);
 }
 
 /**
@@ -51,16 +57,35 @@ VertexBuffer::VertexBuffer(const std::vector<float> &vertices) : m_id(0) {
  * contained in the vector of Vertex structures.
  *
  * @param vertices Vector containing Vertex structs representing the object's vertex data.
+ * @param usage Usage hint, see above.
+ */
+VertexBuffer::VertexBuffer(const std::vector<Vertex> &vertices, const GLenum usage)
+    : m_id(0), m_size(vertices.size() * sizeof(Vertex)), m_usage(usage) {
+    glGenBuffers(1, &m_id);
+    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), usage);
+}
+
+/**
+ * @brief Creates a VertexBuffer from raw bytes, e.g. a buffer view of a mapped model file.
+ *
+ * The bytes are passed to glBufferData as they are, without conversion.
+ *
+ * @param data Buffer content.
+ * @param byteSize Size of the content in bytes.
+ * @param usage Usage hint such as GL_STATIC_DRAW.
  */
-VertexBuffer::VertexBuffer(const std::vector<Vertex> &vertices) : m_id(0) {
+VertexBuffer::VertexBuffer(const void *data, const size_t byteSize, const GLenum usage)
+    : m_id(0), m_size(byteSize), m_usage(usage) {
     glGenBuffers(1, &m_id);
     glBindBuffer(GL_ARRAY_BUFFER, m_id);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, byteSize, data, usage);
 }
 
 VertexBuffer::VertexBuffer(VertexBuffer &&other) noexcept
-    : m_id(other.m_id) {
+    : m_id(other.m_id), m_size(other.m_size), m_usage(other.m_usage) {
     other.m_id = 0;
+    other.m_size = 0;
 }
 
 VertexBuffer::~VertexBuffer() {
@@ -71,8 +96,13 @@ VertexBuffer::~VertexBuffer() {
 VertexBuffer & VertexBuffer::operator=(VertexBuffer &&other) noexcept {
     if (this == &other)
         return *this;
+    if (m_id)
+        glDeleteBuffers(1, &m_id);
     m_id = other.m_id;
+    m_size = other.m_size;
+    m_usage = other.m_usage;
     other.m_id = 0;
+    other.m_size = 0;
     return *this;
 }
 
@@ -95,3 +125,67 @@ void VertexBuffer::bind() const {
 void VertexBuffer::unbind() const {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
+
+/**
+ * @brief Replaces part of the buffer's content with glBufferSubData.
+ * @param offset Offset in bytes from the start of the buffer.
+ * @param data New content.
+ * @param size Size of the new content in bytes.
+ */
+void VertexBuffer::update(const size_t offset, const void *data, const size_t size) const {
+    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+    glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+}
+
+/**
+ * @brief Uploads several modified ranges of a CPU copy of the buffer.
+ *
+ * The ranges are coalesced first (see `coalesceRanges()`), so edits close
+ * to each other cost a single glBufferSubData call. Ranges are clamped to
+ * the buffer size.
+ *
+ * @param data Start of the CPU copy of the whole buffer.
+ * @param ranges Modified byte ranges, in any order.
+ * @param gap Largest number of unchanged bytes merged into a range.
+ */
+void VertexBuffer::updateRanges(const void *data, std::vector<BufferRange> ranges, size_t gap) const {
+    coalesceRanges(ranges, gap);
+    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+    for (const BufferRange &range: ranges) {
+        if (range.offset >= m_size)
+            break;
+        glBufferSubData(GL_ARRAY_BUFFER, range.offset, std::min(range.size, m_size - range.offset),
+                        static_cast<const char *>(data) + range.offset);
+    }
+}
+
+/**
+ * @brief Replaces the whole content of the buffer, orphaning the previous storage.
+ *
+ * The storage is first re-specified without data, with the buffer's usage
+ * hint, so the driver can hand out fresh memory instead of waiting for draws
+ * still reading the old content; it is then filled with glBufferSubData.
+ * The size may differ from the previous one.
+ *
+ * @param data New content.
+ * @param size Size of the new content in bytes.
+ */
+void VertexBuffer::replace(const void *data, const size_t size) {
+    glBindBuffer(GL_ARRAY_BUFFER, m_id);
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, m_usage);
+    if (size > 0)
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+    m_size = size;
+}
+
+unsigned int VertexBuffer::getId() const {
+    return m_id;
+}
+
+size_t VertexBuffer::getSize() const {
+    return m_size;
+}
+
+GLenum VertexBuffer::getUsage() const {
+    return m_usage;
+}
@@ -14,6 +14,8 @@
 #include <vector>
 #include <GL/glew.h>
 
+#include "BufferRanges.hpp"
+
 struct Vertex;
 
 /**
@@ -26,9 +28,10 @@ struct Vertex;
 class VertexBuffer {
 public:
     VertexBuffer() = delete;
-    explicit VertexBuffer(const float *vertices, const size_t size);
-    explicit VertexBuffer(const std::vector<float> &vertices);
-    explicit VertexBuffer(const std::vector<Vertex> &vertices);
+    explicit VertexBuffer(const float *vertices, const size_t size, const GLenum usage = GL_STATIC_DRAW);
+    explicit VertexBuffer(const std::vector<float> &vertices, const GLenum usage = GL_STATIC_DRAW);
+    explicit VertexBuffer(const std::vector<Vertex> &vertices, const GLenum usage = GL_STATIC_DRAW);
+    explicit VertexBuffer(const void *data, const size_t byteSize, const GLenum usage);
     VertexBuffer(const VertexBuffer&) = delete;
     VertexBuffer(VertexBuffer &&other) noexcept;
     ~VertexBuffer();
@@ -38,9 +41,17 @@ public:
 
     void bind() const;
     void unbind() const;
+    void update(const size_t offset, const void *data, const size_t size) const;
+    void updateRanges(const void *data, std::vector<BufferRange> ranges, size_t gap = BUFFER_COALESCE_GAP) const;
+    void replace(const void *data, const size_t size);
+    unsigned int getId() const;
+    size_t getSize() const;
+    GLenum getUsage() const;
 
 private:
     unsigned int m_id;
+    size_t m_size;
+    GLenum m_usage;
 };
 
 
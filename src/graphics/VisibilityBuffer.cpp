@@ -0,0 +1,113 @@
+/**
+ * @file VisibilityBuffer.cpp
+ * @author Patryk
+ * @brief VisibilityBuffer class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+
+#include "VisibilityBuffer.hpp"
+
+/**
+ * @brief Creates the id texture, depth buffer and framebuffer.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @return std::unique_ptr<VisibilityBuffer> The buffer, or nullptr if the framebuffer is incomplete.
+ */
+std::unique_ptr<VisibilityBuffer> VisibilityBuffer::create(int width, int height) {
+    std::unique_ptr<VisibilityBuffer> buffer(new VisibilityBuffer());
+    if (!buffer->resize(width, height))
+        return nullptr;
+    return buffer;
+}
+
+VisibilityBuffer::~VisibilityBuffer() {
+    release();
+}
+
+/**
+ * @brief Recreates the attachments at a new size, e.g. after the window was resized.
+ * @param width Width in pixels.
+ * @param height Height in pixels.
+ * @return bool false if the framebuffer is incomplete.
+ */
+bool VisibilityBuffer::resize(int width, int height) {
+    release();
+    m_width = width > 0 ? width : 1;
+    m_height = height > 0 ? height : 1;
+
+    glGenTextures(1, &m_ids);
+    glBindTexture(GL_TEXTURE_2D, m_ids);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32UI, m_width, m_height, 0, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenRenderbuffers(1, &m_depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_width, m_height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ids, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depth);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        fprintf(stderr, "Visibility buffer is incomplete (status 0x%x)\n", status);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Binds the framebuffer and clears the ids to background and the depth to the far plane.
+ */
+void VisibilityBuffer::bind() const {
+    static const GLuint background[4] = {0, 0, 0, 0};
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glClearBufferuiv(GL_COLOR, 0, background);
+    glClear(GL_DEPTH_BUFFER_BIT);
+}
+
+/**
+ * @brief Binds the default framebuffer back.
+ */
+void VisibilityBuffer::unbind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+ * @brief Binds the id texture to a texture unit, for the resolve pass.
+ * @param slot Texture unit index.
+ */
+void VisibilityBuffer::bindIds(unsigned int slot) const {
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GL_TEXTURE_2D, m_ids);
+}
+
+int VisibilityBuffer::getWidth() const {
+    return m_width;
+}
+
+int VisibilityBuffer::getHeight() const {
+    return m_height;
+}
+
+void VisibilityBuffer::release() {
+    if (m_framebuffer)
+        glDeleteFramebuffers(1, &m_framebuffer);
+    if (m_depth)
+        glDeleteRenderbuffers(1, &m_depth);
+    if (m_ids)
+        glDeleteTextures(1, &m_ids);
+    m_framebuffer = 0;
+    m_depth = 0;
+    m_ids = 0;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file VisibilityBuffer.hpp
+ * @author Patryk
+ * @brief VisibilityBuffer class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_VISIBILITYBUFFER_HPP
+#define SCOP_VISIBILITYBUFFER_HPP
+#include <memory>
+#include <GL/glew.h>
+
+#define VISIBILITY_TRIANGLE_BITS 24
+#define VISIBILITY_MAX_TRIANGLES ((1u << VISIBILITY_TRIANGLE_BITS) - 1)
+#define VISIBILITY_MAX_INSTANCES (1u << (32 - VISIBILITY_TRIANGLE_BITS))
+
+/**
+ * @brief Off-screen target of the first visibility buffer pass.
+ *
+ * Holds one 32-bit unsigned id per pixel (instance in the top 8 bits,
+ * triangle + 1 in the low 24, 0 for background) and a depth buffer.
+ */
+class VisibilityBuffer {
+public:
+    static std::unique_ptr<VisibilityBuffer> create(int width, int height);
+    VisibilityBuffer(const VisibilityBuffer&) = delete;
+    ~VisibilityBuffer();
+
+    VisibilityBuffer &operator=(const VisibilityBuffer&) = delete;
+
+    bool resize(int width, int height);
+    void bind() const;
+    void unbind() const;
+    void bindIds(unsigned int slot) const;
+    int getWidth() const;
+    int getHeight() const;
+
+private:
+    VisibilityBuffer() = default;
+    void release();
+
+    unsigned int m_framebuffer = 0;
+    unsigned int m_ids = 0;
+    unsigned int m_depth = 0;
+    int m_width = 0;
+    int m_height = 0;
+};
+
+
+#endif //SCOP_VISIBILITYBUFFER_HPP
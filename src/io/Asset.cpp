@@ -0,0 +1,193 @@
+/**
+ * @file Asset.cpp
+ * @author Patryk
+ * @brief Asset class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Asset.hpp"
+#include "AssetPack.hpp"
+#include "Compression.hpp"
+
+/**
+ * @brief Loads an asset from the mounted packs or from a loose file.
+ *
+ * Mounted packs are searched first, most recently mounted first. If no pack
+ * contains the path, the file is read from disk.
+ *
+ * @param path Path of the asset.
+ * @return std::unique_ptr<Asset> Loaded asset, or `nullptr` if it could not be found or decoded.
+ */
+std::unique_ptr<Asset> Asset::load(const std::string &path) {
+    std::unique_ptr<Asset> asset(new Asset());
+    asset->m_path = path;
+
+    if (asset->loadFromPacks() || asset->loadFromFile())
+        return asset;
+    return nullptr;
+}
+
+/**
+ * @brief Loads an asset, memory-mapping it if it is a loose file.
+ *
+ * Same lookup as `load()`, but a loose file is mapped read-only instead of
+ * being read, so its bytes can be handed to the GPU without a copy. The
+ * file must not be truncated while the asset is alive.
+ *
+ * @param path Path of the asset.
+ * @return std::unique_ptr<Asset> Loaded asset, or `nullptr` if it could not be found or decoded.
+ */
+std::unique_ptr<Asset> Asset::map(const std::string &path) {
+    std::unique_ptr<Asset> asset(new Asset());
+    asset->m_path = path;
+
+    if (asset->loadFromPacks() || asset->mapFile())
+        return asset;
+    return nullptr;
+}
+
+Asset::~Asset() {
+    if (m_mapping)
+        munmap(m_mapping, m_size);
+}
+
+/**
+ * @brief Checks whether an asset can be loaded without reading it.
+ * @param path Path of the asset.
+ * @return bool true if a mounted pack or the file system contains the path.
+ */
+bool Asset::exists(const std::string &path) {
+    for (const auto &pack: AssetPack::getMounted()) {
+        if (pack->find(path))
+            return true;
+    }
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+const char *Asset::data() const {
+    return m_data;
+}
+
+size_t Asset::size() const {
+    return m_size;
+}
+
+const std::string &Asset::getPath() const {
+    return m_path;
+}
+
+bool Asset::isPacked() const {
+    return m_packed;
+}
+
+/**
+ * @brief Resolves the asset through the mounted packs.
+ *
+ * Uncompressed entries are referenced in place (zero-copy); compressed
+ * entries are decompressed into the asset's own storage.
+ *
+ * @return bool true if a mounted pack contains the asset.
+ */
+bool Asset::loadFromPacks() {
+    for (const auto &pack: AssetPack::getMounted()) {
+        const PackEntry *entry = pack->find(m_path);
+        if (!entry)
+            continue;
+
+        m_packed = true;
+        if (!(entry->flags & PACK_FLAG_COMPRESSED)) {
+            m_data = pack->getEntryData(*entry);
+            m_size = entry->size;
+            return true;
+        }
+
+        m_storage.resize(entry->size);
+        if (!lzDecompress(pack->getEntryData(*entry), entry->storedSize, m_storage.data(), m_storage.size())) {
+            fprintf(stderr, "Corrupted pack entry %s\n", m_path.c_str());
+            m_storage.clear();
+            return false;
+        }
+        m_data = m_storage.data();
+        m_size = m_storage.size();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reads the asset from a loose file on disk.
+ * @return bool true if the file was read.
+ */
+bool Asset::loadFromFile() {
+    FILE *file = fopen(m_path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return false;
+    }
+
+    m_storage.resize(static_cast<size_t>(size));
+    const size_t read = fread(m_storage.data(), 1, m_storage.size(), file);
+    fclose(file);
+    if (read != m_storage.size())
+        return false;
+
+    m_data = m_storage.data();
+    m_size = m_storage.size();
+    return true;
+}
+
+/**
+ * @brief Maps the asset from a loose file on disk.
+ *
+ * Empty files cannot be mapped and fall back to `loadFromFile()`.
+ *
+ * @return bool true if the file was mapped or read.
+ */
+bool Asset::mapFile() {
+    const int fd = open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size == 0) {
+        close(fd);
+        return loadFromFile();
+    }
+
+    void *mapping = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Failed to map %s\n", m_path.c_str());
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_data = static_cast<const char *>(mapping);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+AssetStreamBuf::AssetStreamBuf(const char *data, size_t size) {
+    char *begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+}
+
+AssetStream::AssetStream(const Asset &asset) : std::istream(nullptr), m_buffer(asset.data(), asset.size()) {
+    rdbuf(&m_buffer);
+}
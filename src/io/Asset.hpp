@@ -0,0 +1,78 @@
+/**
+ * @file Asset.hpp
+ * @author Patryk
+ * @brief Asset class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_ASSET_HPP
+#define SCOP_ASSET_HPP
+
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only view over the bytes of a loaded asset.
+ *
+ * Assets are looked up in the mounted packs first and in the loose file
+ * system second. Uncompressed pack entries point directly into the pack
+ * mapping; compressed entries and loose files own their bytes, unless the
+ * loose file was opened with `map()`.
+ */
+class Asset {
+public:
+    Asset() = default;
+    static std::unique_ptr<Asset> load(const std::string &path);
+    static std::unique_ptr<Asset> map(const std::string &path);
+    static bool exists(const std::string &path);
+    Asset(const Asset &other) = delete;
+    ~Asset();
+
+    Asset &operator=(const Asset &other) = delete;
+
+    const char *data() const;
+    size_t size() const;
+    const std::string &getPath() const;
+    bool isPacked() const;
+
+private:
+    std::string m_path;
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+    std::vector<char> m_storage;
+    void *m_mapping = nullptr;
+    bool m_packed = false;
+
+    bool loadFromPacks();
+    bool loadFromFile();
+    bool mapFile();
+};
+
+/**
+ * @brief std::streambuf over an in-memory byte range, used to feed assets
+ * to line-based parsers without copying them.
+ */
+class AssetStreamBuf : public std::streambuf {
+public:
+    AssetStreamBuf(const char *data, size_t size);
+};
+
+/**
+ * @brief std::istream reading the bytes of an Asset.
+ */
+class AssetStream : public std::istream {
+public:
+    explicit AssetStream(const Asset &asset);
+
+private:
+    AssetStreamBuf m_buffer;
+};
+
+#endif //SCOP_ASSET_HPP
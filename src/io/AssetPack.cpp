@@ -0,0 +1,385 @@
+/**
+ * @file AssetPack.cpp
+ * @author Patryk
+ * @brief AssetPack class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "AssetPack.hpp"
+#include "Compression.hpp"
+
+std::vector<std::unique_ptr<AssetPack>> AssetPack::s_mounted;
+
+/**
+ * @brief Normalizes a path so that pack lookups match regardless of spelling.
+ *
+ * Removes `.` components and empty components, and resolves `..` against
+ * the preceding component, so `./res//objects/../objects/42.obj` becomes
+ * `res/objects/42.obj`.
+ *
+ * @param path Path to normalize.
+ * @return std::string Normalized path.
+ */
+std::string normalizeAssetPath(const std::string &path) {
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos)
+            end = path.size();
+        const std::string part = path.substr(start, end - start);
+        if (part == "..") {
+            if (!parts.empty() && parts.back() != "..")
+                parts.pop_back();
+            else
+                parts.push_back(part);
+        } else if (!part.empty() && part != ".") {
+            parts.push_back(part);
+        }
+        start = end + 1;
+    }
+
+    std::string result = (!path.empty() && path[0] == '/') ? "/" : "";
+    for (size_t i = 0; i < parts.size(); i++) {
+        if (i) result += '/';
+        result += parts[i];
+    }
+    return result;
+}
+
+/**
+ * @brief Hashes a normalized asset path (64-bit FNV-1a).
+ * @param path Normalized path.
+ * @return uint64_t Path hash.
+ */
+uint64_t hashAssetPath(const std::string &path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c: path) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Opens and memory-maps a pack file.
+ *
+ * The file is mapped read-only and its header, directory and hash index are
+ * validated before the pack is returned.
+ *
+ * @param packPath Path to the pack file.
+ * @return std::unique_ptr<AssetPack> Opened pack, or `nullptr` if the file could not be mapped or is not a valid pack.
+ */
+std::unique_ptr<AssetPack> AssetPack::open(const std::string &packPath) {
+    std::unique_ptr<AssetPack> pack(new AssetPack());
+
+    pack->m_fd = ::open(packPath.c_str(), O_RDONLY);
+    if (pack->m_fd < 0) {
+        fprintf(stderr, "Failed to open asset pack %s\n", packPath.c_str());
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(pack->m_fd, &st) || static_cast<size_t>(st.st_size) < sizeof(PackHeader)) {
+        fprintf(stderr, "Asset pack %s is too small\n", packPath.c_str());
+        return nullptr;
+    }
+    pack->m_size = static_cast<size_t>(st.st_size);
+
+    void *mapping = mmap(nullptr, pack->m_size, PROT_READ, MAP_PRIVATE, pack->m_fd, 0);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Failed to map asset pack %s\n", packPath.c_str());
+        return nullptr;
+    }
+    pack->m_data = static_cast<const char *>(mapping);
+
+    pack->m_header = reinterpret_cast<const PackHeader *>(pack->m_data);
+    if (!pack->validate()) {
+        fprintf(stderr, "Invalid asset pack %s\n", packPath.c_str());
+        return nullptr;
+    }
+    pack->m_entries = reinterpret_cast<const PackEntry *>(pack->m_data + pack->m_header->directoryOffset);
+    pack->m_hashSlots = reinterpret_cast<const uint32_t *>(pack->m_data + pack->m_header->hashOffset);
+    pack->m_names = pack->m_data + pack->m_header->namesOffset;
+    return pack;
+}
+
+AssetPack::~AssetPack() {
+    if (m_data)
+        munmap(const_cast<char *>(m_data), m_size);
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+/**
+ * @brief Looks up an entry by path.
+ *
+ * The normalized path is hashed and the hash index is probed linearly until
+ * an empty slot is hit; names are compared only when hashes match.
+ *
+ * @param path Path of the asset (normalized internally).
+ * @return const PackEntry* Matching entry, or `nullptr` if the pack does not contain the path.
+ */
+const PackEntry *AssetPack::find(const std::string &path) const {
+    const std::string name = normalizeAssetPath(path);
+    const uint64_t hash = hashAssetPath(name);
+    const uint32_t mask = m_header->hashSlotCount - 1;
+
+    for (uint32_t probe = 0; probe < m_header->hashSlotCount; probe++) {
+        const uint32_t slot = m_hashSlots[(hash + probe) & mask];
+        if (slot == 0)
+            return nullptr;
+        const PackEntry &entry = m_entries[slot - 1];
+        if (entry.hash == hash && entry.nameLength == name.size() &&
+            memcmp(m_names + entry.nameOffset, name.data(), name.size()) == 0)
+            return &entry;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Returns a pointer to the stored bytes of an entry inside the mapping.
+ * @param entry Entry returned by `find()`.
+ * @return const char* Stored (possibly compressed) entry data.
+ */
+const char *AssetPack::getEntryData(const PackEntry &entry) const {
+    return m_data + entry.offset;
+}
+
+std::string AssetPack::getEntryName(const PackEntry &entry) const {
+    return std::string(m_names + entry.nameOffset, entry.nameLength);
+}
+
+/**
+ * @brief Lists all entries whose path starts with the given prefix.
+ *
+ * Uses a binary search over the sorted directory to find the first match.
+ *
+ * @param prefix Path prefix (normalized internally), e.g. `res/objects`.
+ * @return std::vector<std::string> Matching paths in sorted order.
+ */
+std::vector<std::string> AssetPack::list(const std::string &prefix) const {
+    const std::string name = normalizeAssetPath(prefix);
+    std::vector<std::string> result;
+
+    size_t lo = 0, hi = m_header->entryCount;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (getEntryName(m_entries[mid]) < name)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (size_t i = lo; i < m_header->entryCount; i++) {
+        std::string entryName = getEntryName(m_entries[i]);
+        if (entryName.compare(0, name.size(), name) != 0)
+            break;
+        result.push_back(entryName);
+    }
+    return result;
+}
+
+/**
+ * @brief Opens a pack and adds it to the list searched by `Asset::load()`.
+ *
+ * Packs mounted later take precedence over packs mounted earlier.
+ *
+ * @param packPath Path to the pack file.
+ * @return bool true if the pack was opened and mounted.
+ */
+bool AssetPack::mount(const std::string &packPath) {
+    std::unique_ptr<AssetPack> pack = open(packPath);
+    if (!pack)
+        return false;
+    printf("Mounted asset pack %s (%u entries)\n", packPath.c_str(), pack->m_header->entryCount);
+    s_mounted.insert(s_mounted.begin(), std::move(pack));
+    return true;
+}
+
+const std::vector<std::unique_ptr<AssetPack>> &AssetPack::getMounted() {
+    return s_mounted;
+}
+
+/**
+ * @brief Whether `size` bytes from `offset` fit in `limit` bytes, written so the sum cannot wrap around.
+ */
+static bool fitsIn(const uint64_t offset, const uint64_t size, const uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+/**
+ * @brief Checks that every table referenced by the header lies inside the mapping.
+ *
+ * Entries must lie inside the mapping and their names inside the name
+ * table, and every hash slot must be empty or index an existing entry, so
+ * that `find()` and `getEntryData()` never read outside the file. Stored
+ * entries must be exactly their size, since `Asset` exposes them in place,
+ * and compressed ones cannot claim more than PACK_MAX_EXPANSION times
+ * their stored size, which `Asset` allocates before decompressing.
+ *
+ * @return bool true if the header describes a well-formed pack.
+ */
+bool AssetPack::validate() const {
+    const PackHeader &h = *m_header;
+    if (memcmp(h.magic, PACK_MAGIC, 4) != 0 || h.version != PACK_VERSION)
+        return false;
+    if (h.hashSlotCount == 0 || (h.hashSlotCount & (h.hashSlotCount - 1)) != 0)
+        return false;
+    if (!fitsIn(h.directoryOffset, static_cast<uint64_t>(h.entryCount) * sizeof(PackEntry), m_size) ||
+        !fitsIn(h.hashOffset, static_cast<uint64_t>(h.hashSlotCount) * sizeof(uint32_t), m_size) ||
+        !fitsIn(h.namesOffset, h.namesSize, m_size))
+        return false;
+
+    const PackEntry *entries = reinterpret_cast<const PackEntry *>(m_data + h.directoryOffset);
+    for (uint32_t i = 0; i < h.entryCount; i++) {
+        if (!fitsIn(entries[i].offset, entries[i].storedSize, m_size) ||
+            !fitsIn(entries[i].nameOffset, entries[i].nameLength, h.namesSize))
+            return false;
+        if (entries[i].flags & PACK_FLAG_COMPRESSED ? entries[i].size / PACK_MAX_EXPANSION > entries[i].storedSize
+                                                    : entries[i].size != entries[i].storedSize)
+            return false;
+    }
+    const uint32_t *slots = reinterpret_cast<const uint32_t *>(m_data + h.hashOffset);
+    for (uint32_t i = 0; i < h.hashSlotCount; i++) {
+        if (slots[i] > h.entryCount)
+            return false;
+    }
+    return true;
+}
+
+static uint64_t alignOffset(const uint64_t offset, const uint64_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * @brief Builds a pack file from a list of loose files.
+ *
+ * Entries are stored under their normalized path and sorted by it. Each
+ * entry starts on a `PACK_ALIGNMENT` boundary. When `compress` is set,
+ * an entry is stored compressed only if that saves at least 10% of its size;
+ * already-compressed formats such as PNG stay uncompressed and zero-copy.
+ *
+ * @param packPath Output path.
+ * @param files Files to store.
+ * @param compress Whether to try compressing entries.
+ * @return bool true if the pack was written.
+ */
+bool AssetPack::write(const std::string &packPath, const std::vector<std::string> &files, bool compress) {
+    struct PendingEntry {
+        std::string name;
+        std::vector<char> stored;
+        uint64_t size;
+        uint32_t flags;
+    };
+
+    std::vector<PendingEntry> pending;
+    for (const std::string &path: files) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            fprintf(stderr, "Failed to open file %s\n", path.c_str());
+            return false;
+        }
+        PendingEntry entry;
+        entry.name = normalizeAssetPath(path);
+        entry.stored.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        entry.size = entry.stored.size();
+        entry.flags = 0;
+
+        if (compress && !entry.stored.empty()) {
+            std::vector<char> packed = lzCompress(entry.stored.data(), entry.stored.size());
+            if (packed.size() < entry.stored.size() - entry.stored.size() / 10) {
+                entry.stored.swap(packed);
+                entry.flags |= PACK_FLAG_COMPRESSED;
+            }
+        }
+        pending.push_back(std::move(entry));
+    }
+
+    std::sort(pending.begin(), pending.end(), [](const PendingEntry &a, const PendingEntry &b) {
+        return a.name < b.name;
+    });
+    for (size_t i = 1; i < pending.size(); i++) {
+        if (pending[i].name == pending[i - 1].name) {
+            fprintf(stderr, "Duplicate asset path %s\n", pending[i].name.c_str());
+            return false;
+        }
+    }
+
+    uint32_t slotCount = 1;
+    while (slotCount < pending.size() * 2)
+        slotCount <<= 1;
+
+    PackHeader header{};
+    memcpy(header.magic, PACK_MAGIC, 4);
+    header.version = PACK_VERSION;
+    header.entryCount = static_cast<uint32_t>(pending.size());
+    header.hashSlotCount = slotCount;
+    header.alignment = PACK_ALIGNMENT;
+    header.directoryOffset = sizeof(PackHeader);
+    header.hashOffset = header.directoryOffset + pending.size() * sizeof(PackEntry);
+    header.namesOffset = header.hashOffset + slotCount * sizeof(uint32_t);
+
+    std::string names;
+    std::vector<PackEntry> entries(pending.size());
+    std::vector<uint32_t> slots(slotCount, 0);
+    for (size_t i = 0; i < pending.size(); i++) {
+        PackEntry &entry = entries[i];
+        entry.hash = hashAssetPath(pending[i].name);
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(pending[i].name.size());
+        entry.size = pending[i].size;
+        entry.storedSize = pending[i].stored.size();
+        entry.flags = pending[i].flags;
+        names += pending[i].name;
+
+        uint64_t slot = entry.hash & (slotCount - 1);
+        while (slots[slot])
+            slot = (slot + 1) & (slotCount - 1);
+        slots[slot] = static_cast<uint32_t>(i + 1);
+    }
+    header.namesSize = names.size();
+
+    uint64_t offset = header.namesOffset + header.namesSize;
+    for (PackEntry &entry: entries) {
+        offset = alignOffset(offset, PACK_ALIGNMENT);
+        entry.offset = offset;
+        offset += entry.storedSize;
+    }
+
+    std::ofstream out(packPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        fprintf(stderr, "Failed to create asset pack %s\n", packPath.c_str());
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()), entries.size() * sizeof(PackEntry));
+    out.write(reinterpret_cast<const char *>(slots.data()), slots.size() * sizeof(uint32_t));
+    out.write(names.data(), names.size());
+
+    uint64_t written = header.namesOffset + header.namesSize;
+    const char zeros[PACK_ALIGNMENT] = {};
+    for (size_t i = 0; i < entries.size(); i++) {
+        out.write(zeros, entries[i].offset - written);
+        out.write(pending[i].stored.data(), pending[i].stored.size());
+        written = entries[i].offset + entries[i].storedSize;
+    }
+    if (!out) {
+        fprintf(stderr, "Failed to write asset pack %s\n", packPath.c_str());
+        return false;
+    }
+    return true;
+}
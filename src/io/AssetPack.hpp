@@ -0,0 +1,108 @@
+/**
+ * @file AssetPack.hpp
+ * @author Patryk
+ * @brief AssetPack class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_ASSETPACK_HPP
+#define SCOP_ASSETPACK_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define PACK_MAGIC "SPAK"
+#define PACK_VERSION 1
+#define PACK_ALIGNMENT 64
+#define PACK_FLAG_COMPRESSED 1u
+// lzDecompress() writes at most 255 bytes per input byte
+#define PACK_MAX_EXPANSION 255
+
+/**
+ * @brief Fixed-size header at the start of every pack file.
+ *
+ * All offsets are absolute file offsets. The header is followed by the
+ * directory, the hash index, the name table and the aligned entry data.
+ */
+struct PackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t hashSlotCount;
+    uint64_t directoryOffset;
+    uint64_t hashOffset;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+    uint32_t alignment;
+    uint32_t reserved[3];
+};
+
+/**
+ * @brief Directory record describing one file stored in the pack.
+ *
+ * Records are sorted by path, so a prefix of the directory can be listed
+ * with a binary search. `size` is the original size, `storedSize` the size
+ * on disk (smaller when the entry is compressed).
+ */
+struct PackEntry {
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t storedSize;
+    uint64_t size;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+/**
+ * @brief Read-only, memory-mapped asset archive.
+ *
+ * The whole pack is mapped once; lookups go through an open-addressing hash
+ * index and return pointers straight into the mapping, so uncompressed
+ * entries are read without any copy. Mounted packs are searched by
+ * `Asset::load()` before falling back to loose files.
+ */
+class AssetPack {
+public:
+    AssetPack() = default;
+    static std::unique_ptr<AssetPack> open(const std::string &packPath);
+    AssetPack(const AssetPack &other) = delete;
+    ~AssetPack();
+
+    AssetPack &operator=(const AssetPack &other) = delete;
+
+    const PackEntry *find(const std::string &path) const;
+    const char *getEntryData(const PackEntry &entry) const;
+    std::string getEntryName(const PackEntry &entry) const;
+    std::vector<std::string> list(const std::string &prefix) const;
+
+    static bool mount(const std::string &packPath);
+    static const std::vector<std::unique_ptr<AssetPack>> &getMounted();
+    static bool write(const std::string &packPath, const std::vector<std::string> &files, bool compress);
+
+private:
+    int m_fd = -1;
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+
+    const PackHeader *m_header = nullptr;
+    const PackEntry *m_entries = nullptr;
+    const uint32_t *m_hashSlots = nullptr;
+    const char *m_names = nullptr;
+
+    static std::vector<std::unique_ptr<AssetPack>> s_mounted;
+
+    bool validate() const;
+};
+
+std::string normalizeAssetPath(const std::string &path);
+uint64_t hashAssetPath(const std::string &path);
+
+#endif //SCOP_ASSETPACK_HPP
@@ -0,0 +1,160 @@
+/**
+ * @file Compression.cpp
+ * @author Patryk
+ * @brief Byte-oriented LZ compression implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdint>
+#include <cstring>
+#include "Compression.hpp"
+
+#define LZ_MIN_MATCH 4
+#define LZ_LAST_LITERALS 5
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS 16
+
+static uint32_t read32(const char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static void writeLength(std::vector<char> &out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+/**
+ * @brief Compresses a byte buffer with a greedy LZ77 matcher.
+ *
+ * The output is a sequence of tokens, each holding a run of literals
+ * followed by a back-reference (16-bit offset, length >= 4). Lengths that do
+ * not fit in the token nibble are continued with 255-terminated bytes.
+ * The last sequence holds literals only.
+ *
+ * @param src Data to compress.
+ * @param size Size of the data in bytes.
+ * @return std::vector<char> Compressed stream.
+ */
+std::vector<char> lzCompress(const char *src, const size_t size) {
+    std::vector<char> out;
+    out.reserve(size + size / 255 + 16);
+
+    std::vector<uint32_t> table(1u << LZ_HASH_BITS, UINT32_MAX);
+    size_t anchor = 0;
+    size_t i = 0;
+
+    const size_t matchLimit = size > LZ_LAST_LITERALS + LZ_MIN_MATCH ? size - LZ_LAST_LITERALS : 0;
+    while (i + LZ_MIN_MATCH <= matchLimit) {
+        const uint32_t sequence = read32(src + i);
+        const uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        const uint32_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i);
+
+        if (candidate == UINT32_MAX || i - candidate > LZ_MAX_OFFSET || read32(src + candidate) != sequence) {
+            i++;
+            continue;
+        }
+
+        size_t matchLength = LZ_MIN_MATCH;
+        while (i + matchLength < matchLimit && src[candidate + matchLength] == src[i + matchLength])
+            matchLength++;
+
+        const size_t literalLength = i - anchor;
+        const size_t matchCode = matchLength - LZ_MIN_MATCH;
+        out.push_back(static_cast<char>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                        (matchCode < 15 ? matchCode : 15)));
+        if (literalLength >= 15)
+            writeLength(out, literalLength - 15);
+        out.insert(out.end(), src + anchor, src + i);
+
+        const size_t offset = i - candidate;
+        out.push_back(static_cast<char>(offset & 0xFF));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (matchCode >= 15)
+            writeLength(out, matchCode - 15);
+
+        i += matchLength;
+        anchor = i;
+    }
+
+    const size_t literalLength = size - anchor;
+    out.push_back(static_cast<char>((literalLength < 15 ? literalLength : 15) << 4));
+    if (literalLength >= 15)
+        writeLength(out, literalLength - 15);
+    out.insert(out.end(), src + anchor, src + size);
+    return out;
+}
+
+/**
+ * @brief Decompresses a stream produced by `lzCompress()`.
+ *
+ * Every read and write is bounds checked, so corrupted input is rejected
+ * instead of overrunning the destination buffer.
+ *
+ * @param src Compressed stream.
+ * @param srcSize Size of the compressed stream in bytes.
+ * @param dst Destination buffer.
+ * @param dstSize Expected decompressed size in bytes.
+ * @return bool true if the stream decoded to exactly `dstSize` bytes.
+ */
+bool lzDecompress(const char *src, const size_t srcSize, char *dst, const size_t dstSize) {
+    const unsigned char *in = reinterpret_cast<const unsigned char *>(src);
+    size_t ip = 0;
+    size_t op = 0;
+
+    while (ip < srcSize) {
+        const unsigned char token = in[ip++];
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            unsigned char b;
+            do {
+                if (ip >= srcSize) return false;
+                b = in[ip++];
+                literalLength += b;
+            } while (b == 255);
+        }
+        if (ip + literalLength > srcSize || op + literalLength > dstSize)
+            return false;
+        memcpy(dst + op, src + ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+
+        if (ip == srcSize)
+            break;
+
+        if (ip + 2 > srcSize) return false;
+        const size_t offset = in[ip] | (in[ip + 1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op)
+            return false;
+
+        size_t matchLength = (token & 15);
+        if (matchLength == 15) {
+            unsigned char b;
+            do {
+                if (ip >= srcSize) return false;
+                b = in[ip++];
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += LZ_MIN_MATCH;
+        if (op + matchLength > dstSize)
+            return false;
+
+        const char *match = dst + op - offset;
+        for (size_t k = 0; k < matchLength; k++)
+            dst[op + k] = match[k];
+        op += matchLength;
+    }
+    return op == dstSize;
+}
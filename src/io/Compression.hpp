@@ -0,0 +1,21 @@
+/**
+ * @file Compression.hpp
+ * @author Patryk
+ * @brief Byte-oriented LZ compression declarations
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_COMPRESSION_HPP
+#define SCOP_COMPRESSION_HPP
+
+#include <cstddef>
+#include <vector>
+
+std::vector<char> lzCompress(const char *src, const size_t size);
+bool lzDecompress(const char *src, const size_t srcSize, char *dst, const size_t dstSize);
+
+#endif //SCOP_COMPRESSION_HPP
@@ -0,0 +1,75 @@
+/**
+ * @file FileWatcher.cpp
+ * @author Patryk
+ * @brief FileWatcher class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include "FileWatcher.hpp"
+
+/**
+ * @brief Starts watching a file for modifications.
+ * @param filePath File to watch.
+ * @return std::unique_ptr<FileWatcher> The watcher, or `nullptr` if inotify is unavailable.
+ */
+std::unique_ptr<FileWatcher> FileWatcher::create(const std::string &filePath) {
+    std::unique_ptr<FileWatcher> watcher(new FileWatcher());
+
+    const size_t slash = filePath.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : filePath.substr(0, slash + 1);
+    watcher->m_fileName = slash == std::string::npos ? filePath : filePath.substr(slash + 1);
+
+    watcher->m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watcher->m_fd < 0) {
+        fprintf(stderr, "Failed to initialize inotify: %s\n", strerror(errno));
+        return nullptr;
+    }
+    if (inotify_add_watch(watcher->m_fd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        fprintf(stderr, "Failed to watch %s: %s\n", directory.c_str(), strerror(errno));
+        return nullptr;
+    }
+    return watcher;
+}
+
+FileWatcher::~FileWatcher() {
+    if (m_fd >= 0)
+        close(m_fd);
+}
+
+/**
+ * @brief Drains pending inotify events without blocking.
+ * @return bool true once per burst of changes, after the file has been quiet
+ * for FILE_WATCHER_DEBOUNCE_MS.
+ */
+bool FileWatcher::poll() {
+    alignas(struct inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(m_fd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + length;) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+            if (event->len && m_fileName == event->name) {
+                m_pending = true;
+                m_lastEvent = std::chrono::steady_clock::now();
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    if (!m_pending)
+        return false;
+    const auto quiet = std::chrono::steady_clock::now() - m_lastEvent;
+    if (quiet < std::chrono::milliseconds(FILE_WATCHER_DEBOUNCE_MS))
+        return false;
+    m_pending = false;
+    return true;
+}
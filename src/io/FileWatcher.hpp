@@ -0,0 +1,47 @@
+/**
+ * @file FileWatcher.hpp
+ * @author Patryk
+ * @brief FileWatcher class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_FILEWATCHER_HPP
+#define SCOP_FILEWATCHER_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#define FILE_WATCHER_DEBOUNCE_MS 200
+
+/**
+ * @brief Reports changes of a single file using inotify.
+ *
+ * The file's directory is watched rather than the file itself, so editors
+ * that save by writing a temporary file and renaming it over the original
+ * are detected as well. Bursts of events are debounced: `poll()` reports a
+ * change once the file has been quiet for FILE_WATCHER_DEBOUNCE_MS.
+ */
+class FileWatcher {
+public:
+    FileWatcher() = default;
+    static std::unique_ptr<FileWatcher> create(const std::string &filePath);
+    FileWatcher(const FileWatcher &other) = delete;
+    ~FileWatcher();
+
+    FileWatcher &operator=(const FileWatcher &other) = delete;
+
+    bool poll();
+
+private:
+    int m_fd = -1;
+    std::string m_fileName;
+    bool m_pending = false;
+    std::chrono::steady_clock::time_point m_lastEvent;
+};
+
+#endif //SCOP_FILEWATCHER_HPP
@@ -0,0 +1,729 @@
+/**
+ * @file Gltf.cpp
+ * @author Patryk
+ * @brief GltfModel implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "Gltf.hpp"
+#include "Json.hpp"
+#include "../utils/Parallel.hpp"
+
+#define GLTF_MAX_NODE_DEPTH 64
+// Largest count or offset accepted from the JSON, 2^53 (exact in a double)
+#define GLTF_MAX_SIZE 9007199254740992.0
+
+#define GLTF_BYTE 5120
+#define GLTF_UNSIGNED_BYTE 5121
+#define GLTF_SHORT 5122
+#define GLTF_UNSIGNED_SHORT 5123
+#define GLTF_UNSIGNED_INT 5125
+#define GLTF_FLOAT 5126
+
+#define GLTF_TRIANGLES 4
+#define GLTF_TRIANGLE_STRIP 5
+#define GLTF_TRIANGLE_FAN 6
+
+/**
+ * @brief Accessor resolved against its buffer view.
+ */
+struct GltfAccessor {
+    const char *data = nullptr;
+    size_t view = 0;
+    size_t offset = 0;
+    size_t stride = 0;
+    unsigned int componentType = 0;
+    int components = 0;
+    bool normalized = false;
+    size_t count = 0;
+};
+
+static size_t getComponentSize(unsigned int componentType) {
+    switch (componentType) {
+        case GLTF_BYTE:
+        case GLTF_UNSIGNED_BYTE:
+            return 1;
+        case GLTF_SHORT:
+        case GLTF_UNSIGNED_SHORT:
+            return 2;
+        case GLTF_UNSIGNED_INT:
+        case GLTF_FLOAT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static int getComponentCount(const std::string &type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT2") return 4;
+    if (type == "MAT3") return 9;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+static uint32_t readU32(const char *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Reads a byte offset or element count: a missing value is 0, a negative, fractional or huge one is refused.
+ */
+static bool readSize(const JsonValue &value, size_t &size) {
+    const double number = value.isNull() ? 0.0 : value.asNumber(-1.0);
+    if (!(number >= 0.0) || number != std::floor(number) || number > GLTF_MAX_SIZE)
+        return false;
+    size = static_cast<size_t>(number);
+    return true;
+}
+
+static std::array<float, 16> getIdentity() {
+    return {1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+/**
+ * @brief mat1 * mat2 with the renderer's convention (mat1 is applied first).
+ */
+static std::array<float, 16> multiply(const std::array<float, 16> &mat1, const std::array<float, 16> &mat2) {
+    std::array<float, 16> result = {};
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            for (int k = 0; k < 4; k++)
+                result[row * 4 + col] += mat1[row * 4 + k] * mat2[k * 4 + col];
+        }
+    }
+    return result;
+}
+
+static std::array<float, 3> transformPoint(const std::array<float, 16> &m, const std::array<float, 3> &p) {
+    return {p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12],
+            p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13],
+            p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14]};
+}
+
+/**
+ * @brief Local transform of a node, from `matrix` or from translation/rotation/scale.
+ *
+ * glTF matrices are column-major, which is exactly the layout used by the
+ * renderer's matrices (translation in elements 12-14).
+ */
+static std::array<float, 16> getNodeMatrix(const JsonValue &node) {
+    std::array<float, 16> m = getIdentity();
+    const JsonValue &matrix = node["matrix"];
+    if (matrix.size() == 16) {
+        for (size_t i = 0; i < 16; i++)
+            m[i] = static_cast<float>(matrix[i].asNumber());
+        return m;
+    }
+
+    const JsonValue &t = node["translation"];
+    const JsonValue &r = node["rotation"];
+    const JsonValue &s = node["scale"];
+    const float x = static_cast<float>(r[0].asNumber(0.0)), y = static_cast<float>(r[1].asNumber(0.0));
+    const float z = static_cast<float>(r[2].asNumber(0.0)), w = static_cast<float>(r[3].asNumber(1.0));
+    const float sx = static_cast<float>(s[0].asNumber(1.0));
+    const float sy = static_cast<float>(s[1].asNumber(1.0));
+    const float sz = static_cast<float>(s[2].asNumber(1.0));
+
+    m[0] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+    m[1] = 2.0f * (x * y + z * w) * sx;
+    m[2] = 2.0f * (x * z - y * w) * sx;
+    m[4] = 2.0f * (x * y - z * w) * sy;
+    m[5] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+    m[6] = 2.0f * (y * z + x * w) * sy;
+    m[8] = 2.0f * (x * z + y * w) * sz;
+    m[9] = 2.0f * (y * z - x * w) * sz;
+    m[10] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+    m[12] = static_cast<float>(t[0].asNumber());
+    m[13] = static_cast<float>(t[1].asNumber());
+    m[14] = static_cast<float>(t[2].asNumber());
+    return m;
+}
+
+/**
+ * @brief Approximates a metallic-roughness material with Phong parameters.
+ *
+ * The base color drives the ambient and diffuse terms; the specular color
+ * blends from dielectric grey to the base color with metalness, and the
+ * roughness is converted to a Blinn-Phong exponent (2 / alpha^2 - 2).
+ */
+static MaterialParams toPhongParams(const JsonValue &material) {
+    const JsonValue &pbr = material["pbrMetallicRoughness"];
+    const JsonValue &base = pbr["baseColorFactor"];
+    const JsonValue &emissive = material["emissiveFactor"];
+    const float metallic = static_cast<float>(pbr["metallicFactor"].asNumber(1.0));
+    const float roughness = static_cast<float>(pbr["roughnessFactor"].asNumber(1.0));
+
+    MaterialParams params;
+    params.name = material["name"].asString();
+    for (size_t i = 0; i < 3; i++) {
+        const float color = static_cast<float>(base[i].asNumber(1.0));
+        params.Ka[i] = color;
+        params.Kd[i] = color;
+        params.Ks[i] = (0.04f + (color - 0.04f) * metallic) * (1.0f - roughness);
+        params.Ke[i] = static_cast<float>(emissive[i].asNumber(0.0));
+    }
+    const float alpha = std::max(roughness * roughness, 0.01f);
+    params.Ns = std::min(std::max(2.0f / (alpha * alpha) - 2.0f, 1.0f), 1000.0f);
+    params.Ni = 1.5f;
+    params.opacity = static_cast<float>(base[3].asNumber(1.0));
+    params.illum = 2;
+    return params;
+}
+
+/**
+ * @brief Walks the JSON document of a .glb file and fills a GltfModel.
+ */
+class GltfReader {
+public:
+    GltfReader(const JsonValue &json, GltfModel &model, const std::string &path)
+        : m_json(json), m_model(model), m_path(path),
+          m_directory(path.rfind('/') == std::string::npos ? "" : path.substr(0, path.rfind('/') + 1)) {}
+
+    bool read(const char *binData, size_t binSize) {
+        if (!readBuffers(binData, binSize) || !readViews())
+            return false;
+        readImages();
+        readMaterials();
+
+        m_meshes.resize(m_json["meshes"].size());
+        m_meshBuilt.assign(m_meshes.size(), false);
+        for (size_t root: getRootNodes())
+            visitNode(root, getIdentity(), 0);
+
+        if (m_model.primitives.empty()) {
+            fprintf(stderr, "%s: no drawable primitives\n", m_path.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    const JsonValue &m_json;
+    GltfModel &m_model;
+    std::string m_path;
+    std::string m_directory;
+    std::vector<std::pair<const char *, size_t>> m_buffers;
+    std::vector<size_t> m_viewStrides;
+    std::vector<char> m_viewUsage;
+    std::vector<std::vector<GltfPrimitive>> m_meshes;
+    std::vector<bool> m_meshBuilt;
+    long long m_defaultMaterial = -1;
+    bool m_hasBounds = false;
+
+    bool readBuffers(const char *binData, size_t binSize) {
+        const JsonValue &buffers = m_json["buffers"];
+        for (size_t i = 0; i < buffers.size(); i++) {
+            const JsonValue &buffer = buffers[i];
+            const size_t byteLength = static_cast<size_t>(buffer["byteLength"].asInt());
+            const char *data = nullptr;
+            size_t size = 0;
+
+            if (!buffer.has("uri")) {
+                if (i != 0 || !binData) {
+                    fprintf(stderr, "%s: buffer %zu has no data\n", m_path.c_str(), i);
+                    return false;
+                }
+                data = binData;
+                size = binSize;
+            } else {
+                const std::string &uri = buffer["uri"].asString();
+                if (uri.compare(0, 5, "data:") == 0) {
+                    fprintf(stderr, "%s: embedded data URIs are not supported\n", m_path.c_str());
+                    return false;
+                }
+                std::unique_ptr<Asset> external = Asset::map(m_directory + uri);
+                if (!external) {
+                    fprintf(stderr, "%s: cannot open buffer %s\n", m_path.c_str(), uri.c_str());
+                    return false;
+                }
+                data = external->data();
+                size = external->size();
+                m_model.externalBuffers.push_back(std::move(external));
+            }
+            if (byteLength > size) {
+                fprintf(stderr, "%s: buffer %zu is truncated\n", m_path.c_str(), i);
+                return false;
+            }
+            m_buffers.push_back({data, byteLength});
+        }
+        return true;
+    }
+
+    bool readViews() {
+        const JsonValue &views = m_json["bufferViews"];
+        m_model.views.resize(views.size());
+        m_viewStrides.resize(views.size());
+        m_viewUsage.assign(views.size(), 0);
+        for (size_t i = 0; i < views.size(); i++) {
+            const JsonValue &view = views[i];
+            const size_t buffer = static_cast<size_t>(view["buffer"].asInt(-1));
+            const size_t offset = static_cast<size_t>(view["byteOffset"].asInt());
+            const size_t length = static_cast<size_t>(view["byteLength"].asInt());
+            if (buffer >= m_buffers.size() || offset > m_buffers[buffer].second ||
+                length > m_buffers[buffer].second - offset) {
+                fprintf(stderr, "%s: buffer view %zu is out of bounds\n", m_path.c_str(), i);
+                return false;
+            }
+            m_model.views[i].data = m_buffers[buffer].first + offset;
+            m_model.views[i].size = length;
+            m_viewStrides[i] = static_cast<size_t>(view["byteStride"].asInt());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Decodes the images in parallel; embedded images are read straight from the mapping.
+     */
+    void readImages() {
+        const JsonValue &images = m_json["images"];
+        m_model.images.resize(images.size());
+        parallelFor(0, images.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const JsonValue &image = images[i];
+                const std::string name = m_path + "#image" + std::to_string(i);
+                bool decoded = false;
+                if (image.has("bufferView")) {
+                    const size_t view = static_cast<size_t>(image["bufferView"].asInt());
+                    if (view < m_model.views.size())
+                        decoded = Texture2D::decode(name, m_model.views[view].data, m_model.views[view].size,
+                                                    m_model.images[i], false);
+                } else if (image.has("uri")) {
+                    const std::unique_ptr<Asset> asset = Asset::load(m_directory + image["uri"].asString());
+                    if (asset)
+                        decoded = Texture2D::decode(name, asset->data(), asset->size(), m_model.images[i], false);
+                }
+                if (!decoded)
+                    fprintf(stderr, "%s: failed to decode image %zu\n", m_path.c_str(), i);
+            }
+        });
+    }
+
+    void readMaterials() {
+        const JsonValue &materials = m_json["materials"];
+        const JsonValue &textures = m_json["textures"];
+        for (size_t i = 0; i < materials.size(); i++) {
+            GltfMaterial material;
+            material.params = toPhongParams(materials[i]);
+            const JsonValue &baseTexture = materials[i]["pbrMetallicRoughness"]["baseColorTexture"];
+            if (baseTexture.has("index")) {
+                const long long source = textures[static_cast<size_t>(baseTexture["index"].asInt())]["source"].asInt(-1);
+                if (source >= 0 && static_cast<size_t>(source) < m_model.images.size() &&
+                    m_model.images[source].pixels)
+                    material.image = static_cast<int>(source);
+            }
+            m_model.materials.push_back(std::move(material));
+        }
+    }
+
+    size_t getDefaultMaterial() {
+        if (m_defaultMaterial < 0) {
+            m_defaultMaterial = static_cast<long long>(m_model.materials.size());
+            GltfMaterial material;
+            material.params = toPhongParams(JsonValue());
+            material.params.name = "default";
+            m_model.materials.push_back(std::move(material));
+        }
+        return static_cast<size_t>(m_defaultMaterial);
+    }
+
+    std::vector<size_t> getRootNodes() const {
+        std::vector<size_t> roots;
+        const JsonValue &scenes = m_json["scenes"];
+        if (scenes.size()) {
+            const JsonValue &scene = scenes[static_cast<size_t>(m_json["scene"].asInt(0))];
+            for (size_t i = 0; i < scene["nodes"].size(); i++)
+                roots.push_back(static_cast<size_t>(scene["nodes"][i].asInt()));
+            return roots;
+        }
+
+        const JsonValue &nodes = m_json["nodes"];
+        std::vector<bool> isChild(nodes.size(), false);
+        for (size_t i = 0; i < nodes.size(); i++) {
+            for (size_t c = 0; c < nodes[i]["children"].size(); c++) {
+                const size_t child = static_cast<size_t>(nodes[i]["children"][c].asInt());
+                if (child < isChild.size())
+                    isChild[child] = true;
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            if (!isChild[i])
+                roots.push_back(i);
+        }
+        return roots;
+    }
+
+    void visitNode(size_t index, const std::array<float, 16> &parent, int depth) {
+        const JsonValue &nodes = m_json["nodes"];
+        if (index >= nodes.size() || depth > GLTF_MAX_NODE_DEPTH)
+            return;
+        const JsonValue &node = nodes[index];
+        const std::array<float, 16> world = multiply(getNodeMatrix(node), parent);
+
+        if (node.has("mesh")) {
+            const size_t mesh = static_cast<size_t>(node["mesh"].asInt());
+            if (mesh < m_meshes.size()) {
+                if (!m_meshBuilt[mesh])
+                    buildMesh(mesh);
+                for (const GltfPrimitive &primitive: m_meshes[mesh]) {
+                    m_model.primitives.push_back(primitive);
+                    m_model.primitives.back().transform = world;
+                    extendBounds(primitive, world);
+                }
+            }
+        }
+        for (size_t c = 0; c < node["children"].size(); c++)
+            visitNode(static_cast<size_t>(node["children"][c].asInt()), world, depth + 1);
+    }
+
+    void extendBounds(const GltfPrimitive &primitive, const std::array<float, 16> &world) {
+        for (int corner = 0; corner < 8; corner++) {
+            const std::array<float, 3> local = {
+                (corner & 1) ? primitive.max[0] : primitive.min[0],
+                (corner & 2) ? primitive.max[1] : primitive.min[1],
+                (corner & 4) ? primitive.max[2] : primitive.min[2]
+            };
+            const std::array<float, 3> p = transformPoint(world, local);
+            for (int k = 0; k < 3; k++) {
+                if (!m_hasBounds || p[k] < m_model.min[k]) m_model.min[k] = p[k];
+                if (!m_hasBounds || p[k] > m_model.max[k]) m_model.max[k] = p[k];
+            }
+        }
+        m_hasBounds = true;
+    }
+
+    bool readAccessor(const JsonValue &index, GltfAccessor &accessor) const {
+        const JsonValue &json = m_json["accessors"][static_cast<size_t>(index.asInt(-1))];
+        if (json.isNull() || !json.has("bufferView") || json.has("sparse"))
+            return false;
+
+        accessor.componentType = static_cast<unsigned int>(json["componentType"].asInt());
+        accessor.components = getComponentCount(json["type"].asString());
+        accessor.normalized = json["normalized"].asBool();
+        if (!readSize(json["bufferView"], accessor.view) || !readSize(json["byteOffset"], accessor.offset) ||
+            !readSize(json["count"], accessor.count))
+            return false;
+        if (accessor.view >= m_viewStrides.size() || !accessor.components ||
+            !getComponentSize(accessor.componentType))
+            return false;
+
+        // Divided rather than multiplied, so that a huge count cannot wrap around and pass
+        const size_t elementSize = getComponentSize(accessor.componentType) * accessor.components;
+        accessor.stride = m_viewStrides[accessor.view] ? m_viewStrides[accessor.view] : elementSize;
+        const size_t viewSize = m_model.views[accessor.view].size;
+        if (accessor.count && (elementSize > viewSize || accessor.offset > viewSize - elementSize ||
+            accessor.count - 1 > (viewSize - accessor.offset - elementSize) / accessor.stride))
+            return false;
+        accessor.data = m_model.views[accessor.view].data + accessor.offset;
+        return true;
+    }
+
+    /**
+     * @brief Marks a view as holding indices or vertices; a view cannot be both.
+     */
+    bool useView(size_t view, bool indices) {
+        const char usage = indices ? 2 : 1;
+        if (m_viewUsage[view] && m_viewUsage[view] != usage)
+            return false;
+        m_viewUsage[view] = usage;
+        m_model.views[view].indices = indices;
+        return true;
+    }
+
+    static std::array<float, 3> readPosition(const GltfAccessor &accessor, size_t i) {
+        std::array<float, 3> p;
+        memcpy(p.data(), accessor.data + i * accessor.stride, sizeof(p));
+        return p;
+    }
+
+    static size_t readIndex(const GltfAccessor &accessor, size_t i) {
+        const char *p = accessor.data + i * accessor.stride;
+        if (accessor.componentType == GLTF_UNSIGNED_BYTE)
+            return static_cast<unsigned char>(*p);
+        if (accessor.componentType == GLTF_UNSIGNED_SHORT) {
+            uint16_t value;
+            memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        return readU32(p);
+    }
+
+    size_t addGeneratedView(std::unique_ptr<char[]> storage, size_t size) {
+        GltfBufferView view;
+        view.data = storage.get();
+        view.size = size;
+        m_model.generated.push_back(std::move(storage));
+        m_model.generatedSize += size;
+        m_model.views.push_back(view);
+        m_viewUsage.push_back(1);
+        return m_model.views.size() - 1;
+    }
+
+    /**
+     * @brief Computes smooth normals for a primitive without a NORMAL attribute.
+     */
+    size_t generateNormals(const GltfAccessor &positions, const GltfAccessor *indices, unsigned int mode, size_t count) {
+        std::unique_ptr<char[]> storage(new char[positions.count * 3 * sizeof(float)]);
+        float *normals = reinterpret_cast<float *>(storage.get());
+        std::fill(normals, normals + positions.count * 3, 0.0f);
+
+        auto vertexAt = [&](size_t i) { return indices ? readIndex(*indices, i) : i; };
+        auto addTriangle = [&](size_t a, size_t b, size_t c) {
+            const std::array<float, 3> p0 = readPosition(positions, a);
+            const std::array<float, 3> p1 = readPosition(positions, b);
+            const std::array<float, 3> p2 = readPosition(positions, c);
+            const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            const float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length == 0.0f)
+                return;
+            for (size_t v: {a, b, c}) {
+                for (int k = 0; k < 3; k++)
+                    normals[v * 3 + k] += n[k] / length;
+            }
+        };
+
+        if (mode == GLTF_TRIANGLES) {
+            for (size_t i = 0; i + 2 < count; i += 3)
+                addTriangle(vertexAt(i), vertexAt(i + 1), vertexAt(i + 2));
+        } else if (mode == GLTF_TRIANGLE_STRIP) {
+            for (size_t i = 0; i + 2 < count; i++) {
+                if (i % 2)
+                    addTriangle(vertexAt(i + 1), vertexAt(i), vertexAt(i + 2));
+                else
+                    addTriangle(vertexAt(i), vertexAt(i + 1), vertexAt(i + 2));
+            }
+        } else if (mode == GLTF_TRIANGLE_FAN) {
+            for (size_t i = 1; i + 1 < count; i++)
+                addTriangle(vertexAt(0), vertexAt(i), vertexAt(i + 1));
+        }
+
+        for (size_t v = 0; v < positions.count; v++) {
+            float *n = normals + v * 3;
+            const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length > 0.0f) {
+                n[0] /= length;
+                n[1] /= length;
+                n[2] /= length;
+            } else {
+                n[2] = 1.0f;
+            }
+        }
+        return addGeneratedView(std::move(storage), positions.count * 3 * sizeof(float));
+    }
+
+    /**
+     * @brief Projects positions on the XY plane for a primitive without TEXCOORD_0, like OBJ files.
+     */
+    size_t generateUVs(const GltfAccessor &positions, const std::array<float, 3> &min, const std::array<float, 3> &max) {
+        std::unique_ptr<char[]> storage(new char[positions.count * 2 * sizeof(float)]);
+        float *uvs = reinterpret_cast<float *>(storage.get());
+        const float width = max[0] - min[0];
+        const float height = max[1] - min[1];
+        for (size_t v = 0; v < positions.count; v++) {
+            const std::array<float, 3> p = readPosition(positions, v);
+            uvs[v * 2] = width > 0.0f ? (p[0] - min[0]) / width : 0.0f;
+            uvs[v * 2 + 1] = height > 0.0f ? (p[1] - min[1]) / height : 0.0f;
+        }
+        return addGeneratedView(std::move(storage), positions.count * 2 * sizeof(float));
+    }
+
+    static GltfAttribute makeAttribute(unsigned int location, const GltfAccessor &accessor) {
+        GltfAttribute attribute;
+        attribute.location = location;
+        attribute.components = accessor.components;
+        attribute.componentType = accessor.componentType;
+        attribute.normalized = accessor.normalized;
+        attribute.stride = accessor.stride;
+        attribute.offset = accessor.offset;
+        attribute.view = accessor.view;
+        return attribute;
+    }
+
+    void buildMesh(size_t mesh) {
+        m_meshBuilt[mesh] = true;
+        const JsonValue &primitives = m_json["meshes"][mesh]["primitives"];
+        for (size_t p = 0; p < primitives.size(); p++) {
+            GltfPrimitive primitive;
+            if (buildPrimitive(primitives[p], primitive))
+                m_meshes[mesh].push_back(std::move(primitive));
+            else
+                fprintf(stderr, "%s: skipping unsupported primitive %zu of mesh %zu\n", m_path.c_str(), p, mesh);
+        }
+    }
+
+    /**
+     * @brief Resolves the attributes and indices of a primitive.
+     */
+    bool buildPrimitive(const JsonValue &json, GltfPrimitive &primitive) {
+        const JsonValue &attributes = json["attributes"];
+        GltfAccessor positions;
+        if (!readAccessor(attributes["POSITION"], positions) || positions.componentType != GLTF_FLOAT ||
+            positions.components != 3 || positions.count == 0 || !useView(positions.view, false))
+            return false;
+
+        primitive.mode = static_cast<unsigned int>(json["mode"].asInt(GLTF_TRIANGLES));
+        if (primitive.mode > GLTF_TRIANGLE_FAN)
+            return false;
+        primitive.attributes.push_back(makeAttribute(GLTF_LOCATION_POSITION, positions));
+
+        GltfAccessor indices;
+        primitive.count = positions.count;
+        if (json.has("indices")) {
+            if (!readAccessor(json["indices"], indices) || indices.components != 1 ||
+                (indices.componentType != GLTF_UNSIGNED_BYTE && indices.componentType != GLTF_UNSIGNED_SHORT &&
+                 indices.componentType != GLTF_UNSIGNED_INT) ||
+                indices.stride != getComponentSize(indices.componentType) || !useView(indices.view, true))
+                return false;
+            for (size_t i = 0; i < indices.count; i++) {
+                if (readIndex(indices, i) >= positions.count)
+                    return false;
+            }
+            primitive.indexed = true;
+            primitive.indexView = indices.view;
+            primitive.indexType = indices.componentType;
+            primitive.indexOffset = indices.offset;
+            primitive.count = indices.count;
+        }
+
+        std::array<float, 3> &min = primitive.min;
+        std::array<float, 3> &max = primitive.max;
+        min = readPosition(positions, 0);
+        max = min;
+        for (size_t v = 1; v < positions.count; v++) {
+            const std::array<float, 3> p = readPosition(positions, v);
+            for (int k = 0; k < 3; k++) {
+                min[k] = std::min(min[k], p[k]);
+                max[k] = std::max(max[k], p[k]);
+            }
+        }
+
+        GltfAccessor normals;
+        if (readAccessor(attributes["NORMAL"], normals) && normals.componentType == GLTF_FLOAT &&
+            normals.components == 3 && normals.count == positions.count && useView(normals.view, false)) {
+            primitive.attributes.push_back(makeAttribute(GLTF_LOCATION_NORMAL, normals));
+        } else {
+            GltfAttribute attribute;
+            attribute.location = GLTF_LOCATION_NORMAL;
+            attribute.components = 3;
+            attribute.componentType = GLTF_FLOAT;
+            attribute.view = generateNormals(positions, primitive.indexed ? &indices : nullptr,
+                                             primitive.mode, primitive.count);
+            primitive.attributes.push_back(attribute);
+        }
+
+        GltfAccessor uvs;
+        if (readAccessor(attributes["TEXCOORD_0"], uvs) && uvs.components == 2 && uvs.count == positions.count &&
+            (uvs.componentType == GLTF_FLOAT || (uvs.normalized && (uvs.componentType == GLTF_UNSIGNED_BYTE ||
+                                                                    uvs.componentType == GLTF_UNSIGNED_SHORT))) &&
+            useView(uvs.view, false)) {
+            primitive.attributes.push_back(makeAttribute(GLTF_LOCATION_UV, uvs));
+        } else {
+            GltfAttribute attribute;
+            attribute.location = GLTF_LOCATION_UV;
+            attribute.components = 2;
+            attribute.componentType = GLTF_FLOAT;
+            attribute.view = generateUVs(positions, min, max);
+            primitive.attributes.push_back(attribute);
+        }
+
+        const long long material = json["material"].asInt(-1);
+        primitive.material = material >= 0 && static_cast<size_t>(material) < m_model.materials.size()
+                                 ? static_cast<size_t>(material) : getDefaultMaterial();
+        return true;
+    }
+};
+
+/**
+ * @brief Loads a binary glTF 2.0 file.
+ *
+ * The file is memory-mapped; the JSON chunk is parsed and every mesh
+ * primitive reachable from the default scene becomes a GltfPrimitive whose
+ * attributes reference the BIN chunk in place, keeping their interleaving
+ * and component types. Embedded textures are decoded in parallel.
+ *
+ * @param path Path to the .glb file.
+ * @return std::unique_ptr<GltfModel> The model, or `nullptr` if the file is invalid or unsupported.
+ */
+std::unique_ptr<GltfModel> GltfModel::load(const std::string &path) {
+    std::unique_ptr<GltfModel> model(new GltfModel());
+    model->source = Asset::map(path);
+    if (!model->source) {
+        fprintf(stderr, "Failed to open file %s\n", path.c_str());
+        return nullptr;
+    }
+
+    const char *data = model->source->data();
+    const size_t size = model->source->size();
+    if (size < 20 || readU32(data) != GLB_MAGIC || readU32(data + 4) != 2 || readU32(data + 8) > size) {
+        fprintf(stderr, "%s is not a glTF 2.0 binary file\n", path.c_str());
+        return nullptr;
+    }
+
+    const size_t length = readU32(data + 8);
+    const char *json = nullptr;
+    const char *bin = nullptr;
+    size_t jsonSize = 0;
+    size_t binSize = 0;
+    for (size_t offset = 12; offset + 8 <= length;) {
+        const size_t chunkSize = readU32(data + offset);
+        const uint32_t chunkType = readU32(data + offset + 4);
+        if (chunkSize > length - offset - 8) {
+            fprintf(stderr, "%s: truncated chunk\n", path.c_str());
+            return nullptr;
+        }
+        if (chunkType == GLB_CHUNK_JSON && !json) {
+            json = data + offset + 8;
+            jsonSize = chunkSize;
+        } else if (chunkType == GLB_CHUNK_BIN && !bin) {
+            bin = data + offset + 8;
+            binSize = chunkSize;
+        }
+        offset += 8 + ((chunkSize + 3) & ~static_cast<size_t>(3));
+    }
+    if (!json) {
+        fprintf(stderr, "%s: missing JSON chunk\n", path.c_str());
+        return nullptr;
+    }
+
+    const std::unique_ptr<JsonValue> document = JsonValue::parse(json, jsonSize);
+    if (!document)
+        return nullptr;
+    GltfReader reader(*document, *model, path);
+    if (!reader.read(bin, binSize))
+        return nullptr;
+    return model;
+}
+
+/**
+ * @brief Estimates the CPU memory held by the model.
+ *
+ * Mapped files are counted although their pages are shared with the page cache.
+ */
+size_t GltfModel::getMemoryUsage() const {
+    size_t usage = source ? source->size() : 0;
+    for (const auto &buffer: externalBuffers)
+        usage += buffer->size();
+    for (const auto &image: images)
+        usage += image.getMemoryUsage();
+    return usage + generatedSize;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file Gltf.hpp
+ * @author Patryk
+ * @brief GltfModel declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_GLTF_HPP
+#define SCOP_GLTF_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Asset.hpp"
+#include "../textures/Material.hpp"
+#include "../textures/Texture2D.hpp"
+
+#define GLB_MAGIC 0x46546C67u
+#define GLB_CHUNK_JSON 0x4E4F534Au
+#define GLB_CHUNK_BIN 0x004E4942u
+
+#define GLTF_LOCATION_POSITION 0
+#define GLTF_LOCATION_UV 1
+#define GLTF_LOCATION_NORMAL 2
+
+/**
+ * @brief Byte range of a glTF buffer view, uploaded as one GPU buffer.
+ *
+ * `data` points into the mapped file (or into generated attribute storage),
+ * so the range can be handed to the GPU without an intermediate copy.
+ */
+struct GltfBufferView {
+    const char *data = nullptr;
+    size_t size = 0;
+    bool indices = false;
+};
+
+/**
+ * @brief Vertex attribute of a primitive, laid out as in its buffer view.
+ *
+ * Component types use the glTF codes, which are the OpenGL enum values.
+ */
+struct GltfAttribute {
+    unsigned int location = 0;
+    int components = 0;
+    unsigned int componentType = 0;
+    bool normalized = false;
+    size_t stride = 0;
+    size_t offset = 0;
+    size_t view = 0;
+};
+
+/**
+ * @brief One draw call: a mesh primitive placed by its node transform.
+ */
+struct GltfPrimitive {
+    std::vector<GltfAttribute> attributes;
+    unsigned int mode = 4;
+    bool indexed = false;
+    size_t indexView = 0;
+    unsigned int indexType = 0;
+    size_t indexOffset = 0;
+    size_t count = 0;
+    size_t material = 0;
+    std::array<float, 16> transform;
+    std::array<float, 3> min;
+    std::array<float, 3> max;
+};
+
+/**
+ * @brief Material of a glTF model mapped onto the renderer's Phong parameters.
+ */
+struct GltfMaterial {
+    MaterialParams params;
+    int image = -1;
+};
+
+/**
+ * @brief CPU-side content of a binary glTF 2.0 (.glb) file.
+ *
+ * The file stays memory-mapped for the lifetime of the model: buffer views
+ * point into it and are uploaded directly by the caller. Only missing
+ * normals and texture coordinates are generated into owned storage.
+ * Loading makes no GL calls, so it is safe on worker threads.
+ */
+struct GltfModel {
+    std::unique_ptr<Asset> source;
+    std::vector<std::unique_ptr<Asset>> externalBuffers;
+    std::vector<std::unique_ptr<char[]>> generated;
+    size_t generatedSize = 0;
+    std::vector<GltfBufferView> views;
+    std::vector<GltfPrimitive> primitives;
+    std::vector<GltfMaterial> materials;
+    std::vector<Image> images;
+    std::array<float, 3> min;
+    std::array<float, 3> max;
+
+    static std::unique_ptr<GltfModel> load(const std::string &path);
+    size_t getMemoryUsage() const;
+};
+
+#endif //SCOP_GLTF_HPP
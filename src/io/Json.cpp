@@ -0,0 +1,311 @@
+/**
+ * @file Json.cpp
+ * @author Patryk
+ * @brief JsonValue class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Json.hpp"
+
+/**
+ * @brief Recursive descent parser filling JsonValue trees.
+ */
+class JsonReader {
+public:
+    JsonReader(const char *data, size_t size) : m_p(data), m_end(data + size) {}
+
+    bool parseDocument(JsonValue &value) {
+        if (!parseValue(value, 0))
+            return false;
+        skipSpace();
+        return m_p == m_end;
+    }
+
+private:
+    const char *m_p;
+    const char *m_end;
+
+    void skipSpace() {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+            m_p++;
+    }
+
+    bool consume(const char *literal) {
+        const size_t length = strlen(literal);
+        if (static_cast<size_t>(m_end - m_p) < length || memcmp(m_p, literal, length))
+            return false;
+        m_p += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue &value, int depth) {
+        if (depth > JSON_MAX_DEPTH)
+            return false;
+        skipSpace();
+        if (m_p >= m_end)
+            return false;
+
+        switch (*m_p) {
+            case '{':
+                return parseObject(value, depth);
+            case '[':
+                return parseArray(value, depth);
+            case '"':
+                value.m_type = JSON_STRING;
+                return parseString(value.m_string);
+            case 't':
+                value.m_type = JSON_BOOL;
+                value.m_bool = true;
+                return consume("true");
+            case 'f':
+                value.m_type = JSON_BOOL;
+                return consume("false");
+            case 'n':
+                return consume("null");
+            default:
+                return parseNumber(value);
+        }
+    }
+
+    bool parseObject(JsonValue &value, int depth) {
+        value.m_type = JSON_OBJECT;
+        m_p++;
+        skipSpace();
+        if (m_p < m_end && *m_p == '}') {
+            m_p++;
+            return true;
+        }
+        while (true) {
+            skipSpace();
+            if (m_p >= m_end || *m_p != '"')
+                return false;
+            value.m_keys.emplace_back();
+            if (!parseString(value.m_keys.back()))
+                return false;
+            skipSpace();
+            if (m_p >= m_end || *m_p++ != ':')
+                return false;
+            value.m_items.emplace_back();
+            if (!parseValue(value.m_items.back(), depth + 1))
+                return false;
+            skipSpace();
+            if (m_p >= m_end)
+                return false;
+            if (*m_p == '}') {
+                m_p++;
+                return true;
+            }
+            if (*m_p++ != ',')
+                return false;
+        }
+    }
+
+    bool parseArray(JsonValue &value, int depth) {
+        value.m_type = JSON_ARRAY;
+        m_p++;
+        skipSpace();
+        if (m_p < m_end && *m_p == ']') {
+            m_p++;
+            return true;
+        }
+        while (true) {
+            value.m_items.emplace_back();
+            if (!parseValue(value.m_items.back(), depth + 1))
+                return false;
+            skipSpace();
+            if (m_p >= m_end)
+                return false;
+            if (*m_p == ']') {
+                m_p++;
+                return true;
+            }
+            if (*m_p++ != ',')
+                return false;
+        }
+    }
+
+    static void appendUtf8(std::string &out, unsigned int codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    bool parseHex4(unsigned int &codePoint) {
+        if (m_end - m_p < 4)
+            return false;
+        codePoint = 0;
+        for (int i = 0; i < 4; i++) {
+            const char c = *m_p++;
+            codePoint <<= 4;
+            if (c >= '0' && c <= '9') codePoint |= c - '0';
+            else if (c >= 'a' && c <= 'f') codePoint |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') codePoint |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string &out) {
+        m_p++;
+        while (m_p < m_end) {
+            // Copy runs of plain characters at once
+            const char *run = m_p;
+            while (m_p < m_end && *m_p != '"' && *m_p != '\\')
+                m_p++;
+            out.append(run, m_p - run);
+            if (m_p >= m_end)
+                return false;
+            if (*m_p == '"') {
+                m_p++;
+                return true;
+            }
+
+            if (++m_p >= m_end)
+                return false;
+            const char escape = *m_p++;
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned int codePoint;
+                    if (!parseHex4(codePoint))
+                        return false;
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+                        unsigned int low;
+                        if (!consume("\\u") || !parseHex4(low) || low < 0xDC00 || low >= 0xE000)
+                            return false;
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    bool parseNumber(JsonValue &value) {
+        const char *start = m_p;
+        while (m_p < m_end && (strchr("+-.eE", *m_p) || (*m_p >= '0' && *m_p <= '9')))
+            m_p++;
+        const size_t length = m_p - start;
+        if (length == 0 || length >= 64)
+            return false;
+
+        // The document is not null-terminated, so strtod works on a copy
+        char buffer[64];
+        memcpy(buffer, start, length);
+        buffer[length] = '\0';
+        char *end = nullptr;
+        value.m_number = strtod(buffer, &end);
+        value.m_type = JSON_NUMBER;
+        return end == buffer + length;
+    }
+};
+
+/**
+ * @brief Parses a JSON document.
+ * @param data Document text, not necessarily null-terminated.
+ * @param size Size of the document in bytes.
+ * @return std::unique_ptr<JsonValue> Root value, or `nullptr` if the document is malformed.
+ */
+std::unique_ptr<JsonValue> JsonValue::parse(const char *data, size_t size) {
+    std::unique_ptr<JsonValue> root(new JsonValue());
+    JsonReader reader(data, size);
+    if (!reader.parseDocument(*root)) {
+        fprintf(stderr, "Malformed JSON document\n");
+        return nullptr;
+    }
+    return root;
+}
+
+JsonType JsonValue::getType() const {
+    return m_type;
+}
+
+bool JsonValue::isNull() const {
+    return m_type == JSON_NULL;
+}
+
+bool JsonValue::has(const std::string &key) const {
+    return !(*this)[key].isNull();
+}
+
+/**
+ * @brief Number of elements of an array or members of an object.
+ */
+size_t JsonValue::size() const {
+    return m_items.size();
+}
+
+/**
+ * @brief Looks up an object member.
+ * @param key Member name.
+ * @return const JsonValue& The member, or a null value if absent or if this is not an object.
+ */
+const JsonValue &JsonValue::operator[](const std::string &key) const {
+    static const JsonValue null;
+    if (m_type != JSON_OBJECT)
+        return null;
+    for (size_t i = 0; i < m_keys.size(); i++) {
+        if (m_keys[i] == key)
+            return m_items[i];
+    }
+    return null;
+}
+
+/**
+ * @brief Accesses an array element.
+ * @param index Element index.
+ * @return const JsonValue& The element, or a null value if out of range or if this is not an array.
+ */
+const JsonValue &JsonValue::operator[](size_t index) const {
+    static const JsonValue null;
+    if (m_type != JSON_ARRAY || index >= m_items.size())
+        return null;
+    return m_items[index];
+}
+
+bool JsonValue::asBool(bool fallback) const {
+    return m_type == JSON_BOOL ? m_bool : fallback;
+}
+
+double JsonValue::asNumber(double fallback) const {
+    return m_type == JSON_NUMBER ? m_number : fallback;
+}
+
+long long JsonValue::asInt(long long fallback) const {
+    return m_type == JSON_NUMBER ? static_cast<long long>(m_number) : fallback;
+}
+
+const std::string &JsonValue::asString() const {
+    return m_string;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Json.hpp
+ * @author Patryk
+ * @brief JsonValue class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_JSON_HPP
+#define SCOP_JSON_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define JSON_MAX_DEPTH 128
+
+/**
+ * @brief Type of a JSON value.
+ */
+enum JsonType {
+    JSON_NULL = 0,
+    JSON_BOOL,
+    JSON_NUMBER,
+    JSON_STRING,
+    JSON_ARRAY,
+    JSON_OBJECT
+};
+
+/**
+ * @brief Minimal read-only JSON document.
+ *
+ * Parses a complete document in one pass. Lookups never fail: a missing
+ * member or out-of-range element yields a null value, so nested optional
+ * fields can be read with chained `[]` and a default.
+ */
+class JsonValue {
+public:
+    JsonValue() = default;
+    static std::unique_ptr<JsonValue> parse(const char *data, size_t size);
+
+    JsonType getType() const;
+    bool isNull() const;
+    bool has(const std::string &key) const;
+    size_t size() const;
+
+    const JsonValue &operator[](const std::string &key) const;
+    const JsonValue &operator[](size_t index) const;
+
+    bool asBool(bool fallback = false) const;
+    double asNumber(double fallback = 0.0) const;
+    long long asInt(long long fallback = 0) const;
+    const std::string &asString() const;
+
+private:
+    JsonType m_type = JSON_NULL;
+    bool m_bool = false;
+    double m_number = 0.0;
+    std::string m_string;
+    std::vector<JsonValue> m_items;
+    std::vector<std::string> m_keys;
+
+    friend class JsonReader;
+};
+
+#endif //SCOP_JSON_HPP
@@ -0,0 +1,395 @@
+/**
+ * @file MeshCodec.cpp
+ * @author Patryk
+ * @brief Compressed mesh format: quantized, delta coded and byte packed streams
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <tmmintrin.h>
+
+#include "MeshCodec.hpp"
+#include "../core/Packing.hpp"
+#include "../utils/Parallel.hpp"
+
+#define MESH_CODEC_VERTEX_STREAMS 7
+
+/**
+ * @brief File header, followed by the byte offsets of every chunk and of the end of the last one.
+ *
+ * Vertex chunks come first, then index chunks. A quantized value `q` of an
+ * attribute decodes to `min + q * step`.
+ */
+struct MeshCodecHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    float positionMin[3];
+    float positionStep[3];
+    float uvMin[2];
+    float uvStep[2];
+};
+
+/**
+ * @brief Data bytes and pshufb masks of the 256 control bytes of a group of four values.
+ */
+struct StreamTables {
+    uint8_t lengths[256];
+    uint8_t shuffles[256][16];
+
+    StreamTables() {
+        for (int code = 0; code < 256; code++) {
+            int offset = 0;
+            for (int lane = 0; lane < 4; lane++) {
+                const int length = ((code >> (2 * lane)) & 3) + 1;
+                for (int byte = 0; byte < 4; byte++)
+                    shuffles[code][lane * 4 + byte] = byte < length ? static_cast<uint8_t>(offset + byte) : 0x80;
+                offset += length;
+            }
+            lengths[code] = static_cast<uint8_t>(offset);
+        }
+    }
+};
+
+static const StreamTables &getStreamTables() {
+    static const StreamTables tables;
+    return tables;
+}
+
+static bool hasSsse3() {
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+static uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+static uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+/**
+ * @brief Appends a stream of values, delta coded against the previous value and zigzagged.
+ *
+ * Values are packed four at a time: one control byte holds the byte length
+ * (1 to 4) of each of them, and all control bytes of the stream precede
+ * the packed bytes. The last group is padded with zeros.
+ */
+static void encodeStream(const uint32_t *values, size_t count, std::vector<char> &out) {
+    const size_t groups = (count + 3) / 4;
+    const size_t start = out.size();
+    out.resize(start + sizeof(uint32_t) + groups);
+    const size_t dataStart = out.size();
+    uint32_t previous = 0;
+    for (size_t g = 0; g < groups; g++) {
+        uint8_t code = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            const size_t i = g * 4 + lane;
+            uint32_t value = 0;
+            if (i < count) {
+                value = zigzag(values[i] - previous);
+                previous = values[i];
+            }
+            const int length = value < (1u << 8) ? 1 : value < (1u << 16) ? 2 : value < (1u << 24) ? 3 : 4;
+            code |= static_cast<uint8_t>((length - 1) << (2 * lane));
+            for (int byte = 0; byte < length; byte++)
+                out.push_back(static_cast<char>(value >> (8 * byte)));
+        }
+        out[start + sizeof(uint32_t) + g] = static_cast<char>(code);
+    }
+    const uint32_t dataSize = static_cast<uint32_t>(out.size() - dataStart);
+    memcpy(&out[start], &dataSize, sizeof(dataSize));
+}
+
+__attribute__((target("ssse3")))
+static void decodeGroupsSsse3(const uint8_t *control, const uint8_t *data, size_t count, uint32_t *out) {
+    const StreamTables &tables = getStreamTables();
+    const __m128i one = _mm_set1_epi32(1);
+    __m128i previous = _mm_setzero_si128();
+    for (size_t i = 0; i < count; i += 4) {
+        const uint8_t code = *control++;
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)),
+                                     _mm_loadu_si128(reinterpret_cast<const __m128i *>(tables.shuffles[code])));
+        data += tables.lengths[code];
+        v = _mm_xor_si128(_mm_srli_epi32(v, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one)));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, previous);
+        previous = _mm_shuffle_epi32(v, 0xFF);
+        if (i + 4 <= count) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), v);
+        } else {
+            uint32_t last[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(last), v);
+            memcpy(out + i, last, (count - i) * sizeof(uint32_t));
+        }
+    }
+}
+
+static void decodeGroupsScalar(const uint8_t *control, const uint8_t *data, size_t count, uint32_t *out) {
+    uint32_t previous = 0;
+    for (size_t i = 0; i < count; i += 4) {
+        const uint8_t code = *control++;
+        for (int lane = 0; lane < 4; lane++) {
+            const int length = ((code >> (2 * lane)) & 3) + 1;
+            uint32_t value = 0;
+            memcpy(&value, data, length);
+            data += length;
+            previous += unzigzag(value);
+            if (i + lane < count)
+                out[i + lane] = previous;
+        }
+    }
+}
+
+/**
+ * @brief Decodes one stream written by `encodeStream()` and advances `p` past it.
+ *
+ * The control bytes are checked against the stream size first, so the
+ * 16-byte loads of the SSSE3 path stay inside the stream and its padding.
+ *
+ * @return bool false if the stream does not fit in [p, end).
+ */
+static bool decodeStream(const char *&p, const char *end, size_t count, uint32_t *out) {
+    const size_t groups = (count + 3) / 4;
+    uint32_t dataSize;
+    if (end - p < static_cast<ptrdiff_t>(sizeof(dataSize) + groups))
+        return false;
+    memcpy(&dataSize, p, sizeof(dataSize));
+    const uint8_t *control = reinterpret_cast<const uint8_t *>(p + sizeof(dataSize));
+    const uint8_t *data = control + groups;
+    if (end - reinterpret_cast<const char *>(data) < static_cast<ptrdiff_t>(dataSize))
+        return false;
+    const StreamTables &tables = getStreamTables();
+    size_t total = 0;
+    for (size_t g = 0; g < groups; g++)
+        total += tables.lengths[control[g]];
+    if (total != dataSize)
+        return false;
+
+    if (hasSsse3())
+        decodeGroupsSsse3(control, data, count, out);
+    else
+        decodeGroupsScalar(control, data, count, out);
+    p = reinterpret_cast<const char *>(data) + dataSize;
+    return true;
+}
+
+static uint32_t quantize(float value, float min, float scale, uint32_t maxValue) {
+    const float q = (value - min) * scale + 0.5f;
+    if (!(q > 0.0f))
+        return 0;
+    return q >= maxValue ? maxValue : static_cast<uint32_t>(q);
+}
+
+/**
+ * @brief Encodes a mesh into a compact, chunked byte stream.
+ *
+ * Positions and texture coordinates are quantized to MESH_CODEC_POSITION_BITS
+ * and MESH_CODEC_UV_BITS over their bounds, and normals to
+ * MESH_CODEC_NORMAL_BITS per axis of an octahedral map. Every attribute
+ * axis and the indices form separate streams, each predicted from the
+ * previous value, zigzagged and packed to 1 to 4 bytes per value (see
+ * `encodeStream()`), which suits meshes whose vertices follow the order
+ * of the triangles. Vertices and indices are split into independent chunks
+ * of MESH_CODEC_CHUNK_VERTICES and MESH_CODEC_CHUNK_INDICES, encoded in
+ * parallel.
+ *
+ * @param vertices Mesh vertices.
+ * @param indices Triangle indices.
+ * @return std::vector<char> Encoded mesh, see `decodeMesh()`.
+ */
+std::vector<char> encodeMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices) {
+    MeshCodecHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MESH_CODEC_MAGIC;
+    header.version = MESH_CODEC_VERSION;
+    header.vertexCount = vertices.size();
+    header.indexCount = indices.size();
+
+    const uint32_t positionMax = (1u << MESH_CODEC_POSITION_BITS) - 1;
+    const uint32_t uvMax = (1u << MESH_CODEC_UV_BITS) - 1;
+    const uint32_t normalMax = (1u << MESH_CODEC_NORMAL_BITS) - 1;
+    float positionScale[3] = {0.0f, 0.0f, 0.0f}, uvScale[2] = {0.0f, 0.0f};
+    if (!vertices.empty()) {
+        float positionHigh[3], uvHigh[2];
+        for (int a = 0; a < 3; a++)
+            header.positionMin[a] = positionHigh[a] = vertices[0].position[a];
+        for (int a = 0; a < 2; a++)
+            header.uvMin[a] = uvHigh[a] = std::isfinite(vertices[0].uv[a]) ? vertices[0].uv[a] : 0.0f;
+        for (const Vertex &vertex: vertices) {
+            for (int a = 0; a < 3; a++) {
+                header.positionMin[a] = std::min(header.positionMin[a], vertex.position[a]);
+                positionHigh[a] = std::max(positionHigh[a], vertex.position[a]);
+            }
+            for (int a = 0; a < 2; a++) {
+                if (!std::isfinite(vertex.uv[a]))
+                    continue;
+                header.uvMin[a] = std::min(header.uvMin[a], vertex.uv[a]);
+                uvHigh[a] = std::max(uvHigh[a], vertex.uv[a]);
+            }
+        }
+        for (int a = 0; a < 3; a++) {
+            const float extent = positionHigh[a] - header.positionMin[a];
+            header.positionStep[a] = extent / positionMax;
+            positionScale[a] = extent > 0.0f ? positionMax / extent : 0.0f;
+        }
+        for (int a = 0; a < 2; a++) {
+            const float extent = uvHigh[a] - header.uvMin[a];
+            header.uvStep[a] = extent / uvMax;
+            uvScale[a] = extent > 0.0f ? uvMax / extent : 0.0f;
+        }
+    }
+
+    const size_t vertexChunks = (vertices.size() + MESH_CODEC_CHUNK_VERTICES - 1) / MESH_CODEC_CHUNK_VERTICES;
+    const size_t indexChunks = (indices.size() + MESH_CODEC_CHUNK_INDICES - 1) / MESH_CODEC_CHUNK_INDICES;
+    std::vector<std::vector<char>> chunks(vertexChunks + indexChunks);
+    parallelFor(0, chunks.size(), 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        std::vector<uint32_t> values;
+        for (size_t c = chunkBegin; c < chunkEnd; c++) {
+            std::vector<char> &out = chunks[c];
+            if (c >= vertexChunks) {
+                const size_t first = (c - vertexChunks) * MESH_CODEC_CHUNK_INDICES;
+                const size_t count = std::min<size_t>(MESH_CODEC_CHUNK_INDICES, indices.size() - first);
+                encodeStream(&indices[first], count, out);
+                continue;
+            }
+            const size_t first = c * MESH_CODEC_CHUNK_VERTICES;
+            const size_t count = std::min<size_t>(MESH_CODEC_CHUNK_VERTICES, vertices.size() - first);
+            values.resize(count * MESH_CODEC_VERTEX_STREAMS);
+            for (size_t i = 0; i < count; i++) {
+                const Vertex &vertex = vertices[first + i];
+                for (int a = 0; a < 3; a++)
+                    values[a * count + i] = quantize(vertex.position[a], header.positionMin[a], positionScale[a], positionMax);
+                for (int a = 0; a < 2; a++)
+                    values[(3 + a) * count + i] = quantize(vertex.uv[a], header.uvMin[a], uvScale[a], uvMax);
+                const std::array<float, 2> octahedral = encodeOctahedral(vertex.normal);
+                values[5 * count + i] = quantize(octahedral[0], -1.0f, normalMax / 2.0f, normalMax);
+                values[6 * count + i] = quantize(octahedral[1], -1.0f, normalMax / 2.0f, normalMax);
+            }
+            for (int stream = 0; stream < MESH_CODEC_VERTEX_STREAMS; stream++)
+                encodeStream(&values[stream * count], count, out);
+        }
+    });
+
+    std::vector<uint64_t> offsets(chunks.size() + 1);
+    uint64_t offset = sizeof(header) + offsets.size() * sizeof(uint64_t);
+    for (size_t c = 0; c < chunks.size(); c++) {
+        offsets[c] = offset;
+        offset += chunks[c].size();
+    }
+    offsets[chunks.size()] = offset;
+
+    std::vector<char> out(offset + MESH_CODEC_PADDING, 0);
+    memcpy(out.data(), &header, sizeof(header));
+    memcpy(out.data() + sizeof(header), offsets.data(), offsets.size() * sizeof(uint64_t));
+    for (size_t c = 0; c < chunks.size(); c++)
+        memcpy(out.data() + offsets[c], chunks[c].data(), chunks[c].size());
+    return out;
+}
+
+/**
+ * @brief Decodes a mesh written by `encodeMesh()`.
+ *
+ * Chunks are decoded in parallel. Each stream is unpacked, un-zigzagged and
+ * prefix summed four values at a time with SSSE3 (plain code on CPUs without
+ * it), then dequantized. Malformed input, including indices out of range,
+ * is rejected.
+ *
+ * @param data Encoded mesh.
+ * @param size Size of the encoded mesh in bytes.
+ * @param vertices Receives the vertices.
+ * @param indices Receives the triangle indices.
+ * @return bool true on success.
+ */
+bool decodeMesh(const char *data, size_t size, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices) {
+    MeshCodecHeader header;
+    if (size < sizeof(header))
+        return false;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != MESH_CODEC_MAGIC || header.version != MESH_CODEC_VERSION ||
+        header.vertexCount > size || header.indexCount > size)
+        return false;
+
+    const size_t vertexChunks = (header.vertexCount + MESH_CODEC_CHUNK_VERTICES - 1) / MESH_CODEC_CHUNK_VERTICES;
+    const size_t indexChunks = (header.indexCount + MESH_CODEC_CHUNK_INDICES - 1) / MESH_CODEC_CHUNK_INDICES;
+    const size_t chunkCount = vertexChunks + indexChunks;
+    if (vertexChunks > size || (size - sizeof(header)) / sizeof(uint64_t) < chunkCount + 1)
+        return false;
+    std::vector<uint64_t> offsets(chunkCount + 1);
+    memcpy(offsets.data(), data + sizeof(header), offsets.size() * sizeof(uint64_t));
+    for (size_t c = 0; c < chunkCount; c++) {
+        if (offsets[c] > offsets[c + 1])
+            return false;
+    }
+    if (offsets[chunkCount] + MESH_CODEC_PADDING > size)
+        return false;
+
+    vertices.resize(header.vertexCount);
+    indices.resize(header.indexCount);
+    const float normalStep = 2.0f / ((1u << MESH_CODEC_NORMAL_BITS) - 1);
+    std::atomic<bool> valid(true);
+    parallelFor(0, chunkCount, 1, [&](size_t chunkBegin, size_t chunkEnd) {
+        std::vector<uint32_t> values;
+        for (size_t c = chunkBegin; c < chunkEnd && valid; c++) {
+            const char *p = data + offsets[c];
+            const char *end = data + offsets[c + 1];
+            if (c >= vertexChunks) {
+                const size_t first = (c - vertexChunks) * MESH_CODEC_CHUNK_INDICES;
+                const size_t count = std::min<size_t>(MESH_CODEC_CHUNK_INDICES, header.indexCount - first);
+                unsigned int *out = &indices[first];
+                if (!decodeStream(p, end, count, out)) {
+                    valid = false;
+                    break;
+                }
+                unsigned int highest = 0;
+                for (size_t i = 0; i < count; i++)
+                    highest = std::max(highest, out[i]);
+                if (highest >= header.vertexCount)
+                    valid = false;
+                continue;
+            }
+            const size_t first = c * MESH_CODEC_CHUNK_VERTICES;
+            const size_t count = std::min<size_t>(MESH_CODEC_CHUNK_VERTICES, header.vertexCount - first);
+            values.resize(count * MESH_CODEC_VERTEX_STREAMS);
+            for (int stream = 0; stream < MESH_CODEC_VERTEX_STREAMS && valid; stream++) {
+                if (!decodeStream(p, end, count, &values[stream * count]))
+                    valid = false;
+            }
+            if (!valid)
+                break;
+            for (size_t i = 0; i < count; i++) {
+                Vertex &vertex = vertices[first + i];
+                for (int a = 0; a < 3; a++)
+                    vertex.position[a] = header.positionMin[a] + values[a * count + i] * header.positionStep[a];
+                for (int a = 0; a < 2; a++)
+                    vertex.uv[a] = header.uvMin[a] + values[(3 + a) * count + i] * header.uvStep[a];
+                float x = values[5 * count + i] * normalStep - 1.0f;
+                float y = values[6 * count + i] * normalStep - 1.0f;
+                const float z = 1.0f - std::fabs(x) - std::fabs(y);
+                if (z < 0.0f) {
+                    const float fx = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                    y = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                    x = fx;
+                }
+                const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+                vertex.normal = {x * inverseLength, y * inverseLength, z * inverseLength};
+            }
+        }
+    });
+    if (!valid) {
+        vertices.clear();
+        indices.clear();
+    }
+    return valid;
+}
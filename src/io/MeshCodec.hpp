@@ -0,0 +1,35 @@
+/**
+ * @file MeshCodec.hpp
+ * @author Patryk
+ * @brief Compressed mesh format declarations
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_MESH_CODEC_HPP
+#define SCOP_MESH_CODEC_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "../core/Vertex.hpp"
+
+#define MESH_CODEC_MAGIC 0x48534D53u // "SMSH"
+#define MESH_CODEC_VERSION 1u
+#define MESH_CODEC_EXTENSION ".smesh"
+#define MESH_CODEC_POSITION_BITS 16
+#define MESH_CODEC_UV_BITS 14
+#define MESH_CODEC_NORMAL_BITS 12
+#define MESH_CODEC_CHUNK_VERTICES 16384
+#define MESH_CODEC_CHUNK_INDICES 49152
+// Zero bytes after the last stream, so 16-byte loads never read past the buffer
+#define MESH_CODEC_PADDING 16
+#define MESH_CODEC_BENCHMARK_RUNS 10
+
+std::vector<char> encodeMesh(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+bool decodeMesh(const char *data, size_t size, std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+
+#endif //SCOP_MESH_CODEC_HPP
@@ -0,0 +1,511 @@
+/**
+ * @file Ply.cpp
+ * @author Patryk
+ * @brief PlyModel implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+#include "Ply.hpp"
+#include "../core/ObjParser.hpp"
+#include "../utils/Parallel.hpp"
+
+static PlyType parseType(const std::string &name) {
+    if (name == "char" || name == "int8") return PLY_INT8;
+    if (name == "uchar" || name == "uint8") return PLY_UINT8;
+    if (name == "short" || name == "int16") return PLY_INT16;
+    if (name == "ushort" || name == "uint16") return PLY_UINT16;
+    if (name == "int" || name == "int32") return PLY_INT32;
+    if (name == "uint" || name == "uint32") return PLY_UINT32;
+    if (name == "float" || name == "float32") return PLY_FLOAT32;
+    if (name == "double" || name == "float64") return PLY_FLOAT64;
+    return PLY_INVALID;
+}
+
+static size_t getTypeSize(PlyType type) {
+    switch (type) {
+        case PLY_INT8:
+        case PLY_UINT8:
+            return 1;
+        case PLY_INT16:
+        case PLY_UINT16:
+            return 2;
+        case PLY_INT32:
+        case PLY_UINT32:
+        case PLY_FLOAT32:
+            return 4;
+        case PLY_FLOAT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+template<typename T>
+static T load(const char *p) {
+    T value;
+    memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+/**
+ * @brief Reads a little-endian scalar of any PLY type.
+ */
+static double readBinary(const char *p, PlyType type) {
+    switch (type) {
+        case PLY_INT8: return load<int8_t>(p);
+        case PLY_UINT8: return load<uint8_t>(p);
+        case PLY_INT16: return load<int16_t>(p);
+        case PLY_UINT16: return load<uint16_t>(p);
+        case PLY_INT32: return load<int32_t>(p);
+        case PLY_UINT32: return load<uint32_t>(p);
+        case PLY_FLOAT32: return load<float>(p);
+        case PLY_FLOAT64: return load<double>(p);
+        default: return 0.0;
+    }
+}
+
+/**
+ * @brief Converts a color channel to 8 bits; floating point channels are expected in [0, 1].
+ */
+static unsigned char toColorChannel(double value, PlyType type) {
+    if (type == PLY_FLOAT32 || type == PLY_FLOAT64)
+        value *= 255.0;
+    else if (type == PLY_UINT16)
+        value /= 257.0;
+    return static_cast<unsigned char>(std::min(std::max(value, 0.0), 255.0));
+}
+
+static const PlyProperty *findProperty(const PlyElement &element, const char *name, bool list = false) {
+    for (const PlyProperty &property: element.properties) {
+        if (property.name == name && property.list == list)
+            return &property;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Reads the header and the element blocks of a PLY file into a PlyModel.
+ */
+class PlyReader {
+public:
+    PlyReader(const char *data, size_t size, const std::string &path, PlyModel &model)
+        : m_p(data), m_end(data + size), m_path(path), m_model(model) {}
+
+    bool read() {
+        if (!readHeader())
+            return false;
+        for (const PlyElement &element: m_elements) {
+            bool ok;
+            if (element.name == "vertex")
+                ok = readVertices(element);
+            else if (element.name == "face")
+                ok = readFaces(element);
+            else
+                ok = skipElement(element);
+            if (!ok) {
+                fprintf(stderr, "%s: truncated or malformed '%s' element\n", m_path.c_str(), element.name.c_str());
+                return false;
+            }
+        }
+        dropInvalidFaces();
+        return true;
+    }
+
+private:
+    const char *m_p;
+    const char *m_end;
+    std::string m_path;
+    PlyModel &m_model;
+    bool m_ascii = false;
+    std::vector<PlyElement> m_elements;
+
+    bool readHeader() {
+        std::vector<std::string> lines;
+        while (true) {
+            const char *newline = static_cast<const char *>(memchr(m_p, '\n', m_end - m_p));
+            if (!newline) {
+                fprintf(stderr, "%s: missing end_header\n", m_path.c_str());
+                return false;
+            }
+            std::string line(m_p, newline - m_p);
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            m_p = newline + 1;
+            if (line == "end_header")
+                break;
+            lines.push_back(line);
+        }
+        if (lines.empty() || lines[0] != "ply") {
+            fprintf(stderr, "%s is not a PLY file\n", m_path.c_str());
+            return false;
+        }
+
+        for (size_t i = 1; i < lines.size(); i++) {
+            std::istringstream ss(lines[i]);
+            std::string keyword;
+            ss >> keyword;
+            if (keyword == "format") {
+                std::string format;
+                ss >> format;
+                if (format == "ascii") {
+                    m_ascii = true;
+                } else if (format != "binary_little_endian") {
+                    fprintf(stderr, "%s: unsupported PLY format %s\n", m_path.c_str(), format.c_str());
+                    return false;
+                }
+            } else if (keyword == "element") {
+                PlyElement element;
+                ss >> element.name >> element.count;
+                m_elements.push_back(element);
+            } else if (keyword == "property") {
+                if (m_elements.empty())
+                    return false;
+                PlyElement &element = m_elements.back();
+                PlyProperty property;
+                std::string type;
+                ss >> type;
+                if (type == "list") {
+                    std::string countType;
+                    ss >> countType >> type;
+                    property.list = true;
+                    property.countType = parseType(countType);
+                    if (property.countType == PLY_INVALID)
+                        return false;
+                }
+                property.type = parseType(type);
+                ss >> property.name;
+                if (property.type == PLY_INVALID) {
+                    fprintf(stderr, "%s: unknown property type %s\n", m_path.c_str(), type.c_str());
+                    return false;
+                }
+                element.properties.push_back(property);
+            }
+        }
+
+        for (PlyElement &element: m_elements) {
+            size_t offset = 0;
+            bool fixed = true;
+            for (PlyProperty &property: element.properties) {
+                property.offset = offset;
+                offset += getTypeSize(property.type);
+                fixed = fixed && !property.list;
+            }
+            element.size = fixed ? offset : 0;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads one scalar with the generic (sequential) reader.
+     */
+    bool readScalar(PlyType type, double &value) {
+        if (!m_ascii) {
+            const size_t size = getTypeSize(type);
+            if (static_cast<size_t>(m_end - m_p) < size)
+                return false;
+            value = readBinary(m_p, type);
+            m_p += size;
+            return true;
+        }
+
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\r' || *m_p == '\n'))
+            m_p++;
+        if (type == PLY_FLOAT32 || type == PLY_FLOAT64) {
+            float parsed;
+            if (!parseFloat(m_p, m_end, parsed))
+                return false;
+            value = parsed;
+            return true;
+        }
+        const bool negative = m_p < m_end && *m_p == '-';
+        if (negative || (m_p < m_end && *m_p == '+'))
+            m_p++;
+        if (m_p >= m_end || *m_p < '0' || *m_p > '9')
+            return false;
+        long long parsed = 0;
+        for (; m_p < m_end && *m_p >= '0' && *m_p <= '9'; m_p++)
+            parsed = parsed * 10 + (*m_p - '0');
+        value = static_cast<double>(negative ? -parsed : parsed);
+        return true;
+    }
+
+    /**
+     * @brief Reads one item of an element. Scalars go to `values`; the first list goes to `list`.
+     */
+    bool readItem(const PlyElement &element, std::vector<double> &values, std::vector<long long> &list) {
+        values.resize(element.properties.size());
+        bool listRead = false;
+        for (size_t k = 0; k < element.properties.size(); k++) {
+            const PlyProperty &property = element.properties[k];
+            if (!property.list) {
+                if (!readScalar(property.type, values[k]))
+                    return false;
+                continue;
+            }
+            double count;
+            if (!readScalar(property.countType, count) || count < 0)
+                return false;
+            if (!listRead)
+                list.clear();
+            for (size_t i = 0; i < static_cast<size_t>(count); i++) {
+                double value;
+                if (!readScalar(property.type, value))
+                    return false;
+                if (!listRead)
+                    list.push_back(static_cast<long long>(value));
+            }
+            values[k] = count;
+            listRead = true;
+        }
+        return true;
+    }
+
+    bool skipElement(const PlyElement &element) {
+        if (!m_ascii && element.size) {
+            if (element.count > static_cast<size_t>(m_end - m_p) / element.size)
+                return false;
+            m_p += element.count * element.size;
+            return true;
+        }
+        std::vector<double> values;
+        std::vector<long long> list;
+        for (size_t i = 0; i < element.count; i++) {
+            if (!readItem(element, values, list))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Decodes the vertex block.
+     *
+     * Binary blocks have a fixed item size, so every vertex can be decoded
+     * independently and the block is split across worker threads.
+     */
+    bool readVertices(const PlyElement &element) {
+        const PlyProperty *x = findProperty(element, "x");
+        const PlyProperty *y = findProperty(element, "y");
+        const PlyProperty *z = findProperty(element, "z");
+        if (!x || !y || !z) {
+            fprintf(stderr, "%s: vertices have no x, y, z properties\n", m_path.c_str());
+            return false;
+        }
+        const PlyProperty *nx = findProperty(element, "nx");
+        const PlyProperty *ny = findProperty(element, "ny");
+        const PlyProperty *nz = findProperty(element, "nz");
+        const bool normals = nx && ny && nz;
+        const PlyProperty *red = findProperty(element, "red");
+        const PlyProperty *green = findProperty(element, "green");
+        const PlyProperty *blue = findProperty(element, "blue");
+        const PlyProperty *alpha = findProperty(element, "alpha");
+        const bool colors = red && green && blue;
+
+        std::vector<Vertex> &vertices = m_model.vertices;
+        vertices.resize(element.count);
+        if (colors)
+            m_model.colors.resize(element.count);
+        m_model.hasNormals = normals;
+
+        if (!m_ascii && element.size) {
+            if (element.count > static_cast<size_t>(m_end - m_p) / element.size)
+                return false;
+
+            const char *base = m_p;
+            const size_t stride = element.size;
+            const bool packedPosition = x->type == PLY_FLOAT32 && y->type == PLY_FLOAT32 && z->type == PLY_FLOAT32 &&
+                                        y->offset == x->offset + 4 && z->offset == x->offset + 8;
+            const bool packedNormal = normals && nx->type == PLY_FLOAT32 && ny->type == PLY_FLOAT32 &&
+                                      nz->type == PLY_FLOAT32 && ny->offset == nx->offset + 4 &&
+                                      nz->offset == nx->offset + 8;
+            const bool packedColor = colors && red->type == PLY_UINT8 && green->type == PLY_UINT8 &&
+                                     blue->type == PLY_UINT8 && green->offset == red->offset + 1 &&
+                                     blue->offset == red->offset + 2;
+
+            parallelFor(0, element.count, PLY_VERTEX_GRAIN, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const char *item = base + i * stride;
+                    Vertex &v = vertices[i];
+                    if (packedPosition) {
+                        memcpy(v.position.data(), item + x->offset, sizeof(v.position));
+                    } else {
+                        v.position = {static_cast<float>(readBinary(item + x->offset, x->type)),
+                                      static_cast<float>(readBinary(item + y->offset, y->type)),
+                                      static_cast<float>(readBinary(item + z->offset, z->type))};
+                    }
+                    if (packedNormal) {
+                        memcpy(v.normal.data(), item + nx->offset, sizeof(v.normal));
+                    } else if (normals) {
+                        v.normal = {static_cast<float>(readBinary(item + nx->offset, nx->type)),
+                                    static_cast<float>(readBinary(item + ny->offset, ny->type)),
+                                    static_cast<float>(readBinary(item + nz->offset, nz->type))};
+                    } else {
+                        v.normal = {0.0f, 0.0f, 0.0f};
+                    }
+                    v.uv = {0.0f, 0.0f};
+
+                    if (!colors)
+                        continue;
+                    std::array<unsigned char, 4> &color = m_model.colors[i];
+                    if (packedColor) {
+                        memcpy(color.data(), item + red->offset, 3);
+                    } else {
+                        color[0] = toColorChannel(readBinary(item + red->offset, red->type), red->type);
+                        color[1] = toColorChannel(readBinary(item + green->offset, green->type), green->type);
+                        color[2] = toColorChannel(readBinary(item + blue->offset, blue->type), blue->type);
+                    }
+                    color[3] = alpha ? toColorChannel(readBinary(item + alpha->offset, alpha->type), alpha->type) : 255;
+                }
+            });
+            m_p += element.count * element.size;
+            return true;
+        }
+
+        const size_t ix = x - element.properties.data(), iy = y - element.properties.data();
+        const size_t iz = z - element.properties.data();
+        std::vector<double> values;
+        std::vector<long long> list;
+        for (size_t i = 0; i < element.count; i++) {
+            if (!readItem(element, values, list))
+                return false;
+            Vertex &v = vertices[i];
+            v.position = {static_cast<float>(values[ix]), static_cast<float>(values[iy]), static_cast<float>(values[iz])};
+            v.normal = {0.0f, 0.0f, 0.0f};
+            v.uv = {0.0f, 0.0f};
+            if (normals) {
+                v.normal = {static_cast<float>(values[nx - element.properties.data()]),
+                            static_cast<float>(values[ny - element.properties.data()]),
+                            static_cast<float>(values[nz - element.properties.data()])};
+            }
+            if (colors) {
+                std::array<unsigned char, 4> &color = m_model.colors[i];
+                color[0] = toColorChannel(values[red - element.properties.data()], red->type);
+                color[1] = toColorChannel(values[green - element.properties.data()], green->type);
+                color[2] = toColorChannel(values[blue - element.properties.data()], blue->type);
+                color[3] = alpha ? toColorChannel(values[alpha - element.properties.data()], alpha->type) : 255;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Decodes binary `list uchar int` faces when every face is a triangle.
+     *
+     * Each face then takes exactly 13 bytes, so the block can be split
+     * across threads. Returns false without consuming anything if the
+     * layout does not match, leaving the block to the generic reader.
+     */
+    bool readTriangleBlock(const PlyElement &element, const PlyProperty &indices) {
+        const size_t stride = 1 + 3 * sizeof(uint32_t);
+        if (m_ascii || element.properties.size() != 1 || indices.countType != PLY_UINT8 ||
+            (indices.type != PLY_INT32 && indices.type != PLY_UINT32) ||
+            element.count > static_cast<size_t>(m_end - m_p) / stride)
+            return false;
+
+        const char *base = m_p;
+        std::vector<unsigned int> &out = m_model.indices;
+        const size_t first = out.size();
+        out.resize(first + element.count * 3);
+        std::atomic<bool> triangles(true);
+        parallelFor(0, element.count, PLY_FACE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end && triangles.load(std::memory_order_relaxed); i++) {
+                const char *item = base + i * stride;
+                if (static_cast<unsigned char>(item[0]) != 3) {
+                    triangles = false;
+                    return;
+                }
+                memcpy(&out[first + i * 3], item + 1, 3 * sizeof(uint32_t));
+            }
+        });
+        if (!triangles) {
+            out.resize(first);
+            return false;
+        }
+        m_p += element.count * stride;
+        return true;
+    }
+
+    /**
+     * @brief Decodes the face block; polygons are triangulated as fans.
+     */
+    bool readFaces(const PlyElement &element) {
+        const PlyProperty *indices = findProperty(element, "vertex_indices", true);
+        if (!indices)
+            indices = findProperty(element, "vertex_index", true);
+        if (!indices)
+            return skipElement(element);
+        if (readTriangleBlock(element, *indices))
+            return true;
+
+        std::vector<double> values;
+        std::vector<long long> list;
+        for (size_t i = 0; i < element.count; i++) {
+            if (!readItem(element, values, list))
+                return false;
+            for (size_t k = 1; k + 1 < list.size(); k++) {
+                m_model.indices.push_back(static_cast<unsigned int>(list[0]));
+                m_model.indices.push_back(static_cast<unsigned int>(list[k]));
+                m_model.indices.push_back(static_cast<unsigned int>(list[k + 1]));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes triangles referencing vertices that do not exist.
+     */
+    void dropInvalidFaces() {
+        std::vector<unsigned int> &indices = m_model.indices;
+        const size_t vertexCount = m_model.vertices.size();
+        std::atomic<bool> invalid(false);
+        parallelFor(0, indices.size(), PLY_FACE_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (indices[i] >= vertexCount) {
+                    invalid = true;
+                    return;
+                }
+            }
+        });
+        if (!invalid)
+            return;
+
+        size_t kept = 0;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            if (indices[t] >= vertexCount || indices[t + 1] >= vertexCount || indices[t + 2] >= vertexCount)
+                continue;
+            memmove(&indices[kept], &indices[t], 3 * sizeof(unsigned int));
+            kept += 3;
+        }
+        fprintf(stderr, "Dropped %zu faces referencing missing vertices\n", (indices.size() - kept) / 3);
+        indices.resize(kept);
+    }
+};
+
+/**
+ * @brief Decodes a PLY file.
+ * @param data File content.
+ * @param size File size in bytes.
+ * @param path Path used in error messages.
+ * @return std::unique_ptr<PlyModel> The decoded geometry, or `nullptr` if the file is malformed or unsupported.
+ */
+std::unique_ptr<PlyModel> PlyModel::load(const char *data, size_t size, const std::string &path) {
+    std::unique_ptr<PlyModel> model(new PlyModel());
+    PlyReader reader(data, size, path, *model);
+    if (!reader.read())
+        return nullptr;
+    if (model->vertices.empty()) {
+        fprintf(stderr, "%s: no vertices\n", path.c_str());
+        return nullptr;
+    }
+    return model;
+}
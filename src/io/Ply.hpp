@@ -0,0 +1,79 @@
+/**
+ * @file Ply.hpp
+ * @author Patryk
+ * @brief PlyModel declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PLY_HPP
+#define SCOP_PLY_HPP
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Vertex.hpp"
+
+#define PLY_VERTEX_GRAIN 65536
+#define PLY_FACE_GRAIN 65536
+
+/**
+ * @brief Scalar type of a PLY property.
+ */
+enum PlyType {
+    PLY_INVALID = 0,
+    PLY_INT8,
+    PLY_UINT8,
+    PLY_INT16,
+    PLY_UINT16,
+    PLY_INT32,
+    PLY_UINT32,
+    PLY_FLOAT32,
+    PLY_FLOAT64
+};
+
+/**
+ * @brief Property of a PLY element, either a scalar or a list.
+ */
+struct PlyProperty {
+    std::string name;
+    PlyType type = PLY_INVALID;
+    PlyType countType = PLY_INVALID;
+    bool list = false;
+    size_t offset = 0;
+};
+
+/**
+ * @brief Element declared in a PLY header. `size` is 0 when the element has list properties.
+ */
+struct PlyElement {
+    std::string name;
+    size_t count = 0;
+    size_t size = 0;
+    std::vector<PlyProperty> properties;
+};
+
+/**
+ * @brief Geometry decoded from a .ply file.
+ *
+ * Supports ASCII and binary little-endian files. Binary vertex blocks are
+ * decoded in parallel, with a direct copy when x,y,z are consecutive
+ * floats; all-triangle face blocks with `list uchar int` indices are
+ * decoded in parallel too. Other layouts go through a generic reader.
+ * Files without faces are point clouds.
+ */
+struct PlyModel {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<std::array<unsigned char, 4>> colors;
+    bool hasNormals = false;
+
+    static std::unique_ptr<PlyModel> load(const char *data, size_t size, const std::string &path);
+};
+
+#endif //SCOP_PLY_HPP
@@ -0,0 +1,45 @@
+/**
+ * @file Ppm.cpp
+ * @author Patryk
+ * @brief PPM image writer
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "Ppm.hpp"
+#include "../utils/Kernels.hpp"
+
+/**
+ * @brief Writes RGBA8 pixels (red in the lowest byte) as a binary PPM image, dropping alpha.
+ * @param path Output file.
+ * @param width Image width.
+ * @param height Image height.
+ * @param pixels First pixel of the top row.
+ * @param stride Distance between rows, in pixels.
+ * @return bool true if the file was written.
+ */
+bool writePpm(const std::string &path, int width, int height, const uint32_t *pixels, size_t stride) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return false;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", width, height);
+    std::vector<unsigned char> row(static_cast<size_t>(width) * 3);
+    const KernelTable &kernels = getKernels();
+    bool ok = true;
+    for (int y = 0; y < height && ok; y++) {
+        kernels.convertRgbaToRgb(pixels + static_cast<size_t>(y) * stride, width, row.data());
+        ok = fwrite(row.data(), 1, row.size(), file) == row.size();
+    }
+    ok = fclose(file) == 0 && ok;
+    if (!ok)
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+    return ok;
+}
@@ -0,0 +1,21 @@
+/**
+ * @file Ppm.hpp
+ * @author Patryk
+ * @brief PPM image writer
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PPM_HPP
+#define SCOP_PPM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+bool writePpm(const std::string &path, int width, int height, const uint32_t *pixels, size_t stride);
+
+#endif //SCOP_PPM_HPP
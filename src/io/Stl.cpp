@@ -0,0 +1,141 @@
+/**
+ * @file Stl.cpp
+ * @author Patryk
+ * @brief StlModel implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "Stl.hpp"
+#include "../core/ObjParser.hpp"
+#include "../core/Weld.hpp"
+#include "../utils/Parallel.hpp"
+
+/**
+ * @brief Checks whether the file is a binary STL.
+ *
+ * Many binary exporters also start their header with "solid", so the size
+ * announced by the triangle count decides.
+ */
+static bool isBinary(const char *data, size_t size) {
+    if (size < STL_HEADER_SIZE + sizeof(uint32_t))
+        return false;
+    uint32_t triangles;
+    memcpy(&triangles, data + STL_HEADER_SIZE, sizeof(triangles));
+    return size == STL_HEADER_SIZE + sizeof(uint32_t) + static_cast<size_t>(triangles) * STL_TRIANGLE_SIZE;
+}
+
+/**
+ * @brief Copies the corners of every binary facet, in parallel.
+ */
+static void readBinary(const char *data, std::vector<std::array<float, 3>> &corners) {
+    uint32_t triangles;
+    memcpy(&triangles, data + STL_HEADER_SIZE, sizeof(triangles));
+    const char *facets = data + STL_HEADER_SIZE + sizeof(uint32_t);
+    corners.resize(static_cast<size_t>(triangles) * 3);
+    parallelFor(0, triangles, STL_TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; t++) {
+            // Skip the facet normal; the attribute byte count follows the corners
+            memcpy(&corners[t * 3], facets + t * STL_TRIANGLE_SIZE + 3 * sizeof(float), 9 * sizeof(float));
+        }
+    });
+}
+
+/**
+ * @brief Reads the `vertex x y z` lines of an ASCII STL.
+ * @return bool false if a vertex line is malformed or a facet is incomplete.
+ */
+static bool readAscii(const char *data, size_t size, std::vector<std::array<float, 3>> &corners) {
+    const char *p = data;
+    const char *end = data + size;
+    while (p < end) {
+        const char *newline = static_cast<const char *>(memchr(p, '\n', end - p));
+        const char *lineEnd = newline ? newline : end;
+        while (p < lineEnd && (*p == ' ' || *p == '\t'))
+            p++;
+        if (lineEnd - p > 6 && !memcmp(p, "vertex", 6)) {
+            p += 6;
+            std::array<float, 3> corner;
+            for (float &value: corner) {
+                while (p < lineEnd && (*p == ' ' || *p == '\t'))
+                    p++;
+                if (!parseFloat(p, lineEnd, value))
+                    return false;
+            }
+            corners.push_back(corner);
+        }
+        p = lineEnd + 1;
+    }
+    return corners.size() % 3 == 0;
+}
+
+/**
+ * @brief Decodes an STL file and welds its corners.
+ * @param data File content.
+ * @param size File size in bytes.
+ * @param path Path used in error messages.
+ * @param weldTolerance Weld distance as a fraction of the model size; 0 merges only identical corners.
+ * @return std::unique_ptr<StlModel> Indexed geometry, or `nullptr` if the file is malformed or empty.
+ */
+std::unique_ptr<StlModel> StlModel::load(const char *data, size_t size, const std::string &path, float weldTolerance) {
+    std::vector<std::array<float, 3>> corners;
+    if (isBinary(data, size)) {
+        readBinary(data, corners);
+    } else if (size >= 5 && !memcmp(data, "solid", 5)) {
+        if (!readAscii(data, size, corners)) {
+            fprintf(stderr, "%s: malformed ASCII STL\n", path.c_str());
+            return nullptr;
+        }
+    } else {
+        fprintf(stderr, "%s is not an STL file\n", path.c_str());
+        return nullptr;
+    }
+    if (corners.empty()) {
+        fprintf(stderr, "%s: no triangles\n", path.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<StlModel> model(new StlModel());
+    model->triangleCount = corners.size() / 3;
+    std::vector<std::array<float, 3>> positions;
+    weldPoints(corners, weldTolerance, positions, model->indices);
+    corners.clear();
+    corners.shrink_to_fit();
+
+    model->vertices.resize(positions.size());
+    parallelFor(0, positions.size(), STL_TRIANGLE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            model->vertices[i].position = positions[i];
+            model->vertices[i].uv = {0.0f, 0.0f};
+            model->vertices[i].normal = {0.0f, 0.0f, 0.0f};
+        }
+    });
+
+    std::vector<unsigned int> &indices = model->indices;
+    size_t kept = 0;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        const unsigned int a = indices[t], b = indices[t + 1], c = indices[t + 2];
+        if (a == b || b == c || a == c)
+            continue;
+        indices[kept++] = a;
+        indices[kept++] = b;
+        indices[kept++] = c;
+    }
+    indices.resize(kept);
+    if (indices.empty()) {
+        fprintf(stderr, "%s: all triangles are degenerate\n", path.c_str());
+        return nullptr;
+    }
+
+    printf("Loaded %s: %zu triangles, %zu corners welded into %zu vertices, %zu collapsed triangles dropped\n",
+           path.c_str(), model->triangleCount, model->triangleCount * 3, model->vertices.size(),
+           model->triangleCount - kept / 3);
+    return model;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file Stl.hpp
+ * @author Patryk
+ * @brief StlModel declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_STL_HPP
+#define SCOP_STL_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Vertex.hpp"
+
+#define STL_HEADER_SIZE 80
+#define STL_TRIANGLE_SIZE 50
+#define STL_TRIANGLE_GRAIN 65536
+
+/**
+ * @brief Geometry decoded from a binary or ASCII .stl file.
+ *
+ * STL stores three unshared corners per triangle; they are welded through
+ * a spatial hash grid (see `weldPoints()`) into indexed geometry, so the
+ * vertex count drops to that of the actual surface and normals can be
+ * smoothed. Triangles collapsed by welding are dropped. Facet normals of
+ * the file are ignored.
+ */
+struct StlModel {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    size_t triangleCount = 0;
+
+    static std::unique_ptr<StlModel> load(const char *data, size_t size, const std::string &path, float weldTolerance);
+};
+
+#endif //SCOP_STL_HPP
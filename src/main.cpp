@@ -11,46 +11,90 @@
 
 #include <iostream>
 #include <array>
+#include <chrono>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
 #include "core/Object.hpp"
 #include "core/Camera.hpp"
+#include "core/HalfEdge.hpp"
+#include "core/Playlist.hpp"
+#include "core/Sequence.hpp"
+#include "core/ProgressiveLoader.hpp"
+#include "core/ChunkStreamer.hpp"
 #include "textures/TextureManager.hpp"
 #include "graphics/Shader.hpp"
+#include "render/RayTracer.hpp"
 #include "render/Renderer.hpp"
+#include "render/SoftwareRenderer.hpp"
+#include "render/StressScene.hpp"
 #include "utils/utils.hpp"
+#include "utils/Options.hpp"
+#include "utils/Parallel.hpp"
+#include "io/AssetPack.hpp"
+#include "io/FileWatcher.hpp"
+#include "io/MeshCodec.hpp"
 #include "3rd/cImGUI.hpp"
 
 #include "../lib/imgui/imgui.h"
 
 std::unique_ptr<TextureManager> gTextureManager;
+std::unique_ptr<Playlist> gPlaylist;
+std::unique_ptr<Sequence> gSequence;
+std::unique_ptr<ProgressiveLoader> gProgressive;
+std::unique_ptr<ChunkStreamer> gChunks;
 
 Camera gCamera({0.0f, 0.0f, 2.0f},
               {0.0f, 0.0f, 0.0f},
               {0.0f, 1.0f, 0.0f});
 
 void clearExit(GLFWwindow *window, cImGUI &imgui);
+int renderHeadless(const Options &options);
+int rayTraceHeadless(const Options &options);
+int printAdjacency(const Options &options);
+int encodeHeadless(const Options &options);
 
 int main(int argc, char **argv) {
-    if (argc != 3 ) {
-        fprintf(stderr, "Usage:\n");
-        fprintf(stderr, "./scop <obj_path> <texture_path>\n");
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
         return 1;
     }
 
+    for (const std::string &packPath: options.packPaths) {
+        if (!AssetPack::mount(packPath))
+            return 1;
+    }
+    Object::setWeldTolerance(options.weldTolerance);
+    Object::setMeshCleanup(options.cleanup);
+    Object::setAmbientOcclusionRays(options.occlusionRays);
+    if (!options.softwareOutput.empty())
+        return renderHeadless(options);
+    if (!options.raytraceOutput.empty())
+        return rayTraceHeadless(options);
+    if (options.adjacency)
+        return printAdjacency(options);
+    if (!options.encodeOutput.empty())
+        return encodeHeadless(options);
+
     /* Initialize the library */
     if (!glfwInit())
         return -1;
 
-    /* Configure GLFW to use OpenGL 3.3 Core Profile */
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    /* Configure GLFW to use OpenGL 3.3 Core Profile, or 4.3 for storage buffers and compute shaders */
+    const bool needsGL43 = options.vertexPulling || options.gpuCompute;
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, needsGL43 ? 4 : 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_SAMPLES, 4);
 
     /* Create a windowed mode window and its OpenGL context */
     GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "SCOP", nullptr, nullptr);
+    if (!window && needsGL43) {
+        fprintf(stderr, "OpenGL 4.3 is not available, falling back to 3.3\n");
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        window = glfwCreateWindow(WIDTH, HEIGHT, "SCOP", nullptr, nullptr);
+    }
     if (!window) {
         glfwTerminate();
         return -1;
@@ -66,6 +110,15 @@ int main(int argc, char **argv) {
         return -1;
     }
     glEnable(GL_DEPTH_TEST);
+    if (needsGL43 && !GLEW_VERSION_4_3) {
+        fprintf(stderr, "OpenGL 4.3 is not supported, vertex pulling, the visibility buffer and GPU compute disabled\n");
+        options.vertexPulling = false;
+        options.visibilityBuffer = false;
+        options.gpuCompute = false;
+    }
+    Object::setVertexPulling(options.vertexPulling);
+    Object::setGpuCompute(options.gpuCompute);
+    RingBuffer::setPersistentMapping(options.persistentMapping);
 
     /* Set Callbacks */
     glfwSetCursorPosCallback(window, cursorPosCallback);
@@ -77,23 +130,71 @@ int main(int argc, char **argv) {
 
     gTextureManager = std::unique_ptr<TextureManager>(new TextureManager());
 
-    std::unique_ptr<Object> object = Object::create(argv[1]);
-    if (!object) {
+    const std::shared_ptr<Texture2D> texture = gTextureManager->loadTexture2D(options.texturePath);
+    if (!texture) {
         clearExit(window, imgui);
         return 1;
     }
 
-    const std::shared_ptr<Texture2D> texture = gTextureManager->loadTexture2D(argv[2]);
-    if (!texture) {
-        clearExit(window, imgui);
-        return 1;
+    std::unique_ptr<Object> object;
+    std::unique_ptr<FileWatcher> watcher;
+    if (!options.playlistSource.empty()) {
+        gPlaylist = Playlist::create(options.playlistSource, options.texturePath, options.playlist);
+        if (!gPlaylist || !gPlaylist->start(object)) {
+            clearExit(window, imgui);
+            return 1;
+        }
+    } else if (!options.sequenceSource.empty()) {
+        gSequence = Sequence::create(options.sequenceSource, options.sequence);
+        if (gSequence)
+            object = gSequence->start();
+        if (!object) {
+            clearExit(window, imgui);
+            return 1;
+        }
+        object->setTexture2D(texture);
+    } else if (options.progressive) {
+        gProgressive = ProgressiveLoader::create(options.objPath);
+        if (gProgressive)
+            object = gProgressive->start();
+        if (!object) {
+            clearExit(window, imgui);
+            return 1;
+        }
+        object->setTexture2D(texture);
+    } else if (options.chunked) {
+        gChunks = ChunkStreamer::create(options.objPath, options.chunks);
+        if (gChunks)
+            object = gChunks->start();
+        if (!object) {
+            clearExit(window, imgui);
+            return 1;
+        }
+        object->setTexture2D(texture);
+    } else {
+        object = Object::create(options.objPath, options.watch);
+        if (!object) {
+            clearExit(window, imgui);
+            return 1;
+        }
+        object->setTexture2D(texture);
+        if (options.watch)
+            watcher = FileWatcher::create(options.objPath);
     }
-    object->setTexture2D(texture);
 
     Shader shader("./res/shaders/vertex.glsl", "./res/shaders/fragment.glsl");
 
     Renderer renderer;
     renderer.setBackgroundColor(0.3f, 0.13f, 0.01f, 1.0f);
+    if (options.textured)
+        renderer.toggleColorMode();
+    renderer.setInstanceCount(options.instances);
+    if (options.impostors)
+        renderer.enableImpostors(options.impostorDistance);
+    if (options.visibilityBuffer)
+        renderer.enableVisibilityBuffer();
+    else if (options.vertexPulling)
+        renderer.enableVertexPulling();
 
     printf("OpenGL version: %s\n", glGetString(GL_VERSION));
     double lastFrame = glfwGetTime();
@@ -105,16 +206,26 @@ int main(int argc, char **argv) {
         lastFrame = currentFrame;
 
         processInput(window, object, renderer, deltaTime);
+        if (gPlaylist)
+            gPlaylist->update();
+        if (gSequence)
+            gSequence->update(*object);
+        if (gProgressive)
+            gProgressive->update(*object);
+        if (watcher && watcher->poll())
+            object->reload();
 
         /* Render here */
         renderer.clear();
 
         object->updateRotationMatrixY(deltaTime);
+        if (gChunks)
+            gChunks->update(*object, gCamera);
 
         renderer.draw(object, shader, deltaTime);
 
         imgui.createNewFrame();
-        imgui.displayHUD(object);
+        imgui.displayHUD(object, renderer);
         imgui.render();
 
         /* Swap front and back buffers */
@@ -129,8 +240,206 @@ int main(int argc, char **argv) {
 }
 
 void clearExit(GLFWwindow *window, cImGUI &imgui) {
+    gPlaylist.reset();
+    if (gSequence)
+        gSequence->printStatistics();
+    gSequence.reset();
+    gProgressive.reset();
+    if (gChunks)
+        gChunks->printStatistics();
+    gChunks.reset();
     imgui.cleanup();
 
     glfwDestroyWindow(window);
     glfwTerminate();
 }
+
+/**
+ * @brief Renders the model with the software renderer, without creating a window.
+ *
+ * Draws `options.frames` frames, rotating the object as the interactive
+ * loop does at 60 fps, prints the average frame time and writes the last
+ * frame to `options.softwareOutput`. With `--stress`, draws the generated
+ * StressScene instead of the model.
+ *
+ * @param options Parsed command line options.
+ * @return int Process exit code.
+ */
+int renderHeadless(const Options &options) {
+    std::unique_ptr<Object> object;
+    std::unique_ptr<StressScene> scene;
+    Image texture;
+    if (options.stress) {
+        scene = StressScene::create(options.stressScene);
+        if (!scene)
+            return 1;
+    } else {
+        object = Object::load(options.objPath);
+        if (!object)
+            return 1;
+        if (!Texture2D::decode(options.texturePath, texture)) {
+            fprintf(stderr, "Failed to load texture %s\n", options.texturePath.c_str());
+            return 1;
+        }
+    }
+    std::unique_ptr<SoftwareRenderer> renderer = SoftwareRenderer::create(WIDTH, HEIGHT);
+    if (!renderer)
+        return 1;
+    renderer->setBackgroundColor(0.3f, 0.13f, 0.01f, 1.0f);
+
+    const float colorMix = options.textured ? 0.0f : 1.0f;
+    std::chrono::duration<double, std::milli> total(0);
+    for (size_t frame = 0; frame < options.frames; frame++) {
+        if (scene)
+            scene->update(1.0f / 60.0f);
+        else
+            object->updateRotationMatrixY(1.0f / 60.0f);
+        const auto start = std::chrono::steady_clock::now();
+        renderer->clear();
+        if (scene ? !scene->draw(*renderer) : !renderer->draw(*object, texture, colorMix))
+            return 1;
+        total += std::chrono::steady_clock::now() - start;
+    }
+    const double frameTime = total.count() / options.frames;
+    printf("Software renderer: %zu frames at %dx%d on %u threads, %zu triangles, %.2f ms/frame (%.1f fps)\n",
+           options.frames, WIDTH, HEIGHT, getWorkerCount(), renderer->getTriangleCount(), frameTime,
+           1000.0 / frameTime);
+    return renderer->writeImage(options.softwareOutput) ? 0 : 1;
+}
+
+/**
+ * @brief Ray traces a still of the model, without creating a window.
+ *
+ * Builds the Bvh, accumulates `options.samples` passes, prints the build
+ * time and the ray throughput and writes the image to `options.raytraceOutput`.
+ *
+ * @param options Parsed command line options.
+ * @return int Process exit code.
+ */
+int rayTraceHeadless(const Options &options) {
+    std::unique_ptr<Object> object = Object::load(options.objPath);
+    if (!object)
+        return 1;
+    Image texture;
+    if (!Texture2D::decode(options.texturePath, texture)) {
+        fprintf(stderr, "Failed to load texture %s\n", options.texturePath.c_str());
+        return 1;
+    }
+    std::unique_ptr<RayTracer> tracer = RayTracer::create(WIDTH, HEIGHT);
+    if (!tracer)
+        return 1;
+    tracer->setBackgroundColor(0.3f, 0.13f, 0.01f, 1.0f);
+
+    const auto buildStart = std::chrono::steady_clock::now();
+    if (!tracer->setObject(*object))
+        return 1;
+    const std::chrono::duration<double, std::milli> buildTime = std::chrono::steady_clock::now() - buildStart;
+    printf("Bvh: %zu triangles, %zu nodes, built in %.1f ms\n", tracer->getBvh().getTriangleCount(),
+           tracer->getBvh().getNodeCount(), buildTime.count());
+
+    const float colorMix = options.textured ? 0.0f : 1.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t sample = 0; sample < options.samples; sample++)
+        tracer->renderPass(texture, colorMix);
+    const std::chrono::duration<double> total = std::chrono::steady_clock::now() - start;
+    const double megaRays = tracer->getRayCount() / total.count() / 1e6;
+    printf("Ray tracer: %zu samples at %dx%d on %u threads, %.2f s, %.2f Mrays/s (%.2f Mrays/s per core)\n",
+           tracer->getSampleCount(), WIDTH, HEIGHT, getWorkerCount(), total.count(), megaRays,
+           megaRays / getWorkerCount());
+    return tracer->writeImage(options.raytraceOutput) ? 0 : 1;
+}
+
+/**
+ * @brief Builds the half-edge adjacency of the model and prints its statistics, without creating a window.
+ * @param options Parsed command line options.
+ * @return int Process exit code.
+ */
+int printAdjacency(const Options &options) {
+    std::unique_ptr<Object> object = Object::load(options.objPath);
+    if (!object)
+        return 1;
+    const auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<HalfEdgeMesh> mesh = HalfEdgeMesh::build(object->getIndices(), object->getVertices().size());
+    if (!mesh)
+        return 1;
+    const std::chrono::duration<double, std::milli> buildTime = std::chrono::steady_clock::now() - start;
+    printf("Half-edges: %zu faces, %zu vertices, %zu edges (%zu boundary, %zu non-manifold, %zu flipped)\n",
+           mesh->getFaceCount(), mesh->getVertexCount(), mesh->getEdgeCount(), mesh->getBoundaryEdgeCount(),
+           mesh->getNonManifoldEdgeCount(), mesh->getFlippedEdgeCount());
+    printf("Half-edges: %.2f MB (%.1f bytes per face), built in %.2f ms on %u threads\n",
+           mesh->getMemoryUsage() / (1024.0 * 1024.0),
+           mesh->getFaceCount() ? static_cast<double>(mesh->getMemoryUsage()) / mesh->getFaceCount() : 0.0,
+           buildTime.count(), getWorkerCount());
+    return 0;
+}
+
+/**
+ * @brief Compresses the model with `encodeMesh()` and writes it to `options.encodeOutput`, without creating a window.
+ *
+ * Decodes the result MESH_CODEC_BENCHMARK_RUNS times and prints the
+ * compression ratio, the largest position error and the decode throughput
+ * of the fastest run, measured on the decoded size.
+ *
+ * @param options Parsed command line options.
+ * @return int Process exit code.
+ */
+int encodeHeadless(const Options &options) {
+    std::unique_ptr<Object> object = Object::load(options.objPath);
+    if (!object)
+        return 1;
+    const std::vector<Vertex> &vertices = object->getVertices();
+    const std::vector<unsigned int> &indices = object->getIndices();
+    if (vertices.empty()) {
+        fprintf(stderr, "%s has no vertices to encode\n", options.objPath.c_str());
+        return 1;
+    }
+
+    const auto encodeStart = std::chrono::steady_clock::now();
+    const std::vector<char> encoded = encodeMesh(vertices, indices);
+    const std::chrono::duration<double, std::milli> encodeTime = std::chrono::steady_clock::now() - encodeStart;
+
+    std::vector<Vertex> decodedVertices;
+    std::vector<unsigned int> decodedIndices;
+    double best = 0.0;
+    for (int run = 0; run < MESH_CODEC_BENCHMARK_RUNS; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        if (!decodeMesh(encoded.data(), encoded.size(), decodedVertices, decodedIndices)) {
+            fprintf(stderr, "Failed to decode the encoded mesh\n");
+            return 1;
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (run == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    if (decodedIndices != indices) {
+        fprintf(stderr, "Decoded indices differ from the original\n");
+        return 1;
+    }
+    float maxError = 0.0f;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        for (int a = 0; a < 3; a++)
+            maxError = std::max(maxError, std::fabs(decodedVertices[i].position[a] - vertices[i].position[a]));
+    }
+
+    const size_t rawSize = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int);
+    const double gigabytes = rawSize / best / 1e9;
+    printf("Mesh codec: %zu vertices, %zu triangles, %.2f MB -> %.2f MB (%.1fx, %.1f bytes per triangle)\n",
+           vertices.size(), indices.size() / 3, rawSize / (1024.0 * 1024.0), encoded.size() / (1024.0 * 1024.0),
+           static_cast<double>(rawSize) / encoded.size(),
+           indices.empty() ? 0.0 : encoded.size() / (indices.size() / 3.0));
+    printf("Mesh codec: encoded in %.1f ms, decoded in %.2f ms on %u threads, %.2f GB/s (%.2f GB/s per core), "
+           "max position error %g\n", encodeTime.count(), best * 1000.0, getWorkerCount(), gigabytes,
+           gigabytes / getWorkerCount(), maxError);
+
+    FILE *file = fopen(options.encodeOutput.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", options.encodeOutput.c_str());
+        return 1;
+    }
+    const bool ok = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Failed to write %s\n", options.encodeOutput.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,367 @@
+/**
+ * @file RayTracer.cpp
+ * @author Patryk
+ * @brief RayTracer class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "RayTracer.hpp"
+#include "Shading.hpp"
+#include "../core/Camera.hpp"
+#include "../io/Ppm.hpp"
+#include "../utils/Parallel.hpp"
+
+extern Camera gCamera;
+
+/**
+ * @brief Values shared by all tiles of a pass.
+ */
+struct RayTracer::Pass {
+    std::array<float, 16> modelViewProjection;
+    std::array<float, 16> inverseModelViewProjection;
+    std::array<float, 16> model;
+    std::array<float, 9> normalMatrix;
+    std::array<float, 3> cameraPosition;
+    // fragment.glsl light direction in object space
+    std::array<float, 3> light;
+    const Image *texture;
+    float colorMix;
+};
+
+/**
+ * @brief Creates a ray tracer with an accumulation buffer of the given size.
+ * @return std::unique_ptr<RayTracer> The ray tracer, or `nullptr` if the size is invalid.
+ */
+std::unique_ptr<RayTracer> RayTracer::create(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "Invalid ray tracer size %dx%d\n", width, height);
+        return nullptr;
+    }
+    std::unique_ptr<RayTracer> tracer(new RayTracer());
+    tracer->m_width = width;
+    tracer->m_height = height;
+    tracer->m_tilesX = (width + RAYTRACE_TILE_SIZE - 1) / RAYTRACE_TILE_SIZE;
+    tracer->m_tilesY = (height + RAYTRACE_TILE_SIZE - 1) / RAYTRACE_TILE_SIZE;
+    tracer->m_accumulation.resize(static_cast<size_t>(width) * height);
+    tracer->reset();
+    return tracer;
+}
+
+void RayTracer::setBackgroundColor(const float red, const float green, const float blue, const float alpha) {
+    m_background = {red, green, blue, alpha};
+}
+
+/**
+ * @brief Builds the Bvh of an object and makes it the traced scene.
+ *
+ * The object must outlive the ray tracer; its model matrix is read again
+ * at every pass.
+ *
+ * @param object Object loaded with `Object::load()`; it does not need to be uploaded.
+ * @return bool false if the object has no CPU-side triangles (glTF models, point clouds).
+ */
+bool RayTracer::setObject(Object &object) {
+    const std::vector<Vertex> &vertices = object.getVertices();
+    const std::vector<unsigned int> &indices = object.getIndices();
+    m_materials.clear();
+    m_triangleMaterials.assign(indices.size() / 3, 0);
+    for (const SubMesh &subMesh: object.getSubMeshes()) {
+        if (subMesh.mode != GL_TRIANGLES || !subMesh.indexed || subMesh.indexType != GL_UNSIGNED_INT)
+            continue;
+        const size_t first = subMesh.indexOffset / sizeof(unsigned int) / 3;
+        const size_t last = std::min(m_triangleMaterials.size(), first + subMesh.count / 3);
+        for (size_t t = first; t < last; t++)
+            m_triangleMaterials[t] = static_cast<uint32_t>(m_materials.size());
+        m_materials.push_back(&object.getMaterial(subMesh.material)->getParams());
+    }
+    if (m_materials.empty() || !(m_bvh = Bvh::build(vertices, indices))) {
+        fprintf(stderr, "The ray tracer only traces triangles of .obj, .ply and .stl models\n");
+        m_object = nullptr;
+        return false;
+    }
+
+    std::array<float, 3> min = vertices[0].position, max = vertices[0].position;
+    for (const Vertex &vertex: vertices) {
+        for (int a = 0; a < 3; a++) {
+            min[a] = std::min(min[a], vertex.position[a]);
+            max[a] = std::max(max[a], vertex.position[a]);
+        }
+    }
+    const float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+    m_bias = std::sqrt(dx * dx + dy * dy + dz * dz) * RAYTRACE_SHADOW_BIAS;
+    m_object = &object;
+    reset();
+    return true;
+}
+
+/**
+ * @brief Discards the accumulated samples, e.g. after the camera or the object moved.
+ */
+void RayTracer::reset() {
+    std::fill(m_accumulation.begin(), m_accumulation.end(), std::array<float, 3>{0.0f, 0.0f, 0.0f});
+    m_samples = 0;
+    m_rays = 0;
+}
+
+/**
+ * @brief Traces one sample per pixel and adds it to the accumulation buffer.
+ * @param texture Texture sampled at the hit points.
+ * @param colorMix Blend between the texture (0) and the vertex color (1), as uColorMix.
+ */
+void RayTracer::renderPass(const Image &texture, float colorMix) {
+    if (!m_object)
+        return;
+    Pass pass;
+    pass.model = m_object->getMatrix();
+    const std::array<float, 16> viewProjection = multiplyMatrix(gCamera.getCamView(), gCamera.getCamProjection());
+    pass.modelViewProjection = multiplyMatrix(pass.model, viewProjection);
+    pass.inverseModelViewProjection = invertMatrix(pass.modelViewProjection);
+    pass.normalMatrix = getNormalMatrix(pass.model);
+    pass.cameraPosition = gCamera.getPosition();
+    // Directions map to world space as d * mat3(model), so back with the inverse
+    const std::array<float, 16> inverseModel = invertMatrix(pass.model);
+    for (int c = 0; c < 3; c++)
+        pass.light[c] = SHADING_LIGHT_X * inverseModel[c] + SHADING_LIGHT_Y * inverseModel[4 + c] +
+                        SHADING_LIGHT_Z * inverseModel[8 + c];
+    pass.texture = &texture;
+    pass.colorMix = colorMix;
+
+    parallelFor(0, static_cast<size_t>(m_tilesX) * m_tilesY, 1, [&](size_t tileBegin, size_t tileEnd) {
+        for (size_t tile = tileBegin; tile < tileEnd; tile++)
+            traceTile(static_cast<int>(tile), pass);
+    });
+    m_samples++;
+}
+
+/**
+ * @brief Hashes a pixel and a pass index to a number in [0, 1).
+ */
+static float hashToUnit(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return (x >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Maps a point of the clip cube back to object space.
+ */
+static std::array<float, 3> unproject(const std::array<float, 16> &inverse, float x, float y, float z) {
+    float out[4];
+    for (int c = 0; c < 4; c++)
+        out[c] = x * inverse[c] + y * inverse[4 + c] + z * inverse[8 + c] + inverse[12 + c];
+    return {out[0] / out[3], out[1] / out[3], out[2] / out[3]};
+}
+
+/**
+ * @brief Distance along a ray at which it leaves the far plane (z <= w in clip space), as the rasterizer clips.
+ */
+static float getFarDistance(const std::array<float, 16> &modelViewProjection, const std::array<float, 3> &origin,
+                            const std::array<float, 3> &direction) {
+    const std::array<float, 4> start = transformPoint(modelViewProjection, origin);
+    const float slope = (direction[0] * modelViewProjection[3] + direction[1] * modelViewProjection[7] +
+                         direction[2] * modelViewProjection[11]) -
+                        (direction[0] * modelViewProjection[2] + direction[1] * modelViewProjection[6] +
+                         direction[2] * modelViewProjection[10]);
+    return slope < 0.0f ? (start[3] - start[2]) / -slope : INFINITY;
+}
+
+/**
+ * @brief Traces one tile in 2x2 pixel packets: primary rays, then shadow rays from the hits.
+ */
+void RayTracer::traceTile(int tile, const Pass &pass) {
+    const int tileX = (tile % m_tilesX) * RAYTRACE_TILE_SIZE;
+    const int tileY = (tile / m_tilesX) * RAYTRACE_TILE_SIZE;
+    const int tileMaxX = std::min(tileX + RAYTRACE_TILE_SIZE, m_width);
+    const int tileMaxY = std::min(tileY + RAYTRACE_TILE_SIZE, m_height);
+    const std::vector<Vertex> &vertices = m_object->getVertices();
+    const std::vector<unsigned int> &indices = m_object->getIndices();
+    const std::vector<std::array<unsigned char, 4>> &colors = m_object->getVertexColors();
+    const std::vector<unsigned char> &occlusion = m_object->getAmbientOcclusion();
+    uint64_t rays = 0;
+
+    for (int y = tileY; y < tileMaxY; y += 2) {
+        for (int x = tileX; x < tileMaxX; x += 2) {
+            alignas(16) float origin[3][4], direction[3][4], far[4];
+            int active = 0;
+            for (int lane = 0; lane < 4; lane++) {
+                const int px = x + (lane & 1), py = y + (lane >> 1);
+                for (int a = 0; a < 3; a++) {
+                    origin[a][lane] = 0.0f;
+                    direction[a][lane] = 1.0f;
+                }
+                far[lane] = 0.0f;
+                if (px >= tileMaxX || py >= tileMaxY)
+                    continue;
+                active |= 1 << lane;
+                float jitterX = 0.5f, jitterY = 0.5f;
+                if (m_samples > 0) {
+                    const uint32_t seed = (static_cast<uint32_t>(py) * m_width + px) * 0x9E3779B9u ^
+                                          static_cast<uint32_t>(m_samples) * 0x85EBCA6Bu;
+                    jitterX = hashToUnit(seed);
+                    jitterY = hashToUnit(seed ^ 0x68E31DA4u);
+                }
+                const float ndcX = (px + jitterX) / m_width * 2.0f - 1.0f;
+                const float ndcY = 1.0f - (py + jitterY) / m_height * 2.0f;
+                // Rays start on the near plane and head through the middle of the depth range
+                const std::array<float, 3> near = unproject(pass.inverseModelViewProjection, ndcX, ndcY, -1.0f);
+                const std::array<float, 3> middle = unproject(pass.inverseModelViewProjection, ndcX, ndcY, 0.0f);
+                for (int a = 0; a < 3; a++) {
+                    origin[a][lane] = near[a];
+                    direction[a][lane] = middle[a] - near[a];
+                }
+                far[lane] = getFarDistance(pass.modelViewProjection, near, {direction[0][lane], direction[1][lane],
+                                                                            direction[2][lane]});
+            }
+
+            BvhPacket primary;
+            for (int a = 0; a < 3; a++) {
+                primary.origin[a] = _mm_load_ps(origin[a]);
+                primary.direction[a] = _mm_load_ps(direction[a]);
+            }
+            primary.t = _mm_load_ps(far);
+            primary.active = active;
+            m_bvh->intersect(primary);
+            rays += __builtin_popcount(active);
+
+            alignas(16) float hitT[4], hitU[4], hitV[4];
+            alignas(16) uint32_t hitTriangle[4];
+            _mm_store_ps(hitT, primary.t);
+            _mm_store_ps(hitU, primary.u);
+            _mm_store_ps(hitV, primary.v);
+            _mm_store_si128(reinterpret_cast<__m128i *>(hitTriangle), primary.triangle);
+
+            struct {
+                std::array<float, 3> position, normal, color;
+                float u, v, occlusion;
+                uint32_t material;
+            } hits[4];
+            alignas(16) float shadowOrigin[3][4];
+            int shadowActive = 0;
+            for (int lane = 0; lane < 4; lane++) {
+                for (int a = 0; a < 3; a++)
+                    shadowOrigin[a][lane] = 0.0f;
+                if (!(active & (1 << lane)) || hitTriangle[lane] == BVH_NO_HIT)
+                    continue;
+                const uint32_t triangle = hitTriangle[lane];
+                const Vertex &v0 = vertices[indices[triangle * 3]];
+                const Vertex &v1 = vertices[indices[triangle * 3 + 1]];
+                const Vertex &v2 = vertices[indices[triangle * 3 + 2]];
+                const float u = hitU[lane], v = hitV[lane], w = 1.0f - u - v;
+                std::array<float, 3> geometric;
+                for (int a = 0; a < 3; a++) {
+                    hits[lane].position[a] = origin[a][lane] + direction[a][lane] * hitT[lane];
+                    hits[lane].normal[a] = v0.normal[a] * w + v1.normal[a] * u + v2.normal[a] * v;
+                }
+                hits[lane].u = v0.uv[0] * w + v1.uv[0] * u + v2.uv[0] * v;
+                hits[lane].v = v0.uv[1] * w + v1.uv[1] * u + v2.uv[1] * v;
+                // Flat vColor comes from the last vertex, GL's default provoking vertex
+                const unsigned int provoking = indices[triangle * 3 + 2];
+                hits[lane].color = colors.empty() ? getFallbackColor(v2.position) : std::array<float, 3>{
+                    colors[provoking][0] / 255.0f, colors[provoking][1] / 255.0f, colors[provoking][2] / 255.0f};
+                hits[lane].material = m_triangleMaterials[triangle];
+                hits[lane].occlusion = occlusion.empty() ? 1.0f : (occlusion[indices[triangle * 3]] * w +
+                                                                   occlusion[indices[triangle * 3 + 1]] * u +
+                                                                   occlusion[indices[triangle * 3 + 2]] * v) / 255.0f;
+
+                // Offset the shadow ray origin off the surface, on the side the primary ray came from
+                geometric = crossProdVec(subtractVec(v1.position, v0.position), subtractVec(v2.position, v0.position));
+                const float length = std::sqrt(dotProdVec(geometric, geometric));
+                if (length == 0.0f)
+                    continue;
+                const float facing = geometric[0] * direction[0][lane] + geometric[1] * direction[1][lane] +
+                                     geometric[2] * direction[2][lane];
+                const float offset = (facing > 0.0f ? -m_bias : m_bias) / length;
+                for (int a = 0; a < 3; a++)
+                    shadowOrigin[a][lane] = hits[lane].position[a] + geometric[a] * offset;
+                shadowActive |= 1 << lane;
+            }
+
+            int shadowed = 0;
+            if (shadowActive) {
+                BvhPacket shadow;
+                for (int a = 0; a < 3; a++) {
+                    shadow.origin[a] = _mm_load_ps(shadowOrigin[a]);
+                    shadow.direction[a] = _mm_set1_ps(pass.light[a]);
+                }
+                shadow.t = _mm_set1_ps(INFINITY);
+                shadow.active = shadowActive;
+                shadowed = m_bvh->occluded(shadow);
+                rays += __builtin_popcount(shadowActive);
+            }
+
+            for (int lane = 0; lane < 4; lane++) {
+                if (!(active & (1 << lane)))
+                    continue;
+                std::array<float, 3> &pixel = m_accumulation[static_cast<size_t>(y + (lane >> 1)) * m_width +
+                                                             x + (lane & 1)];
+                if (hitTriangle[lane] == BVH_NO_HIT) {
+                    for (int c = 0; c < 3; c++)
+                        pixel[c] += m_background[c];
+                    continue;
+                }
+                const std::array<float, 3> &p = hits[lane].position, &n = hits[lane].normal;
+                const std::array<float, 4> world = transformPoint(pass.model, p);
+                const std::array<float, 9> &m = pass.normalMatrix;
+                const std::array<float, 3> normal = {m[0] * n[0] + m[1] * n[1] + m[2] * n[2],
+                                                     m[3] * n[0] + m[4] * n[1] + m[5] * n[2],
+                                                     m[6] * n[0] + m[7] * n[1] + m[8] * n[2]};
+                const std::array<float, 3> viewDir = {pass.cameraPosition[0] - world[0],
+                                                      pass.cameraPosition[1] - world[1],
+                                                      pass.cameraPosition[2] - world[2]};
+                const std::array<float, 4> color = shadeFragment(
+                    hits[lane].u, hits[lane].v, normal, viewDir, hits[lane].color, *pass.texture,
+                    *m_materials[hits[lane].material], pass.colorMix, shadowed & (1 << lane) ? 0.0f : 1.0f,
+                    hits[lane].occlusion);
+                for (int c = 0; c < 3; c++)
+                    pixel[c] += std::min(std::max(color[c], 0.0f), 1.0f);
+            }
+        }
+    }
+    m_rays += rays;
+}
+
+/**
+ * @brief Writes the average of the accumulated samples as a binary PPM image.
+ * @param path Output file.
+ * @return bool true if the file was written.
+ */
+bool RayTracer::writeImage(const std::string &path) const {
+    const float scale = m_samples > 0 ? 1.0f / m_samples : 0.0f;
+    std::vector<uint32_t> pixels(m_accumulation.size());
+    parallelFor(0, pixels.size(), 65536, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const std::array<float, 3> &sum = m_accumulation[i];
+            pixels[i] = packColor(sum[0] * scale, sum[1] * scale, sum[2] * scale, 1.0f);
+        }
+    });
+    return writePpm(path, m_width, m_height, pixels.data(), m_width);
+}
+
+/**
+ * @brief Number of passes accumulated since the last `reset()`.
+ */
+size_t RayTracer::getSampleCount() const {
+    return m_samples;
+}
+
+/**
+ * @brief Number of primary and shadow rays traced since the last `reset()`.
+ */
+uint64_t RayTracer::getRayCount() const {
+    return m_rays;
+}
+
+const Bvh &RayTracer::getBvh() const {
+    return *m_bvh;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file RayTracer.hpp
+ * @author Patryk
+ * @brief RayTracer class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_RAY_TRACER_HPP
+#define SCOP_RAY_TRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Bvh.hpp"
+#include "../core/Object.hpp"
+#include "../textures/Texture2D.hpp"
+
+#define RAYTRACE_TILE_SIZE 16
+#define RAYTRACE_DEFAULT_SAMPLES 16
+// Shadow ray offset, relative to the bounding box diagonal
+#define RAYTRACE_SHADOW_BIAS 1e-4f
+
+class Object;
+
+/**
+ * @brief Renders reference stills of an object by casting rays against a Bvh.
+ *
+ * Uses the same camera, model matrix, materials and textures as the raster
+ * paths and the directional light of fragment.glsl, with hard shadows cast
+ * by one shadow ray per hit. Every pass traces one jittered sample per
+ * pixel and adds it to an accumulation buffer, so the image converges to an
+ * antialiased result; the first pass samples pixel centers. Passes split
+ * the image into RAYTRACE_TILE_SIZE square tiles traced in parallel, and
+ * rays are traced in 2x2 pixel packets (see BvhPacket).
+ */
+class RayTracer {
+public:
+    static std::unique_ptr<RayTracer> create(int width, int height);
+    RayTracer(const RayTracer&) = delete;
+    RayTracer &operator=(const RayTracer&) = delete;
+    ~RayTracer() = default;
+
+    void setBackgroundColor(const float red, const float green, const float blue, const float alpha);
+    bool setObject(Object &object);
+    void reset();
+    void renderPass(const Image &texture, float colorMix);
+    bool writeImage(const std::string &path) const;
+
+    size_t getSampleCount() const;
+    uint64_t getRayCount() const;
+    const Bvh &getBvh() const;
+
+private:
+    RayTracer() = default;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    std::array<float, 4> m_background = {0.0f, 0.0f, 0.0f, 1.0f};
+    std::vector<std::array<float, 3>> m_accumulation;
+    size_t m_samples = 0;
+    std::atomic<uint64_t> m_rays{0};
+
+    Object *m_object = nullptr;
+    std::unique_ptr<Bvh> m_bvh;
+    std::vector<const MaterialParams *> m_materials;
+    std::vector<uint32_t> m_triangleMaterials;
+    float m_bias = 0.0f;
+
+    struct Pass;
+    void traceTile(int tile, const Pass &pass);
+};
+
+#endif //SCOP_RAY_TRACER_HPP
@@ -9,6 +9,9 @@
  *
  */
 
+#include <chrono>
+#include <cmath>
+
 #include "Renderer.hpp"
 #include "../core/Camera.hpp"
 #include "../textures/TextureManager.hpp"
@@ -34,31 +37,350 @@ void Renderer::clear() const {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+Renderer::~Renderer() {
+    if (m_queries[0])
+        glDeleteQueries(RENDERER_TIMER_QUERIES, m_queries);
+}
+
 /**
  * @brief Draws given object using given shader. Binds all necessary object's information required by shader.
+ *
+ * Issues one draw call per sub-mesh, each with its own transform, material and texture,
+ * instanced `setInstanceCount()` times. With vertex pulling on and storage
+ * buffers uploaded, the object's vertices are fetched by vertex_pulling.glsl
+ * instead of `shader`'s vertex stage, with non-indexed draws walking the
+ * index buffer by gl_VertexID. In visibility buffer mode, see
+ * `drawVisibility()`. With impostors on, copies past the switch distance
+ * are drawn as impostors instead of the mesh, see `prepareImpostor()`. The
+ * draw calls are timed on the GPU either way, see `getGpuTime()`.
+ *
  * @param object An actual object to draw
  * @param shader Program that tells how to draw given object
  * @param deltaTime Used to create smooth transition when switching mode from colored to texture
  */
-void Renderer::draw(std::unique_ptr<Object> &object, Shader &shader, float deltaTime) const {
-    static float rColorMix = 1.0f;
+void Renderer::draw(std::unique_ptr<Object> &object, Shader &shader, float deltaTime) {
+    if (m_colorMode && m_colorMix < 1.0f) m_colorMix += 2.0f * deltaTime;
+    if (!m_colorMode && m_colorMix > 0.0f) m_colorMix -= 2.0f * deltaTime;
 
-    object->bind();
-    shader.bind();
+    const bool visibility = canUseVisibilityBuffer(object);
+    const bool impostors = !visibility && prepareImpostor(object);
+    if (!impostors)
+        m_impostorCount = 0;
+    beginTimer();
+    if (visibility) {
+        drawVisibility(object);
+    } else {
+        drawForward(object, shader, m_vertexPulling && object->hasStorageBuffers(), impostors);
+        if (impostors)
+            drawImpostors(object);
+    }
+    endTimer();
+}
 
-    setUniforms(object, shader);
+/**
+ * @brief Shades every fragment as it is rasterized, with vertex attributes or vertex pulling.
+ * @param object Object to draw
+ * @param shader Program used without vertex pulling
+ * @param pulling true to draw with vertex_pulling.glsl from the object's storage buffers
+ * @param impostors true to draw only the copies closer than the switch distance, see `selectMeshInstances()`
+ */
+void Renderer::drawForward(std::unique_ptr<Object> &object, Shader &shader, bool pulling, bool impostors) {
+    Shader &program = pulling ? *m_pullingShader : shader;
+    program.bind();
 
-    if (m_colorMode && rColorMix < 1.0f) rColorMix += 2.0f * deltaTime;
-    if (!m_colorMode && rColorMix > 0.0f) rColorMix -= 2.0f * deltaTime;
+    setUniforms(program);
+    setImpostorUniforms(program, impostors);
 
-    shader.setFloat("uColorMix", rColorMix);
+    program.setFloat("uColorMix", m_colorMix);
+    program.setInt("uVertexColor", object->hasVertexColors() ? 1 : 0);
+    if (pulling) {
+        program.setInt("uOcclusion", object->hasAmbientOcclusion() ? 1 : 0);
+        object->bindStorage();
+    } else if (!object->hasAmbientOcclusion()) {
+        // Without a baked buffer, aOcclusion reads this constant
+        glVertexAttrib1f(OBJECT_LOCATION_OCCLUSION, 1.0f);
+    }
 
     glPolygonMode(GL_FRONT_AND_BACK, m_polygonMode ? GL_LINE : GL_FILL);
 
-    glDrawElements(GL_TRIANGLES, object->getIndices().size(), GL_UNSIGNED_INT, nullptr);
+    const std::array<float, 16> model = object->getMatrix();
+    const std::vector<SubMesh> &subMeshes = object->getSubMeshes();
+    for (size_t i = 0; i < subMeshes.size(); i++) {
+        const SubMesh &subMesh = subMeshes[i];
+        const std::array<float, 16> subMeshModel = multiplyMatrix(subMesh.transform, model);
+        program.setUniformMatrix4fv("uModel", subMeshModel);
+        object->getMaterial(subMesh.material)->apply(program);
+        bindTexture(object, subMesh, program);
 
+        object->bind(i);
+        if (pulling)
+            program.setInt("uIndexed", subMesh.indexed ? 1 : 0);
+        const std::vector<InstanceRun> runs = impostors ? selectMeshInstances(subMeshModel)
+                                                        : std::vector<InstanceRun>(1, InstanceRun{0, m_instances});
+        for (const InstanceRun &run: runs) {
+            program.setInt("uInstanceOffset", static_cast<int>(run.first));
+            const GLsizei instances = static_cast<GLsizei>(run.count);
+            if (pulling) {
+                // The indices are read from a storage buffer, gl_VertexID walks them
+                glDrawArraysInstanced(subMesh.mode, 0, static_cast<GLsizei>(subMesh.count), instances);
+            } else if (subMesh.indexed) {
+                glDrawElementsInstanced(subMesh.mode, static_cast<GLsizei>(subMesh.count), subMesh.indexType,
+                                        reinterpret_cast<void *>(subMesh.indexOffset), instances);
+            } else {
+                glDrawArraysInstanced(subMesh.mode, 0, static_cast<GLsizei>(subMesh.count), instances);
+            }
+        }
+    }
+
+    if (pulling)
+        object->unbindStorage();
     object->unbind();
-    shader.unbind();
+    program.unbind();
+}
+
+/**
+ * @brief Draws the object in two passes so every pixel is shaded exactly once.
+ *
+ * The first pass rasterizes positions only and writes an instance and
+ * triangle id per pixel to the VisibilityBuffer. A full-screen pass then
+ * fetches the triangle behind each pixel from the storage buffers,
+ * rebuilds perspective-correct barycentrics from its projected corners and
+ * shades it with the material and lighting of fragment.glsl. The id target
+ * is not multisampled, so edges are not antialiased in this mode.
+ *
+ * @param object Object to draw, with storage buffers and a single triangle sub-mesh
+ */
+void Renderer::drawVisibility(std::unique_ptr<Object> &object) {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if (m_visibilityBuffer->getWidth() != viewport[2] || m_visibilityBuffer->getHeight() != viewport[3])
+        m_visibilityBuffer->resize(viewport[2], viewport[3]);
+
+    const SubMesh &subMesh = object->getSubMeshes().front();
+    const std::array<float, 16> model = multiplyMatrix(subMesh.transform, object->getMatrix());
+
+    m_visibilityBuffer->bind();
+    m_visibilityShader->bind();
+    setUniforms(*m_visibilityShader);
+    m_visibilityShader->setUniformMatrix4fv("uModel", model);
+    m_visibilityShader->setInt("uIndexed", subMesh.indexed ? 1 : 0);
+    glPolygonMode(GL_FRONT_AND_BACK, m_polygonMode ? GL_LINE : GL_FILL);
+    object->bindStorage();
+    object->bind(0);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, static_cast<GLsizei>(subMesh.count), static_cast<GLsizei>(m_instances));
+    m_visibilityBuffer->unbind();
+
+    m_resolveShader->bind();
+    setUniforms(*m_resolveShader);
+    m_resolveShader->setUniformMatrix4fv("uModel", model);
+    m_resolveShader->setInt("uIndexed", subMesh.indexed ? 1 : 0);
+    m_resolveShader->setFloat("uColorMix", m_colorMix);
+    m_resolveShader->setInt("uVertexColor", object->hasVertexColors() ? 1 : 0);
+    m_resolveShader->setInt("uOcclusion", object->hasAmbientOcclusion() ? 1 : 0);
+    object->getMaterial(subMesh.material)->apply(*m_resolveShader);
+    const unsigned int textureSlot = bindTexture(object, subMesh, *m_resolveShader);
+    const unsigned int idSlot = textureSlot == RENDERER_VISIBILITY_TEXTURE_SLOT ? RENDERER_VISIBILITY_TEXTURE_SLOT - 1
+                                                                                : RENDERER_VISIBILITY_TEXTURE_SLOT;
+    m_visibilityBuffer->bindIds(idSlot);
+    m_resolveShader->setInt("uIds", static_cast<int>(idSlot));
+
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glDisable(GL_DEPTH_TEST);
+    m_fullScreen->bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    m_fullScreen->unbind();
+    glEnable(GL_DEPTH_TEST);
+
+    object->unbindStorage();
+    m_resolveShader->unbind();
+}
+
+/**
+ * @brief Tells whether the object can be drawn in visibility buffer mode.
+ *
+ * Needs the mode to be on, the object's storage buffers and a single
+ * triangle sub-mesh whose triangle ids fit in VISIBILITY_TRIANGLE_BITS.
+ * Other objects are drawn forward.
+ */
+bool Renderer::canUseVisibilityBuffer(const std::unique_ptr<Object> &object) const {
+    if (!m_visibilityMode || !object->hasStorageBuffers())
+        return false;
+    const std::vector<SubMesh> &subMeshes = object->getSubMeshes();
+    return subMeshes.size() == 1 && subMeshes[0].mode == GL_TRIANGLES &&
+           subMeshes[0].count / 3 <= VISIBILITY_MAX_TRIANGLES;
+}
+
+/**
+ * @brief Makes sure the impostor of the object is baked and current, when impostors can be used for it.
+ *
+ * Impostors need the mode to be on, more than one copy and a single
+ * triangle sub-mesh whose geometry stays on the CPU. Streamed animations
+ * are drawn without them, as they would be baked again every frame. The
+ * atlas is baked again whenever the object's revision changes, e.g. after
+ * a live reload or a playlist switch.
+ *
+ * @return bool true if the object is drawn with impostors this frame.
+ */
+bool Renderer::prepareImpostor(std::unique_ptr<Object> &object) {
+    if (!m_impostors || m_instances < 2 || object->getStreamBuffer() || object->getVertices().empty())
+        return false;
+    const std::vector<SubMesh> &subMeshes = object->getSubMeshes();
+    if (subMeshes.size() != 1 || subMeshes[0].mode != GL_TRIANGLES)
+        return false;
+    if (!m_impostor || m_impostorRevision != object->getRevision())
+        bakeImpostor(object);
+    return m_impostor != nullptr;
+}
+
+/**
+ * @brief Renders the object into a new impostor atlas from every view direction.
+ *
+ * Each view is an orthographic projection of the bounding sphere around
+ * the object's center, in object space, drawn into its own cell of the
+ * atlas with impostor_bake_fragment.glsl. On failure impostors are turned off.
+ *
+ * @param object Object with a single triangle sub-mesh
+ */
+void Renderer::bakeImpostor(std::unique_ptr<Object> &object) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::array<float, 3> center = object->getCenter();
+    float radius = 0.0f;
+    for (const Vertex &vertex: object->getVertices()) {
+        const std::array<float, 3> offset = subtractVec(vertex.position, center);
+        radius = std::max(radius, dotProdVec(offset, offset));
+    }
+    m_impostorRevision = object->getRevision();
+    m_impostor = Impostor::create(center, std::sqrt(radius));
+    if (!m_impostor) {
+        m_impostors = false;
+        return;
+    }
+    if (!m_impostorShader) {
+        m_impostorShader = std::unique_ptr<Shader>(new Shader(RENDERER_IMPOSTOR_VERTEX_SHADER,
+                                                              RENDERER_IMPOSTOR_FRAGMENT_SHADER));
+        m_impostorBakeShader = std::unique_ptr<Shader>(new Shader(RENDERER_IMPOSTOR_BAKE_VERTEX_SHADER,
+                                                                  RENDERER_IMPOSTOR_BAKE_FRAGMENT_SHADER));
+        m_impostorQuad = std::unique_ptr<VertexArray>(new VertexArray());
+    }
+
+    const SubMesh &subMesh = object->getSubMeshes().front();
+    Shader &bake = *m_impostorBakeShader;
+    bake.bind();
+    bake.setUniformVec3("uCenter", m_impostor->getCenter());
+    bake.setFloat("uRadius", m_impostor->getRadius());
+    bake.setFloat("uViewScale", Impostor::getViewScale());
+    bake.setInt("uVertexColor", object->hasVertexColors() ? 1 : 0);
+    bindTexture(object, subMesh, bake);
+    if (!object->hasAmbientOcclusion())
+        glVertexAttrib1f(OBJECT_LOCATION_OCCLUSION, 1.0f);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+    m_impostor->bind();
+    object->bind(0);
+    for (size_t view = 0; view < IMPOSTOR_VIEWS; view++) {
+        // Same basis as impostor_vertex.glsl builds for the camera direction
+        const std::array<float, 3> direction = Impostor::getViewDirection(view);
+        const std::array<float, 3> right = normalizeVec(crossProdVec({0.0f, 1.0f, 0.0f}, direction));
+        bake.setUniformVec3("uViewDir", direction);
+        bake.setUniformVec3("uViewRight", right);
+        bake.setUniformVec3("uViewUp", crossProdVec(direction, right));
+        m_impostor->bindView(view);
+        if (subMesh.indexed)
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(subMesh.count), subMesh.indexType,
+                           reinterpret_cast<void *>(subMesh.indexOffset));
+        else
+            glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(subMesh.count));
+    }
+    object->unbind();
+    m_impostor->unbind();
+    bake.unbind();
+
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    printf("Impostor: %d views of %d px baked in %.1f ms, %.1f MB\n", IMPOSTOR_VIEWS, IMPOSTOR_VIEW_SIZE,
+           elapsed.count(), m_impostor->getMemoryUsage() / (1024.0 * 1024.0));
+}
+
+/**
+ * @brief Draws a camera-facing quad per copy past the start of the fade band, textured from the atlas.
+ *
+ * impostor_vertex.glsl discards the closer copies, which only cost four
+ * vertices each; impostor_fragment.glsl blends the nearest views, lights
+ * them and writes their depth so impostors intersect like meshes.
+ */
+void Renderer::drawImpostors(std::unique_ptr<Object> &object) {
+    Shader &program = *m_impostorShader;
+    program.bind();
+    setUniforms(program);
+    setImpostorUniforms(program, true);
+    const SubMesh &subMesh = object->getSubMeshes().front();
+    program.setUniformMatrix4fv("uModel", multiplyMatrix(subMesh.transform, object->getMatrix()));
+    program.setFloat("uColorMix", m_colorMix);
+    object->getMaterial(subMesh.material)->apply(program);
+    m_impostor->bindTextures(RENDERER_IMPOSTOR_TEXTURE_SLOT);
+    program.setInt("uImpostorColor", RENDERER_IMPOSTOR_TEXTURE_SLOT);
+    program.setInt("uImpostorVertexColor", RENDERER_IMPOSTOR_TEXTURE_SLOT + 1);
+    program.setInt("uImpostorNormal", RENDERER_IMPOSTOR_TEXTURE_SLOT + 2);
+    program.setInt("uImpostorAzimuths", IMPOSTOR_AZIMUTHS);
+    program.setInt("uImpostorElevations", IMPOSTOR_ELEVATIONS);
+    program.setFloat("uImpostorViewScale", Impostor::getViewScale());
+
+    glPolygonMode(GL_FRONT_AND_BACK, m_polygonMode ? GL_LINE : GL_FILL);
+    m_impostorQuad->bind();
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(m_instances));
+    m_impostorQuad->unbind();
+    program.unbind();
+}
+
+/**
+ * @brief Sets the switch distance and fade band read by the mesh and impostor shaders.
+ * @param shader Program to set them on
+ * @param impostors false disables the fade, so every copy draws the full mesh
+ */
+void Renderer::setImpostorUniforms(Shader &shader, bool impostors) const {
+    shader.setUniformVec3("uImpostorCenter", impostors ? m_impostor->getCenter() : std::array<float, 3>{0.0f, 0.0f, 0.0f});
+    shader.setFloat("uImpostorRadius", impostors ? m_impostor->getRadius() : 0.0f);
+    shader.setFloat("uImpostorDistance", m_impostorDistance);
+    shader.setFloat("uImpostorFade", impostors ? m_impostorDistance * IMPOSTOR_FADE_FRACTION : 0.0f);
+}
+
+/**
+ * @brief Lists the copies closer than the switch distance, which need the full mesh, and counts the impostors.
+ *
+ * Copies are numbered row by row, so the ones within a distance form a few
+ * runs, about one per row, each drawn with one instanced call.
+ *
+ * @param model Model matrix the mesh is drawn with
+ * @return std::vector<InstanceRun> Runs of consecutive copies, in order.
+ */
+std::vector<InstanceRun> Renderer::selectMeshInstances(const std::array<float, 16> &model) {
+    const std::array<float, 3> &local = m_impostor->getCenter();
+    std::array<float, 3> center;
+    for (int row = 0; row < 3; row++)
+        center[row] = model[row] * local[0] + model[4 + row] * local[1] + model[8 + row] * local[2] + model[12 + row];
+    const std::array<float, 3> &camera = gCamera.getPosition();
+    const float fadeStart = m_impostorDistance * (1.0f - IMPOSTOR_FADE_FRACTION);
+
+    std::vector<InstanceRun> runs;
+    m_impostorCount = 0;
+    for (size_t i = 0; i < m_instances; i++) {
+        // Same grid as instanceOffset() in the shaders
+        const int column = static_cast<int>(i) % m_instanceColumns;
+        const int row = static_cast<int>(i) / m_instanceColumns;
+        const std::array<float, 3> position = {
+            center[0] + (static_cast<float>(column) - static_cast<float>(m_instanceColumns - 1) * 0.5f) * RENDERER_INSTANCE_SPACING,
+            center[1], center[2] - static_cast<float>(row) * RENDERER_INSTANCE_SPACING};
+        const std::array<float, 3> offset = subtractVec(camera, position);
+        const float distance = std::sqrt(dotProdVec(offset, offset));
+        if (distance > fadeStart)
+            m_impostorCount++;
+        if (distance >= m_impostorDistance)
+            continue;
+        if (!runs.empty() && runs.back().first + runs.back().count == i)
+            runs.back().count++;
+        else
+            runs.push_back({i, 1});
+    }
+    return runs;
 }
 
 void Renderer::switchPolygonMode() {
@@ -70,19 +392,171 @@ void Renderer::toggleColorMode() {
 }
 
 /**
- * @brief Binds objects information to shader.
- * @param object An actual object to draw
+ * @brief Compiles vertex_pulling.glsl so `toggleVertexPulling()` can switch to it, and switches to it.
+ *
+ * Requires an OpenGL 4.3 context and objects uploaded after
+ * `Object::setVertexPulling(true)`.
+ */
+void Renderer::enableVertexPulling() {
+    if (!m_pullingShader)
+        m_pullingShader = std::unique_ptr<Shader>(new Shader(RENDERER_PULLING_VERTEX_SHADER,
+                                                             RENDERER_PULLING_FRAGMENT_SHADER));
+    m_vertexPulling = true;
+}
+
+/**
+ * @brief Switches between fixed-function vertex attributes and vertex pulling.
+ *
+ * Does nothing unless `enableVertexPulling()` was called.
+ */
+void Renderer::toggleVertexPulling() {
+    if (m_pullingShader)
+        m_vertexPulling = !m_vertexPulling;
+}
+
+bool Renderer::isVertexPulling() const {
+    return m_vertexPulling;
+}
+
+/**
+ * @brief Creates the visibility buffer, its shaders and enables vertex pulling, then switches to visibility buffer mode.
+ *
+ * Requires an OpenGL 4.3 context, the pass reads the same storage buffers
+ * as vertex pulling.
+ */
+void Renderer::enableVisibilityBuffer() {
+    enableVertexPulling();
+    if (!m_visibilityBuffer) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        m_visibilityBuffer = VisibilityBuffer::create(viewport[2], viewport[3]);
+        if (!m_visibilityBuffer)
+            return;
+        m_visibilityShader = std::unique_ptr<Shader>(new Shader(RENDERER_VISIBILITY_VERTEX_SHADER,
+                                                                RENDERER_VISIBILITY_FRAGMENT_SHADER));
+        m_resolveShader = std::unique_ptr<Shader>(new Shader(RENDERER_RESOLVE_VERTEX_SHADER,
+                                                             RENDERER_RESOLVE_FRAGMENT_SHADER));
+        m_fullScreen = std::unique_ptr<VertexArray>(new VertexArray());
+    }
+    m_visibilityMode = true;
+}
+
+/**
+ * @brief Switches between forward shading and visibility buffer mode.
+ *
+ * Does nothing unless `enableVisibilityBuffer()` succeeded.
+ */
+void Renderer::toggleVisibilityBuffer() {
+    if (m_visibilityBuffer)
+        m_visibilityMode = !m_visibilityMode;
+}
+
+bool Renderer::isVisibilityBuffer() const {
+    return m_visibilityMode;
+}
+
+/**
+ * @brief Sets how many copies of the object are drawn, on a grid, to scale the triangle count up.
+ * @param instances Number of copies, between 1 and VISIBILITY_MAX_INSTANCES.
+ */
+void Renderer::setInstanceCount(size_t instances) {
+    m_instances = std::max<size_t>(1, std::min<size_t>(instances, VISIBILITY_MAX_INSTANCES));
+    m_instanceColumns = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(m_instances))));
+}
+
+/**
+ * @brief Draws copies of the object past a distance as impostors, baked from the object on its next draw.
+ *
+ * Only used with more than one instance, in forward shading.
+ *
+ * @param distance Distance from the camera where copies switch to impostors; they crossfade
+ * over the last IMPOSTOR_FADE_FRACTION of it.
+ */
+void Renderer::enableImpostors(float distance) {
+    m_impostorDistance = distance > 0.0f ? distance : IMPOSTOR_DEFAULT_DISTANCE;
+    m_impostors = true;
+}
+
+/**
+ * @brief Switches impostors on and off, keeping the baked atlas.
+ */
+void Renderer::toggleImpostors() {
+    m_impostors = !m_impostors;
+    m_impostorCount = 0;
+}
+
+bool Renderer::isImpostors() const {
+    return m_impostors;
+}
+
+/**
+ * @brief Number of copies drawn as impostors last frame, fading ones included.
+ */
+size_t Renderer::getImpostorCount() const {
+    return m_impostorCount;
+}
+
+/**
+ * @brief GPU time of the object's draw calls, as measured by a GL_TIME_ELAPSED query.
+ *
+ * Results are read one frame late so the CPU never waits for the GPU.
+ *
+ * @return double Milliseconds, 0 until the first result is available.
+ */
+double Renderer::getGpuTime() const {
+    return m_gpuTime;
+}
+
+/**
+ * @brief Starts this frame's timer query, after collecting the result of the previous one using the same query object.
+ */
+void Renderer::beginTimer() {
+    if (!m_queries[0])
+        glGenQueries(RENDERER_TIMER_QUERIES, m_queries);
+    const size_t slot = m_frame % RENDERER_TIMER_QUERIES;
+    if (m_queryPending[slot]) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(m_queries[slot], GL_QUERY_RESULT, &elapsed);
+        m_gpuTime = elapsed / 1e6;
+    }
+    glBeginQuery(GL_TIME_ELAPSED, m_queries[slot]);
+}
+
+void Renderer::endTimer() {
+    glEndQuery(GL_TIME_ELAPSED);
+    m_queryPending[m_frame % RENDERER_TIMER_QUERIES] = true;
+    m_frame++;
+}
+
+/**
+ * @brief Binds camera information to shader.
  * @param shader Program that tells how to draw given object
  */
-void Renderer::setUniforms(std::unique_ptr<Object> &object, Shader &shader) const {
-    shader.setUniformMatrix4fv("uModel", object->getMatrix());
+void Renderer::setUniforms(Shader &shader) const {
     shader.setUniformMatrix4fv("uView", gCamera.getCamView());
     shader.setUniformMatrix4fv("uProjection", gCamera.getCamProjection());
     shader.setUniformVec3("uCameraPos", gCamera.getPosition());
+    shader.setInt("uInstanceColumns", m_instanceColumns);
+    shader.setFloat("uInstanceSpacing", RENDERER_INSTANCE_SPACING);
+}
+
+/**
+ * @brief Binds the texture of a sub-mesh: its own embedded texture if it has one, the object's texture otherwise.
+ * @param object Object owning the sub-mesh
+ * @param subMesh Sub-mesh about to be drawn
+ * @param shader Program that samples the texture
+ * @return unsigned int Texture unit the texture is bound to
+ */
+unsigned int Renderer::bindTexture(std::unique_ptr<Object> &object, const SubMesh &subMesh, Shader &shader) const {
+    if (subMesh.texture >= 0 && object->getTexture(subMesh.texture)) {
+        object->getTexture(subMesh.texture)->bind(RENDERER_MODEL_TEXTURE_SLOT);
+        shader.setInt("uTexture", RENDERER_MODEL_TEXTURE_SLOT);
+        return RENDERER_MODEL_TEXTURE_SLOT;
+    }
 
     std::string texturePath = object->getTexture2DPath();
     gTextureManager->bindTexture(texturePath);
-    shader.setInt("aTexture", gTextureManager->getSlot(texturePath));
-
-    object->getMaterial()->apply(shader);
+    const unsigned int slot = gTextureManager->getSlot(texturePath);
+    shader.setInt("uTexture", slot);
+    return slot;
 }
@@ -14,24 +14,103 @@
 
 #include "../core/Object.hpp"
 #include "../graphics/Shader.hpp"
+#include "../graphics/VertexArray.hpp"
+#include "../graphics/VisibilityBuffer.hpp"
+#include "../graphics/Impostor.hpp"
+
+#define RENDERER_MODEL_TEXTURE_SLOT 0
+#define RENDERER_TIMER_QUERIES 2
+#define RENDERER_PULLING_VERTEX_SHADER "./res/shaders/vertex_pulling.glsl"
+#define RENDERER_PULLING_FRAGMENT_SHADER "./res/shaders/fragment.glsl"
+#define RENDERER_VISIBILITY_VERTEX_SHADER "./res/shaders/visibility_vertex.glsl"
+#define RENDERER_VISIBILITY_FRAGMENT_SHADER "./res/shaders/visibility_fragment.glsl"
+#define RENDERER_RESOLVE_VERTEX_SHADER "./res/shaders/resolve_vertex.glsl"
+#define RENDERER_RESOLVE_FRAGMENT_SHADER "./res/shaders/resolve_fragment.glsl"
+#define RENDERER_VISIBILITY_TEXTURE_SLOT 15
+#define RENDERER_INSTANCE_SPACING 1.5f
+#define RENDERER_IMPOSTOR_VERTEX_SHADER "./res/shaders/impostor_vertex.glsl"
+#define RENDERER_IMPOSTOR_FRAGMENT_SHADER "./res/shaders/impostor_fragment.glsl"
+#define RENDERER_IMPOSTOR_BAKE_VERTEX_SHADER "./res/shaders/impostor_bake_vertex.glsl"
+#define RENDERER_IMPOSTOR_BAKE_FRAGMENT_SHADER "./res/shaders/impostor_bake_fragment.glsl"
+#define RENDERER_IMPOSTOR_TEXTURE_SLOT 12
 
 class Object;
+struct SubMesh;
+
+/**
+ * @brief Consecutive copies of the object drawn with the full mesh.
+ */
+struct InstanceRun {
+    size_t first;
+    size_t count;
+};
 
 /**
  * @brief Renderer wraps all rendering calls into dedicated functions. It also controlls how objects are being rendered.
  */
 class Renderer {
 public:
+    Renderer() = default;
+    Renderer(const Renderer&) = delete;
+    ~Renderer();
+
+    Renderer &operator=(const Renderer&) = delete;
+
     void setBackgroundColor(const float red, const float green, const float blue, const float alpha);
     void clear() const;
-    void draw(std::unique_ptr<Object> &object, Shader& shader, float deltaTime) const;
+    void draw(std::unique_ptr<Object> &object, Shader& shader, float deltaTime);
     void switchPolygonMode();
     void toggleColorMode();
+    void enableVertexPulling();
+    void toggleVertexPulling();
+    bool isVertexPulling() const;
+    void enableVisibilityBuffer();
+    void toggleVisibilityBuffer();
+    bool isVisibilityBuffer() const;
+    void setInstanceCount(size_t instances);
+    void enableImpostors(float distance);
+    void toggleImpostors();
+    bool isImpostors() const;
+    size_t getImpostorCount() const;
+    double getGpuTime() const;
 
 private:
-    void setUniforms(std::unique_ptr<Object> &object, Shader& shader) const;
+    void drawForward(std::unique_ptr<Object> &object, Shader &shader, bool pulling, bool impostors);
+    void drawVisibility(std::unique_ptr<Object> &object);
+    bool canUseVisibilityBuffer(const std::unique_ptr<Object> &object) const;
+    bool prepareImpostor(std::unique_ptr<Object> &object);
+    void bakeImpostor(std::unique_ptr<Object> &object);
+    void drawImpostors(std::unique_ptr<Object> &object);
+    void setImpostorUniforms(Shader &shader, bool impostors) const;
+    std::vector<InstanceRun> selectMeshInstances(const std::array<float, 16> &model);
+    void setUniforms(Shader& shader) const;
+    unsigned int bindTexture(std::unique_ptr<Object> &object, const SubMesh &subMesh, Shader &shader) const;
+    void beginTimer();
+    void endTimer();
     bool m_polygonMode = false;
     bool m_colorMode = true;
+    bool m_vertexPulling = false;
+    bool m_visibilityMode = false;
+    float m_colorMix = 1.0f;
+    size_t m_instances = 1;
+    int m_instanceColumns = 1;
+    std::unique_ptr<Shader> m_pullingShader = nullptr;
+    std::unique_ptr<Shader> m_visibilityShader = nullptr;
+    std::unique_ptr<Shader> m_resolveShader = nullptr;
+    std::unique_ptr<VisibilityBuffer> m_visibilityBuffer = nullptr;
+    std::unique_ptr<VertexArray> m_fullScreen = nullptr;
+    bool m_impostors = false;
+    float m_impostorDistance = IMPOSTOR_DEFAULT_DISTANCE;
+    size_t m_impostorRevision = 0;
+    size_t m_impostorCount = 0;
+    std::unique_ptr<Impostor> m_impostor = nullptr;
+    std::unique_ptr<Shader> m_impostorShader = nullptr;
+    std::unique_ptr<Shader> m_impostorBakeShader = nullptr;
+    std::unique_ptr<VertexArray> m_impostorQuad = nullptr;
+    unsigned int m_queries[RENDERER_TIMER_QUERIES] = {0, 0};
+    bool m_queryPending[RENDERER_TIMER_QUERIES] = {false, false};
+    size_t m_frame = 0;
+    double m_gpuTime = 0.0;
 };
 
 #endif //SCOP_RENDERER_HPP
@@ -0,0 +1,207 @@
+/**
+ * @file Shading.cpp
+ * @author Patryk
+ * @brief CPU versions of the shader stages, shared by the software renderers
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "Shading.hpp"
+
+/**
+ * @brief Transforms a point by a matrix stored like the GL uniforms (translation at 12-14).
+ */
+std::array<float, 4> transformPoint(const std::array<float, 16> &m, const std::array<float, 3> &p) {
+    std::array<float, 4> out;
+    for (int c = 0; c < 4; c++)
+        out[c] = p[0] * m[c] + p[1] * m[4 + c] + p[2] * m[8 + c] + m[12 + c];
+    return out;
+}
+
+/**
+ * @brief Computes transpose(inverse(mat3(model))) as done in vertex.glsl, in the same storage order.
+ * @return std::array<float, 9> Matrix n applied as out[row] = sum(n[row * 3 + col] * in[col]).
+ */
+std::array<float, 9> getNormalMatrix(const std::array<float, 16> &model) {
+    // g[row][col] of the GL matrix is model[col * 4 + row]
+    auto g = [&](int row, int col) { return model[col * 4 + row]; };
+    const float c00 = g(1, 1) * g(2, 2) - g(1, 2) * g(2, 1);
+    const float c01 = g(1, 2) * g(2, 0) - g(1, 0) * g(2, 2);
+    const float c02 = g(1, 0) * g(2, 1) - g(1, 1) * g(2, 0);
+    const float det = g(0, 0) * c00 + g(0, 1) * c01 + g(0, 2) * c02;
+    const float inv = det != 0.0f ? 1.0f / det : 0.0f;
+    // The transposed inverse is the cofactor matrix divided by the determinant; n[row * 3 + col]
+    return {
+        c00 * inv, c01 * inv, c02 * inv,
+        (g(0, 2) * g(2, 1) - g(0, 1) * g(2, 2)) * inv, (g(0, 0) * g(2, 2) - g(0, 2) * g(2, 0)) * inv,
+        (g(0, 1) * g(2, 0) - g(0, 0) * g(2, 1)) * inv,
+        (g(0, 1) * g(1, 2) - g(0, 2) * g(1, 1)) * inv, (g(0, 2) * g(1, 0) - g(0, 0) * g(1, 2)) * inv,
+        (g(0, 0) * g(1, 1) - g(0, 1) * g(1, 0)) * inv
+    };
+}
+
+static float fract(float x) {
+    return x - std::floor(x);
+}
+
+/**
+ * @brief vColor of vertex.glsl for models without vertex colors: a gray level derived from the position.
+ */
+std::array<float, 3> getFallbackColor(const std::array<float, 3> &position) {
+    const float gray = (fract(position[0]) * 0.3f + fract(position[1]) * 0.3f + fract(position[2]) * 0.3f) / 1.5f;
+    return {gray, gray, gray};
+}
+
+/**
+ * @brief Packs a color into RGBA8, red in the lowest byte.
+ */
+uint32_t packColor(float red, float green, float blue, float alpha) {
+    auto channel = [](float value) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    };
+    return channel(red) | channel(green) << 8 | channel(blue) << 16 | channel(alpha) << 24;
+}
+
+/**
+ * @brief Fetches one texel with GL_MIRRORED_REPEAT wrapping.
+ */
+static std::array<float, 4> fetchTexel(const Image &texture, int x, int y) {
+    auto mirror = [](int i, int size) {
+        const int period = 2 * size;
+        int m = i % period;
+        if (m < 0)
+            m += period;
+        return m < size ? m : period - 1 - m;
+    };
+    x = mirror(x, texture.width);
+    y = mirror(y, texture.height);
+    const unsigned char *p = texture.pixels.get() +
+                             (static_cast<size_t>(y) * texture.width + x) * texture.nrChannels;
+    const float s = 1.0f / 255.0f;
+    switch (texture.nrChannels) {
+        case 1: return {p[0] * s, p[0] * s, p[0] * s, 1.0f};
+        case 2: return {p[0] * s, p[0] * s, p[0] * s, p[1] * s};
+        case 3: return {p[0] * s, p[1] * s, p[2] * s, 1.0f};
+        default: return {p[0] * s, p[1] * s, p[2] * s, p[3] * s};
+    }
+}
+
+/**
+ * @brief Samples a texture bilinearly; rows are stored bottom-up as uploaded to GL.
+ */
+std::array<float, 4> sampleTexture(const Image &texture, float u, float v) {
+    if (!texture.pixels || texture.width <= 0 || texture.height <= 0)
+        return {1.0f, 1.0f, 1.0f, 1.0f};
+    const float x = u * texture.width - 0.5f, y = v * texture.height - 0.5f;
+    const float fx = std::floor(x), fy = std::floor(y);
+    const int x0 = static_cast<int>(fx), y0 = static_cast<int>(fy);
+    const float tx = x - fx, ty = y - fy;
+    const std::array<float, 4> c00 = fetchTexel(texture, x0, y0), c10 = fetchTexel(texture, x0 + 1, y0);
+    const std::array<float, 4> c01 = fetchTexel(texture, x0, y0 + 1), c11 = fetchTexel(texture, x0 + 1, y0 + 1);
+    std::array<float, 4> out;
+    for (int i = 0; i < 4; i++) {
+        const float top = c00[i] + (c10[i] - c00[i]) * tx;
+        const float bottom = c01[i] + (c11[i] - c01[i]) * tx;
+        out[i] = top + (bottom - top) * ty;
+    }
+    return out;
+}
+
+static std::array<float, 3> normalize3(float x, float y, float z) {
+    const float length = std::sqrt(x * x + y * y + z * z);
+    if (length == 0.0f)
+        return {0.0f, 0.0f, 0.0f};
+    return {x / length, y / length, z / length};
+}
+
+/**
+ * @brief Shades one fragment like fragment.glsl.
+ * @param u, v Texture coordinates.
+ * @param normal World space normal, not necessarily normalized.
+ * @param viewDir Direction towards the camera, not necessarily normalized.
+ * @param color Vertex color (vColor).
+ * @param lightVisibility Scales the diffuse and specular terms, 0 for fragments in shadow.
+ * @param occlusion Baked ambient occlusion (vOcclusion), scales the ambient and diffuse terms.
+ * @return std::array<float, 4> Unclamped RGBA color.
+ */
+std::array<float, 4> shadeFragment(float u, float v, const std::array<float, 3> &normal,
+                                   const std::array<float, 3> &viewDir, const std::array<float, 3> &color,
+                                   const Image &texture, const MaterialParams &material, float colorMix,
+                                   float lightVisibility, float occlusion) {
+    const std::array<float, 4> texColor = sampleTexture(texture, u, v);
+    const float mixed[4] = {
+        texColor[0] + (color[0] - texColor[0]) * colorMix,
+        texColor[1] + (color[1] - texColor[1]) * colorMix,
+        texColor[2] + (color[2] - texColor[2]) * colorMix,
+        texColor[3] + (1.0f - texColor[3]) * colorMix
+    };
+
+    const std::array<float, 3> n = normalize3(normal[0], normal[1], normal[2]);
+    const float diffuseFactor = n[0] * SHADING_LIGHT_X + n[1] * SHADING_LIGHT_Y + n[2] * SHADING_LIGHT_Z;
+    const float diffuse = diffuseFactor > 0.0f ? 0.8f * diffuseFactor * lightVisibility : 0.0f;
+    const std::array<float, 3> view = normalize3(viewDir[0], viewDir[1], viewDir[2]);
+    const std::array<float, 3> halfway = normalize3(SHADING_LIGHT_X + view[0], SHADING_LIGHT_Y + view[1],
+                                                    SHADING_LIGHT_Z + view[2]);
+    const float spec = std::pow(std::max(n[0] * halfway[0] + n[1] * halfway[1] + n[2] * halfway[2], 0.0f),
+                                material.Ns) * lightVisibility;
+
+    std::array<float, 4> out;
+    for (int i = 0; i < 3; i++)
+        out[i] = mixed[i] * ((0.2f * material.Ka[i] + diffuse * material.Kd[i]) * occlusion + material.Ks[i] * spec);
+    out[3] = mixed[3] * ((0.2f + diffuse) * occlusion + 1.0f);
+    return out;
+}
+
+/**
+ * @brief Shades one fragment like `shadeFragment()`, with a list of lights instead of the one of fragment.glsl.
+ *
+ * Each light adds its diffuse and specular terms, scaled by its color;
+ * the ambient term is counted once. A single white light along
+ * SHADING_LIGHT_X/Y/Z gives the same color as `shadeFragment()`.
+ *
+ * @param lights Lights of the scene.
+ * @param occlusion Baked ambient occlusion (vOcclusion), scales the ambient and diffuse terms.
+ * @return std::array<float, 4> Unclamped RGBA color.
+ */
+std::array<float, 4> shadeFragmentLights(float u, float v, const std::array<float, 3> &normal,
+                                         const std::array<float, 3> &viewDir, const std::array<float, 3> &color,
+                                         const Image &texture, const MaterialParams &material, float colorMix,
+                                         const std::vector<ShadingLight> &lights, float occlusion) {
+    const std::array<float, 4> texColor = sampleTexture(texture, u, v);
+    const float mixed[4] = {
+        texColor[0] + (color[0] - texColor[0]) * colorMix,
+        texColor[1] + (color[1] - texColor[1]) * colorMix,
+        texColor[2] + (color[2] - texColor[2]) * colorMix,
+        texColor[3] + (1.0f - texColor[3]) * colorMix
+    };
+
+    const std::array<float, 3> n = normalize3(normal[0], normal[1], normal[2]);
+    const std::array<float, 3> view = normalize3(viewDir[0], viewDir[1], viewDir[2]);
+    float diffuse[3] = {0.0f, 0.0f, 0.0f}, specular[3] = {0.0f, 0.0f, 0.0f}, diffuseAlpha = 0.0f;
+    for (const ShadingLight &light: lights) {
+        const std::array<float, 3> &l = light.direction;
+        const float diffuseFactor = n[0] * l[0] + n[1] * l[1] + n[2] * l[2];
+        const float lightDiffuse = diffuseFactor > 0.0f ? 0.8f * diffuseFactor : 0.0f;
+        const std::array<float, 3> halfway = normalize3(l[0] + view[0], l[1] + view[1], l[2] + view[2]);
+        const float spec = std::pow(std::max(n[0] * halfway[0] + n[1] * halfway[1] + n[2] * halfway[2], 0.0f),
+                                    material.Ns);
+        for (int i = 0; i < 3; i++) {
+            diffuse[i] += lightDiffuse * light.color[i];
+            specular[i] += spec * light.color[i];
+        }
+        diffuseAlpha += lightDiffuse;
+    }
+
+    std::array<float, 4> out;
+    for (int i = 0; i < 3; i++)
+        out[i] = mixed[i] * ((0.2f * material.Ka[i] + diffuse[i] * material.Kd[i]) * occlusion +
+                             material.Ks[i] * specular[i]);
+    out[3] = mixed[3] * ((0.2f + diffuseAlpha) * occlusion + 1.0f);
+    return out;
+}
@@ -0,0 +1,52 @@
+/**
+ * @file Shading.hpp
+ * @author Patryk
+ * @brief CPU versions of the shader stages, shared by the software renderers
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_SHADING_HPP
+#define SCOP_SHADING_HPP
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../textures/Material.hpp"
+#include "../textures/Texture2D.hpp"
+
+// Light direction of fragment.glsl, not normalized there either
+#define SHADING_LIGHT_X 0.0f
+#define SHADING_LIGHT_Y 0.5f
+#define SHADING_LIGHT_Z 1.0f
+
+/**
+ * @brief Directional light of `shadeFragmentLights()`.
+ *
+ * `direction` points towards the light, like SHADING_LIGHT_X/Y/Z, and is
+ * used as is.
+ */
+struct ShadingLight {
+    std::array<float, 3> direction;
+    std::array<float, 3> color;
+};
+
+std::array<float, 4> transformPoint(const std::array<float, 16> &m, const std::array<float, 3> &p);
+std::array<float, 9> getNormalMatrix(const std::array<float, 16> &model);
+std::array<float, 3> getFallbackColor(const std::array<float, 3> &position);
+uint32_t packColor(float red, float green, float blue, float alpha);
+std::array<float, 4> sampleTexture(const Image &texture, float u, float v);
+std::array<float, 4> shadeFragment(float u, float v, const std::array<float, 3> &normal,
+                                   const std::array<float, 3> &viewDir, const std::array<float, 3> &color,
+                                   const Image &texture, const MaterialParams &material, float colorMix,
+                                   float lightVisibility = 1.0f, float occlusion = 1.0f);
+std::array<float, 4> shadeFragmentLights(float u, float v, const std::array<float, 3> &normal,
+                                         const std::array<float, 3> &viewDir, const std::array<float, 3> &color,
+                                         const Image &texture, const MaterialParams &material, float colorMix,
+                                         const std::vector<ShadingLight> &lights, float occlusion = 1.0f);
+
+#endif //SCOP_SHADING_HPP
@@ -0,0 +1,435 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @author Patryk
+ * @brief SoftwareRenderer class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <emmintrin.h>
+
+#include "SoftwareRenderer.hpp"
+#include "Shading.hpp"
+#include "../core/Camera.hpp"
+#include "../io/Ppm.hpp"
+#include "../utils/Parallel.hpp"
+
+extern Camera gCamera;
+
+/**
+ * @brief Creates a renderer with its own color and depth buffers.
+ * @param width Image width in pixels.
+ * @param height Image height in pixels.
+ * @return std::unique_ptr<SoftwareRenderer> The renderer, or `nullptr` if the size is invalid.
+ */
+std::unique_ptr<SoftwareRenderer> SoftwareRenderer::create(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        fprintf(stderr, "Invalid software renderer size %dx%d\n", width, height);
+        return nullptr;
+    }
+    std::unique_ptr<SoftwareRenderer> renderer(new SoftwareRenderer());
+    renderer->m_width = width;
+    renderer->m_height = height;
+    // Rows are padded so that 4-pixel SSE accesses never leave the buffer
+    renderer->m_stride = (width + 3) & ~3;
+    renderer->m_tilesX = (width + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+    renderer->m_tilesY = (height + SOFTWARE_TILE_SIZE - 1) / SOFTWARE_TILE_SIZE;
+    renderer->m_color.resize(static_cast<size_t>(renderer->m_stride) * height);
+    renderer->m_depth.resize(static_cast<size_t>(renderer->m_stride) * height);
+    return renderer;
+}
+
+void SoftwareRenderer::setBackgroundColor(const float red, const float green, const float blue, const float alpha) {
+    m_background = {red, green, blue, alpha};
+}
+
+/**
+ * @brief Fills the color buffer with the background color and resets the depth buffer.
+ */
+void SoftwareRenderer::clear() {
+    const uint32_t background = packColor(m_background[0], m_background[1], m_background[2], m_background[3]);
+    parallelFor(0, m_height, 16, [&](size_t begin, size_t end) {
+        const size_t first = begin * m_stride, last = end * m_stride;
+        std::fill(m_color.begin() + first, m_color.begin() + last, background);
+        std::fill(m_depth.begin() + first, m_depth.begin() + last, 1.0f);
+    });
+    m_triangleCount = 0;
+}
+
+static std::array<float, 3> normalize3(float x, float y, float z) {
+    const float length = std::sqrt(x * x + y * y + z * z);
+    if (length == 0.0f)
+        return {0.0f, 0.0f, 0.0f};
+    return {x / length, y / length, z / length};
+}
+
+/**
+ * @brief Renders an object into the color buffer.
+ *
+ * Runs one pass (vertex stage, setup and binning, tile rasterization) per
+ * indexed triangle sub-mesh, using the same camera, model matrix and
+ * material as Renderer::draw.
+ *
+ * @param object Object loaded with `Object::load()`; it does not need to be uploaded.
+ * @param texture Texture sampled by the fragment stage.
+ * @param colorMix Blend between the texture (0) and the vertex color (1), as uColorMix.
+ * @return bool false if the object has no CPU-side triangles (glTF models, point clouds).
+ */
+bool SoftwareRenderer::draw(Object &object, const Image &texture, float colorMix) {
+    return drawObject(object, object.getMatrix(), texture, nullptr, colorMix);
+}
+
+/**
+ * @brief Renders a copy of an object with its own model matrix and material.
+ *
+ * Lets a scene draw many copies of one loaded model, each placed and
+ * shaded differently, without loading it again.
+ *
+ * @param object Object loaded with `Object::load()`.
+ * @param model Model matrix used instead of the object's.
+ * @param texture Texture sampled by the fragment stage.
+ * @param material Material used for every sub-mesh instead of the object's.
+ * @param colorMix Blend between the texture (0) and the vertex color (1), as uColorMix.
+ * @return bool false if the object has no CPU-side triangles (glTF models, point clouds).
+ */
+bool SoftwareRenderer::draw(Object &object, const std::array<float, 16> &model, const Image &texture,
+                            const MaterialParams &material, float colorMix) {
+    return drawObject(object, model, texture, &material, colorMix);
+}
+
+/**
+ * @brief Lights the next draws with these directional lights instead of the light of fragment.glsl.
+ * @param lights Lights of the scene; empty restores the light of fragment.glsl.
+ */
+void SoftwareRenderer::setLights(const std::vector<ShadingLight> &lights) {
+    m_lights = lights;
+}
+
+/**
+ * @brief Runs the pipeline for every indexed triangle sub-mesh of an object.
+ * @param material Material of every sub-mesh, or `nullptr` for the object's own materials.
+ */
+bool SoftwareRenderer::drawObject(Object &object, const std::array<float, 16> &model, const Image &texture,
+                                  const MaterialParams *material, float colorMix) {
+    const std::vector<Vertex> &vertices = object.getVertices();
+    const std::vector<unsigned int> &indices = object.getIndices();
+    const std::vector<std::array<unsigned char, 4>> &colors = object.getVertexColors();
+    const std::vector<unsigned char> &occlusion = object.getAmbientOcclusion();
+    if (vertices.empty()) {
+        fprintf(stderr, "The software renderer only draws .obj, .ply and .stl models\n");
+        return false;
+    }
+    if (indices.empty()) {
+        fprintf(stderr, "The software renderer only draws triangles, not point clouds\n");
+        return false;
+    }
+
+    const std::array<float, 16> viewProjection = multiplyMatrix(gCamera.getCamView(), gCamera.getCamProjection());
+    const std::array<float, 3> cameraPosition = gCamera.getPosition();
+    const size_t tiles = static_cast<size_t>(m_tilesX) * m_tilesY;
+
+    for (const SubMesh &subMesh: object.getSubMeshes()) {
+        if (subMesh.mode != GL_TRIANGLES || !subMesh.indexed || subMesh.indexType != GL_UNSIGNED_INT)
+            continue;
+        const std::array<float, 16> subMeshModel = multiplyMatrix(subMesh.transform, model);
+        const std::array<float, 16> modelViewProjection = multiplyMatrix(subMeshModel, viewProjection);
+        const std::array<float, 9> normalMatrix = getNormalMatrix(subMeshModel);
+
+        // Vertex stage
+        m_vertices.resize(vertices.size());
+        parallelFor(0, vertices.size(), SOFTWARE_VERTEX_GRAIN, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Vertex &in = vertices[i];
+                SoftwareVertex &out = m_vertices[i];
+                out.clip = transformPoint(modelViewProjection, in.position);
+                const std::array<float, 4> world = transformPoint(subMeshModel, in.position);
+
+                const std::array<float, 3> normal = normalize3(
+                    normalMatrix[0] * in.normal[0] + normalMatrix[1] * in.normal[1] + normalMatrix[2] * in.normal[2],
+                    normalMatrix[3] * in.normal[0] + normalMatrix[4] * in.normal[1] + normalMatrix[5] * in.normal[2],
+                    normalMatrix[6] * in.normal[0] + normalMatrix[7] * in.normal[1] + normalMatrix[8] * in.normal[2]);
+                const std::array<float, 3> viewDir = normalize3(cameraPosition[0] - world[0],
+                                                                cameraPosition[1] - world[1],
+                                                                cameraPosition[2] - world[2]);
+                out.varyings = {in.uv[0], in.uv[1], normal[0], normal[1], normal[2],
+                                viewDir[0], viewDir[1], viewDir[2],
+                                occlusion.empty() ? 1.0f : occlusion[i] / 255.0f};
+
+                if (!colors.empty()) {
+                    out.color = {colors[i][0] / 255.0f, colors[i][1] / 255.0f, colors[i][2] / 255.0f};
+                } else {
+                    out.color = getFallbackColor(in.position);
+                }
+            }
+        });
+
+        // Clipping, setup and binning, one list of triangles and bins per block
+        const size_t triangleCount = subMesh.count / 3;
+        const size_t first = subMesh.indexOffset / sizeof(unsigned int);
+        const size_t blocks = (triangleCount + SOFTWARE_TRIANGLE_GRAIN - 1) / SOFTWARE_TRIANGLE_GRAIN;
+        if (m_blockTriangles.size() < blocks)
+            m_blockTriangles.resize(blocks);
+        if (m_bins.size() < blocks * tiles)
+            m_bins.resize(blocks * tiles);
+        parallelFor(0, blocks, 1, [&](size_t blockBegin, size_t blockEnd) {
+            for (size_t block = blockBegin; block < blockEnd; block++) {
+                m_blockTriangles[block].clear();
+                for (size_t tile = 0; tile < tiles; tile++)
+                    m_bins[block * tiles + tile].clear();
+                const size_t end = std::min(triangleCount, (block + 1) * SOFTWARE_TRIANGLE_GRAIN);
+                for (size_t t = block * SOFTWARE_TRIANGLE_GRAIN; t < end; t++) {
+                    const unsigned int *corners = &indices[first + t * 3];
+                    if (corners[0] >= vertices.size() || corners[1] >= vertices.size() || corners[2] >= vertices.size())
+                        continue;
+                    setupTriangle(m_vertices[corners[0]], m_vertices[corners[1]], m_vertices[corners[2]], block);
+                }
+            }
+        });
+        for (size_t block = 0; block < blocks; block++)
+            m_triangleCount += m_blockTriangles[block].size();
+
+        // Rasterization, one tile per task
+        const MaterialParams &params = material ? *material : object.getMaterial(subMesh.material)->getParams();
+        parallelFor(0, tiles, 1, [&](size_t tileBegin, size_t tileEnd) {
+            for (size_t tile = tileBegin; tile < tileEnd; tile++)
+                rasterizeTile(static_cast<int>(tile), blocks, texture, params, colorMix);
+        });
+    }
+    return true;
+}
+
+static SoftwareVertex lerpVertex(const SoftwareVertex &a, const SoftwareVertex &b, float t) {
+    SoftwareVertex out;
+    for (int i = 0; i < 4; i++)
+        out.clip[i] = a.clip[i] + (b.clip[i] - a.clip[i]) * t;
+    for (int i = 0; i < SOFTWARE_VARYINGS; i++)
+        out.varyings[i] = a.varyings[i] + (b.varyings[i] - a.varyings[i]) * t;
+    out.color = a.color;
+    return out;
+}
+
+/**
+ * @brief Clips a triangle against the near, far and w > 0 planes and emits the pieces.
+ *
+ * Triangles entirely outside one of the frustum planes are rejected. The
+ * side planes are not clipped; the screen bounds of the triangle are
+ * clamped instead. The color is flat and taken from the last vertex, as
+ * with GL's default provoking vertex.
+ */
+void SoftwareRenderer::setupTriangle(const SoftwareVertex &a, const SoftwareVertex &b, const SoftwareVertex &c,
+                                     size_t block) {
+    const SoftwareVertex *corners[3] = {&a, &b, &c};
+    int outsideAll = 0x3F, outsideAny = 0;
+    for (const SoftwareVertex *v: corners) {
+        const float x = v->clip[0], y = v->clip[1], z = v->clip[2], w = v->clip[3];
+        const int code = (x < -w) | (x > w) << 1 | (y < -w) << 2 | (y > w) << 3 | (z < -w) << 4 | (z > w) << 5;
+        outsideAll &= code;
+        outsideAny |= code | (w < SOFTWARE_MIN_W) << 6;
+    }
+    if (outsideAll)
+        return;
+    if (!(outsideAny & 0x70)) {
+        emitTriangle(a, b, c, c.color, block);
+        return;
+    }
+
+    // Sutherland-Hodgman against z >= -w, z <= w and w >= SOFTWARE_MIN_W
+    SoftwareVertex polygon[2][9];
+    int count = 3;
+    polygon[0][0] = a;
+    polygon[0][1] = b;
+    polygon[0][2] = c;
+    int current = 0;
+    for (int plane = 0; plane < 3 && count > 0; plane++) {
+        auto distance = [plane](const SoftwareVertex &v) {
+            if (plane == 0) return v.clip[3] + v.clip[2];
+            if (plane == 1) return v.clip[3] - v.clip[2];
+            return v.clip[3] - SOFTWARE_MIN_W;
+        };
+        const SoftwareVertex *in = polygon[current];
+        SoftwareVertex *out = polygon[current ^ 1];
+        int outCount = 0;
+        for (int i = 0; i < count; i++) {
+            const SoftwareVertex &from = in[i];
+            const SoftwareVertex &to = in[(i + 1) % count];
+            const float d0 = distance(from), d1 = distance(to);
+            if (d0 >= 0.0f)
+                out[outCount++] = from;
+            if ((d0 >= 0.0f) != (d1 >= 0.0f))
+                out[outCount++] = lerpVertex(from, to, d0 / (d0 - d1));
+        }
+        count = outCount;
+        current ^= 1;
+    }
+    for (int i = 1; i + 1 < count; i++)
+        emitTriangle(polygon[current][0], polygon[current][i], polygon[current][i + 1], c.color, block);
+}
+
+/**
+ * @brief Projects a clipped triangle to the screen, computes its edge functions and bins it.
+ */
+void SoftwareRenderer::emitTriangle(const SoftwareVertex &a, const SoftwareVertex &b, const SoftwareVertex &c,
+                                    const std::array<float, 3> &color, size_t block) {
+    const SoftwareVertex *v[3] = {&a, &b, &c};
+    float x[3], y[3], z[3], inverseW[3];
+    for (int i = 0; i < 3; i++) {
+        inverseW[i] = 1.0f / v[i]->clip[3];
+        x[i] = (v[i]->clip[0] * inverseW[i] * 0.5f + 0.5f) * m_width;
+        y[i] = (0.5f - v[i]->clip[1] * inverseW[i] * 0.5f) * m_height;
+        z[i] = v[i]->clip[2] * inverseW[i] * 0.5f + 0.5f;
+    }
+    float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+    if (!(area != 0.0f))
+        return;
+    if (area < 0.0f) {
+        // No face culling: flip the winding so that the inside is positive
+        std::swap(v[1], v[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        std::swap(z[1], z[2]);
+        std::swap(inverseW[1], inverseW[2]);
+        area = -area;
+    }
+
+    SoftwareTriangle triangle;
+    triangle.minX = std::max(0, static_cast<int>(std::ceil(std::min({x[0], x[1], x[2]}) - 0.5f)));
+    triangle.maxX = std::min(m_width - 1, static_cast<int>(std::floor(std::max({x[0], x[1], x[2]}) - 0.5f)));
+    triangle.minY = std::max(0, static_cast<int>(std::ceil(std::min({y[0], y[1], y[2]}) - 0.5f)));
+    triangle.maxY = std::min(m_height - 1, static_cast<int>(std::floor(std::max({y[0], y[1], y[2]}) - 0.5f)));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    for (int i = 0; i < 3; i++) {
+        // Edge opposite to vertex i: cross(v[k] - v[j], p - v[j]), positive inside
+        const int j = (i + 1) % 3, k = (i + 2) % 3;
+        triangle.edgeA[i] = y[j] - y[k];
+        triangle.edgeB[i] = x[k] - x[j];
+        triangle.edgeC[i] = x[j] * y[k] - x[k] * y[j];
+        triangle.topLeft[i] = triangle.edgeA[i] > 0.0f || (triangle.edgeA[i] == 0.0f && triangle.edgeB[i] > 0.0f);
+    }
+    triangle.inverseArea = 1.0f / area;
+    triangle.depth = {z[0], z[1] - z[0], z[2] - z[0]};
+    triangle.inverseW = {inverseW[0], inverseW[1] - inverseW[0], inverseW[2] - inverseW[0]};
+    for (int n = 0; n < SOFTWARE_VARYINGS; n++) {
+        const float v0 = v[0]->varyings[n] * inverseW[0];
+        triangle.varyings[0][n] = v0;
+        triangle.varyings[1][n] = v[1]->varyings[n] * inverseW[1] - v0;
+        triangle.varyings[2][n] = v[2]->varyings[n] * inverseW[2] - v0;
+    }
+    triangle.color = color;
+
+    std::vector<SoftwareTriangle> &triangles = m_blockTriangles[block];
+    const uint32_t index = static_cast<uint32_t>(triangles.size());
+    triangles.push_back(triangle);
+    const size_t tiles = static_cast<size_t>(m_tilesX) * m_tilesY;
+    for (int ty = triangle.minY / SOFTWARE_TILE_SIZE; ty <= triangle.maxY / SOFTWARE_TILE_SIZE; ty++) {
+        for (int tx = triangle.minX / SOFTWARE_TILE_SIZE; tx <= triangle.maxX / SOFTWARE_TILE_SIZE; tx++)
+            m_bins[block * tiles + ty * m_tilesX + tx].push_back(index);
+    }
+}
+
+/**
+ * @brief Rasterizes every triangle binned into one tile, in submission order.
+ *
+ * Edge functions and the depth test are evaluated 4 pixels at a time with
+ * SSE; only the pixels that pass are shaded.
+ */
+void SoftwareRenderer::rasterizeTile(int tile, size_t blocks, const Image &texture, const MaterialParams &material,
+                                     float colorMix) {
+    const int tileX = (tile % m_tilesX) * SOFTWARE_TILE_SIZE;
+    const int tileY = (tile / m_tilesX) * SOFTWARE_TILE_SIZE;
+    const int tileMaxX = std::min(tileX + SOFTWARE_TILE_SIZE, m_width) - 1;
+    const int tileMaxY = std::min(tileY + SOFTWARE_TILE_SIZE, m_height) - 1;
+    const size_t tiles = static_cast<size_t>(m_tilesX) * m_tilesY;
+    const __m128 laneOffsets = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (size_t block = 0; block < blocks; block++) {
+        const std::vector<SoftwareTriangle> &triangles = m_blockTriangles[block];
+        for (uint32_t index: m_bins[block * tiles + tile]) {
+            const SoftwareTriangle &t = triangles[index];
+            const int minX = std::max(t.minX, tileX), maxX = std::min(t.maxX, tileMaxX);
+            const int minY = std::max(t.minY, tileY), maxY = std::min(t.maxY, tileMaxY);
+            const __m128 a0 = _mm_set1_ps(t.edgeA[0]), a1 = _mm_set1_ps(t.edgeA[1]), a2 = _mm_set1_ps(t.edgeA[2]);
+            const __m128 inverseArea = _mm_set1_ps(t.inverseArea);
+            const __m128 z0 = _mm_set1_ps(t.depth[0]), dz1 = _mm_set1_ps(t.depth[1]), dz2 = _mm_set1_ps(t.depth[2]);
+
+            for (int y = minY; y <= maxY; y++) {
+                const float py = y + 0.5f;
+                const __m128 row0 = _mm_set1_ps(t.edgeB[0] * py + t.edgeC[0]);
+                const __m128 row1 = _mm_set1_ps(t.edgeB[1] * py + t.edgeC[1]);
+                const __m128 row2 = _mm_set1_ps(t.edgeB[2] * py + t.edgeC[2]);
+                float *depthRow = &m_depth[static_cast<size_t>(y) * m_stride];
+                uint32_t *colorRow = &m_color[static_cast<size_t>(y) * m_stride];
+
+                for (int x = minX & ~3; x <= maxX; x += 4) {
+                    const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+                    const __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), row0);
+                    const __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), row1);
+                    const __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), row2);
+                    __m128 inside = t.topLeft[0] ? _mm_cmpge_ps(e0, zero) : _mm_cmpgt_ps(e0, zero);
+                    inside = _mm_and_ps(inside, t.topLeft[1] ? _mm_cmpge_ps(e1, zero) : _mm_cmpgt_ps(e1, zero));
+                    inside = _mm_and_ps(inside, t.topLeft[2] ? _mm_cmpge_ps(e2, zero) : _mm_cmpgt_ps(e2, zero));
+                    int mask = _mm_movemask_ps(inside);
+                    // Lanes outside [minX, maxX]
+                    mask &= (0xF << std::max(0, minX - x)) & (0xF >> std::max(0, x + 3 - maxX));
+                    if (!mask)
+                        continue;
+
+                    const __m128 l1 = _mm_mul_ps(e1, inverseArea), l2 = _mm_mul_ps(e2, inverseArea);
+                    const __m128 z = _mm_add_ps(z0, _mm_add_ps(_mm_mul_ps(l1, dz1), _mm_mul_ps(l2, dz2)));
+                    const __m128 stored = _mm_loadu_ps(depthRow + x);
+                    mask &= _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(z, stored), _mm_cmpge_ps(z, zero)));
+                    if (!mask)
+                        continue;
+
+                    alignas(16) float lambda1[4], lambda2[4], depth[4];
+                    _mm_store_ps(lambda1, l1);
+                    _mm_store_ps(lambda2, l2);
+                    _mm_store_ps(depth, z);
+                    for (int lane = 0; lane < 4; lane++) {
+                        if (!(mask & (1 << lane)))
+                            continue;
+                        depthRow[x + lane] = depth[lane];
+                        const float w = 1.0f / (t.inverseW[0] + lambda1[lane] * t.inverseW[1] +
+                                                lambda2[lane] * t.inverseW[2]);
+                        std::array<float, SOFTWARE_VARYINGS> varyings;
+                        for (int n = 0; n < SOFTWARE_VARYINGS; n++)
+                            varyings[n] = (t.varyings[0][n] + lambda1[lane] * t.varyings[1][n] +
+                                           lambda2[lane] * t.varyings[2][n]) * w;
+                        const std::array<float, 4> color = m_lights.empty() ? shadeFragment(
+                            varyings[0], varyings[1], {varyings[2], varyings[3], varyings[4]},
+                            {varyings[5], varyings[6], varyings[7]}, t.color, texture, material, colorMix,
+                            1.0f, varyings[8]) : shadeFragmentLights(
+                            varyings[0], varyings[1], {varyings[2], varyings[3], varyings[4]},
+                            {varyings[5], varyings[6], varyings[7]}, t.color, texture, material, colorMix,
+                            m_lights, varyings[8]);
+                        colorRow[x + lane] = packColor(color[0], color[1], color[2], color[3]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Writes the color buffer as a binary PPM image.
+ * @param path Output file.
+ * @return bool true if the file was written.
+ */
+bool SoftwareRenderer::writeImage(const std::string &path) const {
+    return writePpm(path, m_width, m_height, m_color.data(), m_stride);
+}
+
+/**
+ * @brief Number of triangles set up (after clipping) since the last `clear()`.
+ */
+size_t SoftwareRenderer::getTriangleCount() const {
+    return m_triangleCount;
+}
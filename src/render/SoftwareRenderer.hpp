@@ -0,0 +1,119 @@
+/**
+ * @file SoftwareRenderer.hpp
+ * @author Patryk
+ * @brief SoftwareRenderer class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_SOFTWARE_RENDERER_HPP
+#define SCOP_SOFTWARE_RENDERER_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Object.hpp"
+#include "../textures/Texture2D.hpp"
+#include "Shading.hpp"
+
+#define SOFTWARE_TILE_SIZE 64
+#define SOFTWARE_VERTEX_GRAIN 16384
+#define SOFTWARE_TRIANGLE_GRAIN 16384
+#define SOFTWARE_VARYINGS 9
+#define SOFTWARE_MIN_W 1e-5f
+
+class Object;
+
+/**
+ * @brief Vertex after the vertex stage: clip position and the outputs of vertex.glsl.
+ */
+struct SoftwareVertex {
+    std::array<float, 4> clip;
+    // uv, normal, view direction, occlusion
+    std::array<float, SOFTWARE_VARYINGS> varyings;
+    std::array<float, 3> color;
+};
+
+/**
+ * @brief Triangle set up for rasterization.
+ *
+ * Holds the three edge functions in screen space (positive inside), and the
+ * depth, 1/w and varyings/w at vertex 0 with their differences towards
+ * vertices 1 and 2, interpolated with the barycentric weights.
+ */
+struct SoftwareTriangle {
+    std::array<float, 3> edgeA, edgeB, edgeC;
+    std::array<bool, 3> topLeft;
+    float inverseArea;
+    std::array<float, 3> depth;
+    std::array<float, 3> inverseW;
+    std::array<std::array<float, SOFTWARE_VARYINGS>, 3> varyings;
+    std::array<float, 3> color;
+    int minX, minY, maxX, maxY;
+};
+
+/**
+ * @brief CPU implementation of the vertex.glsl / fragment.glsl pipeline.
+ *
+ * Renders into its own color and depth buffers without any GL context, for
+ * machines without a usable driver. Vertices are transformed in parallel;
+ * triangles are clipped against the near and far planes, set up and binned
+ * into SOFTWARE_TILE_SIZE square tiles in parallel blocks, and every tile is
+ * then rasterized by one worker with SSE half-space tests (4 pixels at a
+ * time) and early depth test. Varyings are interpolated perspective
+ * correctly, textures are sampled bilinearly with mirrored repeat and
+ * shading follows fragment.glsl (ambient, diffuse and Blinn-Phong
+ * specular). Triangles are binned in submission order, so the image does
+ * not depend on the thread count. `setLights()` replaces the light of
+ * fragment.glsl with any number of directional lights.
+ */
+class SoftwareRenderer {
+public:
+    static std::unique_ptr<SoftwareRenderer> create(int width, int height);
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer &operator=(const SoftwareRenderer&) = delete;
+    ~SoftwareRenderer() = default;
+
+    void setBackgroundColor(const float red, const float green, const float blue, const float alpha);
+    void clear();
+    bool draw(Object &object, const Image &texture, float colorMix);
+    bool draw(Object &object, const std::array<float, 16> &model, const Image &texture,
+              const MaterialParams &material, float colorMix);
+    void setLights(const std::vector<ShadingLight> &lights);
+    bool writeImage(const std::string &path) const;
+
+    size_t getTriangleCount() const;
+
+private:
+    SoftwareRenderer() = default;
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_stride = 0;
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    std::array<float, 4> m_background = {0.0f, 0.0f, 0.0f, 1.0f};
+    std::vector<uint32_t> m_color;
+    std::vector<float> m_depth;
+    size_t m_triangleCount = 0;
+    std::vector<ShadingLight> m_lights;
+
+    std::vector<SoftwareVertex> m_vertices;
+    std::vector<std::vector<SoftwareTriangle>> m_blockTriangles;
+    std::vector<std::vector<uint32_t>> m_bins;
+
+    bool drawObject(Object &object, const std::array<float, 16> &model, const Image &texture,
+                    const MaterialParams *material, float colorMix);
+    void emitTriangle(const SoftwareVertex &a, const SoftwareVertex &b, const SoftwareVertex &c,
+                      const std::array<float, 3> &color, size_t block);
+    void setupTriangle(const SoftwareVertex &a, const SoftwareVertex &b, const SoftwareVertex &c, size_t block);
+    void rasterizeTile(int tile, size_t blocks, const Image &texture, const MaterialParams &material, float colorMix);
+};
+
+#endif //SCOP_SOFTWARE_RENDERER_HPP
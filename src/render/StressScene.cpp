@@ -0,0 +1,158 @@
+/**
+ * @file StressScene.cpp
+ * @author Patryk
+ * @brief StressScene class implementation
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "StressScene.hpp"
+#include "../core/Camera.hpp"
+#include "../utils/utils.hpp"
+#include "../utils/Vector.hpp"
+
+extern Camera gCamera;
+
+static const char *s_meshes[] = {"teapot.obj", "teapot2.obj", "42.obj"};
+static const char *s_textures[] = {"dog.png", "snowrocks.png", "blue_left.png"};
+
+/**
+ * @brief Uniform float in [min, max) from the generator, the same on every platform.
+ */
+static float uniform(std::mt19937 &random, float min, float max) {
+    return min + (max - min) * static_cast<float>(random() >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Loads the bundled meshes and textures and generates the scene.
+ *
+ * Copies are scattered between STRESS_NEAR and STRESS_FAR in front of the
+ * camera, within its field of view. Lights share a total intensity of one,
+ * so the image stays as bright whatever their count. Materials, copies,
+ * material assignments and lights are drawn from separate streams of the
+ * seed, so changing one count leaves the rest of the scene as it was.
+ * With `settings.mesh`, that model is the only mesh, which changes the
+ * triangle count alone.
+ *
+ * @param settings Seed and counts of the scene.
+ * @return std::unique_ptr<StressScene> The scene, or `nullptr` if a bundled file cannot be loaded.
+ */
+std::unique_ptr<StressScene> StressScene::create(const StressSettings &settings) {
+    std::unique_ptr<StressScene> scene(new StressScene());
+    std::vector<std::string> names(s_meshes, s_meshes + sizeof(s_meshes) / sizeof(s_meshes[0]));
+    if (!settings.mesh.empty())
+        names.assign(1, settings.mesh);
+    for (const std::string &name: names) {
+        std::unique_ptr<Object> mesh = Object::load(STRESS_MESH_PATH + name);
+        if (!mesh)
+            return nullptr;
+        scene->m_meshMatrices.push_back(mesh->getMatrix());
+        scene->m_meshes.push_back(std::move(mesh));
+    }
+    scene->m_textures.resize(sizeof(s_textures) / sizeof(s_textures[0]));
+    for (size_t i = 0; i < scene->m_textures.size(); i++) {
+        const std::string path = std::string(STRESS_TEXTURE_PATH) + s_textures[i];
+        if (!Texture2D::decode(path, scene->m_textures[i])) {
+            fprintf(stderr, "Failed to load texture %s\n", path.c_str());
+            return nullptr;
+        }
+    }
+
+    std::seed_seq materialSeed = {settings.seed, 0u}, instanceSeed = {settings.seed, 1u};
+    std::seed_seq assignmentSeed = {settings.seed, 2u}, lightSeed = {settings.seed, 3u};
+    std::mt19937 random(materialSeed), assignment(assignmentSeed);
+    for (size_t i = 0; i < settings.materials; i++) {
+        StressMaterial material;
+        material.params.name = "stress" + std::to_string(i);
+        material.params.Ns = uniform(random, 8.0f, 128.0f);
+        for (int c = 0; c < 3; c++) {
+            material.params.Ka[c] = uniform(random, 0.6f, 1.0f);
+            material.params.Kd[c] = uniform(random, 0.5f, 1.0f);
+            material.params.Ks[c] = uniform(random, 0.0f, 0.5f);
+            material.params.Ke[c] = 0.0f;
+        }
+        material.params.Ni = 1.0f;
+        material.params.opacity = 1.0f;
+        material.params.illum = 2.0f;
+        material.texture = random() % scene->m_textures.size();
+        scene->m_materials.push_back(material);
+    }
+
+    random.seed(instanceSeed);
+    const std::array<float, 3> eye = gCamera.getPosition();
+    const float halfView = std::tan(22.5f * static_cast<float>(M_PI) / 180.0f);
+    for (size_t i = 0; i < settings.objects; i++) {
+        StressInstance instance;
+        instance.mesh = random() % scene->m_meshes.size();
+        instance.material = assignment() % scene->m_materials.size();
+        const float distance = uniform(random, STRESS_NEAR, STRESS_FAR);
+        instance.position = {eye[0] + uniform(random, -0.8f, 0.8f) * halfView * distance,
+                             eye[1] + uniform(random, -0.8f, 0.8f) * halfView * distance,
+                             eye[2] - distance};
+        instance.scale = uniform(random, 0.3f, 0.8f);
+        instance.angle = uniform(random, 0.0f, 2.0f * static_cast<float>(M_PI));
+        instance.spin = uniform(random, -1.0f, 1.0f);
+        scene->m_instances.push_back(instance);
+    }
+
+    random.seed(lightSeed);
+    for (size_t i = 0; i < settings.lights; i++) {
+        ShadingLight light;
+        light.direction = normalizeVec({uniform(random, -1.0f, 1.0f), uniform(random, -0.2f, 1.0f),
+                                        uniform(random, 0.3f, 1.0f)});
+        for (int c = 0; c < 3; c++)
+            light.color[c] = uniform(random, 0.6f, 1.0f) / settings.lights;
+        scene->m_lights.push_back(light);
+    }
+
+    printf("Stress scene: seed %u, %zu objects of %zu meshes, %zu materials, %zu textures, %zu lights, "
+           "%zu triangles per frame\n", settings.seed, scene->m_instances.size(), scene->m_meshes.size(),
+           scene->m_materials.size(), scene->m_textures.size(), scene->m_lights.size(), scene->getTriangleCount());
+    return scene;
+}
+
+/**
+ * @brief Turns every copy around its vertical axis at its own speed.
+ * @param deltaTime Elapsed time in seconds.
+ */
+void StressScene::update(float deltaTime) {
+    for (StressInstance &instance: m_instances)
+        instance.angle += instance.spin * deltaTime;
+}
+
+/**
+ * @brief Draws every copy with its transform, material and texture, lit by the scene's lights.
+ * @param renderer Software renderer, cleared by the caller.
+ * @return bool false if a draw failed.
+ */
+bool StressScene::draw(SoftwareRenderer &renderer) {
+    renderer.setLights(m_lights);
+    for (const StressInstance &instance: m_instances) {
+        std::array<float, 16> model = multiplyMatrix(m_meshMatrices[instance.mesh],
+                                                     getRotationMatrixY(instance.angle));
+        model = scaleMatrix(model, instance.scale);
+        model = translateMatrix(model, instance.position[0], instance.position[1], instance.position[2]);
+        const StressMaterial &material = m_materials[instance.material];
+        if (!renderer.draw(*m_meshes[instance.mesh], model, m_textures[material.texture], material.params, 0.0f))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Triangles submitted per frame, before clipping.
+ */
+size_t StressScene::getTriangleCount() const {
+    size_t triangles = 0;
+    for (const StressInstance &instance: m_instances)
+        triangles += m_meshes[instance.mesh]->getIndices().size() / 3;
+    return triangles;
+}
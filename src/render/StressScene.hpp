@@ -0,0 +1,105 @@
+/**
+ * @file StressScene.hpp
+ * @author Patryk
+ * @brief StressScene class declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_STRESS_SCENE_HPP
+#define SCOP_STRESS_SCENE_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../core/Object.hpp"
+#include "../textures/Material.hpp"
+#include "../textures/Texture2D.hpp"
+#include "Shading.hpp"
+#include "SoftwareRenderer.hpp"
+
+#define STRESS_DEFAULT_OBJECTS 64
+#define STRESS_DEFAULT_MATERIALS 8
+#define STRESS_DEFAULT_LIGHTS 1
+#define STRESS_MAX_COUNT 65536
+#define STRESS_MESH_PATH "res/objects/"
+#define STRESS_TEXTURE_PATH "res/textures/"
+// Distance range from the camera where copies are scattered
+#define STRESS_NEAR 1.5f
+#define STRESS_FAR 8.0f
+
+/**
+ * @brief Parameters of a generated StressScene; the same settings always give the same scene.
+ */
+struct StressSettings {
+    uint32_t seed = 1;
+    size_t objects = STRESS_DEFAULT_OBJECTS;
+    size_t materials = STRESS_DEFAULT_MATERIALS;
+    size_t lights = STRESS_DEFAULT_LIGHTS;
+    // Model of STRESS_MESH_PATH every copy is made of; empty for the default mix
+    std::string mesh;
+};
+
+/**
+ * @brief Generated material: random Phong parameters and one of the bundled textures.
+ */
+struct StressMaterial {
+    MaterialParams params;
+    size_t texture;
+};
+
+/**
+ * @brief One copy of a bundled mesh in the scene.
+ */
+struct StressInstance {
+    size_t mesh;
+    size_t material;
+    std::array<float, 3> position;
+    float scale;
+    float angle;
+    float spin;
+};
+
+/**
+ * @brief Scene of many copies of the bundled meshes, generated from a seed to measure how rendering scales.
+ *
+ * Each bundled mesh and texture is loaded once. The generator then draws
+ * `materials` random materials and `objects` copies, each of a random
+ * mesh with a random material, position inside the view of the default
+ * camera, size, orientation and spin, and `lights` directional lights of
+ * random direction and color. Drawn with the software renderer, each copy
+ * is one `SoftwareRenderer::draw()` call, so the frame time can be
+ * measured against the object, material and light counts independently,
+ * and against the triangle count by making every copy of one bundled mesh
+ * of the wanted density (`mesh`).
+ */
+class StressScene {
+public:
+    static std::unique_ptr<StressScene> create(const StressSettings &settings);
+    StressScene(const StressScene&) = delete;
+    StressScene &operator=(const StressScene&) = delete;
+    ~StressScene() = default;
+
+    void update(float deltaTime);
+    bool draw(SoftwareRenderer &renderer);
+
+    size_t getTriangleCount() const;
+
+private:
+    StressScene() = default;
+
+    std::vector<std::unique_ptr<Object>> m_meshes;
+    std::vector<std::array<float, 16>> m_meshMatrices;
+    std::vector<Image> m_textures;
+    std::vector<StressMaterial> m_materials;
+    std::vector<StressInstance> m_instances;
+    std::vector<ShadingLight> m_lights;
+};
+
+#endif //SCOP_STRESS_SCENE_HPP
@@ -14,6 +14,7 @@
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include "../io/Asset.hpp"
 
 /**
  * @brief Creates a material from a file.
@@ -30,6 +31,15 @@ std::unique_ptr<Material> Material::create(const std::string &filePath) {
     return mat;
 }
 
+/**
+ * @brief Creates a material from already known parameters, e.g. read from a glTF file.
+ */
+std::unique_ptr<Material> Material::create(const MaterialParams &params) {
+    std::unique_ptr<Material> mat = std::unique_ptr<Material>(new Material());
+    mat->m_params = params;
+    return mat;
+}
+
 Material::Material(Material &&other) noexcept : m_params(std::move(other.m_params)) {
 }
 
@@ -53,18 +63,23 @@ void Material::apply(Shader &shader) {
     shader.setFloat("uNs", m_params.Ns);
 }
 
+const MaterialParams &Material::getParams() const {
+    return m_params;
+}
+
 /**
  * @brief Parses an MTL material file.
  *
- * Reads material parameters from the given file and fills the
- * MaterialParams structure. Returns false if the file cannot be opened.
+ * Reads material parameters from the given file (loose or packed) and fills
+ * the MaterialParams structure. Returns false if the file cannot be opened.
  */
 bool Material::parseFile(const std::string &filePath) {
-    std::ifstream file(filePath);
-    if (!file) {
+    const std::unique_ptr<Asset> asset = Asset::load(filePath);
+    if (!asset) {
         fprintf(stderr, "Failed to open material file %s\n", filePath.c_str());
         return false;
     }
+    AssetStream file(*asset);
 
     std::string line;
     while (getline(file, line)) {
@@ -49,7 +49,9 @@ public:
     Material &operator=(Material &&other) noexcept;
 
     static std::unique_ptr<Material> create(const std::string &filePath);
+    static std::unique_ptr<Material> create(const MaterialParams &params);
     void apply(Shader &shader);
+    const MaterialParams &getParams() const;
 
 private:
     MaterialParams m_params;
@@ -11,12 +11,12 @@
 
 #include <GL/glew.h>
 #include "Texture2D.hpp"
+#include "../io/Asset.hpp"
 
 /**
  * @brief Loads an image from a file and creates a 2D OpenGL texture.
  *
- * This static function creates a new Texture2D object, loads the image from the specified file
- * using stb_image, uploads it to the GPU, sets wrapping and filtering options, and generates mipmaps.
+ * Decodes the image with `decode()` and uploads it with `create(const Image &)`.
  * If the image fails to load, the function returns `nullptr`.
  *
  * @param path Path to the texture image file.
@@ -27,14 +27,34 @@
  * @return std::shared_ptr<Texture2D> Shared pointer to the loaded texture, or `nullptr` if loading failed.
  */
 std::shared_ptr<Texture2D> Texture2D::create(const std::string &path, unsigned int wrapS, unsigned int wrapT, unsigned int minFilter, unsigned int magFilter) {
-    std::shared_ptr<Texture2D> texture = std::make_shared<Texture2D>();
-    texture->m_path = path;
+    Image image;
+    if (!decode(path, image))
+        return nullptr;
+    return create(image, wrapS, wrapT, minFilter, magFilter);
+}
 
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char *data = stbi_load(texture->m_path.c_str(), &texture->m_width, &texture->m_height, &texture->m_nrChannels, 0);
-    if (!data)
+/**
+ * @brief Creates a 2D OpenGL texture from an already decoded image.
+ *
+ * Uploads the pixels to the GPU, sets wrapping and filtering options, and generates mipmaps.
+ *
+ * @param image Decoded image.
+ * @param wrapS Wrapping mode for the S (X) coordinate. Default: GL_MIRRORED_REPEAT.
+ * @param wrapT Wrapping mode for the T (Y) coordinate. Default: GL_MIRRORED_REPEAT.
+ * @param minFilter Minification filter. Default: GL_LINEAR_MIPMAP_LINEAR.
+ * @param magFilter Magnification filter. Default: GL_LINEAR.
+ * @return std::shared_ptr<Texture2D> Shared pointer to the texture, or `nullptr` if the image holds no pixels.
+ */
+std::shared_ptr<Texture2D> Texture2D::create(const Image &image, unsigned int wrapS, unsigned int wrapT, unsigned int minFilter, unsigned int magFilter) {
+    if (!image.pixels)
         return nullptr;
 
+    std::shared_ptr<Texture2D> texture = std::make_shared<Texture2D>();
+    texture->m_path = image.path;
+    texture->m_width = image.width;
+    texture->m_height = image.height;
+    texture->m_nrChannels = image.nrChannels;
+
     glGenTextures(1, &texture->m_id);
     glBindTexture(GL_TEXTURE_2D, texture->m_id);
 
@@ -45,13 +65,48 @@ std::shared_ptr<Texture2D> Texture2D::create(const std::string &path, unsigned i
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
 
     const unsigned int format = (texture->m_nrChannels == 4) ? GL_RGBA : GL_RGB;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, texture->m_width, texture->m_height, 0, format, GL_UNSIGNED_BYTE, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, texture->m_width, texture->m_height, 0, format, GL_UNSIGNED_BYTE, image.pixels.get());
     glGenerateMipmap(GL_TEXTURE_2D);
 
-    stbi_image_free(data);
     return texture;
 }
 
+/**
+ * @brief Decodes an image file into CPU memory.
+ *
+ * The file is resolved through `Asset::load()` (loose or packed) and
+ * decoded with stb_image, flipped vertically for OpenGL. No GL calls are
+ * made, so this function is safe to call from worker threads.
+ *
+ * @param path Path to the image file.
+ * @param image Output image.
+ * @return bool true if the image was decoded.
+ */
+bool Texture2D::decode(const std::string &path, Image &image) {
+    const std::unique_ptr<Asset> asset = Asset::load(path);
+    if (!asset)
+        return false;
+
+    return decode(path, asset->data(), asset->size(), image);
+}
+
+/**
+ * @brief Decodes an image held in memory, e.g. embedded in a model file.
+ * @param name Name stored as the image path.
+ * @param data Encoded image bytes.
+ * @param size Size of the encoded image in bytes.
+ * @param image Output image.
+ * @param flipVertically Flip rows for OpenGL's bottom-left origin; false for formats such as glTF whose UVs start at the top.
+ * @return bool true if the image was decoded.
+ */
+bool Texture2D::decode(const std::string &name, const char *data, size_t size, Image &image, bool flipVertically) {
+    image.path = name;
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    image.pixels.reset(stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(data), static_cast<int>(size),
+                                             &image.width, &image.height, &image.nrChannels, 0));
+    return image.pixels != nullptr;
+}
+
 Texture2D::Texture2D(Texture2D &&other) noexcept : m_id(other.m_id),
                                                    m_path(std::move(other.m_path)),
                                                    m_width(other.m_width),
@@ -17,6 +17,29 @@
 #include <memory>
 #include <GL/glew.h>
 
+/**
+ * @brief Releases pixel data allocated by stb_image.
+ */
+struct ImagePixelsDeleter {
+    void operator()(unsigned char *pixels) const { stbi_image_free(pixels); }
+};
+
+/**
+ * @brief Decoded image kept in CPU memory, ready to be uploaded as a texture.
+ *
+ * Decoding does not require an OpenGL context, so images can be prepared
+ * on worker threads and turned into textures later on the main thread.
+ */
+struct Image {
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int nrChannels = 0;
+    std::unique_ptr<unsigned char, ImagePixelsDeleter> pixels;
+
+    size_t getMemoryUsage() const { return static_cast<size_t>(width) * height * nrChannels; }
+};
+
 /**
  * @brief Wraps a 2D texture in OpenGL.
  *
@@ -31,6 +54,13 @@ public:
               unsigned int wrapT = GL_MIRRORED_REPEAT,
               unsigned int minFilter = GL_LINEAR_MIPMAP_LINEAR,
               unsigned int magFilter = GL_LINEAR);
+    static std::shared_ptr<Texture2D> create(const Image &image,
+              unsigned int wrapS = GL_MIRRORED_REPEAT,
+              unsigned int wrapT = GL_MIRRORED_REPEAT,
+              unsigned int minFilter = GL_LINEAR_MIPMAP_LINEAR,
+              unsigned int magFilter = GL_LINEAR);
+    static bool decode(const std::string &path, Image &image);
+    static bool decode(const std::string &name, const char *data, size_t size, Image &image, bool flipVertically = true);
     Texture2D(const Texture2D &other) = delete;
     Texture2D(Texture2D &&other) noexcept;
 
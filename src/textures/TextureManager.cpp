@@ -80,6 +80,50 @@ std::shared_ptr<Texture2D> TextureManager::loadTexture2D(const std::string &path
     return tex;
 }
 
+/**
+ * @brief Creates a 2D texture from a decoded image or returns the existing one.
+ *
+ * Same as the path-based overload, but the image has already been decoded
+ * (typically on a worker thread), so only the GPU upload happens here.
+ *
+ * @param image Decoded image; its path is used as the texture key.
+ * @param wrapS Wrapping mode for the S (X) coordinate. Default: GL_MIRRORED_REPEAT.
+ * @param wrapT Wrapping mode for the T (Y) coordinate. Default: GL_MIRRORED_REPEAT.
+ * @param minFilter Minification filter. Default: GL_LINEAR_MIPMAP_LINEAR.
+ * @param magFilter Magnification filter. Default: GL_LINEAR.
+ * @return std::shared_ptr<Texture2D> Shared pointer to the texture, or `nullptr` if creation failed.
+ */
+std::shared_ptr<Texture2D> TextureManager::loadTexture2D(const Image &image, unsigned int wrapS, unsigned int wrapT, unsigned int minFilter, unsigned int magFilter) {
+    auto it = m_textures2D.find(image.path);
+    if (it != m_textures2D.end()) return it->second;
+
+    auto tex = Texture2D::create(image, wrapS, wrapT, minFilter, magFilter);
+    if (!tex) {
+        fprintf(stderr, "Failed to load texture: %s\n", image.path.c_str());
+        return nullptr;
+    }
+    m_textures2D[image.path] = tex;
+    m_slots[image.path] = m_nextSlot;
+    m_nextSlot++;
+    return tex;
+}
+
+/**
+ * @brief Drops the manager's reference to a texture.
+ *
+ * The GPU texture is released once no object holds it anymore.
+ *
+ * @param path Path of the texture to unload.
+ */
+void TextureManager::unloadTexture2D(const std::string &path) {
+    m_textures2D.erase(path);
+    m_slots.erase(path);
+}
+
+bool TextureManager::hasTexture2D(const std::string &path) const {
+    return m_textures2D.find(path) != m_textures2D.end();
+}
+
 /**
  * @brief Returns the GPU slot assigned to a texture.
  *
@@ -92,7 +136,7 @@ std::shared_ptr<Texture2D> TextureManager::loadTexture2D(const std::string &path
 unsigned int TextureManager::getSlot(const std::string &path) {
     auto it = m_slots.find(path);
     if (it != m_slots.end()) {
-        return it->second;
+        return it->second % m_maxSlots;
     }
     fprintf(stderr, "Warning: texture %s not found, returning slot 0!\n", path.c_str());
     return 0;
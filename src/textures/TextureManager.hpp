@@ -38,6 +38,12 @@ public:
               unsigned int wrapT = GL_MIRRORED_REPEAT,
               unsigned int minFilter = GL_LINEAR_MIPMAP_LINEAR,
               unsigned int magFilter = GL_LINEAR);
+    std::shared_ptr<Texture2D> loadTexture2D(const Image &image, unsigned int wrapS = GL_MIRRORED_REPEAT,
+              unsigned int wrapT = GL_MIRRORED_REPEAT,
+              unsigned int minFilter = GL_LINEAR_MIPMAP_LINEAR,
+              unsigned int magFilter = GL_LINEAR);
+    void unloadTexture2D(const std::string &path);
+    bool hasTexture2D(const std::string &path) const;
 
     void bindTexture(const std::string &path);
     unsigned int getSlot(const std::string &path);
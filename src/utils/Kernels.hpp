@@ -0,0 +1,68 @@
+/**
+ * @file Kernels.hpp
+ * @author Patryk
+ * @brief Hot loops built per instruction set and selected at startup
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_KERNELS_HPP
+#define SCOP_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../core/Packing.hpp"
+
+// Environment variable forcing an instruction set: sse2, avx2 or avx512
+#define KERNEL_ISA_ENV "SCOP_ISA"
+// Floats per Vertex, and offsets of its members
+#define KERNEL_VERTEX_FLOATS 8
+#define KERNEL_VERTEX_UV 3
+#define KERNEL_VERTEX_NORMAL 5
+
+/**
+ * @brief Instruction sets the kernels are built for, from the x86-64 baseline up.
+ */
+enum KernelIsa {
+    KERNEL_ISA_SSE2 = 0,
+    KERNEL_ISA_AVX2,
+    KERNEL_ISA_AVX512,
+    KERNEL_ISA_COUNT
+};
+
+/**
+ * @brief Entry points of one build of the kernels.
+ *
+ * The same source (KernelsImpl.hpp) is compiled by kernels_sse2.cpp,
+ * kernels_avx2.cpp and kernels_avx512.cpp with -O3 and that instruction
+ * set enabled, so the compiler can vectorize it; `getKernels()` picks
+ * the best build the CPU supports. All builds give bit-identical results.
+ * Vertex arrays are passed as floats, KERNEL_VERTEX_FLOATS per vertex.
+ */
+struct KernelTable {
+    // out = a * b, 4x4 row-major
+    void (*multiplyMatrix)(const float *a, const float *b, float *out);
+    // Per-member sums, minimums and maximums of KERNEL_VERTEX_FLOATS floats over `count` vertices
+    void (*accumulateBounds)(const float *vertices, size_t count, float *sum, float *min, float *max);
+    // Unit normal of each triangle, 3 floats per triangle, zero for degenerate ones
+    void (*computeFaceNormals)(const float *vertices, const unsigned int *indices, size_t triangleCount,
+                               float *normals);
+    void (*packVertices)(const float *vertices, size_t count, PackedVertex *packed);
+    // RGBA8 pixels (red in the lowest byte) to RGB8, dropping alpha
+    void (*convertRgbaToRgb)(const uint32_t *pixels, size_t count, unsigned char *rgb);
+};
+
+const KernelTable &getKernels();
+KernelIsa getKernelIsa();
+const char *getKernelIsaName(KernelIsa isa);
+
+// Defined by kernels_<isa>.cpp; nullptr when the compiler could not target that instruction set
+const KernelTable *getSse2Kernels();
+const KernelTable *getAvx2Kernels();
+const KernelTable *getAvx512Kernels();
+
+#endif //SCOP_KERNELS_HPP
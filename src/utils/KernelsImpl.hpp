@@ -0,0 +1,116 @@
+/**
+ * @file KernelsImpl.hpp
+ * @author Patryk
+ * @brief Kernel bodies, compiled once per instruction set
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+// No include guard: each kernels_<isa>.cpp includes this once, with its own
+// compiler flags. Everything is in an anonymous namespace and only calls C
+// functions, builtins and static helpers, so no inline function built for a
+// wider instruction set can be shared with the rest of the program by the
+// linker. Loops keep the summation order of the scalar code, so the results
+// do not depend on the instruction set (the Makefile also disables FMA
+// contraction for these files).
+
+#include <cmath>
+#include <cstring>
+
+#include "Kernels.hpp"
+#include "../core/PackingMath.hpp"
+
+namespace {
+
+void multiplyMatrix(const float *a, const float *b, float *out) {
+    for (int row = 0; row < 4; row++) {
+        float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int k = 0; k < 4; k++) {
+            for (int col = 0; col < 4; col++)
+                result[col] += a[row * 4 + k] * b[k * 4 + col];
+        }
+        for (int col = 0; col < 4; col++)
+            out[row * 4 + col] = result[col];
+    }
+}
+
+// Works on every float of the vertex rather than on the position only, so
+// one vertex fills one 256-bit register
+void accumulateBounds(const float *vertices, size_t count, float *sum, float *min, float *max) {
+    float s[KERNEL_VERTEX_FLOATS], lo[KERNEL_VERTEX_FLOATS], hi[KERNEL_VERTEX_FLOATS];
+    for (int k = 0; k < KERNEL_VERTEX_FLOATS; k++) {
+        s[k] = sum[k];
+        lo[k] = min[k];
+        hi[k] = max[k];
+    }
+    for (size_t i = 0; i < count; i++) {
+        const float *v = vertices + i * KERNEL_VERTEX_FLOATS;
+        for (int k = 0; k < KERNEL_VERTEX_FLOATS; k++) {
+            s[k] += v[k];
+            lo[k] = v[k] < lo[k] ? v[k] : lo[k];
+            hi[k] = v[k] > hi[k] ? v[k] : hi[k];
+        }
+    }
+    for (int k = 0; k < KERNEL_VERTEX_FLOATS; k++) {
+        sum[k] = s[k];
+        min[k] = lo[k];
+        max[k] = hi[k];
+    }
+}
+
+void computeFaceNormals(const float *vertices, const unsigned int *indices, size_t triangleCount, float *normals) {
+    for (size_t t = 0; t < triangleCount; t++) {
+        const float *v0 = vertices + static_cast<size_t>(indices[t * 3]) * KERNEL_VERTEX_FLOATS;
+        const float *v1 = vertices + static_cast<size_t>(indices[t * 3 + 1]) * KERNEL_VERTEX_FLOATS;
+        const float *v2 = vertices + static_cast<size_t>(indices[t * 3 + 2]) * KERNEL_VERTEX_FLOATS;
+        const float ax = v1[0] - v0[0], ay = v1[1] - v0[1], az = v1[2] - v0[2];
+        const float bx = v2[0] - v0[0], by = v2[1] - v0[1], bz = v2[2] - v0[2];
+        const float x = (ay * bz) - (az * by);
+        const float y = (az * bx) - (ax * bz);
+        const float z = (ax * by) - (bx * ay);
+        const float length = sqrtf((x * x) + (y * y) + (z * z));
+        // Branch-free form of normalizeVec(): zero for a zero-length normal
+        const float keep = length == 0.0f ? 0.0f : 1.0f;
+        const float divisor = length == 0.0f ? 1.0f : length;
+        normals[t * 3] = (x * keep) / divisor;
+        normals[t * 3 + 1] = (y * keep) / divisor;
+        normals[t * 3 + 2] = (z * keep) / divisor;
+    }
+}
+
+void packVertices(const float *vertices, size_t count, PackedVertex *packed) {
+    for (size_t i = 0; i < count; i++) {
+        const float *v = vertices + i * KERNEL_VERTEX_FLOATS;
+        PackedVertex &out = packed[i];
+        out.position[0] = v[0];
+        out.position[1] = v[1];
+        out.position[2] = v[2];
+        out.uv = halfFromFloat(v[KERNEL_VERTEX_UV]) |
+                 static_cast<uint32_t>(halfFromFloat(v[KERNEL_VERTEX_UV + 1])) << 16;
+        float octahedral[2];
+        octahedralFromNormal(v + KERNEL_VERTEX_NORMAL, octahedral);
+        out.normal = snorm16FromFloat(octahedral[0]) | snorm16FromFloat(octahedral[1]) << 16;
+    }
+}
+
+void convertRgbaToRgb(const uint32_t *pixels, size_t count, unsigned char *rgb) {
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t pixel = pixels[i];
+        rgb[i * 3] = pixel & 0xFF;
+        rgb[i * 3 + 1] = (pixel >> 8) & 0xFF;
+        rgb[i * 3 + 2] = (pixel >> 16) & 0xFF;
+    }
+}
+
+const KernelTable s_kernels = {
+    multiplyMatrix,
+    accumulateBounds,
+    computeFaceNormals,
+    packVertices,
+    convertRgbaToRgb
+};
+
+}
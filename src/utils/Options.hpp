@@ -0,0 +1,67 @@
+/**
+ * @file Options.hpp
+ * @author Patryk
+ * @brief Command line options declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_OPTIONS_HPP
+#define SCOP_OPTIONS_HPP
+
+#include <string>
+#include <vector>
+
+#include "../core/Playlist.hpp"
+#include "../core/Sequence.hpp"
+#include "../core/ChunkStreamer.hpp"
+#include "../core/AmbientOcclusion.hpp"
+#include "../core/Weld.hpp"
+#include "../render/RayTracer.hpp"
+#include "../render/StressScene.hpp"
+#include "../graphics/VisibilityBuffer.hpp"
+#include "../graphics/Impostor.hpp"
+
+/**
+ * @brief Settings parsed from the command line.
+ */
+struct Options {
+    std::string objPath;
+    std::string texturePath;
+    std::vector<std::string> packPaths;
+    std::string playlistSource;
+    PlaylistSettings playlist;
+    std::string sequenceSource;
+    SequenceSettings sequence;
+    bool watch = false;
+    bool progressive = false;
+    bool chunked = false;
+    ChunkSettings chunks;
+    float weldTolerance = WELD_DEFAULT_TOLERANCE;
+    bool cleanup = true;
+    size_t occlusionRays = 0;
+    bool textured = false;
+    std::string softwareOutput;
+    bool stress = false;
+    StressSettings stressScene;
+    size_t frames = 1;
+    std::string raytraceOutput;
+    size_t samples = RAYTRACE_DEFAULT_SAMPLES;
+    bool adjacency = false;
+    std::string encodeOutput;
+    bool vertexPulling = false;
+    bool visibilityBuffer = false;
+    size_t instances = 1;
+    bool impostors = false;
+    float impostorDistance = IMPOSTOR_DEFAULT_DISTANCE;
+    bool gpuCompute = false;
+    bool persistentMapping = true;
+};
+
+bool parseOptions(int argc, char **argv, Options &options);
+void printUsage();
+
+#endif //SCOP_OPTIONS_HPP
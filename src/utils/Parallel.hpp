@@ -0,0 +1,21 @@
+/**
+ * @file Parallel.hpp
+ * @author Patryk
+ * @brief Parallel loop helpers declaration
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_PARALLEL_HPP
+#define SCOP_PARALLEL_HPP
+
+#include <cstddef>
+#include <functional>
+
+unsigned int getWorkerCount();
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body);
+
+#endif //SCOP_PARALLEL_HPP
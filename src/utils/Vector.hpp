@@ -0,0 +1,24 @@
+/**
+ * @file Vector.hpp
+ * @author Patryk
+ * @brief 3D vector operations, usable without OpenGL
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCOP_VECTOR_HPP
+#define SCOP_VECTOR_HPP
+
+#include <array>
+
+std::array<float, 3> subtractVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
+std::array<float, 3> addVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
+std::array<float, 3> normalizeVec(const std::array<float, 3> &vec);
+std::array<float, 3> crossProdVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
+float dotProdVec(const std::array<float, 3>& a, const std::array<float, 3>& b);
+std::array<float, 3> multiplyVecByFloat(const std::array<float, 3> &vec, float x);
+
+#endif //SCOP_VECTOR_HPP
@@ -13,19 +13,22 @@
 #include <GLFW/glfw3.h>
 #include "../core/Camera.hpp"
 #include "../core/Object.hpp"
+#include "../core/Playlist.hpp"
 #include "../render/Renderer.hpp"
 
 extern Camera gCamera;
+extern std::unique_ptr<Playlist> gPlaylist;
 
 static void changeModes(GLFWwindow *window, Renderer &renderer);
+static void switchModel(GLFWwindow *window, std::unique_ptr<Object> &object);
 static void moveObject(GLFWwindow *window, std::unique_ptr<Object> &object, double deltaTime);
 static void moveCamera(GLFWwindow *window, double deltaTime);
 
 /**
  * @brief Processes all input for the current frame.
  *
- * Handles closing the window, changing rendering modes, moving the object,
- * and moving the camera based on key presses.
+ * Handles closing the window, changing rendering modes, switching playlist
+ * models, moving the object, and moving the camera based on key presses.
  *
  * @param window Pointer to the GLFW window.
  * @param object Reference to the object being controlled.
@@ -38,6 +41,7 @@ void processInput(GLFWwindow *window, std::unique_ptr<Object> &object, Renderer
         glfwSetWindowShouldClose(window, true);
 
     changeModes(window, renderer);
+    switchModel(window, object);
     moveObject(window, object, deltaTime);
     moveCamera(window, deltaTime);
 }
@@ -45,7 +49,9 @@ void processInput(GLFWwindow *window, std::unique_ptr<Object> &object, Renderer
 /**
  * @brief Handles toggling polygon and color modes.
  *
- * Toggles wireframe/solid polygon mode with 'P' and switches color mode with 'T'.
+ * Toggles wireframe/solid polygon mode with 'P', switches color mode with 'T',
+ * vertex attributes/vertex pulling with 'V', forward/visibility buffer
+ * shading with 'B' and impostors with 'I'.
  * Ensures mode changes only occur once per key press.
  *
  * @param window Pointer to the GLFW window.
@@ -54,9 +60,15 @@ void processInput(GLFWwindow *window, std::unique_ptr<Object> &object, Renderer
 static void changeModes(GLFWwindow *window, Renderer &renderer) {
     static bool pWasPressed = false;
     static bool tWasPressed = false;
+    static bool vWasPressed = false;
+    static bool bWasPressed = false;
+    static bool iWasPressed = false;
 
     const bool pIsPressed = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
     const bool tIsPressed = glfwGetKey(window, GLFW_KEY_T) == GLFW_PRESS;
+    const bool vIsPressed = glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS;
+    const bool bIsPressed = glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS;
+    const bool iIsPressed = glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS;
 
     if (pIsPressed && !pWasPressed)
         renderer.switchPolygonMode();
@@ -65,6 +77,46 @@ static void changeModes(GLFWwindow *window, Renderer &renderer) {
     if (tIsPressed && !tWasPressed)
         renderer.toggleColorMode();
     tWasPressed = tIsPressed;
+
+    if (vIsPressed && !vWasPressed)
+        renderer.toggleVertexPulling();
+    vWasPressed = vIsPressed;
+
+    if (bIsPressed && !bWasPressed)
+        renderer.toggleVisibilityBuffer();
+    bWasPressed = bIsPressed;
+
+    if (iIsPressed && !iWasPressed)
+        renderer.toggleImpostors();
+    iWasPressed = iIsPressed;
+}
+
+/**
+ * @brief Switches to the next or previous playlist model.
+ *
+ * ']' selects the next model and '[' the previous one. Does nothing
+ * outside playlist mode. Ensures a switch only occurs once per key press.
+ *
+ * @param window Pointer to the GLFW window.
+ * @param object Reference to the displayed object, replaced on switch.
+ */
+static void switchModel(GLFWwindow *window, std::unique_ptr<Object> &object) {
+    static bool nextWasPressed = false;
+    static bool previousWasPressed = false;
+
+    if (!gPlaylist)
+        return;
+
+    const bool nextIsPressed = glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS;
+    const bool previousIsPressed = glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS;
+
+    if (nextIsPressed && !nextWasPressed)
+        gPlaylist->next(object);
+    nextWasPressed = nextIsPressed;
+
+    if (previousIsPressed && !previousWasPressed)
+        gPlaylist->previous(object);
+    previousWasPressed = previousIsPressed;
 }
 
 /**
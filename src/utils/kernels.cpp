@@ -0,0 +1,99 @@
+/**
+ * @file kernels.cpp
+ * @author Patryk
+ * @brief Selection of the kernel build matching the CPU
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "Kernels.hpp"
+
+static const char *s_isaNames[KERNEL_ISA_COUNT] = {"sse2", "avx2", "avx512"};
+
+/**
+ * @brief Returns the widest instruction set both the CPU and the operating system support.
+ */
+static KernelIsa detectIsa() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq"))
+        return KERNEL_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return KERNEL_ISA_AVX2;
+#endif
+    return KERNEL_ISA_SSE2;
+}
+
+static const KernelTable *getBuild(KernelIsa isa) {
+    switch (isa) {
+        case KERNEL_ISA_AVX512:
+            return getAvx512Kernels();
+        case KERNEL_ISA_AVX2:
+            return getAvx2Kernels();
+        default:
+            return getSse2Kernels();
+    }
+}
+
+/**
+ * @brief Picks the kernel build, once: the best one the CPU runs, or the one named by KERNEL_ISA_ENV.
+ *
+ * A forced instruction set the CPU lacks, or that the compiler could not
+ * build, falls back to the next narrower one with a warning.
+ */
+static KernelIsa selectIsa() {
+    const KernelIsa supported = detectIsa();
+    KernelIsa isa = supported;
+    const char *forced = getenv(KERNEL_ISA_ENV);
+    if (forced && forced[0]) {
+        int index = 0;
+        while (index < KERNEL_ISA_COUNT && strcmp(forced, s_isaNames[index]) != 0)
+            index++;
+        if (index == KERNEL_ISA_COUNT) {
+            fprintf(stderr, "%s: unknown instruction set '%s', expected sse2, avx2 or avx512\n", KERNEL_ISA_ENV,
+                    forced);
+        } else if (index > supported) {
+            fprintf(stderr, "%s: this CPU does not support %s, using %s\n", KERNEL_ISA_ENV, forced,
+                    s_isaNames[supported]);
+        } else {
+            isa = static_cast<KernelIsa>(index);
+        }
+    }
+    while (isa > KERNEL_ISA_SSE2 && !getBuild(isa)) {
+        const KernelIsa narrower = static_cast<KernelIsa>(isa - 1);
+        fprintf(stderr, "Kernels were not built for %s, using %s\n", s_isaNames[isa], s_isaNames[narrower]);
+        isa = narrower;
+    }
+    return isa;
+}
+
+/**
+ * @brief Returns the instruction set the kernels run with, selected on first use.
+ */
+KernelIsa getKernelIsa() {
+    static const KernelIsa isa = selectIsa();
+    return isa;
+}
+
+/**
+ * @brief Returns the kernel build selected for this CPU, see `getKernelIsa()`.
+ */
+const KernelTable &getKernels() {
+    static const KernelTable *kernels = getBuild(getKernelIsa());
+    return *kernels;
+}
+
+/**
+ * @brief Returns the name of an instruction set, as accepted by KERNEL_ISA_ENV.
+ */
+const char *getKernelIsaName(KernelIsa isa) {
+    return isa < KERNEL_ISA_COUNT ? s_isaNames[isa] : "unknown";
+}
@@ -0,0 +1,28 @@
+/**
+ * @file kernels_avx2.cpp
+ * @author Patryk
+ * @brief AVX2 build of the kernels
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Kernels.hpp"
+
+#ifdef __AVX2__
+
+#include "KernelsImpl.hpp"
+
+const KernelTable *getAvx2Kernels() {
+    return &s_kernels;
+}
+
+#else
+
+const KernelTable *getAvx2Kernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * @file kernels_avx512.cpp
+ * @author Patryk
+ * @brief AVX-512 build of the kernels
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "Kernels.hpp"
+
+#ifdef __AVX512F__
+
+#include "KernelsImpl.hpp"
+
+const KernelTable *getAvx512Kernels() {
+    return &s_kernels;
+}
+
+#else
+
+const KernelTable *getAvx512Kernels() {
+    return nullptr;
+}
+
+#endif
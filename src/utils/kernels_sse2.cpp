@@ -0,0 +1,16 @@
+/**
+ * @file kernels_sse2.cpp
+ * @author Patryk
+ * @brief Baseline build of the kernels, SSE2 on x86-64
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "KernelsImpl.hpp"
+
+const KernelTable *getSse2Kernels() {
+    return &s_kernels;
+}
@@ -0,0 +1,338 @@
+/**
+ * @file options.cpp
+ * @author Patryk
+ * @brief File contains command line parsing functions
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Options.hpp"
+
+/**
+ * @brief Parses a non-negative integer option value.
+ * @param text Value to parse.
+ * @param value Parsed value.
+ * @return bool true if the whole string is a valid number.
+ */
+static bool parseCount(const char *text, size_t &value) {
+    char *end = nullptr;
+    const unsigned long long parsed = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-')
+        return false;
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+/**
+ * @brief Parses a non-negative decimal option value.
+ * @param text Value to parse.
+ * @param value Parsed value.
+ * @return bool true if the whole string is a valid number.
+ */
+static bool parseDecimal(const char *text, float &value) {
+    char *end = nullptr;
+    const float parsed = strtof(text, &end);
+    if (end == text || *end != '\0' || !(parsed >= 0.0f))
+        return false;
+    value = parsed;
+    return true;
+}
+
+/**
+ * @brief Prints program usage to stderr.
+ */
+void printUsage() {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "./scop [options] <obj_path> <texture_path>\n");
+    fprintf(stderr, "./scop [options] --playlist <dir_or_list> <texture_path>\n");
+    fprintf(stderr, "./scop [options] --sequence <dir_or_list> <texture_path>\n");
+    fprintf(stderr, "./scop [options] --software <output.ppm> <obj_path> <texture_path>\n");
+    fprintf(stderr, "./scop [options] --raytrace <output.ppm> <obj_path> <texture_path>\n");
+    fprintf(stderr, "./scop [options] --adjacency <obj_path>\n");
+    fprintf(stderr, "./scop [options] --encode <output.smesh> <obj_path>\n");
+    fprintf(stderr, "Options:\n");
+    fprintf(stderr, "  --pack <file>                mount an asset pack (may be repeated)\n");
+    fprintf(stderr, "  --playlist <dir_or_list>     browse several models with [ and ]\n");
+    fprintf(stderr, "  --prefetch <count>           models prefetched ahead in playlist mode (default %d)\n", PLAYLIST_DEFAULT_PREFETCH);
+    fprintf(stderr, "  --prefetch-budget <MB>       memory budget of the prefetch cache (default %d)\n", PLAYLIST_DEFAULT_BUDGET_MB);
+    fprintf(stderr, "  --prefetch-upload            also upload prefetched models to the GPU ahead of time\n");
+    fprintf(stderr, "  --sequence <dir_or_list>     play numbered model files as an animation\n");
+    fprintf(stderr, "  --fps <rate>                 playback rate of --sequence (default %g)\n", SEQUENCE_DEFAULT_FPS);
+    fprintf(stderr, "  --sequence-ring <count>      frames decoded ahead in sequence mode (default %d)\n", SEQUENCE_DEFAULT_RING);
+    fprintf(stderr, "  --sequence-cache             decode frames from .smesh files written next to them on first use\n");
+    fprintf(stderr, "  --no-persistent-map          stream frames with unsynchronized mapping and orphaning, as on OpenGL 3.3\n");
+    fprintf(stderr, "  --watch                      reload the model when its file changes on disk\n");
+    fprintf(stderr, "  --progressive                show a coarse base first and refine it over the next frames, from a .spm cache\n");
+    fprintf(stderr, "  --chunked                    stream octree chunks of the model from a .schk file under memory budgets\n");
+    fprintf(stderr, "  --chunk-ram <MB>             host memory budget of --chunked (default %d)\n", CHUNK_DEFAULT_RAM_MB);
+    fprintf(stderr, "  --chunk-vram <MB>            GPU memory budget of --chunked (default %d)\n", CHUNK_DEFAULT_VRAM_MB);
+    fprintf(stderr, "  --textured                   start in texture mode instead of color mode\n");
+    fprintf(stderr, "  --software <output.ppm>      render without a GPU and write the last frame to a PPM image\n");
+    fprintf(stderr, "  --frames <count>             frames rendered by --software (default 1)\n");
+    fprintf(stderr, "  --stress <seed>              render a generated scene of bundled meshes with --software instead of a model\n");
+    fprintf(stderr, "  --stress-objects <count>     copies of bundled meshes in the --stress scene (default %d)\n", STRESS_DEFAULT_OBJECTS);
+    fprintf(stderr, "  --stress-materials <count>   random materials in the --stress scene (default %d)\n", STRESS_DEFAULT_MATERIALS);
+    fprintf(stderr, "  --stress-lights <count>      directional lights of the --stress scene (default %d)\n", STRESS_DEFAULT_LIGHTS);
+    fprintf(stderr, "  --stress-mesh <name>         make every --stress copy from this model of %s instead of the default mix\n", STRESS_MESH_PATH);
+    fprintf(stderr, "  --raytrace <output.ppm>      ray trace a still with shadows and write it to a PPM image\n");
+    fprintf(stderr, "  --samples <count>            samples per pixel accumulated by --raytrace (default %d)\n", RAYTRACE_DEFAULT_SAMPLES);
+    fprintf(stderr, "  --ao                         bake per-vertex ambient occlusion at load (%d rays per vertex)\n", AO_DEFAULT_RAYS);
+    fprintf(stderr, "  --ao-rays <count>            bake ambient occlusion with this many rays per vertex\n");
+    fprintf(stderr, "  --adjacency                  build the half-edge adjacency of the model, print its statistics and exit\n");
+    fprintf(stderr, "  --encode <output.smesh>      compress the model, print the ratio and decode speed and exit\n");
+    fprintf(stderr, "  --vertex-pulling             fetch vertices from storage buffers in the vertex shader (OpenGL 4.3, toggle with V)\n");
+    fprintf(stderr, "  --visibility-buffer          shade each pixel once from a triangle id buffer (OpenGL 4.3, toggle with B)\n");
+    fprintf(stderr, "  --instances <count>          draw this many copies of the model on a grid (at most %u)\n", VISIBILITY_MAX_INSTANCES);
+    fprintf(stderr, "  --impostors                  draw far --instances copies as billboards baked from the model (toggle with I)\n");
+    fprintf(stderr, "  --impostor-distance <dist>   distance where copies switch to impostors (default %g)\n", IMPOSTOR_DEFAULT_DISTANCE);
+    fprintf(stderr, "  --gpu-compute                compute normals and bounds with compute shaders after upload (OpenGL 4.3)\n");
+    fprintf(stderr, "  --weld <tolerance>           weld distance of .obj vertices and .stl corners relative to the model size (default %g)\n", WELD_DEFAULT_TOLERANCE);
+    fprintf(stderr, "  --no-cleanup                 keep degenerate and duplicate triangles and unused vertices of .obj files\n");
+}
+
+/**
+ * @brief Parses command line arguments.
+ *
+ * Options may appear anywhere; the remaining positional arguments are the
+ * object and texture paths, or only the default texture in playlist and sequence modes.
+ *
+ * @param argc Argument count.
+ * @param argv Argument values.
+ * @param options Structure filled with the parsed settings.
+ * @return bool true if the arguments are valid.
+ */
+bool parseOptions(int argc, char **argv, Options &options) {
+    std::vector<std::string> positional;
+
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--pack") == 0 || strcmp(argv[i], "--playlist") == 0 ||
+            strcmp(argv[i], "--prefetch") == 0 || strcmp(argv[i], "--prefetch-budget") == 0 ||
+            strcmp(argv[i], "--weld") == 0 || strcmp(argv[i], "--software") == 0 ||
+            strcmp(argv[i], "--frames") == 0 || strcmp(argv[i], "--raytrace") == 0 ||
+            strcmp(argv[i], "--samples") == 0 || strcmp(argv[i], "--ao-rays") == 0 ||
+            strcmp(argv[i], "--encode") == 0 || strcmp(argv[i], "--instances") == 0 ||
+            strcmp(argv[i], "--sequence") == 0 || strcmp(argv[i], "--fps") == 0 ||
+            strcmp(argv[i], "--sequence-ring") == 0 || strcmp(argv[i], "--impostor-distance") == 0 ||
+            strcmp(argv[i], "--chunk-ram") == 0 || strcmp(argv[i], "--chunk-vram") == 0 ||
+            strcmp(argv[i], "--stress") == 0 || strcmp(argv[i], "--stress-objects") == 0 ||
+            strcmp(argv[i], "--stress-materials") == 0 || strcmp(argv[i], "--stress-lights") == 0 ||
+            strcmp(argv[i], "--stress-mesh") == 0) {
+            if (!hasValue) {
+                fprintf(stderr, "Missing value for %s\n", argv[i]);
+                return false;
+            }
+        }
+
+        if (strcmp(argv[i], "--pack") == 0) {
+            options.packPaths.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--playlist") == 0) {
+            options.playlistSource = argv[++i];
+        } else if (strcmp(argv[i], "--prefetch") == 0) {
+            if (!parseCount(argv[++i], options.playlist.prefetchCount)) {
+                fprintf(stderr, "Invalid prefetch count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--prefetch-budget") == 0) {
+            size_t megabytes = 0;
+            if (!parseCount(argv[++i], megabytes)) {
+                fprintf(stderr, "Invalid prefetch budget %s\n", argv[i]);
+                return false;
+            }
+            options.playlist.memoryBudget = megabytes * 1024 * 1024;
+        } else if (strcmp(argv[i], "--prefetch-upload") == 0) {
+            options.playlist.uploadAhead = true;
+        } else if (strcmp(argv[i], "--sequence") == 0) {
+            options.sequenceSource = argv[++i];
+        } else if (strcmp(argv[i], "--fps") == 0) {
+            if (!parseDecimal(argv[++i], options.sequence.fps) || options.sequence.fps == 0.0f) {
+                fprintf(stderr, "Invalid playback rate %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--sequence-ring") == 0) {
+            if (!parseCount(argv[++i], options.sequence.ringSize) || options.sequence.ringSize == 0) {
+                fprintf(stderr, "Invalid ring size %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--sequence-cache") == 0) {
+            options.sequence.cache = true;
+        } else if (strcmp(argv[i], "--no-persistent-map") == 0) {
+            options.persistentMapping = false;
+        } else if (strcmp(argv[i], "--watch") == 0) {
+            options.watch = true;
+        } else if (strcmp(argv[i], "--progressive") == 0) {
+            options.progressive = true;
+        } else if (strcmp(argv[i], "--chunked") == 0) {
+            options.chunked = true;
+        } else if (strcmp(argv[i], "--chunk-ram") == 0) {
+            size_t megabytes = 0;
+            if (!parseCount(argv[++i], megabytes) || megabytes == 0) {
+                fprintf(stderr, "Invalid chunk RAM budget %s\n", argv[i]);
+                return false;
+            }
+            options.chunks.ramBudget = megabytes * 1024 * 1024;
+            options.chunked = true;
+        } else if (strcmp(argv[i], "--chunk-vram") == 0) {
+            size_t megabytes = 0;
+            if (!parseCount(argv[++i], megabytes) || megabytes == 0) {
+                fprintf(stderr, "Invalid chunk VRAM budget %s\n", argv[i]);
+                return false;
+            }
+            options.chunks.vramBudget = megabytes * 1024 * 1024;
+            options.chunked = true;
+        } else if (strcmp(argv[i], "--textured") == 0) {
+            options.textured = true;
+        } else if (strcmp(argv[i], "--software") == 0) {
+            options.softwareOutput = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0) {
+            if (!parseCount(argv[++i], options.frames) || options.frames == 0) {
+                fprintf(stderr, "Invalid frame count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--stress") == 0) {
+            size_t seed = 0;
+            if (!parseCount(argv[++i], seed) || seed > UINT32_MAX) {
+                fprintf(stderr, "Invalid seed %s\n", argv[i]);
+                return false;
+            }
+            options.stressScene.seed = static_cast<uint32_t>(seed);
+            options.stress = true;
+        } else if (strcmp(argv[i], "--stress-objects") == 0) {
+            if (!parseCount(argv[++i], options.stressScene.objects) || options.stressScene.objects > STRESS_MAX_COUNT) {
+                fprintf(stderr, "Invalid object count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--stress-materials") == 0) {
+            if (!parseCount(argv[++i], options.stressScene.materials) || options.stressScene.materials == 0 ||
+                options.stressScene.materials > STRESS_MAX_COUNT) {
+                fprintf(stderr, "Invalid material count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--stress-mesh") == 0) {
+            options.stressScene.mesh = argv[++i];
+        } else if (strcmp(argv[i], "--stress-lights") == 0) {
+            if (!parseCount(argv[++i], options.stressScene.lights) || options.stressScene.lights == 0 ||
+                options.stressScene.lights > STRESS_MAX_COUNT) {
+                fprintf(stderr, "Invalid light count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--raytrace") == 0) {
+            options.raytraceOutput = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0) {
+            if (!parseCount(argv[++i], options.samples) || options.samples == 0) {
+                fprintf(stderr, "Invalid sample count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--ao") == 0) {
+            if (options.occlusionRays == 0)
+                options.occlusionRays = AO_DEFAULT_RAYS;
+        } else if (strcmp(argv[i], "--ao-rays") == 0) {
+            if (!parseCount(argv[++i], options.occlusionRays) || options.occlusionRays == 0) {
+                fprintf(stderr, "Invalid ray count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--no-cleanup") == 0) {
+            options.cleanup = false;
+        } else if (strcmp(argv[i], "--adjacency") == 0) {
+            options.adjacency = true;
+        } else if (strcmp(argv[i], "--encode") == 0) {
+            options.encodeOutput = argv[++i];
+        } else if (strcmp(argv[i], "--vertex-pulling") == 0) {
+            options.vertexPulling = true;
+        } else if (strcmp(argv[i], "--visibility-buffer") == 0) {
+            options.visibilityBuffer = true;
+            options.vertexPulling = true;
+        } else if (strcmp(argv[i], "--gpu-compute") == 0) {
+            options.gpuCompute = true;
+        } else if (strcmp(argv[i], "--instances") == 0) {
+            if (!parseCount(argv[++i], options.instances) || options.instances == 0 ||
+                options.instances > VISIBILITY_MAX_INSTANCES) {
+                fprintf(stderr, "Invalid instance count %s\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(argv[i], "--impostors") == 0) {
+            options.impostors = true;
+        } else if (strcmp(argv[i], "--impostor-distance") == 0) {
+            if (!parseDecimal(argv[++i], options.impostorDistance) || options.impostorDistance <= 0.0f) {
+                fprintf(stderr, "Invalid impostor distance %s\n", argv[i]);
+                return false;
+            }
+            options.impostors = true;
+        } else if (strcmp(argv[i], "--weld") == 0) {
+            if (!parseDecimal(argv[++i], options.weldTolerance)) {
+                fprintf(stderr, "Invalid weld tolerance %s\n", argv[i]);
+                return false;
+            }
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return false;
+        } else {
+            positional.push_back(argv[i]);
+        }
+    }
+
+    if (options.progressive && (!options.playlistSource.empty() || !options.sequenceSource.empty() || options.watch ||
+                                options.occlusionRays > 0 || !options.softwareOutput.empty() ||
+                                !options.raytraceOutput.empty() || options.adjacency || !options.encodeOutput.empty())) {
+        fprintf(stderr, "--progressive is not supported with --playlist, --sequence, --watch, --ao, --software, --raytrace, --adjacency and --encode\n");
+        return false;
+    }
+    if (options.chunked && (options.progressive || !options.playlistSource.empty() || !options.sequenceSource.empty() ||
+                            options.watch || options.occlusionRays > 0 || !options.softwareOutput.empty() ||
+                            !options.raytraceOutput.empty() || options.adjacency || !options.encodeOutput.empty() ||
+                            options.instances > 1)) {
+        fprintf(stderr, "--chunked is not supported with --progressive, --playlist, --sequence, --watch, --ao, --software, --raytrace, --adjacency, --encode and --instances\n");
+        return false;
+    }
+    if (options.stress) {
+        if (options.softwareOutput.empty() || !positional.empty()) {
+            fprintf(stderr, "--stress renders with --software and takes no model or texture\n");
+            return false;
+        }
+        if (options.progressive || options.chunked || !options.playlistSource.empty() ||
+            !options.sequenceSource.empty() || options.watch || !options.raytraceOutput.empty() ||
+            options.adjacency || !options.encodeOutput.empty()) {
+            fprintf(stderr, "--stress is not supported with --progressive, --chunked, --playlist, --sequence, --watch, --raytrace, --adjacency and --encode\n");
+            return false;
+        }
+        return true;
+    }
+    if (!options.sequenceSource.empty()) {
+        if (positional.size() != 1)
+            return false;
+        if (!options.playlistSource.empty() || options.watch || options.occlusionRays > 0 ||
+            !options.softwareOutput.empty() || !options.raytraceOutput.empty() || options.adjacency ||
+            !options.encodeOutput.empty()) {
+            fprintf(stderr, "--playlist, --watch, --ao, --software, --raytrace, --adjacency and --encode are not supported in sequence mode\n");
+            return false;
+        }
+        options.texturePath = positional[0];
+        return true;
+    }
+    if (!options.playlistSource.empty()) {
+        if (positional.size() != 1)
+            return false;
+        if (options.watch || !options.softwareOutput.empty() || !options.raytraceOutput.empty() || options.adjacency ||
+            !options.encodeOutput.empty()) {
+            fprintf(stderr, "--watch, --software, --raytrace, --adjacency and --encode are not supported in playlist mode\n");
+            return false;
+        }
+        options.texturePath = positional[0];
+        return true;
+    }
+    if ((options.adjacency || !options.encodeOutput.empty()) && positional.size() == 1) {
+        options.objPath = positional[0];
+        return true;
+    }
+    if (positional.size() != 2)
+        return false;
+    options.objPath = positional[0];
+    options.texturePath = positional[1];
+    return true;
+}
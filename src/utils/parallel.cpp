@@ -0,0 +1,82 @@
+/**
+ * @file parallel.cpp
+ * @author Patryk
+ * @brief File contains parallel loop helpers
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "Parallel.hpp"
+
+/**
+ * @brief Reads the worker count from `SCOP_THREADS`, or the hardware thread count.
+ */
+static unsigned int computeWorkerCount() {
+    const char *env = getenv("SCOP_THREADS");
+    const int requested = env ? atoi(env) : 0;
+    const unsigned int count = requested > 0 ? static_cast<unsigned int>(requested)
+                                             : std::thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+/**
+ * @brief Returns the number of threads used by `parallelFor()`, computed on first use.
+ *
+ * Safe to call from any thread: playlist prefetch workers load meshes
+ * through `parallelFor()` while the main thread does too.
+ *
+ * @return unsigned int Worker count, at least 1.
+ */
+unsigned int getWorkerCount() {
+    static const unsigned int count = computeWorkerCount();
+    return count;
+}
+
+/**
+ * @brief Runs a loop body over [begin, end) on all worker threads.
+ *
+ * The range is split into blocks of `grain` iterations that threads claim
+ * dynamically, so uneven work is balanced. The calling thread takes part in
+ * the work. Small ranges run inline without spawning threads.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Number of iterations per block (at least 1).
+ * @param body Function called with each block as [blockBegin, blockEnd).
+ */
+void parallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)> &body) {
+    if (begin >= end)
+        return;
+    grain = std::max<size_t>(grain, 1);
+
+    const size_t blocks = (end - begin + grain - 1) / grain;
+    const size_t threadCount = std::min<size_t>(getWorkerCount(), blocks);
+    if (threadCount <= 1) {
+        body(begin, end);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t block;
+        while ((block = next.fetch_add(1)) < blocks) {
+            const size_t blockBegin = begin + block * grain;
+            body(blockBegin, std::min(end, blockBegin + grain));
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread &thread: threads)
+        thread.join();
+}
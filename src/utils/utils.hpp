@@ -16,6 +16,7 @@
 #include <cmath>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include "Vector.hpp"
 #include "../core/Object.hpp"
 #include "../render/Renderer.hpp"
 
@@ -34,18 +35,11 @@ std::array<float, 16> getPerspective(const float fov, const float aspectRatio, c
 std::array<float, 16> translateMatrix(const std::array<float, 16> &mat, const float x, const float y, const float z);
 std::array<float, 16> scaleMatrix(const std::array<float, 16> &matrix, const float scaleFactor);
 std::array<float, 16> multiplyMatrix(const std::array<float, 16> &mat1, const std::array<float, 16> &mat2);
+std::array<float, 16> invertMatrix(const std::array<float, 16> &mat);
 std::array<float, 16> getRotationMatrixY(const float angle);
 std::array<float, 16> getIdentityMat4();
 void printMatrix(const std::array<float, 16>& mat, const std::string& name);
 
-// Vector operations
-std::array<float, 3> subtractVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
-std::array<float, 3> addVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
-std::array<float, 3> normalizeVec(const std::array<float, 3> &vec);
-std::array<float, 3> crossProdVec(const std::array<float, 3> &a, const std::array<float, 3> &b);
-float dotProdVec(const std::array<float, 3>& a, const std::array<float, 3>& b);
-std::array<float, 3> multiplyVecByFloat(const std::array<float, 3> &vec, float x);
-
 // Callbacks
 void framebufferSizeCallback(GLFWwindow* window, int width, int height);
 void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
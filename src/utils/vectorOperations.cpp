@@ -12,6 +12,8 @@
 #include <array>
 #include <cmath>
 
+#include "Vector.hpp"
+
 /**
  * @brief Subtracts one 3D vector from another.
  *
@@ -0,0 +1,156 @@
+/**
+ * @file scop_mesh.cpp
+ * @author Patryk
+ * @brief Command line tool processing models without OpenGL
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../src/core/Mesh.hpp"
+#include "../src/core/ProgressiveMesh.hpp"
+#include "../src/core/ChunkedMesh.hpp"
+#include "../src/io/MeshCodec.hpp"
+#include "../src/utils/Kernels.hpp"
+#include "../src/utils/Parallel.hpp"
+
+static void printUsage() {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "./scop_mesh [-o] [-e] [-p] [-c] <model>...\n");
+    fprintf(stderr, "  -o  reorder vertices in the order the triangles use them\n");
+    fprintf(stderr, "  -e  write each processed model as <model>.smesh\n");
+    fprintf(stderr, "  -p  write the progressive mesh cache of each model as <model>.spm\n");
+    fprintf(stderr, "  -c  write each model as octree chunks for --chunked streaming as <model>.schk\n");
+}
+
+/**
+ * @brief Writes a mesh compressed with `encodeMesh()`.
+ * @param mesh Mesh to write.
+ * @param path Output file path.
+ * @return bool true on success.
+ */
+static bool writeEncoded(const Mesh &mesh, const std::string &path) {
+    const std::vector<char> encoded = encodeMesh(mesh.vertices, mesh.indices);
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return false;
+    }
+    const bool ok = fwrite(encoded.data(), 1, encoded.size(), file) == encoded.size();
+    if (fclose(file) != 0 || !ok) {
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Splits a mesh with `buildProgressiveMesh()` and writes its cache, printing the size of each level.
+ * @param mesh Mesh to split.
+ * @param bounds Bounds of the mesh.
+ * @param path Output file path.
+ * @return bool true on success.
+ */
+static bool writeProgressive(const Mesh &mesh, const MeshBounds &bounds, const std::string &path) {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<ProgressiveLevel> levels;
+    if (!buildProgressiveMesh(mesh.vertices, mesh.indices, levels)) {
+        fprintf(stderr, "%s has no triangles to refine\n", path.c_str());
+        return false;
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    size_t vertices = 0, triangles = 0;
+    for (size_t i = 0; i < levels.size(); i++) {
+        vertices += levels[i].vertices.size();
+        triangles += levels[i].indices.size() / 3;
+        printf("  level %zu: %zu vertices, %zu triangles, %zu corner updates\n", i, vertices, triangles,
+               levels[i].updates.size());
+    }
+    printf("  split in %.1f ms\n", elapsed.count());
+    return saveProgressiveMesh(path, bounds, levels);
+}
+
+/**
+ * @brief Partitions a mesh with `saveChunkedMesh()`, printing the chunks written.
+ * @param mesh Mesh to partition.
+ * @param path Output file path.
+ * @return bool true on success.
+ */
+static bool writeChunked(const Mesh &mesh, const std::string &path) {
+    const auto start = std::chrono::steady_clock::now();
+    if (!saveChunkedMesh(path, mesh.vertices, mesh.indices))
+        return false;
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    const std::unique_ptr<ChunkedFile> file = ChunkedFile::open(path);
+    if (!file)
+        return false;
+    size_t largest = 0;
+    for (const MeshChunk &chunk: file->getChunks())
+        largest = std::max<size_t>(largest, chunk.indexCount / 3);
+    printf("  %zu chunks of at most %zu triangles, %zu vertices with duplicates on chunk borders, written in %.1f ms\n",
+           file->getChunks().size(), largest, file->getVertexCount(), elapsed.count());
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int arg = 1;
+    bool optimize = false;
+    bool encode = false;
+    bool progressive = false;
+    bool chunked = false;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-o") == 0) {
+            optimize = true;
+        } else if (strcmp(argv[arg], "-e") == 0) {
+            encode = true;
+        } else if (strcmp(argv[arg], "-p") == 0) {
+            progressive = true;
+        } else if (strcmp(argv[arg], "-c") == 0) {
+            chunked = true;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (arg == argc) {
+        printUsage();
+        return 1;
+    }
+
+    int status = 0;
+    for (; arg < argc; arg++) {
+        const std::string path = argv[arg];
+        const auto start = std::chrono::steady_clock::now();
+        std::unique_ptr<Mesh> mesh = Mesh::load(path);
+        if (!mesh) {
+            status = 1;
+            continue;
+        }
+        if (optimize)
+            mesh->optimizeVertexOrder();
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        const MeshBounds bounds = mesh->computeBounds();
+        printf("%s: %zu vertices, %zu triangles, size %g x %g x %g, %.2f MB, processed in %.1f ms on %u threads "
+               "(%s kernels)\n", path.c_str(), mesh->vertices.size(), mesh->indices.size() / 3,
+               bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1], bounds.max[2] - bounds.min[2],
+               mesh->getMemoryUsage() / (1024.0 * 1024.0), elapsed.count(), getWorkerCount(),
+               getKernelIsaName(getKernelIsa()));
+        if (encode && !writeEncoded(*mesh, path + MESH_CODEC_EXTENSION))
+            status = 1;
+        if (progressive && !writeProgressive(*mesh, bounds, path + PROGRESSIVE_EXTENSION))
+            status = 1;
+        if (chunked && !writeChunked(*mesh, path + CHUNKED_EXTENSION))
+            status = 1;
+    }
+    return status;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file scop_pack.cpp
+ * @author Patryk
+ * @brief Command line tool building and listing scop asset packs
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "../src/io/AssetPack.hpp"
+
+/**
+ * @brief Recursively collects regular files below a path.
+ * @param path File or directory to collect.
+ * @param files Output list of file paths.
+ */
+static void collectFiles(const std::string &path, std::vector<std::string> &files) {
+    struct stat st;
+    if (stat(path.c_str(), &st)) {
+        fprintf(stderr, "Cannot access %s\n", path.c_str());
+        return;
+    }
+    if (S_ISREG(st.st_mode)) {
+        files.push_back(path);
+        return;
+    }
+    if (!S_ISDIR(st.st_mode))
+        return;
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return;
+    while (const dirent *entry = readdir(dir)) {
+        // Skip '.', '..' and hidden files such as macOS '._' resource forks
+        if (entry->d_name[0] == '.')
+            continue;
+        collectFiles(path + "/" + entry->d_name, files);
+    }
+    closedir(dir);
+}
+
+static void printUsage() {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "./scop_pack [-c] <output.pack> <file_or_dir>...\n");
+    fprintf(stderr, "./scop_pack -l <input.pack>\n");
+    fprintf(stderr, "  -c  compress entries when it saves space\n");
+    fprintf(stderr, "  -l  list the entries of an existing pack\n");
+}
+
+static int listPack(const std::string &packPath) {
+    std::unique_ptr<AssetPack> pack = AssetPack::open(packPath);
+    if (!pack)
+        return 1;
+    for (const std::string &name: pack->list("")) {
+        const PackEntry *entry = pack->find(name);
+        printf("%10llu %10llu %s %s\n",
+               static_cast<unsigned long long>(entry->size),
+               static_cast<unsigned long long>(entry->storedSize),
+               (entry->flags & PACK_FLAG_COMPRESSED) ? "lz " : "raw",
+               name.c_str());
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "-l") == 0)
+        return listPack(argv[2]);
+
+    int arg = 1;
+    bool compress = false;
+    if (arg < argc && strcmp(argv[arg], "-c") == 0) {
+        compress = true;
+        arg++;
+    }
+    if (argc - arg < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string packPath = argv[arg++];
+    std::vector<std::string> files;
+    for (; arg < argc; arg++)
+        collectFiles(argv[arg], files);
+    if (files.empty()) {
+        fprintf(stderr, "No files to pack\n");
+        return 1;
+    }
+
+    if (!AssetPack::write(packPath, files, compress))
+        return 1;
+    printf("Packed %zu files into %s\n", files.size(), packPath.c_str());
+    return 0;
+}
@@ -0,0 +1,624 @@
+/**
+ * @file scop_perf.cpp
+ * @author Patryk
+ * @brief Performance regression suite comparing against stored baselines
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "../src/core/Mesh.hpp"
+#include "../src/io/Json.hpp"
+#include "../src/utils/Kernels.hpp"
+#include "../src/utils/Parallel.hpp"
+
+#define PERF_BASELINE "perf/baseline.json"
+#define PERF_RUNS 8
+// One-sided Mann-Whitney significance level
+#define PERF_ALPHA 0.01
+// Smallest slowdown of the median reported as a regression
+#define PERF_MIN_EFFECT 0.10
+// Allowed growth of deterministic measurements such as memory
+#define PERF_MEMORY_TOLERANCE 0.02
+#define PERF_MODELS "res/objects"
+#define PERF_SYNTHETIC_DIR "obj/perf"
+#define PERF_SCOP "./scop"
+#define PERF_TEXTURE "res/textures/dog.png"
+#define PERF_FRAMES 2
+// Fixed workload timed along the benchmarks to factor out the speed of the machine
+#define PERF_CALIBRATION "calibration/sort"
+#define PERF_CALIBRATION_SIZE (1 << 20)
+#define PERF_STRESS_SEED 1
+// Worker threads of the timed code, unless SCOP_THREADS is set; the same on every machine
+#define PERF_THREADS 4
+#define PERF_SCALING_RUNS 3
+
+/**
+ * @brief Measurements of one benchmark; lower is better.
+ */
+struct Benchmark {
+    std::string name;
+    std::string unit;
+    std::vector<double> samples;
+};
+
+/**
+ * @brief Synthetic model generated for the suite, larger than the bundled ones.
+ */
+struct SyntheticModel {
+    const char *name;
+    int rings;
+    int segments;
+};
+
+static const SyntheticModel s_synthetic[] = {
+    {"sphere_200k", 251, 400},
+};
+
+// Models also rendered by the frame time benchmark, which is slower than loading
+static const char *s_frameModels[] = {"teapot.obj", "dog.obj", "sphere_200k.obj"};
+
+/**
+ * @brief Parameter of the `scop --stress` scene swept by the scaling benchmark, the others keeping their defaults.
+ */
+struct ScalingAxis {
+    const char *name;
+    const char *option;
+    std::vector<std::string> values;
+};
+
+static const ScalingAxis s_scalingAxes[] = {
+    {"objects", "--stress-objects", {"1", "4", "16", "64", "256"}},
+    // Bundled meshes from 76 to 163k triangles
+    {"triangles", "--stress-mesh", {"42.obj", "teapot.obj", "dog.obj", "templeRoof.obj"}},
+    {"materials", "--stress-materials", {"1", "4", "16", "64"}},
+    {"lights", "--stress-lights", {"1", "2", "4", "8", "16"}},
+};
+
+static bool hasModelExtension(const std::string &name) {
+    for (const char *extension: {".obj", ".ply", ".stl", ".smesh"}) {
+        const size_t length = strlen(extension);
+        if (name.size() > length && name.compare(name.size() - length, length, extension) == 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Lists the models of a directory, sorted by name.
+ */
+static std::vector<std::string> listModels(const std::string &directory) {
+    std::vector<std::string> names;
+    DIR *dir = opendir(directory.c_str());
+    if (!dir) {
+        fprintf(stderr, "Cannot open %s\n", directory.c_str());
+        return names;
+    }
+    while (const dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.' && hasModelExtension(entry->d_name))
+            names.push_back(entry->d_name);
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+/**
+ * @brief Writes a UV sphere as an .obj file, unless it already exists.
+ * @param path Output path.
+ * @param model Number of rings and segments; the sphere has about 2 * rings * segments triangles.
+ * @return bool true if the file exists or was written.
+ */
+static bool writeSphere(const std::string &path, const SyntheticModel &model) {
+    struct stat st;
+    if (stat(path.c_str(), &st) == 0)
+        return true;
+    mkdir(PERF_SYNTHETIC_DIR, 0755);
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return false;
+    }
+    for (int ring = 0; ring <= model.rings; ring++) {
+        const double theta = M_PI * ring / model.rings;
+        for (int segment = 0; segment < model.segments; segment++) {
+            const double phi = 2.0 * M_PI * segment / model.segments;
+            fprintf(file, "v %.6f %.6f %.6f\n", std::sin(theta) * std::cos(phi), std::cos(theta),
+                    std::sin(theta) * std::sin(phi));
+        }
+    }
+    for (int ring = 0; ring < model.rings; ring++) {
+        for (int segment = 0; segment < model.segments; segment++) {
+            const int a = ring * model.segments + segment + 1;
+            const int b = ring * model.segments + (segment + 1) % model.segments + 1;
+            const int c = a + model.segments, d = b + model.segments;
+            if (ring > 0)
+                fprintf(file, "f %d %d %d\n", a, b, c);
+            if (ring < model.rings - 1)
+                fprintf(file, "f %d %d %d\n", b, d, c);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Times a workload independent from the scop code: sorting pseudo-random integers.
+ * @return double Elapsed milliseconds.
+ */
+static double runCalibration() {
+    std::vector<unsigned int> values(PERF_CALIBRATION_SIZE);
+    unsigned int state = 12345;
+    for (unsigned int &value: values) {
+        state = state * 1664525u + 1013904223u;
+        value = state;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    std::sort(values.begin(), values.end());
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+typedef std::vector<std::pair<std::string, std::string>> ModelList;
+
+/**
+ * @brief Times `Mesh::load()` of each model and records the memory of the result.
+ *
+ * Runs in rounds loading every model once, so slow drift of the machine
+ * (frequency scaling, page cache, other processes) spreads over all models
+ * instead of biasing the ones measured at a bad moment.
+ *
+ * @param models Model names and paths.
+ * @param runs Number of timed rounds, after one warm-up round.
+ * @param results Receives the load time and memory benchmarks.
+ * @param calibration Receives one calibration sample per round.
+ * @return bool false if a model could not be loaded.
+ */
+static bool measureLoads(const ModelList &models, int runs, std::vector<Benchmark> &results,
+                         Benchmark &calibration) {
+    MeshSettings settings;
+    settings.verbose = false;
+    std::vector<Benchmark> loads, memory;
+    for (const auto &model: models) {
+        loads.push_back({"load/" + model.first, "ms", {}});
+        memory.push_back({"memory/" + model.first, "bytes", {}});
+    }
+    for (int run = 0; run <= runs; run++) {
+        if (run > 0)
+            calibration.samples.push_back(runCalibration());
+        for (size_t i = 0; i < models.size(); i++) {
+            const auto start = std::chrono::steady_clock::now();
+            std::unique_ptr<Mesh> mesh = Mesh::load(models[i].second, settings);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (!mesh)
+                return false;
+            if (run == 0)
+                memory[i].samples.push_back(static_cast<double>(mesh->getMemoryUsage()));
+            else
+                loads[i].samples.push_back(elapsed.count());
+        }
+    }
+    for (size_t i = 0; i < models.size(); i++) {
+        results.push_back(loads[i]);
+        results.push_back(memory[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the number written just before `suffix` in a line of output.
+ * @return double The number, or -1 if the line does not contain `suffix`.
+ */
+static double numberBefore(const char *line, const char *suffix) {
+    const char *end = strstr(line, suffix);
+    if (!end)
+        return -1.0;
+    const char *number = end;
+    while (number > line && number[-1] != ' ')
+        number--;
+    return atof(number);
+}
+
+/**
+ * @brief Runs one `scop --software` command and reads the frame time it reports.
+ * @param command Shell command, with stderr redirected to stdout.
+ * @param frameTime Receives the average frame time in milliseconds.
+ * @param triangles Receives the triangles per frame reported by a --stress scene, or -1.
+ * @return bool false if scop failed or printed no frame time.
+ */
+static bool runSoftwareRenderer(const std::string &command, double &frameTime, double &triangles) {
+    FILE *pipe = popen(command.c_str(), "r");
+    if (!pipe) {
+        fprintf(stderr, "Failed to run %s\n", command.c_str());
+        return false;
+    }
+    char line[512];
+    frameTime = -1.0;
+    triangles = -1.0;
+    while (fgets(line, sizeof(line), pipe)) {
+        const double time = numberBefore(line, " ms/frame");
+        if (time >= 0.0)
+            frameTime = time;
+        const double count = numberBefore(line, " triangles per frame");
+        if (count >= 0.0)
+            triangles = count;
+    }
+    if (pclose(pipe) != 0 || frameTime < 0.0) {
+        fprintf(stderr, "%s did not report a frame time\n", command.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Times the software renderer in headless mode, one `scop --software` process per sample.
+ * @param path Model to render.
+ * @param name Model name used in the benchmark name.
+ * @param runs Number of processes.
+ * @param results Receives the frame time benchmark.
+ * @param calibration Receives one calibration sample per process.
+ * @return bool false if scop failed or printed no frame time.
+ */
+static bool measureFrames(const std::string &path, const std::string &name, int runs,
+                          std::vector<Benchmark> &results, Benchmark &calibration) {
+    Benchmark frame = {"frame/" + name, "ms", {}};
+    const std::string command = std::string(PERF_SCOP) + " --software /dev/null --frames " +
+                                std::to_string(PERF_FRAMES) + " '" + path + "' " + PERF_TEXTURE + " 2>&1";
+    for (int run = 0; run < runs; run++) {
+        calibration.samples.push_back(runCalibration());
+        double frameTime, triangles;
+        if (!runSoftwareRenderer(command, frameTime, triangles))
+            return false;
+        frame.samples.push_back(frameTime);
+    }
+    results.push_back(frame);
+    return true;
+}
+
+static double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+/**
+ * @brief One-sided Mann-Whitney U test: probability of samples at least this much slower than the baseline by chance.
+ *
+ * Uses the normal approximation with tie and continuity corrections, which
+ * holds from about 8 samples per side. Makes no assumption on the shape of
+ * the distributions, so outliers from a busy machine do not dominate.
+ *
+ * @param baseline Baseline samples.
+ * @param current Current samples.
+ * @return double p-value; small when `current` tends to be larger than `baseline`.
+ */
+static double mannWhitneyGreater(const std::vector<double> &baseline, const std::vector<double> &current) {
+    const size_t n1 = baseline.size(), n2 = current.size(), n = n1 + n2;
+    if (n1 == 0 || n2 == 0)
+        return 1.0;
+    std::vector<std::pair<double, bool>> all;
+    for (const double value: baseline)
+        all.push_back({value, false});
+    for (const double value: current)
+        all.push_back({value, true});
+    std::sort(all.begin(), all.end());
+
+    double currentRanks = 0.0, ties = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && all[j].first == all[i].first)
+            j++;
+        const double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (all[k].second)
+                currentRanks += rank;
+        }
+        const double t = static_cast<double>(j - i);
+        ties += t * t * t - t;
+        i = j;
+    }
+    const double u = currentRanks - n2 * (n2 + 1) / 2.0;
+    const double mean = n1 * n2 / 2.0;
+    const double variance = n1 * n2 / 12.0 * ((n + 1) - ties / (static_cast<double>(n) * (n - 1)));
+    if (variance <= 0.0)
+        return u > mean ? 0.0 : 1.0;
+    const double z = (u - mean - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+/**
+ * @brief Compares the results with the baseline and prints one line per benchmark.
+ *
+ * A timing regresses when it is significantly slower (Mann-Whitney,
+ * PERF_ALPHA) and its median grew by more than PERF_MIN_EFFECT; a
+ * deterministic measurement when it grew by more than PERF_MEMORY_TOLERANCE.
+ * Benchmarks missing from the baseline are reported as new.
+ *
+ * Timings are first divided by the speed of the machine relative to the
+ * baseline, the ratio of the calibration medians, so a machine that is
+ * busier or clocked lower than when the baseline was stored does not turn
+ * every timing into a regression. The baseline must come from the same
+ * kernels and thread count, see `checkConfiguration()`.
+ *
+ * @return size_t Number of regressions.
+ */
+static size_t compare(const std::vector<Benchmark> &results, const JsonValue &baseline) {
+    double speed = 1.0;
+    for (const Benchmark &benchmark: results) {
+        const JsonValue &stored = baseline["benchmarks"][benchmark.name]["samples"];
+        if (benchmark.name != PERF_CALIBRATION || stored.size() == 0)
+            continue;
+        std::vector<double> before;
+        for (size_t i = 0; i < stored.size(); i++)
+            before.push_back(stored[i].asNumber());
+        if (median(before) > 0.0)
+            speed = median(benchmark.samples) / median(before);
+    }
+    printf("Calibration runs %.2fx as long as in the baseline, timings are scaled accordingly\n", speed);
+
+    size_t regressions = 0;
+    for (const Benchmark &original: results) {
+        if (original.name == PERF_CALIBRATION)
+            continue;
+        Benchmark benchmark = original;
+        if (benchmark.unit == "ms") {
+            for (double &sample: benchmark.samples)
+                sample /= speed;
+        }
+        const JsonValue &stored = baseline["benchmarks"][benchmark.name]["samples"];
+        const double now = median(benchmark.samples);
+        if (stored.size() == 0) {
+            printf("%-34s %12.2f %-5s new\n", benchmark.name.c_str(), now, benchmark.unit.c_str());
+            continue;
+        }
+        std::vector<double> before;
+        for (size_t i = 0; i < stored.size(); i++)
+            before.push_back(stored[i].asNumber());
+        const double then = median(before);
+        const double change = then > 0.0 ? now / then - 1.0 : 0.0;
+
+        bool regressed;
+        char detail[32] = "";
+        if (benchmark.samples.size() == 1) {
+            regressed = change > PERF_MEMORY_TOLERANCE;
+        } else {
+            const double p = mannWhitneyGreater(before, benchmark.samples);
+            regressed = p < PERF_ALPHA && change > PERF_MIN_EFFECT;
+            snprintf(detail, sizeof(detail), "p=%.4f", p);
+        }
+        printf("%-34s %12.2f -> %12.2f %-5s %+6.1f%% %-8s %s\n", benchmark.name.c_str(), then, now,
+               benchmark.unit.c_str(), change * 100.0, detail, regressed ? "REGRESSION" : "ok");
+        if (regressed)
+            regressions++;
+    }
+    return regressions;
+}
+
+/**
+ * @brief Measures frame time curves of the software renderer on generated `scop --stress` scenes.
+ *
+ * Sweeps each parameter of `s_scalingAxes` in turn, the others keeping
+ * the defaults of `scop`, and prints the median frame time of each point
+ * with the triangles drawn. The scene of every point is generated from the
+ * same seed, so curves of two runs or machines are comparable.
+ *
+ * @param runs Processes per point.
+ * @param csvPath File receiving the curves as CSV, or empty.
+ * @return bool false if scop failed or the CSV file could not be written.
+ */
+static bool measureScaling(int runs, const std::string &csvPath) {
+    FILE *csv = nullptr;
+    if (!csvPath.empty()) {
+        csv = fopen(csvPath.c_str(), "w");
+        if (!csv) {
+            fprintf(stderr, "Failed to open %s for writing\n", csvPath.c_str());
+            return false;
+        }
+        fprintf(csv, "parameter,value,triangles,median_ms,min_ms,max_ms\n");
+    }
+    bool ok = true;
+    for (const ScalingAxis &axis: s_scalingAxes) {
+        printf("Frame time against %s (%s), %d samples per point\n", axis.name, axis.option, runs);
+        printf("  %14s %12s %12s %12s %12s\n", "value", "triangles", "median ms", "min ms", "max ms");
+        for (const std::string &value: axis.values) {
+            const std::string command = std::string(PERF_SCOP) + " --software /dev/null --frames " +
+                                        std::to_string(PERF_FRAMES) + " --stress " +
+                                        std::to_string(PERF_STRESS_SEED) + " " + axis.option + " " + value +
+                                        " 2>&1";
+            std::vector<double> samples;
+            double triangles = 0.0;
+            for (int run = 0; run < runs && ok; run++) {
+                double frameTime;
+                ok = runSoftwareRenderer(command, frameTime, triangles);
+                samples.push_back(frameTime);
+            }
+            if (!ok)
+                break;
+            const double low = *std::min_element(samples.begin(), samples.end());
+            const double high = *std::max_element(samples.begin(), samples.end());
+            printf("  %14s %12.0f %12.2f %12.2f %12.2f\n", value.c_str(), triangles, median(samples), low, high);
+            if (csv)
+                fprintf(csv, "%s,%s,%.0f,%.10g,%.10g,%.10g\n", axis.name, value.c_str(), triangles, median(samples),
+                        low, high);
+        }
+        if (!ok)
+            break;
+    }
+    if (csv && fclose(csv) != 0) {
+        fprintf(stderr, "Failed to write %s\n", csvPath.c_str());
+        return false;
+    }
+    return ok;
+}
+
+/**
+ * @brief Checks that the baseline was measured with the kernels and thread count of this run.
+ *
+ * The calibration only factors out the single-threaded speed of the
+ * machine: timings from other kernels or another number of workers differ
+ * by more than any regression threshold, so they are not compared.
+ *
+ * @return bool false, with the reason printed, if the configurations differ.
+ */
+static bool checkConfiguration(const JsonValue &baseline, const std::string &path) {
+    const std::string kernels = getKernelIsaName(getKernelIsa());
+    const long long threads = static_cast<long long>(getWorkerCount());
+    const std::string storedKernels = baseline["kernels"].asString();
+    const long long storedThreads = baseline["threads"].asInt(0);
+    if (storedKernels == kernels && storedThreads == threads)
+        return true;
+    const std::string storedCount = storedThreads > 0 ? std::to_string(storedThreads) : "an unrecorded number of";
+    fprintf(stderr, "%s was measured with %s kernels on %s threads, this run uses %s kernels on %lld threads.\n",
+            path.c_str(), storedKernels.empty() ? "unknown" : storedKernels.c_str(), storedCount.c_str(),
+            kernels.c_str(), threads);
+    fprintf(stderr, "Timings are not comparable: run with %s=<isa> and SCOP_THREADS=<count> matching the baseline, "
+            "or store a new one with -u\n", KERNEL_ISA_ENV);
+    return false;
+}
+
+static bool writeBaseline(const std::string &path, const std::vector<Benchmark> &results) {
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing\n", path.c_str());
+        return false;
+    }
+    fprintf(file, "{\n  \"kernels\": \"%s\",\n  \"threads\": %u,\n  \"benchmarks\": {\n",
+            getKernelIsaName(getKernelIsa()), getWorkerCount());
+    for (size_t i = 0; i < results.size(); i++) {
+        const Benchmark &benchmark = results[i];
+        fprintf(file, "    \"%s\": {\"unit\": \"%s\", \"samples\": [", benchmark.name.c_str(),
+                benchmark.unit.c_str());
+        for (size_t s = 0; s < benchmark.samples.size(); s++)
+            fprintf(file, "%s%.10g", s ? ", " : "", benchmark.samples[s]);
+        fprintf(file, "]}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Failed to write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+static std::unique_ptr<JsonValue> readBaseline(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open baseline %s, run with -u to create it\n", path.c_str());
+        return nullptr;
+    }
+    std::string data;
+    char buffer[65536];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.append(buffer, read);
+    fclose(file);
+    std::unique_ptr<JsonValue> baseline = JsonValue::parse(data.data(), data.size());
+    if (!baseline)
+        fprintf(stderr, "%s: malformed baseline\n", path.c_str());
+    return baseline;
+}
+
+static void printUsage() {
+    fprintf(stderr, "Usage:\n");
+    fprintf(stderr, "./scop_perf [-u] [-n <runs>] [baseline.json]\n");
+    fprintf(stderr, "./scop_perf -s [-n <runs>] [-o <curves.csv>]\n");
+    fprintf(stderr, "  -u  store the results as the new baseline instead of comparing\n");
+    fprintf(stderr, "  -n  samples per timing (default %d, %d with -s)\n", PERF_RUNS, PERF_SCALING_RUNS);
+    fprintf(stderr, "  -s  measure frame time curves against the parameters of a generated stress scene\n");
+    fprintf(stderr, "  -o  also write the -s curves as CSV\n");
+}
+
+int main(int argc, char **argv) {
+    bool update = false;
+    bool scaling = false;
+    int runs = 0;
+    std::string baselinePath = PERF_BASELINE;
+    std::string csvPath;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-u") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            scaling = true;
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (argv[i][0] != '-') {
+            baselinePath = argv[i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    // Pinned before anything reads it, for this process and the scop processes it starts
+    if (!getenv("SCOP_THREADS"))
+        setenv("SCOP_THREADS", std::to_string(PERF_THREADS).c_str(), 1);
+    if (scaling) {
+        if (update || runs < 0) {
+            printUsage();
+            return 1;
+        }
+        return measureScaling(runs ? runs : PERF_SCALING_RUNS, csvPath) ? 0 : 1;
+    }
+    if (runs == 0)
+        runs = PERF_RUNS;
+    if (runs < 2 || !csvPath.empty()) {
+        printUsage();
+        return 1;
+    }
+
+    ModelList models;
+    for (const std::string &name: listModels(PERF_MODELS))
+        models.push_back({name, std::string(PERF_MODELS) + "/" + name});
+    for (const SyntheticModel &model: s_synthetic) {
+        const std::string path = std::string(PERF_SYNTHETIC_DIR) + "/" + model.name + ".obj";
+        if (!writeSphere(path, model))
+            return 1;
+        models.push_back({std::string(model.name) + ".obj", path});
+    }
+
+    std::unique_ptr<JsonValue> baseline;
+    if (!update && (!(baseline = readBaseline(baselinePath)) || !checkConfiguration(*baseline, baselinePath)))
+        return 1;
+
+    printf("Measuring %zu models, %d samples each (%s kernels, %u threads)\n", models.size(), runs,
+           getKernelIsaName(getKernelIsa()), getWorkerCount());
+    std::vector<Benchmark> results;
+    Benchmark calibration = {PERF_CALIBRATION, "ms", {}};
+    if (!measureLoads(models, runs, results, calibration))
+        return 1;
+    for (const auto &model: models) {
+        const char **end = s_frameModels + sizeof(s_frameModels) / sizeof(s_frameModels[0]);
+        if (std::find_if(s_frameModels, end, [&](const char *name) { return model.first == name; }) == end)
+            continue;
+        if (!measureFrames(model.second, model.first, runs, results, calibration))
+            return 1;
+    }
+    results.push_back(calibration);
+
+    if (update) {
+        if (!writeBaseline(baselinePath, results))
+            return 1;
+        printf("Stored %zu benchmarks in %s\n", results.size(), baselinePath.c_str());
+        return 0;
+    }
+    const size_t regressions = compare(results, *baseline);
+    if (regressions) {
+        printf("%zu of %zu benchmarks regressed\n", regressions, results.size());
+        return 1;
+    }
+    printf("No regression in %zu benchmarks\n", results.size());
+    return 0;
+}